@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/abstract-wifi-mac.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/aodv/model/aodv-neighbor.h"
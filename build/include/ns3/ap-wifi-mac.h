@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/ap-wifi-mac.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wimax/model/bs-scheduler-simple.h"
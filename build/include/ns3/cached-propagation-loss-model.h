@@ -0,0 +1 @@
+#include "../../../src/propagation/model/cached-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/eht/common-info-basic-mle.h"
@@ -0,0 +1 @@
+#include "../../../src/stats/model/count-min-sketch.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/dsdv/model/dsdv-packet.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/eht/eht-configuration.h"
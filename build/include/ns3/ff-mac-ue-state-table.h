@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/ff-mac-ue-state-table.h"
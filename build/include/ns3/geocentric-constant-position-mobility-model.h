@@ -0,0 +1 @@
+#include "/root/repo/src/mobility/model/geocentric-constant-position-mobility-model.h"
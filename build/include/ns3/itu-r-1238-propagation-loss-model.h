@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/model/itu-r-1238-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/network/utils/mac48-address.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/topology-read/model/mapped-text-file.h"
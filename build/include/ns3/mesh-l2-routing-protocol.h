@@ -0,0 +1 @@
+#include "/root/repo/src/mesh/model/mesh-l2-routing-protocol.h"
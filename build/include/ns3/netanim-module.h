@@ -0,0 +1,8 @@
+#ifdef NS3_MODULE_COMPILATION 
+    error "Do not include ns3 module aggregator headers from other modules these are meant only for end user scripts." 
+#endif 
+#ifndef NS3_MODULE_NETANIM
+    // Module headers: 
+    #include <ns3/animation-interface.h>
+    #include <ns3/animation-trace.h>
+#endif 
\ No newline at end of file
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/no-op-component-carrier-manager.h"
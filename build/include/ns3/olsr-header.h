@@ -0,0 +1 @@
+#include "/root/repo/src/olsr/model/olsr-header.h"
@@ -0,0 +1 @@
+#include "../../../src/stats/model/quantile-sketch.h"
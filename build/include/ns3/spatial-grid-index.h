@@ -0,0 +1 @@
+#include "../../../src/mobility/model/spatial-grid-index.h"
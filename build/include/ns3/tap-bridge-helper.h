@@ -0,0 +1 @@
+#include "/root/repo/src/tap-bridge/helper/tap-bridge-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wimax/model/ul-mac-messages.h"
@@ -313,21 +313,16 @@ int main(int argc, char* argv[]) {
     p2pEdge.SetDeviceAttribute("DataRate", StringValue("200Mbps"));
     p2pEdge.SetChannelAttribute("Delay", StringValue("10ms"));
 
-    // error mode 
-    Ptr<RateErrorModel> errorCore = CreateObject<RateErrorModel>();
-    errorCore->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
-    errorCore->SetAttribute("ErrorRate", DoubleValue(0.001)); // 0.1%
-    p2pCore.SetDeviceAttribute("ReceiveErrorModel", PointerValue(errorCore));
-    
-    Ptr<RateErrorModel> errorMid = CreateObject<RateErrorModel>();  
-    errorMid->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
-    errorMid->SetAttribute("ErrorRate", DoubleValue(0.01));   // 1%
-    p2pMid.SetDeviceAttribute("ReceiveErrorModel", PointerValue(errorMid));
-
-    Ptr<RateErrorModel> errorEdge = CreateObject<RateErrorModel>();
-    errorEdge->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
-    errorEdge->SetAttribute("ErrorRate", DoubleValue(0.05));  // 5%
-    p2pEdge.SetDeviceAttribute("ReceiveErrorModel", PointerValue(errorEdge));
+    // error mode: one loss process per device, with precomputed loss gaps
+    auto setErrorRate = [](PointToPointHelper& helper, double rate) {
+        helper.SetReceiveErrorModel("ns3::RateErrorModel",
+                                    "ErrorUnit", StringValue("ERROR_UNIT_PACKET"),
+                                    "ErrorRate", DoubleValue(rate),
+                                    "ScheduleLosses", BooleanValue(true));
+    };
+    setErrorRate(p2pCore, 0.001); // 0.1%
+    setErrorRate(p2pMid, 0.01);   // 1%
+    setErrorRate(p2pEdge, 0.05);  // 5%
 
     Ipv4AddressHelper address("10.1.0.0", "255.255.255.0");
     NetDeviceContainer allDevices;
@@ -354,12 +349,11 @@ int main(int argc, char* argv[]) {
     }
 
     // ----------- 核心到边缘层连接 -----------
+    setErrorRate(p2pMid, 0.001); // 0.1%, as the core links
     for (uint32_t i = 0; i < groupCore.GetN(); ++i) {
         NodeContainer pair(groupCore.Get(i), groupEdge.Get(i));
         NetDeviceContainer dev = p2pMid.Install(pair);
         
-        dev.Get(0)->SetAttribute("ReceiveErrorModel", PointerValue(errorCore));
-        dev.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorCore));        
         address.Assign(dev);
         address.NewNetwork();
         allDevices.Add(dev);
@@ -15,8 +15,6 @@
  */
 #include "aodv-id-cache.h"
 
-#include <algorithm>
-
 namespace ns3
 {
 namespace aodv
@@ -25,29 +23,26 @@ bool
 IdCache::IsDuplicate(Ipv4Address addr, uint32_t id)
 {
     Purge();
-    for (auto i = m_idCache.begin(); i != m_idCache.end(); ++i)
+    uint64_t key = GetKey(addr, id);
+    if (m_idCache.IsScheduled(key))
     {
-        if (i->m_context == addr && i->m_id == id)
-        {
-            return true;
-        }
+        return true;
     }
-    UniqueId uniqueId = {addr, id, m_lifetime + Simulator::Now()};
-    m_idCache.push_back(uniqueId);
+    m_idCache.Schedule(key, m_lifetime + Simulator::Now());
     return false;
 }
 
 void
 IdCache::Purge()
 {
-    m_idCache.erase(remove_if(m_idCache.begin(), m_idCache.end(), IsExpired()), m_idCache.end());
+    m_idCache.Expire(Simulator::Now());
 }
 
 uint32_t
 IdCache::GetSize()
 {
     Purge();
-    return m_idCache.size();
+    return m_idCache.GetSize();
 }
 
 } // namespace aodv
@@ -19,8 +19,7 @@
 
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
-
-#include <vector>
+#include "ns3/timer-wheel.h"
 
 namespace ns3
 {
@@ -76,36 +75,18 @@ class IdCache
     }
 
   private:
-    /// Unique packet ID
-    struct UniqueId
-    {
-        /// ID is supposed to be unique in single address context (e.g. sender address)
-        Ipv4Address m_context;
-        /// The id
-        uint32_t m_id;
-        /// When record will expire
-        Time m_expire;
-    };
-
     /**
-     * @brief IsExpired structure
+     * @param addr the IP address
+     * @param id the cache entry ID
+     * @returns the key of the pair in the cache
      */
-    struct IsExpired
+    static uint64_t GetKey(Ipv4Address addr, uint32_t id)
     {
-        /**
-         * @brief Check if the entry is expired
-         *
-         * @param u UniqueId entry
-         * @return true if expired, false otherwise
-         */
-        bool operator()(const UniqueId& u) const
-        {
-            return (u.m_expire < Simulator::Now());
-        }
-    };
+        return (static_cast<uint64_t>(addr.Get()) << 32) | id;
+    }
 
-    /// Already seen IDs
-    std::vector<UniqueId> m_idCache;
+    /// Already seen IDs, with the time when they expire
+    TimerWheel<uint64_t> m_idCache;
     /// Default lifetime for ID records
     Time m_lifetime;
 };
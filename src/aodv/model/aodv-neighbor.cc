@@ -29,7 +29,8 @@ NS_LOG_COMPONENT_DEFINE("AodvNeighbors");
 namespace aodv
 {
 Neighbors::Neighbors(Time delay)
-    : m_ntimer(Timer::CANCEL_ON_DESTROY)
+    : m_ntimer(Timer::CANCEL_ON_DESTROY),
+      m_closed(false)
 {
     m_ntimer.SetDelay(delay);
     m_ntimer.SetFunction(&Neighbors::Purge, this);
@@ -83,6 +84,7 @@ Neighbors::Update(Ipv4Address addr, Time expire)
     NS_LOG_LOGIC("Open link to " << addr);
     Neighbor neighbor(addr, LookupMacAddress(addr), expire + Simulator::Now());
     m_nb.push_back(neighbor);
+    m_expiry.Schedule(addr, neighbor.m_expireTime);
     Purge();
 }
 
@@ -111,19 +113,53 @@ Neighbors::Purge()
         return;
     }
 
-    CloseNeighbor pred;
-    if (!m_handleLinkFailure.IsNull())
+    // the list is only visited when an entry has expired or was closed
+    bool expired = m_closed;
+    for (const auto& addr : m_expiry.Expire(Simulator::Now()))
     {
-        for (auto j = m_nb.begin(); j != m_nb.end(); ++j)
+        auto i = std::find_if(m_nb.begin(), m_nb.end(), [&addr](const Neighbor& nb) {
+            return nb.m_neighborAddress == addr;
+        });
+        if (i == m_nb.end())
         {
-            if (pred(*j))
+            // the entry was closed
+            continue;
+        }
+        if (i->m_expireTime < Simulator::Now())
+        {
+            expired = true;
+        }
+        else
+        {
+            // the expire time was extended since the expiry was scheduled
+            m_expiry.Schedule(addr, i->m_expireTime);
+        }
+    }
+
+    if (expired)
+    {
+        CloseNeighbor pred;
+        if (!m_handleLinkFailure.IsNull())
+        {
+            for (auto j = m_nb.begin(); j != m_nb.end(); ++j)
+            {
+                if (pred(*j))
+                {
+                    NS_LOG_LOGIC("Close link to " << j->m_neighborAddress);
+                    m_handleLinkFailure(j->m_neighborAddress);
+                }
+            }
+        }
+        for (const auto& nb : m_nb)
+        {
+            if (nb.close)
             {
-                NS_LOG_LOGIC("Close link to " << j->m_neighborAddress);
-                m_handleLinkFailure(j->m_neighborAddress);
+                m_expiry.Cancel(nb.m_neighborAddress);
             }
         }
+        m_nb.erase(std::remove_if(m_nb.begin(), m_nb.end(), pred), m_nb.end());
+        m_closed = false;
     }
-    m_nb.erase(std::remove_if(m_nb.begin(), m_nb.end(), pred), m_nb.end());
     m_ntimer.Cancel();
     m_ntimer.Schedule();
 }
@@ -173,6 +209,7 @@ Neighbors::ProcessTxError(const WifiMacHeader& hdr)
         if (i->m_hardwareAddress == addr)
         {
             i->close = true;
+            m_closed = true;
         }
     }
     Purge();
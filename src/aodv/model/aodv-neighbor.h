@@ -21,6 +21,7 @@
 #include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/timer.h"
 
 #include <vector>
@@ -103,6 +104,7 @@ class Neighbors
     void Clear()
     {
         m_nb.clear();
+        m_expiry.Clear();
     }
 
     /**
@@ -152,6 +154,10 @@ class Neighbors
     Timer m_ntimer;
     /// vector of entries
     std::vector<Neighbor> m_nb;
+    /// Expiry of the entries, so that Purge() only visits the list when one has expired
+    TimerWheel<Ipv4Address, Ipv4AddressHash> m_expiry;
+    /// Whether some entries were closed by a layer 2 notification
+    bool m_closed;
     /// list of ARP cached to be used for layer 2 notifications processing
     std::vector<Ptr<ArpCache>> m_arp;
 
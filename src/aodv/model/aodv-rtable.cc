@@ -260,6 +260,7 @@ RoutingTable::DeleteRoute(Ipv4Address dst)
     Purge();
     if (m_ipv4AddressEntry.erase(dst) != 0)
     {
+        m_expiry.Cancel(dst);
         NS_LOG_LOGIC("Route deletion to " << dst << " successful");
         return true;
     }
@@ -277,6 +278,10 @@ RoutingTable::AddRoute(RoutingTableEntry& rt)
         rt.SetRreqCnt(0);
     }
     auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    if (result.second)
+    {
+        ScheduleExpiry(rt);
+    }
     return result.second;
 }
 
@@ -296,6 +301,7 @@ RoutingTable::Update(RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " set RreqCnt to 0");
         i->second.SetRreqCnt(0);
     }
+    ScheduleExpiry(i->second);
     return true;
 }
 
@@ -311,6 +317,7 @@ RoutingTable::SetEntryState(Ipv4Address id, RouteFlags state)
     }
     i->second.SetFlag(state);
     i->second.SetRreqCnt(0);
+    ScheduleExpiry(i->second);
     NS_LOG_LOGIC("Route set entry state to " << id << ": new state is " << state);
     return true;
 }
@@ -345,6 +352,7 @@ RoutingTable::InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unr
             {
                 NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
                 i->second.Invalidate(m_badLinkLifetime);
+                ScheduleExpiry(i->second);
             }
         }
     }
@@ -364,6 +372,7 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
         {
             auto tmp = i;
             ++i;
+            m_expiry.Cancel(tmp->first);
             m_ipv4AddressEntry.erase(tmp);
         }
         else
@@ -377,38 +386,35 @@ void
 RoutingTable::Purge()
 {
     NS_LOG_FUNCTION(this);
-    if (m_ipv4AddressEntry.empty())
-    {
-        return;
-    }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+    for (const auto& dst : m_expiry.Expire(Simulator::Now()))
     {
-        if (i->second.GetLifeTime().IsStrictlyNegative())
+        auto i = m_ipv4AddressEntry.find(dst);
+        NS_ASSERT(i != m_ipv4AddressEntry.end());
+        if (!i->second.GetLifeTime().IsStrictlyNegative())
         {
-            if (i->second.GetFlag() == INVALID)
-            {
-                auto tmp = i;
-                ++i;
-                m_ipv4AddressEntry.erase(tmp);
-            }
-            else if (i->second.GetFlag() == VALID)
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-                ++i;
-            }
-            else
-            {
-                ++i;
-            }
+            // the lifetime was extended since the expiry was scheduled
+            ScheduleExpiry(i->second);
         }
-        else
+        else if (i->second.GetFlag() == INVALID)
         {
-            ++i;
+            m_ipv4AddressEntry.erase(i);
+        }
+        else if (i->second.GetFlag() == VALID)
+        {
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.Invalidate(m_badLinkLifetime);
+            ScheduleExpiry(i->second);
         }
+        // the expired entries in search are scheduled again when they are updated
     }
 }
 
+void
+RoutingTable::ScheduleExpiry(const RoutingTableEntry& rt)
+{
+    m_expiry.Schedule(rt.GetDestination(), Simulator::Now() + rt.GetLifeTime());
+}
+
 void
 RoutingTable::Purge(std::map<Ipv4Address, RoutingTableEntry>& table) const
 {
@@ -20,6 +20,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/net-device.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/timer.h"
 
 #include <cassert>
@@ -507,6 +508,7 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_expiry.Clear();
     }
 
     /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
@@ -528,6 +530,8 @@ class RoutingTable
   private:
     /// The routing table
     std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+    /// Expiry of the lifetime of the entries, so that Purge() only visits the expired ones
+    TimerWheel<Ipv4Address, Ipv4AddressHash> m_expiry;
     /// Deletion time for invalid routes
     Time m_badLinkLifetime;
     /**
@@ -535,6 +539,12 @@ class RoutingTable
      * @param table the routing table entry to purge
      */
     void Purge(std::map<Ipv4Address, RoutingTableEntry>& table) const;
+    /**
+     * Schedule the expiry of the lifetime of an entry, which must be called whenever an
+     * entry of the table is added or modified.
+     * @param rt the routing table entry
+     */
+    void ScheduleExpiry(const RoutingTableEntry& rt);
 };
 
 } // namespace aodv
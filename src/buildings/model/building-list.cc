@@ -66,6 +66,15 @@ class BuildingListPriv : public Object
      * @returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * Gets the spatial index of the Buildings, building it if needed
+     * @returns the spatial index
+     */
+    Ptr<const BuildingSpatialIndex> GetSpatialIndex();
+    /**
+     * Discards the spatial index of the Buildings
+     */
+    void InvalidateSpatialIndex();
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -88,6 +97,7 @@ class BuildingListPriv : public Object
      */
     static void Delete();
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+    Ptr<BuildingSpatialIndex> m_index;      //!< Spatial index of m_buildings, if up to date
 };
 
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
@@ -154,6 +164,7 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    m_index = nullptr;
     Object::DoDispose();
 }
 
@@ -162,6 +173,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    m_index = nullptr;
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -193,6 +205,23 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+Ptr<const BuildingSpatialIndex>
+BuildingListPriv::GetSpatialIndex()
+{
+    if (!m_index)
+    {
+        NS_LOG_LOGIC("Building the spatial index of " << m_buildings.size() << " buildings");
+        m_index = Create<BuildingSpatialIndex>(m_buildings);
+    }
+    return m_index;
+}
+
+void
+BuildingListPriv::InvalidateSpatialIndex()
+{
+    m_index = nullptr;
+}
+
 } // namespace ns3
 
 /**
@@ -233,4 +262,16 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+Ptr<const BuildingSpatialIndex>
+BuildingList::GetSpatialIndex()
+{
+    return BuildingListPriv::Get()->GetSpatialIndex();
+}
+
+void
+BuildingList::InvalidateSpatialIndex()
+{
+    BuildingListPriv::Get()->InvalidateSpatialIndex();
+}
+
 } // namespace ns3
@@ -11,6 +11,8 @@
 #ifndef BUILDING_LIST_H_
 #define BUILDING_LIST_H_
 
+#include "building-spatial-index.h"
+
 #include "ns3/ptr.h"
 
 #include <vector>
@@ -58,6 +60,20 @@ class BuildingList
      * @returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * The index is built on the first call after a building has been added
+     * to the list or has had its boundaries changed.
+     *
+     * @returns a spatial index of the buildings currently in the list.
+     */
+    static Ptr<const BuildingSpatialIndex> GetSpatialIndex();
+    /**
+     * Discard the spatial index of the buildings, so that it is rebuilt by
+     * the next call to GetSpatialIndex.
+     *
+     * This method is called automatically from Building::SetBoundaries.
+     */
+    static void InvalidateSpatialIndex();
 };
 
 } // namespace ns3
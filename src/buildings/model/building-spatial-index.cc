@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "building-spatial-index.h"
+
+#include "building.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BuildingSpatialIndex");
+
+BuildingSpatialIndex::BuildingSpatialIndex(const std::vector<Ptr<Building>>& buildings)
+    : m_xMin(0),
+      m_xMax(0),
+      m_yMin(0),
+      m_yMax(0),
+      m_cellSize(1),
+      m_margin(0),
+      m_nx(0),
+      m_ny(0)
+{
+    NS_LOG_FUNCTION(this << buildings.size());
+    auto isBounded = [](const Box& box) {
+        return std::isfinite(box.xMin) && std::isfinite(box.xMax) && std::isfinite(box.yMin) &&
+               std::isfinite(box.yMax);
+    };
+
+    double xMin = std::numeric_limits<double>::infinity();
+    double xMax = -xMin;
+    double yMin = xMin;
+    double yMax = -xMin;
+    double sides = 0;
+    uint32_t nBounded = 0;
+    for (const auto& building : buildings)
+    {
+        Box box = building->GetBoundaries();
+        if (isBounded(box))
+        {
+            xMin = std::min(xMin, box.xMin);
+            xMax = std::max(xMax, box.xMax);
+            yMin = std::min(yMin, box.yMin);
+            yMax = std::max(yMax, box.yMax);
+            sides += std::max(box.xMax - box.xMin, box.yMax - box.yMin);
+            nBounded++;
+        }
+        else
+        {
+            m_unbounded.push_back(building);
+        }
+    }
+    if (nBounded == 0)
+    {
+        return;
+    }
+
+    // about one cell per building, and no cell smaller than an average building
+    double width = xMax - xMin;
+    double height = yMax - yMin;
+    m_cellSize = std::max(sides / nBounded, std::sqrt(width * height / nBounded));
+    if (!std::isfinite(m_cellSize) || m_cellSize <= 0)
+    {
+        m_cellSize = std::max({width, height, 1.0});
+    }
+    // the buildings may be spread along a line
+    const double maxCells = 4.0 * nBounded + 16;
+    while ((std::floor(width / m_cellSize) + 1) * (std::floor(height / m_cellSize) + 1) > maxCells)
+    {
+        m_cellSize *= 2;
+    }
+    m_margin = 1e-6 * m_cellSize;
+    m_xMin = xMin - m_margin;
+    m_xMax = xMax + m_margin;
+    m_yMin = yMin - m_margin;
+    m_yMax = yMax + m_margin;
+    m_nx = static_cast<uint32_t>(std::floor((m_xMax - m_xMin) / m_cellSize)) + 1;
+    m_ny = static_cast<uint32_t>(std::floor((m_yMax - m_yMin) / m_cellSize)) + 1;
+    m_cells.resize(static_cast<std::size_t>(m_nx) * m_ny);
+
+    for (const auto& building : buildings)
+    {
+        Box box = building->GetBoundaries();
+        uint32_t x0 = 0;
+        uint32_t x1 = m_nx - 1;
+        uint32_t y0 = 0;
+        uint32_t y1 = m_ny - 1;
+        if (isBounded(box))
+        {
+            x0 = GetColumn(box.xMin - m_margin);
+            x1 = GetColumn(box.xMax + m_margin);
+            y0 = GetRow(box.yMin - m_margin);
+            y1 = GetRow(box.yMax + m_margin);
+        }
+        for (uint32_t y = y0; y <= y1; y++)
+        {
+            for (uint32_t x = x0; x <= x1; x++)
+            {
+                m_cells[static_cast<std::size_t>(y) * m_nx + x].push_back(building);
+            }
+        }
+    }
+    NS_LOG_LOGIC(buildings.size() << " buildings in " << m_nx << "x" << m_ny << " cells of "
+                                  << m_cellSize << " m");
+}
+
+uint32_t
+BuildingSpatialIndex::GetColumn(double x) const
+{
+    auto column = static_cast<int64_t>(std::floor((x - m_xMin) / m_cellSize));
+    return static_cast<uint32_t>(std::clamp<int64_t>(column, 0, m_nx - 1));
+}
+
+uint32_t
+BuildingSpatialIndex::GetRow(double y) const
+{
+    auto row = static_cast<int64_t>(std::floor((y - m_yMin) / m_cellSize));
+    return static_cast<uint32_t>(std::clamp<int64_t>(row, 0, m_ny - 1));
+}
+
+uint32_t
+BuildingSpatialIndex::GetNCells() const
+{
+    return m_cells.size();
+}
+
+const std::vector<Ptr<Building>>&
+BuildingSpatialIndex::GetBuildingsAround(const Vector& position) const
+{
+    if (m_cells.empty() || !(position.x >= m_xMin && position.x <= m_xMax &&
+                             position.y >= m_yMin && position.y <= m_yMax))
+    {
+        return m_unbounded;
+    }
+    return m_cells[static_cast<std::size_t>(GetRow(position.y)) * m_nx + GetColumn(position.x)];
+}
+
+void
+BuildingSpatialIndex::GetBuildingsAlong(const Vector& l1,
+                                        const Vector& l2,
+                                        std::vector<Ptr<Building>>& buildings) const
+{
+    double xLo = std::min(l1.x, l2.x);
+    double xHi = std::max(l1.x, l2.x);
+    double yLo = std::min(l1.y, l2.y);
+    double yHi = std::max(l1.y, l2.y);
+    if (m_cells.empty() || !(xHi >= m_xMin && xLo <= m_xMax && yHi >= m_yMin && yLo <= m_yMax))
+    {
+        buildings = m_unbounded;
+        return;
+    }
+
+    buildings.clear();
+    uint32_t x0 = GetColumn(xLo);
+    uint32_t x1 = GetColumn(xHi);
+    double slope = (x0 == x1) ? 0 : (l2.y - l1.y) / (l2.x - l1.x);
+    for (uint32_t x = x0; x <= x1; x++)
+    {
+        // the ordinates of the segment within the column
+        double yA = yLo;
+        double yB = yHi;
+        if (x0 != x1)
+        {
+            double xA = std::max(xLo, m_xMin + x * m_cellSize - m_margin);
+            double xB = std::min(xHi, m_xMin + (x + 1) * m_cellSize + m_margin);
+            double yXA = l1.y + (xA - l1.x) * slope;
+            double yXB = l1.y + (xB - l1.x) * slope;
+            yA = std::max(yLo, std::min(yXA, yXB) - m_margin);
+            yB = std::min(yHi, std::max(yXA, yXB) + m_margin);
+        }
+        for (uint32_t y = GetRow(yA); y <= GetRow(yB); y++)
+        {
+            const auto& cell = m_cells[static_cast<std::size_t>(y) * m_nx + x];
+            buildings.insert(buildings.end(), cell.begin(), cell.end());
+        }
+    }
+
+    // the buildings overlapping several cells are found several times
+    std::sort(buildings.begin(), buildings.end(), [](const auto& a, const auto& b) {
+        return a->GetId() < b->GetId();
+    });
+    buildings.erase(std::unique(buildings.begin(), buildings.end()), buildings.end());
+}
+
+} // namespace ns3
@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BUILDING_SPATIAL_INDEX_H
+#define BUILDING_SPATIAL_INDEX_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+class Building;
+
+/**
+ * @ingroup buildings
+ * @brief A uniform grid of the footprints of a set of buildings
+ *
+ * This index answers the questions "which buildings may contain a
+ * position?" and "which buildings may intersect a line segment?" without
+ * checking every building.  Each cell of a grid in the x-y plane lists the
+ * buildings whose footprint overlaps it, slightly enlarged to absorb the
+ * rounding errors of the exact tests.  The candidates returned by the
+ * queries are a superset of the buildings passing Building::IsInside or
+ * Building::IsIntersect, which the caller still has to check.
+ *
+ * The size of the cells is chosen so that there are about as many cells as
+ * buildings, and that a cell is not smaller than an average building.  The
+ * buildings with a non-finite footprint are listed in every cell.
+ *
+ * The index is a snapshot: it is not updated when a building is added or
+ * its boundaries are changed.  BuildingList::GetSpatialIndex returns an
+ * index that is up to date with the list.
+ */
+class BuildingSpatialIndex : public SimpleRefCount<BuildingSpatialIndex>
+{
+  public:
+    /**
+     * Constructor
+     * @param buildings the buildings to index, in increasing order of
+     *        identifier
+     */
+    BuildingSpatialIndex(const std::vector<Ptr<Building>>& buildings);
+
+    /**
+     * Get the buildings that may contain a position.
+     * @param position the position
+     * @return the buildings, in increasing order of identifier
+     */
+    const std::vector<Ptr<Building>>& GetBuildingsAround(const Vector& position) const;
+
+    /**
+     * Get the buildings that may intersect a line segment.
+     * @param l1 the first end of the line segment
+     * @param l2 the second end of the line segment
+     * @param [out] buildings the buildings, in increasing order of identifier
+     */
+    void GetBuildingsAlong(const Vector& l1,
+                           const Vector& l2,
+                           std::vector<Ptr<Building>>& buildings) const;
+
+    /**
+     * @return the number of cells of the grid
+     */
+    uint32_t GetNCells() const;
+
+  private:
+    /**
+     * Get the column of the cells containing an abscissa.
+     * @param x the abscissa, within the grid
+     * @return the column of the cells
+     */
+    uint32_t GetColumn(double x) const;
+    /**
+     * Get the row of the cells containing an ordinate.
+     * @param y the ordinate, within the grid
+     * @return the row of the cells
+     */
+    uint32_t GetRow(double y) const;
+
+    double m_xMin;     //!< Lower x coordinate of the grid
+    double m_xMax;     //!< Upper x coordinate of the grid
+    double m_yMin;     //!< Lower y coordinate of the grid
+    double m_yMax;     //!< Upper y coordinate of the grid
+    double m_cellSize; //!< Size of the side of a cell
+    double m_margin;   //!< Enlargement of the footprints and of the queries
+    uint32_t m_nx;     //!< Number of columns of the grid
+    uint32_t m_ny;     //!< Number of rows of the grid
+    /// Buildings overlapping each cell, by row then column
+    std::vector<std::vector<Ptr<Building>>> m_cells;
+    /// Buildings with a non-finite footprint
+    std::vector<Ptr<Building>> m_unbounded;
+};
+
+} // namespace ns3
+
+#endif /* BUILDING_SPATIAL_INDEX_H */
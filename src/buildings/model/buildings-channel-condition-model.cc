@@ -15,6 +15,8 @@
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -160,9 +162,12 @@ bool
 BuildingsChannelConditionModel::IsLineOfSightBlocked(const ns3::Vector& l1,
                                                      const ns3::Vector& l2) const
 {
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    // only the buildings whose footprint may intersect the line-segment are checked
+    std::vector<Ptr<Building>> buildings;
+    BuildingList::GetSpatialIndex()->GetBuildingsAlong(l1, l2, buildings);
+    for (const auto& building : buildings)
     {
-        if ((*bit)->IsIntersect(l1, l2))
+        if (building->IsIntersect(l1, l2))
         {
             // The line of sight should be blocked if the line-segment between
             // l1 and l2 intersects one of the buildings.
@@ -157,21 +157,23 @@ MobilityBuildingInfo::MakeConsistent(Ptr<MobilityModel> mm)
 {
     bool found = false;
     Vector pos = mm->GetPosition();
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    // only the buildings whose footprint may contain the position are checked
+    Ptr<const BuildingSpatialIndex> index = BuildingList::GetSpatialIndex();
+    for (const auto& building : index->GetBuildingsAround(pos))
     {
-        NS_LOG_LOGIC("checking building " << (*bit)->GetId() << " with boundaries "
-                                          << (*bit)->GetBoundaries());
-        if ((*bit)->IsInside(pos))
+        NS_LOG_LOGIC("checking building " << building->GetId() << " with boundaries "
+                                          << building->GetBoundaries());
+        if (building->IsInside(pos))
         {
             NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos
-                                                 << " falls inside building " << (*bit)->GetId());
+                                                 << " falls inside building " << building->GetId());
             NS_ABORT_MSG_UNLESS(found == false,
                                 " MobilityBuildingInfo already inside another building!");
             found = true;
-            uint16_t floor = (*bit)->GetFloor(pos);
-            uint16_t roomX = (*bit)->GetRoomX(pos);
-            uint16_t roomY = (*bit)->GetRoomY(pos);
-            SetIndoor(*bit, floor, roomX, roomY);
+            uint16_t floor = building->GetFloor(pos);
+            uint16_t roomX = building->GetRoomX(pos);
+            uint16_t roomY = building->GetRoomY(pos);
+            SetIndoor(building, floor, roomX, roomY);
         }
     }
     if (!found)
@@ -22,6 +22,7 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace ns3
 {
@@ -260,23 +261,25 @@ RandomWalk2dOutdoorMobilityModel::IsLineClearOfBuildings(Vector currentPosition,
     double minIntersectionDistance = std::numeric_limits<double>::max();
     Ptr<Building> minIntersectionDistanceBuilding;
 
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    std::vector<Ptr<Building>> buildings;
+    BuildingList::GetSpatialIndex()->GetBuildingsAlong(currentPosition, nextPosition, buildings);
+    for (const auto& building : buildings)
     {
         // check if this building intersects the line between the current and next positions
         // this checks also if the next position is inside the building
-        if ((*bit)->IsIntersect(currentPosition, nextPosition))
+        if (building->IsIntersect(currentPosition, nextPosition))
         {
-            NS_LOG_LOGIC("Building " << (*bit)->GetBoundaries() << " intersects the line between "
+            NS_LOG_LOGIC("Building " << building->GetBoundaries() << " intersects the line between "
                                      << currentPosition << " and " << nextPosition);
             auto intersection = CalculateIntersectionFromOutside(currentPosition,
                                                                  nextPosition,
-                                                                 (*bit)->GetBoundaries());
+                                                                 building->GetBoundaries());
             double distance = CalculateDistance(intersection, currentPosition);
             intersectBuilding = true;
             if (distance < minIntersectionDistance)
             {
                 minIntersectionDistance = distance;
-                minIntersectionDistanceBuilding = (*bit);
+                minIntersectionDistanceBuilding = building;
             }
         }
     }
@@ -0,0 +1,241 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/building-list.h"
+#include "ns3/building-spatial-index.h"
+#include "ns3/building.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BuildingSpatialIndexTest");
+
+/**
+ * @ingroup building-test
+ *
+ * Checks that the candidates returned by BuildingSpatialIndex include every
+ * building containing a position or intersecting a line segment, for random
+ * buildings, positions and segments.  Some of the positions and of the ends
+ * of the segments are on the walls or on the corners of the buildings.
+ */
+class BuildingSpatialIndexTestCase : public TestCase
+{
+  public:
+    BuildingSpatialIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that a list of candidates is sorted and includes some buildings.
+     * @param candidates the candidates returned by the index
+     * @param expected the buildings that must be in the candidates
+     */
+    void CheckCandidates(const std::vector<Ptr<Building>>& candidates,
+                         const std::vector<Ptr<Building>>& expected);
+};
+
+BuildingSpatialIndexTestCase::BuildingSpatialIndexTestCase()
+    : TestCase("Candidates of the building spatial index")
+{
+}
+
+void
+BuildingSpatialIndexTestCase::CheckCandidates(const std::vector<Ptr<Building>>& candidates,
+                                              const std::vector<Ptr<Building>>& expected)
+{
+    for (std::size_t i = 1; i < candidates.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_LT(candidates[i - 1]->GetId(),
+                              candidates[i]->GetId(),
+                              "The candidates are not sorted by identifier");
+    }
+    for (const auto& building : expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(std::binary_search(candidates.begin(),
+                                                 candidates.end(),
+                                                 building,
+                                                 [](const auto& a, const auto& b) {
+                                                     return a->GetId() < b->GetId();
+                                                 }),
+                              true,
+                              "Building " << building->GetId() << " is not a candidate");
+    }
+}
+
+void
+BuildingSpatialIndexTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    // small buildings on a 1 km square, a few large ones, and adjacent ones
+    std::vector<Ptr<Building>> buildings;
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        double size = (i % 50 == 0) ? rand->GetValue(100, 400) : rand->GetValue(5, 30);
+        double x = rand->GetValue(-500, 500);
+        double y = rand->GetValue(-500, 500);
+        if (i % 10 == 1)
+        {
+            // shares a wall with the previous building
+            Box previous = buildings.back()->GetBoundaries();
+            x = previous.xMax;
+            y = previous.yMin;
+        }
+        Ptr<Building> building = CreateObject<Building>();
+        building->SetBoundaries(Box(x, x + size, y, y + size * 0.7, 0, rand->GetValue(3, 60)));
+        buildings.push_back(building);
+    }
+
+    // positions in the area around the buildings, or on a wall or corner of a building
+    auto getPosition = [&]() {
+        uint32_t choice = rand->GetInteger(0, 3);
+        if (choice == 0)
+        {
+            return Vector(rand->GetValue(-700, 700),
+                          rand->GetValue(-700, 700),
+                          rand->GetValue(0, 70));
+        }
+        Box box = buildings[rand->GetInteger(0, buildings.size() - 1)]->GetBoundaries();
+        double x = (choice == 1) ? box.xMin : rand->GetValue(box.xMin, box.xMax);
+        double y = (choice == 1) ? box.yMax : (choice == 2 ? box.yMin : box.yMax);
+        return Vector(x, y, rand->GetValue(box.zMin, box.zMax));
+    };
+
+    Ptr<const BuildingSpatialIndex> index = BuildingList::GetSpatialIndex();
+    NS_TEST_ASSERT_MSG_GT(index->GetNCells(), 1, "The buildings are in a single cell");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(index->GetNCells(),
+                                4 * buildings.size() + 16,
+                                "The grid has too many cells");
+
+    std::vector<Ptr<Building>> expected;
+    std::vector<Ptr<Building>> candidates;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        Vector position = getPosition();
+        expected.clear();
+        for (const auto& building : buildings)
+        {
+            if (building->IsInside(position))
+            {
+                expected.push_back(building);
+            }
+        }
+        CheckCandidates(index->GetBuildingsAround(position), expected);
+
+        Vector l1 = getPosition();
+        Vector l2 = (i % 4 == 0) ? Vector(l1.x, rand->GetValue(-700, 700), l1.z) : getPosition();
+        expected.clear();
+        for (const auto& building : buildings)
+        {
+            if (building->IsIntersect(l1, l2))
+            {
+                expected.push_back(building);
+            }
+        }
+        index->GetBuildingsAlong(l1, l2, candidates);
+        CheckCandidates(candidates, expected);
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup building-test
+ *
+ * Checks that the spatial index of BuildingList follows the buildings
+ * added to the list and the changes of their boundaries.
+ */
+class BuildingListSpatialIndexTestCase : public TestCase
+{
+  public:
+    BuildingListSpatialIndexTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BuildingListSpatialIndexTestCase::BuildingListSpatialIndexTestCase()
+    : TestCase("Update of the spatial index of the building list")
+{
+}
+
+void
+BuildingListSpatialIndexTestCase::DoRun()
+{
+    Vector inFirst(5, 5, 1);
+    Vector inSecond(105, 5, 1);
+    Vector l1(-10, 5, 1);
+    Vector l2(200, 5, 1);
+
+    NS_TEST_ASSERT_MSG_EQ(BuildingList::GetSpatialIndex()->GetBuildingsAround(inFirst).empty(),
+                          true,
+                          "There are no buildings");
+
+    Ptr<Building> first = CreateObject<Building>();
+    first->SetBoundaries(Box(0, 10, 0, 10, 0, 10));
+    std::vector<Ptr<Building>> around =
+        BuildingList::GetSpatialIndex()->GetBuildingsAround(inFirst);
+    NS_TEST_ASSERT_MSG_EQ(around.size(), 1, "The first building is not indexed");
+    NS_TEST_ASSERT_MSG_EQ(around[0], first, "The first building is not indexed");
+
+    Ptr<Building> second = CreateObject<Building>();
+    second->SetBoundaries(Box(100, 110, 0, 10, 0, 10));
+    std::vector<Ptr<Building>> along;
+    BuildingList::GetSpatialIndex()->GetBuildingsAlong(l1, l2, along);
+    NS_TEST_ASSERT_MSG_EQ(along.size(), 2, "The second building is not indexed");
+
+    // move the first building away from the segment
+    first->SetBoundaries(Box(0, 10, 1000, 1010, 0, 10));
+    Ptr<const BuildingSpatialIndex> index = BuildingList::GetSpatialIndex();
+    index->GetBuildingsAlong(l1, l2, along);
+    NS_TEST_ASSERT_MSG_EQ(along.size(), 1, "The first building has not been moved");
+    NS_TEST_ASSERT_MSG_EQ(along[0], second, "The first building has not been moved");
+    NS_TEST_ASSERT_MSG_EQ(index->GetBuildingsAround(inSecond).size(), 1, "Wrong candidates");
+    NS_TEST_ASSERT_MSG_EQ(index->GetBuildingsAround(Vector(5, 1005, 1)).size(),
+                          1,
+                          "The first building has not been moved");
+
+    // a building without bounds is a candidate everywhere
+    const double inf = std::numeric_limits<double>::infinity();
+    Ptr<Building> unbounded = CreateObject<Building>();
+    unbounded->SetBoundaries(Box(-inf, inf, -inf, inf, 0, 1));
+    index = BuildingList::GetSpatialIndex();
+    NS_TEST_ASSERT_MSG_EQ(index->GetBuildingsAround(inSecond).size(), 2, "Wrong candidates");
+    NS_TEST_ASSERT_MSG_EQ(index->GetBuildingsAround(Vector(1e6, 0, 0)).size(),
+                          1,
+                          "The unbounded building is not a candidate");
+    index->GetBuildingsAlong(l1, l2, along);
+    NS_TEST_ASSERT_MSG_EQ(along.size(), 2, "Wrong candidates");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup building-test
+ * Test suite for the building spatial index
+ */
+class BuildingSpatialIndexTestSuite : public TestSuite
+{
+  public:
+    BuildingSpatialIndexTestSuite();
+};
+
+BuildingSpatialIndexTestSuite::BuildingSpatialIndexTestSuite()
+    : TestSuite("building-spatial-index", Type::UNIT)
+{
+    AddTestCase(new BuildingSpatialIndexTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BuildingListSpatialIndexTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static BuildingSpatialIndexTestSuite g_buildingSpatialIndexTestSuite;
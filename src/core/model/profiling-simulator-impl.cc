@@ -0,0 +1,510 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "profiling-simulator-impl.h"
+
+#include "default-simulator-impl.h"
+#include "demangle.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+#include "string.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup profiling
+ * ns3::ProfilingSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions
+NS_LOG_COMPONENT_DEFINE("ProfilingSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+namespace
+{
+
+/**
+ * @ingroup profiling
+ * Get an object factory configured to the default simulator implementation
+ * @return an object factory.
+ */
+ObjectFactory
+GetDefaultSimulatorImplFactory()
+{
+    ObjectFactory factory;
+    factory.SetTypeId(DefaultSimulatorImpl::GetTypeId());
+    return factory;
+}
+
+/**
+ * @ingroup profiling
+ * Event wrapping another event, whose execution is profiled.
+ */
+class ProfiledEventImpl : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] profiler The profiling simulator implementation.
+     * @param [in] event The wrapped event; ownership is transferred.
+     */
+    ProfiledEventImpl(ProfilingSimulatorImpl* profiler, EventImpl* event)
+        : m_profiler(profiler),
+          m_event(event, false),
+          m_type(typeid(*event))
+    {
+    }
+
+  protected:
+    ~ProfiledEventImpl() override
+    {
+    }
+
+  private:
+    void Notify() override
+    {
+        m_profiler->InvokeProfiled(PeekPointer(m_event), m_type);
+    }
+
+    ProfilingSimulatorImpl* m_profiler; //!< The profiling simulator implementation
+    Ptr<EventImpl> m_event;             //!< The wrapped event
+    std::type_index m_type;             //!< Dynamic type of the wrapped event
+};
+
+/**
+ * @ingroup profiling
+ * Convert a wall clock duration to microseconds.
+ * @param [in] d The duration.
+ * @return The duration in microseconds.
+ */
+double
+ToMicroSeconds(std::chrono::steady_clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+/**
+ * @ingroup profiling
+ * Write a string as a JSON string literal.
+ * @param [in] os The output stream.
+ * @param [in] s The string.
+ */
+void
+WriteJsonString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+} // namespace
+
+TypeId
+ProfilingSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ProfilingSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<ProfilingSimulatorImpl>()
+            .AddAttribute(
+                "SimulatorImplFactory",
+                "Factory for the underlying simulator implementation being profiled.",
+                ObjectFactoryValue(GetDefaultSimulatorImplFactory()),
+                MakeObjectFactoryAccessor(&ProfilingSimulatorImpl::m_simulatorImplFactory),
+                MakeObjectFactoryChecker())
+            .AddAttribute("TraceFile",
+                          "The name of the file to write every profiled event to, in the Chrome "
+                          "trace event JSON format. If empty, no trace is written.",
+                          StringValue(""),
+                          MakeStringAccessor(&ProfilingSimulatorImpl::m_traceFileName),
+                          MakeStringChecker())
+            .AddAttribute("ReportFile",
+                          "The name of the file to write the profiling report to when the "
+                          "simulator is destroyed. If empty, the report is written to the "
+                          "standard output.",
+                          StringValue(""),
+                          MakeStringAccessor(&ProfilingSimulatorImpl::m_reportFileName),
+                          MakeStringChecker());
+    return tid;
+}
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl()
+    : m_finished(false),
+      m_started(false),
+      m_firstTraceEvent(true)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ProfilingSimulatorImpl::~ProfilingSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ProfilingSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Finish();
+    if (m_simulator)
+    {
+        m_simulator->Dispose();
+        m_simulator = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+ProfilingSimulatorImpl::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+    m_simulator = m_simulatorImplFactory.Create<SimulatorImpl>();
+    if (!m_traceFileName.empty())
+    {
+        m_traceFile.open(m_traceFileName);
+        if (!m_traceFile.is_open())
+        {
+            NS_FATAL_ERROR("Cannot open profiling trace file " << m_traceFileName);
+        }
+        m_traceFile << "{\"traceEvents\":[";
+    }
+    SimulatorImpl::NotifyConstructionCompleted();
+}
+
+EventImpl*
+ProfilingSimulatorImpl::Wrap(EventImpl* event)
+{
+    return new ProfiledEventImpl(this, event);
+}
+
+void
+ProfilingSimulatorImpl::InvokeProfiled(EventImpl* event, const std::type_index& type)
+{
+    uint32_t context = m_simulator->GetContext();
+    Clock::time_point begin = Clock::now();
+    if (!m_started)
+    {
+        m_start = begin;
+        m_started = true;
+    }
+    event->Invoke();
+    Clock::duration elapsed = Clock::now() - begin;
+
+    m_total.count++;
+    m_total.elapsed += elapsed;
+
+    Entry& contextEntry = m_contexts[context];
+    bool newContext = (contextEntry.count == 0);
+    contextEntry.count++;
+    contextEntry.elapsed += elapsed;
+
+    auto it = m_types.find(type);
+    if (it == m_types.end())
+    {
+        it = m_types.emplace(type, TypeEntry()).first;
+        it->second.name = GetEventName(type);
+    }
+    it->second.count++;
+    it->second.elapsed += elapsed;
+
+    if (m_traceFile.is_open())
+    {
+        if (newContext)
+        {
+            m_traceFile << (m_firstTraceEvent ? "\n" : ",\n")
+                        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << context
+                        << ",\"args\":{\"name\":\"";
+            if (context == Simulator::NO_CONTEXT)
+            {
+                m_traceFile << "no context";
+            }
+            else
+            {
+                m_traceFile << "context " << context;
+            }
+            m_traceFile << "\"}}";
+            m_firstTraceEvent = false;
+        }
+        m_traceFile << (m_firstTraceEvent ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(m_traceFile, it->second.name);
+        m_traceFile << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << context
+                    << ",\"ts\":" << ToMicroSeconds(begin - m_start)
+                    << ",\"dur\":" << ToMicroSeconds(elapsed)
+                    << ",\"args\":{\"time\":" << m_simulator->Now().GetSeconds() << "}}";
+        m_firstTraceEvent = false;
+    }
+}
+
+std::string
+ProfilingSimulatorImpl::GetEventName(const std::type_index& type)
+{
+    std::string name = Demangle(type.name());
+    // Extract the first parameter of MakeEvent<...>(...), i.e., the type
+    // of the function, member function or lambda bound to the event
+    const std::string prefix = "MakeEvent<";
+    std::size_t pos = name.find(prefix);
+    if (pos == std::string::npos)
+    {
+        return name;
+    }
+    pos += prefix.size() - 1;
+    std::size_t start = std::string::npos;
+    int depth = 0;
+    for (std::size_t i = pos; i < name.size(); i++)
+    {
+        char c = name[i];
+        if (c == '<' || c == '(' || c == '[' || c == '{')
+        {
+            depth++;
+            if (c == '(' && depth == 1)
+            {
+                start = i + 1;
+            }
+        }
+        else if (c == '>' || c == ')' || c == ']' || c == '}')
+        {
+            depth--;
+            if (c == ')' && depth == 0 && start != std::string::npos)
+            {
+                return name.substr(start, i - start);
+            }
+        }
+        else if (c == ',' && depth == 1 && start != std::string::npos)
+        {
+            return name.substr(start, i - start);
+        }
+    }
+    return name;
+}
+
+void
+ProfilingSimulatorImpl::Report(std::ostream& os) const
+{
+    double totalSeconds = std::chrono::duration<double>(m_total.elapsed).count();
+    os << "Profiled " << m_total.count << " events in " << totalSeconds
+       << " s of wall clock time";
+    if (totalSeconds > 0)
+    {
+        os << " (" << m_total.count / totalSeconds << " events/s)";
+    }
+    os << std::endl;
+
+    auto printRow = [&os, totalSeconds](const Entry& entry) {
+        double seconds = std::chrono::duration<double>(entry.elapsed).count();
+        os << std::setw(12) << entry.count << std::setw(12) << std::fixed << std::setprecision(3)
+           << seconds * 1e3 << std::setw(10) << std::setprecision(2)
+           << (totalSeconds > 0 ? 100 * seconds / totalSeconds : 0.0) << std::setw(14)
+           << std::setprecision(0) << (seconds > 0 ? entry.count / seconds : 0.0)
+           << std::defaultfloat << std::setprecision(6);
+    };
+
+    std::vector<std::pair<uint32_t, Entry>> contexts(m_contexts.begin(), m_contexts.end());
+    std::sort(contexts.begin(), contexts.end(), [](const auto& a, const auto& b) {
+        return a.second.elapsed > b.second.elapsed;
+    });
+    os << std::endl
+       << std::setw(12) << "context" << std::setw(12) << "events" << std::setw(12) << "wall (ms)"
+       << std::setw(10) << "share (%)" << std::setw(14) << "events/s" << std::endl;
+    for (const auto& [context, entry] : contexts)
+    {
+        if (context == Simulator::NO_CONTEXT)
+        {
+            os << std::setw(12) << "none";
+        }
+        else
+        {
+            os << std::setw(12) << context;
+        }
+        printRow(entry);
+        os << std::endl;
+    }
+
+    std::vector<const TypeEntry*> types;
+    types.reserve(m_types.size());
+    for (const auto& [type, entry] : m_types)
+    {
+        types.push_back(&entry);
+    }
+    std::sort(types.begin(), types.end(), [](const TypeEntry* a, const TypeEntry* b) {
+        return a->elapsed > b->elapsed;
+    });
+    os << std::endl
+       << std::setw(12) << "events" << std::setw(12) << "wall (ms)" << std::setw(10)
+       << "share (%)" << std::setw(14) << "events/s"
+       << "  event" << std::endl;
+    for (const auto* entry : types)
+    {
+        printRow(*entry);
+        os << "  " << entry->name << std::endl;
+    }
+}
+
+uint64_t
+ProfilingSimulatorImpl::GetProfiledEventCount() const
+{
+    return m_total.count;
+}
+
+void
+ProfilingSimulatorImpl::Finish()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_finished)
+    {
+        return;
+    }
+    m_finished = true;
+    if (m_traceFile.is_open())
+    {
+        m_traceFile << "\n]}\n";
+        m_traceFile.close();
+    }
+    if (m_reportFileName.empty())
+    {
+        Report(std::cout);
+    }
+    else
+    {
+        std::ofstream report(m_reportFileName);
+        if (!report.is_open())
+        {
+            NS_FATAL_ERROR("Cannot open profiling report file " << m_reportFileName);
+        }
+        Report(report);
+    }
+}
+
+void
+ProfilingSimulatorImpl::Destroy()
+{
+    m_simulator->Destroy();
+    Finish();
+}
+
+bool
+ProfilingSimulatorImpl::IsFinished() const
+{
+    return m_simulator->IsFinished();
+}
+
+void
+ProfilingSimulatorImpl::Stop()
+{
+    m_simulator->Stop();
+}
+
+EventId
+ProfilingSimulatorImpl::Stop(const Time& delay)
+{
+    return m_simulator->Stop(delay);
+}
+
+EventId
+ProfilingSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    return m_simulator->Schedule(delay, Wrap(event));
+}
+
+void
+ProfilingSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+{
+    m_simulator->ScheduleWithContext(context, delay, Wrap(event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return m_simulator->ScheduleNow(Wrap(event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    return m_simulator->ScheduleDestroy(event);
+}
+
+void
+ProfilingSimulatorImpl::Remove(const EventId& id)
+{
+    m_simulator->Remove(id);
+}
+
+void
+ProfilingSimulatorImpl::Cancel(const EventId& id)
+{
+    m_simulator->Cancel(id);
+}
+
+bool
+ProfilingSimulatorImpl::IsExpired(const EventId& id) const
+{
+    return m_simulator->IsExpired(id);
+}
+
+void
+ProfilingSimulatorImpl::Run()
+{
+    m_simulator->Run();
+}
+
+Time
+ProfilingSimulatorImpl::Now() const
+{
+    return m_simulator->Now();
+}
+
+Time
+ProfilingSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    return m_simulator->GetDelayLeft(id);
+}
+
+Time
+ProfilingSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return m_simulator->GetMaximumSimulationTime();
+}
+
+void
+ProfilingSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    m_simulator->SetScheduler(schedulerFactory);
+}
+
+uint32_t
+ProfilingSimulatorImpl::GetSystemId() const
+{
+    return m_simulator->GetSystemId();
+}
+
+uint32_t
+ProfilingSimulatorImpl::GetContext() const
+{
+    return m_simulator->GetContext();
+}
+
+uint64_t
+ProfilingSimulatorImpl::GetEventCount() const
+{
+    return m_simulator->GetEventCount();
+}
+
+} // namespace ns3
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PROFILING_SIMULATOR_IMPL_H
+#define PROFILING_SIMULATOR_IMPL_H
+
+#include "event-impl.h"
+#include "object-factory.h"
+#include "ptr.h"
+#include "simulator-impl.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * @file
+ * @ingroup profiling
+ * ns3::ProfilingSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @defgroup profiling Profiling Simulator
+ *
+ * Simulator implementation that attributes wall clock time to events.
+ */
+
+/**
+ * @ingroup profiling
+ *
+ * @brief A SimulatorImpl decorator that measures the wall clock cost of
+ * every event.
+ *
+ * This implementation forwards all calls to an underlying simulator
+ * implementation (by default, DefaultSimulatorImpl), but wraps each
+ * scheduled event so that the wall clock time spent executing it is
+ * recorded, together with the context (normally the node id) in which it
+ * runs and the dynamic type of the event, which identifies the function
+ * or member function bound to it (e.g.,
+ * `void (ns3::PointToPointNetDevice::*)(ns3::Ptr<ns3::Packet>)`).
+ *
+ * The measurements are aggregated by context and by event type, and
+ * reported as tables of event counts, wall clock time, time share and
+ * event rate when the simulator is destroyed.  Optionally, every event is
+ * also written as a complete ("X") event to a JSON file in the Chrome
+ * trace event format, which can be loaded in chrome://tracing or Perfetto;
+ * each context is shown as a separate thread.
+ *
+ * To use this class, run any ns-3 simulation with the command-line
+ * argument --SimulatorImplementationType=ns3::ProfilingSimulatorImpl,
+ * or set the SimulatorImplementationType global value.  When it is not
+ * selected, no profiling code is executed.
+ *
+ * Events scheduled with Simulator::ScheduleDestroy are not profiled.
+ */
+class ProfilingSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     * Get the registered TypeId for this class.
+     * @returns The TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    ProfilingSimulatorImpl();
+    /** Destructor. */
+    ~ProfilingSimulatorImpl() override;
+
+    // Inherited from SimulatorImpl
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Print the profiling tables collected so far.
+     *
+     * @param [in] os The output stream.
+     */
+    void Report(std::ostream& os) const;
+
+    /**
+     * @return the number of events executed so far through this implementation.
+     */
+    uint64_t GetProfiledEventCount() const;
+
+    /**
+     * Execute a profiled event and record its cost.
+     *
+     * @param [in] event The wrapped event.
+     * @param [in] type The dynamic type of the wrapped event.
+     */
+    void InvokeProfiled(EventImpl* event, const std::type_index& type);
+
+  protected:
+    void DoDispose() override;
+    void NotifyConstructionCompleted() override;
+
+  private:
+    /** Wall clock used for the measurements. */
+    using Clock = std::chrono::steady_clock;
+
+    /** Cost accumulated by a group of events. */
+    struct Entry
+    {
+        uint64_t count{0};          //!< Number of events executed
+        Clock::duration elapsed{0}; //!< Wall clock time spent in the events
+    };
+
+    /** Cost accumulated by a type of event. */
+    struct TypeEntry : public Entry
+    {
+        std::string name; //!< Human-readable name of the event type
+    };
+
+    /**
+     * Wrap an event so that its execution is profiled.
+     *
+     * @param [in] event The event to wrap; ownership is transferred.
+     * @return The wrapping event.
+     */
+    EventImpl* Wrap(EventImpl* event);
+
+    /**
+     * Write the closing part of the trace file and the report, if enabled.
+     */
+    void Finish();
+
+    /**
+     * Get a readable name for an event type.
+     *
+     * The event classes created by MakeEvent are local to a function
+     * template; its first parameter, which is the type of the bound
+     * function or lambda, is extracted from the demangled name.
+     *
+     * @param [in] type The dynamic type of the event.
+     * @return The name.
+     */
+    static std::string GetEventName(const std::type_index& type);
+
+    Ptr<SimulatorImpl> m_simulator;       //!< The wrapped simulator implementation
+    ObjectFactory m_simulatorImplFactory; //!< Wrapped simulator implementation factory
+    std::string m_traceFileName;          //!< Name of the Chrome trace output file
+    std::string m_reportFileName;         //!< Name of the report output file
+    bool m_finished;                      //!< True once the outputs have been written
+
+    std::unordered_map<uint32_t, Entry> m_contexts;         //!< Cost per context
+    std::unordered_map<std::type_index, TypeEntry> m_types; //!< Cost per event type
+    Entry m_total;                                          //!< Total cost
+    Clock::time_point m_start;                              //!< Wall clock origin
+    bool m_started;                                         //!< True once m_start is set
+
+    std::ofstream m_traceFile; //!< Chrome trace output file
+    bool m_firstTraceEvent;    //!< True until the first trace record is written
+};
+
+} // namespace ns3
+
+#endif /* PROFILING_SIMULATOR_IMPL_H */
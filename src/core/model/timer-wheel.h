@@ -0,0 +1,368 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "assert.h"
+#include "nstime.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup timer
+ * @brief Hierarchical timer wheel tracking the expiry time of a set of keys.
+ *
+ * Tables whose entries have a lifetime (routing tables, route caches, caches
+ * of already seen packets...) can use a TimerWheel to find their expired
+ * entries without visiting all of them. Each key is stored in the slot of the
+ * wheel covering its expiry time, and Expire() only visits the slots that the
+ * simulation time went past since its previous call. The slots of level 0
+ * span one tick, the resolution of the wheel, and each slot of level L spans
+ * all the slots of level L-1. Keys expiring in a distant future are kept in
+ * the upper levels and moved down as their expiry time approaches, so that
+ * both scheduling a key and reporting its expiry have a constant amortized
+ * cost.
+ *
+ * A key has a single expiry time, and scheduling a key that is already due
+ * to expire earlier has no effect. Extending the lifetime of an entry, which
+ * is much more frequent than shortening it, thus costs nothing; the owner of
+ * the keys is expected to check the entries of the reported keys and to
+ * schedule again the ones whose lifetime was extended in the meantime.
+ *
+ * @tparam Key the type of the keys
+ * @tparam Hash the hash function of the keys
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class TimerWheel
+{
+  public:
+    /**
+     * Constructor
+     * @param resolution the time spanned by a slot of the lowest level
+     */
+    explicit TimerWheel(Time resolution = MilliSeconds(1));
+
+    /**
+     * Schedule the expiry of a key, unless it is already due to expire earlier.
+     * @param key the key
+     * @param expiry the absolute expiry time of the key
+     */
+    void Schedule(const Key& key, Time expiry);
+
+    /**
+     * Cancel the expiry of a key, if it is scheduled.
+     * @param key the key
+     */
+    void Cancel(const Key& key);
+
+    /**
+     * @param key the key
+     * @return whether the expiry of the key is scheduled
+     */
+    bool IsScheduled(const Key& key) const;
+
+    /**
+     * @return the number of keys whose expiry is scheduled
+     */
+    std::size_t GetSize() const;
+
+    /// Cancel the expiry of all the keys
+    void Clear();
+
+    /**
+     * Remove the keys whose expiry time is strictly earlier than the given
+     * time. The keys are reported in a deterministic order, by increasing
+     * tick of their expiry time.
+     * @param now the current time
+     * @return the expired keys
+     */
+    std::vector<Key> Expire(Time now);
+
+  private:
+    /// Key stored in a slot of the wheel
+    struct Record
+    {
+        Key key;     //!< The key
+        Time expiry; //!< The expiry time of the key when it was stored
+    };
+
+    static constexpr uint32_t SLOT_BITS = 6;          //!< Log2 of the number of slots per level
+    static constexpr uint32_t SLOTS = 1 << SLOT_BITS; //!< Number of slots per level
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;  //!< Mask of the index of a slot
+    static constexpr uint32_t LEVELS = 4;             //!< Number of levels
+
+    /**
+     * @param time a time
+     * @return the tick that contains the given time
+     */
+    uint64_t GetTick(Time time) const;
+
+    /**
+     * Store a record in the slot covering its expiry time.
+     * @param record the record
+     */
+    void Insert(const Record& record);
+
+    /**
+     * @param record a record
+     * @return whether the record holds the expiry time currently scheduled for its key
+     */
+    bool IsCurrent(const Record& record) const;
+
+    /**
+     * Report the key of a record as expired, unless its expiry was rescheduled or cancelled.
+     * @param record the record
+     * @param expired the expired keys
+     */
+    void Report(const Record& record, std::vector<Key>& expired);
+
+    /// Move down the records of the upper level slots that start at the current tick
+    void Cascade();
+
+    uint64_t m_resolution;                        //!< The resolution, in time steps
+    uint64_t m_tick;                              //!< The current tick
+    std::vector<std::vector<Record>> m_slots;     //!< The slots of all the levels
+    std::array<std::size_t, LEVELS> m_records{};  //!< The number of records of each level
+    std::unordered_map<Key, Time, Hash> m_expiry; //!< The expiry time of each scheduled key
+};
+
+/*************************************************
+ **  Template implementation
+ ************************************************/
+
+template <typename Key, typename Hash>
+TimerWheel<Key, Hash>::TimerWheel(Time resolution)
+    : m_resolution(resolution.GetTimeStep()),
+      m_tick(0)
+{
+    NS_ASSERT_MSG(resolution.IsStrictlyPositive(), "The resolution must be positive");
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Schedule(const Key& key, Time expiry)
+{
+    auto [it, inserted] = m_expiry.emplace(key, expiry);
+    if (!inserted)
+    {
+        if (it->second <= expiry)
+        {
+            return;
+        }
+        it->second = expiry;
+    }
+    Insert({key, expiry});
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Cancel(const Key& key)
+{
+    // the records of the key are dropped when their slot is visited
+    m_expiry.erase(key);
+}
+
+template <typename Key, typename Hash>
+bool
+TimerWheel<Key, Hash>::IsScheduled(const Key& key) const
+{
+    return m_expiry.find(key) != m_expiry.end();
+}
+
+template <typename Key, typename Hash>
+std::size_t
+TimerWheel<Key, Hash>::GetSize() const
+{
+    return m_expiry.size();
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Clear()
+{
+    m_expiry.clear();
+    for (auto& slot : m_slots)
+    {
+        slot.clear();
+    }
+    m_records.fill(0);
+}
+
+template <typename Key, typename Hash>
+std::vector<Key>
+TimerWheel<Key, Hash>::Expire(Time now)
+{
+    std::vector<Key> expired;
+    uint64_t target = GetTick(now);
+    if (m_expiry.empty())
+    {
+        // only stale records are left
+        if (std::any_of(m_records.begin(), m_records.end(), [](auto n) { return n > 0; }))
+        {
+            Clear();
+        }
+        m_tick = std::max(m_tick, target);
+        return expired;
+    }
+
+    while (m_tick < target)
+    {
+        if (m_records[0] > 0)
+        {
+            auto& slot = m_slots[m_tick & SLOT_MASK];
+            for (const auto& record : slot)
+            {
+                Report(record, expired);
+            }
+            m_records[0] -= slot.size();
+            slot.clear();
+            ++m_tick;
+        }
+        else
+        {
+            // nothing can expire before the next slot of the lowest non-empty level
+            uint32_t level = 1;
+            while (level < LEVELS && m_records[level] == 0)
+            {
+                ++level;
+            }
+            if (level == LEVELS)
+            {
+                m_tick = target;
+                break;
+            }
+            uint64_t span = uint64_t(1) << (SLOT_BITS * level);
+            m_tick = std::min(target, (m_tick | (span - 1)) + 1);
+        }
+        if ((m_tick & SLOT_MASK) == 0)
+        {
+            Cascade();
+        }
+    }
+
+    // the records stored before the current tick, or within it, are in the current slot
+    auto& slot = m_slots[m_tick & SLOT_MASK];
+    auto kept = slot.begin();
+    for (auto it = slot.begin(); it != slot.end(); ++it)
+    {
+        if (it->expiry < now)
+        {
+            Report(*it, expired);
+        }
+        else if (IsCurrent(*it))
+        {
+            *kept++ = *it;
+        }
+    }
+    m_records[0] -= slot.end() - kept;
+    slot.erase(kept, slot.end());
+    return expired;
+}
+
+template <typename Key, typename Hash>
+uint64_t
+TimerWheel<Key, Hash>::GetTick(Time time) const
+{
+    return time.IsStrictlyPositive() ? static_cast<uint64_t>(time.GetTimeStep()) / m_resolution
+                                     : 0;
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Insert(const Record& record)
+{
+    if (m_slots.empty())
+    {
+        m_slots.resize(LEVELS * SLOTS);
+    }
+    // the keys already expired are stored in the current slot
+    uint64_t tick = std::max(GetTick(record.expiry), m_tick);
+    // the lowest level whose slots reach the tick from the current one
+    uint32_t level = 0;
+    while (level < LEVELS &&
+           (tick >> (SLOT_BITS * level)) - (m_tick >> (SLOT_BITS * level)) >= SLOTS)
+    {
+        ++level;
+    }
+    uint64_t index;
+    if (level < LEVELS)
+    {
+        index = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+    }
+    else
+    {
+        // beyond the horizon of the wheel: store it in the last slot visited at the top
+        // level, it will be stored again when this slot is visited
+        level = LEVELS - 1;
+        index = ((m_tick >> (SLOT_BITS * level)) + SLOT_MASK) & SLOT_MASK;
+    }
+    m_slots[level * SLOTS + index].push_back(record);
+    ++m_records[level];
+}
+
+template <typename Key, typename Hash>
+bool
+TimerWheel<Key, Hash>::IsCurrent(const Record& record) const
+{
+    auto it = m_expiry.find(record.key);
+    return it != m_expiry.end() && it->second == record.expiry;
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Report(const Record& record, std::vector<Key>& expired)
+{
+    auto it = m_expiry.find(record.key);
+    if (it != m_expiry.end() && it->second == record.expiry)
+    {
+        expired.push_back(record.key);
+        m_expiry.erase(it);
+    }
+}
+
+template <typename Key, typename Hash>
+void
+TimerWheel<Key, Hash>::Cascade()
+{
+    // the highest level whose current slot starts at the current tick; its records must be
+    // moved down before the ones of the levels below it
+    uint32_t top = 1;
+    while (top + 1 < LEVELS && ((m_tick >> (SLOT_BITS * top)) & SLOT_MASK) == 0)
+    {
+        ++top;
+    }
+    for (uint32_t level = top; level > 0; --level)
+    {
+        auto& slot = m_slots[level * SLOTS + ((m_tick >> (SLOT_BITS * level)) & SLOT_MASK)];
+        std::vector<Record> records;
+        records.swap(slot);
+        m_records[level] -= records.size();
+        for (const auto& record : records)
+        {
+            if (IsCurrent(record))
+            {
+                Insert(record);
+            }
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
@@ -10,9 +10,14 @@
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/profiling-simulator-impl.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <fstream>
+#include <iterator>
+
 using namespace ns3;
 
 /**
@@ -703,6 +708,89 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that ProfilingSimulatorImpl executes and accounts for events.
+ */
+class ProfilingSimulatorImplTestCase : public TestCase
+{
+  public:
+    ProfilingSimulatorImplTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Test Event.
+     * @param value Event parameter.
+     */
+    void Event(int value);
+
+    int m_sum;              //!< Sum of the executed event parameters.
+    uint32_t m_lastContext; //!< Context of the last executed event.
+};
+
+ProfilingSimulatorImplTestCase::ProfilingSimulatorImplTestCase()
+    : TestCase("Check that ProfilingSimulatorImpl executes and accounts for events"),
+      m_sum(0),
+      m_lastContext(0)
+{
+}
+
+void
+ProfilingSimulatorImplTestCase::Event(int value)
+{
+    m_sum += value;
+    m_lastContext = Simulator::GetContext();
+}
+
+void
+ProfilingSimulatorImplTestCase::DoRun()
+{
+    std::string reportFile = CreateTempDirFilename("profiling-report.txt");
+    std::string traceFile = CreateTempDirFilename("profiling-trace.json");
+    ObjectFactory factory;
+    factory.SetTypeId(ProfilingSimulatorImpl::GetTypeId());
+    factory.Set("ReportFile", StringValue(reportFile), "TraceFile", StringValue(traceFile));
+    Ptr<ProfilingSimulatorImpl> impl = factory.Create<ProfilingSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+
+    Simulator::Schedule(MicroSeconds(10), &ProfilingSimulatorImplTestCase::Event, this, 1);
+    Simulator::Schedule(MicroSeconds(20), &ProfilingSimulatorImplTestCase::Event, this, 2);
+    EventId cancelled =
+        Simulator::Schedule(MicroSeconds(30), &ProfilingSimulatorImplTestCase::Event, this, 100);
+    Simulator::ScheduleWithContext(7,
+                                   MicroSeconds(40),
+                                   &ProfilingSimulatorImplTestCase::Event,
+                                   this,
+                                   4);
+    Simulator::Cancel(cancelled);
+    NS_TEST_ASSERT_MSG_EQ(cancelled.IsExpired(), true, "Cancelled event is not expired");
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 7, "Wrong events executed");
+    NS_TEST_ASSERT_MSG_EQ(m_lastContext, 7, "Context not propagated to the profiled event");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetProfiledEventCount(), 3, "Wrong number of profiled events");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), MicroSeconds(40), "Wrong simulation time");
+
+    Simulator::Destroy();
+
+    std::ifstream report(reportFile);
+    std::string contents((std::istreambuf_iterator<char>(report)),
+                         std::istreambuf_iterator<char>());
+    NS_TEST_ASSERT_MSG_NE(contents.find("Profiled 3 events"),
+                          std::string::npos,
+                          "Report does not account for all events");
+    NS_TEST_ASSERT_MSG_NE(contents.find("ProfilingSimulatorImplTestCase::*"),
+                          std::string::npos,
+                          "Report does not name the event function");
+    std::ifstream trace(traceFile);
+    contents.assign(std::istreambuf_iterator<char>(trace), std::istreambuf_iterator<char>());
+    NS_TEST_ASSERT_MSG_EQ(contents.substr(0, 15), "{\"traceEvents\":", "Wrong trace format");
+    NS_TEST_ASSERT_MSG_NE(contents.find("]}"), std::string::npos, "Trace not terminated");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -726,6 +814,7 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new ProfilingSimulatorImplTestCase, TestCase::Duration::QUICK);
     }
 };
 
@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+#include "ns3/timer-wheel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup timer-wheel-tests
+ * TimerWheel test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup timer-wheel-tests TimerWheel tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup timer-wheel-tests
+ *
+ * @brief Check the scheduling, rescheduling and cancellation of keys.
+ */
+class TimerWheelScheduleTestCase : public TestCase
+{
+  public:
+    TimerWheelScheduleTestCase();
+    void DoRun() override;
+};
+
+TimerWheelScheduleTestCase::TimerWheelScheduleTestCase()
+    : TestCase("Check the scheduling, rescheduling and cancellation of keys")
+{
+}
+
+void
+TimerWheelScheduleTestCase::DoRun()
+{
+    TimerWheel<uint32_t> wheel(MilliSeconds(1));
+    NS_TEST_EXPECT_MSG_EQ(wheel.Expire(Seconds(1)).empty(), true, "Nothing is scheduled");
+
+    wheel.Schedule(1, Seconds(2));
+    wheel.Schedule(2, MilliSeconds(2500));
+    wheel.Schedule(3, Seconds(10));
+    wheel.Schedule(4, Seconds(3));
+    NS_TEST_ASSERT_MSG_EQ(wheel.GetSize(), 4, "Four keys are scheduled");
+
+    // key 3 is due to expire earlier, key 4 is not postponed
+    wheel.Schedule(3, Seconds(2));
+    wheel.Schedule(4, Seconds(20));
+    wheel.Cancel(2);
+    NS_TEST_EXPECT_MSG_EQ(wheel.IsScheduled(2), false, "Key 2 was cancelled");
+    NS_TEST_EXPECT_MSG_EQ(wheel.GetSize(), 3, "Three keys are scheduled");
+
+    // the expiry time must be strictly earlier than the given time
+    NS_TEST_EXPECT_MSG_EQ(wheel.Expire(Seconds(2)).empty(), true, "Nothing has expired yet");
+    auto expired = wheel.Expire(Seconds(2) + NanoSeconds(1));
+    std::sort(expired.begin(), expired.end());
+    NS_TEST_EXPECT_MSG_EQ((expired == std::vector<uint32_t>{1, 3}), true, "Wrong expired keys");
+    NS_TEST_EXPECT_MSG_EQ(wheel.IsScheduled(1), false, "Key 1 has been reported");
+
+    NS_TEST_EXPECT_MSG_EQ(wheel.Expire(Seconds(2.9)).empty(), true, "Key 2 was cancelled");
+    expired = wheel.Expire(Seconds(4));
+    NS_TEST_EXPECT_MSG_EQ((expired == std::vector<uint32_t>{4}), true, "Key 4 should expire");
+
+    // a key scheduled in the past is reported at the next call
+    wheel.Schedule(5, Seconds(1));
+    expired = wheel.Expire(Seconds(4));
+    NS_TEST_EXPECT_MSG_EQ((expired == std::vector<uint32_t>{5}), true, "Key 5 should expire");
+
+    wheel.Schedule(6, Seconds(5));
+    wheel.Clear();
+    NS_TEST_EXPECT_MSG_EQ(wheel.GetSize(), 0, "The wheel should be empty after Clear()");
+    NS_TEST_EXPECT_MSG_EQ(wheel.Expire(Seconds(6)).empty(), true, "Key 6 was cleared");
+}
+
+/**
+ * @ingroup timer-wheel-tests
+ *
+ * @brief Check the expired keys against a brute force search, with expiry times spanning
+ * all the levels of the wheel and beyond.
+ */
+class TimerWheelRandomTestCase : public TestCase
+{
+  public:
+    TimerWheelRandomTestCase();
+    void DoRun() override;
+};
+
+TimerWheelRandomTestCase::TimerWheelRandomTestCase()
+    : TestCase("Check the expired keys against a brute force search")
+{
+}
+
+void
+TimerWheelRandomTestCase::DoRun()
+{
+    // a coarse resolution keeps several keys per slot, a fine one exercises all the levels
+    for (auto resolution : {MicroSeconds(1), MilliSeconds(1), Seconds(1)})
+    {
+        TimerWheel<uint32_t> wheel(resolution);
+        std::map<uint32_t, Time> reference;
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<uint32_t> key(0, 199);
+        // lifetimes from 1 us to about 3 hours, uniformly distributed on a log scale
+        std::uniform_real_distribution<double> lifetime(0, 10);
+        std::uniform_int_distribution<int64_t> step(0, 2000000);
+
+        Time now;
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            uint32_t k = key(rng);
+            if (i % 7 == 0)
+            {
+                wheel.Cancel(k);
+                reference.erase(k);
+            }
+            else
+            {
+                Time expiry = now + MicroSeconds(std::pow(10, lifetime(rng)));
+                wheel.Schedule(k, expiry);
+                auto [it, inserted] = reference.emplace(k, expiry);
+                if (!inserted)
+                {
+                    it->second = std::min(it->second, expiry);
+                }
+            }
+
+            now += MicroSeconds(step(rng));
+            std::vector<uint32_t> expected;
+            for (auto it = reference.begin(); it != reference.end();)
+            {
+                if (it->second < now)
+                {
+                    expected.push_back(it->first);
+                    it = reference.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            auto expired = wheel.Expire(now);
+            std::sort(expired.begin(), expired.end());
+            NS_TEST_ASSERT_MSG_EQ((expired == expected),
+                                  true,
+                                  "Wrong expired keys at " << now.As(Time::S) << " with resolution "
+                                                           << resolution.As(Time::US));
+            NS_TEST_ASSERT_MSG_EQ(wheel.GetSize(), reference.size(), "Wrong number of keys");
+        }
+    }
+}
+
+/**
+ * @ingroup timer-wheel-tests
+ *
+ * @brief TimerWheel test suite
+ */
+class TimerWheelTestSuite : public TestSuite
+{
+  public:
+    TimerWheelTestSuite();
+};
+
+TimerWheelTestSuite::TimerWheelTestSuite()
+    : TestSuite("timer-wheel", Type::UNIT)
+{
+    AddTestCase(new TimerWheelScheduleTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new TimerWheelRandomTestCase(), TestCase::Duration::QUICK);
+}
+
+static TimerWheelTestSuite g_timerWheelTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This example measures the delivery of the frames of a CsmaChannel on
+// LANs of increasing numbers of hosts.  A number of hosts send UDP
+// datagrams to their neighbour and one host sends UDP broadcast datagrams.
+// For each LAN, it reports the number of events and the wall clock time
+// needed to simulate the traffic, with the default channel and with the
+// UnicastFilter and ShareGroupFrames attributes of the channel enabled.
+// The numbers of datagrams received are checked to be identical.
+// Sample usage:  ./ns3 run 'csma-lan-scaling --counts=10,100,500 --flows=10'
+
+#include "ns3/abort.h"
+#include "ns3/application-container.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/csma-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// Number of datagrams received by the sinks
+static uint64_t g_received = 0;
+
+/**
+ * Count a datagram received by a sink.
+ * @param packet the datagram
+ * @param from the address of the sender
+ */
+static void
+SinkRx(Ptr<const Packet> packet, const Address& from)
+{
+    g_received++;
+}
+
+/**
+ * Simulate the traffic of a LAN.
+ * @param nHosts the number of hosts
+ * @param nFlows the number of unicast flows
+ * @param duration the duration of the traffic
+ * @param optimize the value of the UnicastFilter and ShareGroupFrames
+ *        attributes of the channel
+ */
+static void
+Run(uint32_t nHosts, uint32_t nFlows, Time duration, bool optimize)
+{
+    NodeContainer hosts;
+    hosts.Create(nHosts);
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    csma.SetChannelAttribute("Delay", TimeValue(MicroSeconds(1)));
+    csma.SetChannelAttribute("UnicastFilter", BooleanValue(optimize));
+    csma.SetChannelAttribute("ShareGroupFrames", BooleanValue(optimize));
+    NetDeviceContainer devices = csma.Install(hosts);
+    csma.AssignStreams(devices, 0);
+
+    InternetStackHelper internet;
+    internet.Install(hosts);
+    internet.AssignStreams(hosts, 100000);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.0.0.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 9;
+    ApplicationContainer apps;
+    for (uint32_t i = 0; i <= nFlows; i++)
+    {
+        uint32_t sender = i * nHosts / (nFlows + 1);
+        Ipv4Address destination = (i == nFlows) ? Ipv4Address("255.255.255.255")
+                                                : interfaces.GetAddress((sender + 1) % nHosts);
+        OnOffHelper onoff("ns3::UdpSocketFactory", InetSocketAddress(destination, port));
+        onoff.SetConstantRate(DataRate((i == nFlows) ? "100kbps" : "2Mbps"), 512);
+        apps.Add(onoff.Install(hosts.Get(sender)));
+    }
+    PacketSinkHelper sink("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    apps.Add(sink.Install(hosts));
+    apps.Start(Seconds(1));
+    apps.Stop(Seconds(1) + duration);
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::PacketSink/Rx",
+                                  MakeCallback(&SinkRx));
+
+    g_received = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(Seconds(1) + duration + Seconds(1));
+    Simulator::Run();
+    int64_t ms = timer.End();
+    uint64_t nEvents = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    std::cout << std::setw(8) << nHosts << std::setw(10) << (optimize ? "on" : "off")
+              << std::setw(12) << g_received << std::setw(14) << nEvents << std::setw(10) << ms
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string counts = "10,100,500";
+    uint32_t nFlows = 10;
+    Time duration = Seconds(1);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Measure the delivery of the frames of a CsmaChannel on LANs.");
+    cmd.AddValue("counts", "comma-separated numbers of hosts", counts);
+    cmd.AddValue("flows", "number of unicast flows", nFlows);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(8) << "hosts" << std::setw(10) << "filter" << std::setw(12)
+              << "received" << std::setw(14) << "events" << std::setw(10) << "ms" << std::endl;
+    std::istringstream list(counts);
+    std::string count;
+    while (std::getline(list, count, ','))
+    {
+        uint32_t nHosts = std::stoul(count);
+        NS_ABORT_MSG_IF(nHosts < 2, "There must be at least two hosts");
+        Run(nHosts, nFlows, duration, false);
+        uint64_t received = g_received;
+        Run(nHosts, nFlows, duration, true);
+        NS_ABORT_MSG_IF(g_received != received, "Different numbers of datagrams received");
+    }
+    return 0;
+}
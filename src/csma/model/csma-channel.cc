@@ -10,6 +10,8 @@
 
 #include "csma-net-device.h"
 
+#include "ns3/boolean.h"
+#include "ns3/ethernet-header.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -39,12 +41,29 @@ CsmaChannel::GetTypeId()
                           "Transmission delay through the channel",
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&CsmaChannel::m_delay),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("UnicastFilter",
+                          "If true, a unicast frame is not delivered to the devices on which "
+                          "it has no effect, that is, the devices with another address that "
+                          "do not observe the frames sent to other devices "
+                          "(see CsmaNetDevice::IsReceiveNeeded).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CsmaChannel::m_unicastFilter),
+                          MakeBooleanChecker())
+            .AddAttribute("ShareGroupFrames",
+                          "If true, the headers and the trailer of a broadcast or multicast "
+                          "frame are removed once by the channel for all the receiving "
+                          "devices, instead of once per device.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CsmaChannel::m_shareGroupFrames),
+                          MakeBooleanChecker());
     return tid;
 }
 
 CsmaChannel::CsmaChannel()
-    : Channel()
+    : Channel(),
+      m_unicastFilter(false),
+      m_shareGroupFrames(false)
 {
     NS_LOG_FUNCTION_NOARGS();
     m_state = IDLE;
@@ -214,17 +233,49 @@ CsmaChannel::TransmitEnd()
 
     NS_LOG_LOGIC("Receive");
 
+    Ptr<CsmaNetDevice> sender = m_deviceList[m_currentSrc].devicePtr;
+    Mac48Address destination;
+    Ptr<const CsmaDecodedFrame> frame;
+    if (m_unicastFilter || m_shareGroupFrames)
+    {
+        EthernetHeader header(false);
+        m_currentPkt->PeekHeader(header);
+        destination = header.GetDestination();
+        if (m_shareGroupFrames && destination.IsGroup())
+        {
+            frame = CsmaNetDevice::DecodeFrame(m_currentPkt);
+        }
+    }
+
     for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
     {
-        if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+        if (it->IsActive() && it->devicePtr != sender)
         {
+            if (m_unicastFilter && !it->devicePtr->IsReceiveNeeded(destination))
+            {
+                NS_LOG_LOGIC("Frame not delivered to " << it->devicePtr);
+                continue;
+            }
             // schedule reception events
-            Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
-                                           m_delay,
-                                           &CsmaNetDevice::Receive,
-                                           it->devicePtr,
-                                           m_currentPkt,
-                                           m_deviceList[m_currentSrc].devicePtr);
+            if (frame)
+            {
+                Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
+                                               m_delay,
+                                               &CsmaNetDevice::ReceiveDecoded,
+                                               it->devicePtr,
+                                               m_currentPkt,
+                                               sender,
+                                               frame);
+            }
+            else
+            {
+                Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
+                                               m_delay,
+                                               &CsmaNetDevice::Receive,
+                                               it->devicePtr,
+                                               m_currentPkt,
+                                               sender);
+            }
         }
     }
 
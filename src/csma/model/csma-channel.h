@@ -76,6 +76,15 @@ enum WireState
  * flag to indicate if the channel is currently in use. It does not
  * take into account the distances between stations or the speed of
  * light to determine collisions.
+ *
+ * Each frame is delivered to every other active device by a separate
+ * reception event, in the context of the node of the device.  On channels
+ * with many devices, the UnicastFilter attribute skips the reception
+ * events of the unicast frames on the devices where they have no effect,
+ * and the ShareGroupFrames attribute removes the headers of a broadcast
+ * or multicast frame once for all the receiving devices.  Neither changes
+ * the results of a simulation, as long as the callbacks and trace sources
+ * of the devices are set before the frames are sent.
  */
 class CsmaChannel : public Channel
 {
@@ -327,6 +336,18 @@ class CsmaChannel : public Channel
      * Current state of the channel
      */
     WireState m_state;
+
+    /**
+     * Whether the unicast frames are only delivered to the devices on
+     * which they have an effect
+     */
+    bool m_unicastFilter;
+
+    /**
+     * Whether the broadcast and multicast frames are decoded once for all
+     * the receiving devices
+     */
+    bool m_shareGroupFrames;
 };
 
 } // namespace ns3
@@ -687,46 +687,35 @@ void
 CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice)
 {
     NS_LOG_FUNCTION(packet << senderDevice);
-    NS_LOG_LOGIC("UID is " << packet->GetUid());
-
-    //
-    // We never forward up packets that we sent.  Real devices don't do this since
-    // their receivers are disabled during send, so we don't.
-    //
-    if (senderDevice == this)
-    {
-        return;
-    }
-
-    //
-    // Hit the trace hook.  This trace will fire on all packets received from the
-    // channel except those originated by this device.
-    //
-    m_phyRxEndTrace(packet);
-
-    //
-    // Only receive if the send side of net device is enabled
-    //
-    if (!IsReceiveEnabled())
-    {
-        m_phyRxDropTrace(packet);
-        return;
-    }
+    DoReceive(packet, senderDevice, nullptr);
+}
 
-    Ptr<Packet> pktCopy = packet->Copy();
+void
+CsmaNetDevice::ReceiveDecoded(Ptr<const Packet> packet,
+                              Ptr<CsmaNetDevice> senderDevice,
+                              Ptr<const CsmaDecodedFrame> frame)
+{
+    NS_LOG_FUNCTION(packet << senderDevice << frame);
+    DoReceive(packet, senderDevice, frame);
+}
 
-    if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(pktCopy))
+Ptr<const CsmaDecodedFrame>
+CsmaNetDevice::DecodeFrame(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(packet);
+    Ptr<CsmaDecodedFrame> frame = Create<CsmaDecodedFrame>();
+    Ptr<Packet> payload = packet->Copy();
+    RemoveFrameHeaders(payload, *frame);
+    if (frame->crcGood)
     {
-        NS_LOG_LOGIC("Dropping pkt due to error model ");
-        m_phyRxDropTrace(packet);
-        return;
+        frame->payload = payload;
     }
+    return frame;
+}
 
-    //
-    // Trace sinks will expect complete packets, not packets without some of the
-    // headers.
-    //
-
+void
+CsmaNetDevice::RemoveFrameHeaders(Ptr<Packet> pktCopy, CsmaDecodedFrame& frame)
+{
     EthernetTrailer trailer;
     pktCopy->RemoveTrailer(trailer);
     if (Node::ChecksumEnabled())
@@ -734,21 +723,20 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
         trailer.EnableFcs(true);
     }
 
-    bool crcGood = trailer.CheckFcs(pktCopy);
-    if (!crcGood)
+    frame.crcGood = trailer.CheckFcs(pktCopy);
+    if (!frame.crcGood)
     {
-        NS_LOG_INFO("CRC error on Packet " << packet);
-        m_phyRxDropTrace(packet);
         return;
     }
 
     EthernetHeader header(false);
     pktCopy->RemoveHeader(header);
+    frame.source = header.GetSource();
+    frame.destination = header.GetDestination();
 
     NS_LOG_LOGIC("Pkt source is " << header.GetSource());
     NS_LOG_LOGIC("Pkt destination is " << header.GetDestination());
 
-    uint16_t protocol;
     //
     // If the length/type is less than 1500, it corresponds to a length
     // interpretation packet.  In this case, it is an 802.3 packet and
@@ -767,11 +755,89 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
 
         LlcSnapHeader llc;
         pktCopy->RemoveHeader(llc);
-        protocol = llc.GetType();
+        frame.protocol = llc.GetType();
     }
     else
     {
-        protocol = header.GetLengthType();
+        frame.protocol = header.GetLengthType();
+    }
+}
+
+bool
+CsmaNetDevice::IsReceiveNeeded(Mac48Address destination) const
+{
+    return destination.IsGroup() || destination == m_address || !m_promiscRxCallback.IsNull() ||
+           m_receiveErrorModel || !m_phyRxEndTrace.IsEmpty() || !m_phyRxDropTrace.IsEmpty() ||
+           !m_promiscSnifferTrace.IsEmpty();
+}
+
+void
+CsmaNetDevice::DoReceive(Ptr<const Packet> packet,
+                         Ptr<CsmaNetDevice> senderDevice,
+                         Ptr<const CsmaDecodedFrame> frame)
+{
+    NS_LOG_LOGIC("UID is " << packet->GetUid());
+
+    //
+    // We never forward up packets that we sent.  Real devices don't do this since
+    // their receivers are disabled during send, so we don't.
+    //
+    if (senderDevice == this)
+    {
+        return;
+    }
+
+    //
+    // Hit the trace hook.  This trace will fire on all packets received from the
+    // channel except those originated by this device.
+    //
+    m_phyRxEndTrace(packet);
+
+    //
+    // Only receive if the send side of net device is enabled
+    //
+    if (!IsReceiveEnabled())
+    {
+        m_phyRxDropTrace(packet);
+        return;
+    }
+
+    Ptr<Packet> pktCopy;
+    CsmaDecodedFrame decoded;
+    if (!frame || m_receiveErrorModel)
+    {
+        pktCopy = packet->Copy();
+
+        if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(pktCopy))
+        {
+            NS_LOG_LOGIC("Dropping pkt due to error model ");
+            m_phyRxDropTrace(packet);
+            return;
+        }
+
+        //
+        // Trace sinks will expect complete packets, not packets without some of the
+        // headers.
+        //
+        RemoveFrameHeaders(pktCopy, decoded);
+    }
+    else
+    {
+        decoded.source = frame->source;
+        decoded.destination = frame->destination;
+        decoded.protocol = frame->protocol;
+        decoded.crcGood = frame->crcGood;
+        if (frame->crcGood)
+        {
+            pktCopy = frame->payload->Copy();
+        }
+    }
+
+    if (!decoded.crcGood)
+    {
+        NS_LOG_INFO("CRC error on Packet " << packet);
+        m_phyRxDropTrace(packet);
+        return;
     }
 
     //
@@ -779,15 +845,15 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     //
     PacketType packetType;
 
-    if (header.GetDestination().IsBroadcast())
+    if (decoded.destination.IsBroadcast())
     {
         packetType = PACKET_BROADCAST;
     }
-    else if (header.GetDestination().IsGroup())
+    else if (decoded.destination.IsGroup())
     {
         packetType = PACKET_MULTICAST;
     }
-    else if (header.GetDestination() == m_address)
+    else if (decoded.destination == m_address)
     {
         packetType = PACKET_HOST;
     }
@@ -807,9 +873,9 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
         m_macPromiscRxTrace(packet);
         m_promiscRxCallback(this,
                             pktCopy,
-                            protocol,
-                            header.GetSource(),
-                            header.GetDestination(),
+                            decoded.protocol,
+                            decoded.source,
+                            decoded.destination,
                             packetType);
     }
 
@@ -822,7 +888,7 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     {
         m_snifferTrace(packet);
         m_macRxTrace(packet);
-        m_rxCallback(this, pktCopy, protocol, header.GetSource());
+        m_rxCallback(this, pktCopy, decoded.protocol, decoded.source);
     }
 }
 
@@ -21,6 +21,7 @@
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include "ns3/queue-fwd.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/traced-callback.h"
 
 #include <cstring>
@@ -38,6 +39,25 @@ class ErrorModel;
  * please refer to the ns-3 manual.
  */
 
+/**
+ * @ingroup csma
+ * @brief A frame decoded once for all the devices receiving it
+ *
+ * Holds the payload of a frame sent on a CsmaChannel, without its Ethernet
+ * header and trailer, its padding and its LLC/SNAP header, and the fields
+ * of these headers that the receiving devices need.
+ *
+ * @see CsmaNetDevice::DecodeFrame
+ */
+struct CsmaDecodedFrame : public SimpleRefCount<CsmaDecodedFrame>
+{
+    Ptr<const Packet> payload; //!< Payload of the frame, if the FCS is correct
+    Mac48Address source;       //!< Source address of the frame
+    Mac48Address destination;  //!< Destination address of the frame
+    uint16_t protocol{0};      //!< Protocol number of the payload
+    bool crcGood{false};       //!< Whether the FCS of the frame is correct
+};
+
 /**
  * @ingroup csma
  * @class CsmaNetDevice
@@ -163,6 +183,43 @@ class CsmaNetDevice : public NetDevice
      */
     void Receive(Ptr<const Packet> p, Ptr<CsmaNetDevice> sender);
 
+    /**
+     * Receive a packet from a connected CsmaChannel, which has already
+     * decoded it with DecodeFrame.
+     *
+     * This is equivalent to Receive, except that the headers and the
+     * trailer of a frame received by several devices are removed only
+     * once.  A device with a receive ErrorModel decodes the packet itself.
+     *
+     * @param p a reference to the received packet
+     * @param sender the CsmaNetDevice that transmitted the packet in the first place
+     * @param frame the packet decoded by DecodeFrame
+     */
+    void ReceiveDecoded(Ptr<const Packet> p,
+                        Ptr<CsmaNetDevice> sender,
+                        Ptr<const CsmaDecodedFrame> frame);
+
+    /**
+     * Remove the headers and the trailer of a packet sent on a CsmaChannel,
+     * as a receiving device does, and check its FCS.
+     *
+     * @param p the packet sent on the channel
+     * @return the decoded frame
+     */
+    static Ptr<const CsmaDecodedFrame> DecodeFrame(Ptr<const Packet> p);
+
+    /**
+     * Check whether a frame sent on the channel to a destination address
+     * has any effect on this device.  A unicast frame sent to another
+     * device has none unless a promiscuous receive callback or a receive
+     * ErrorModel is set, or the PhyRxEnd, PhyRxDrop or PromiscSniffer
+     * trace sources are connected.
+     *
+     * @param destination the destination address of the frame
+     * @return false if the frame does not need to be received by this device
+     */
+    bool IsReceiveNeeded(Mac48Address destination) const;
+
     /**
      * Is the send side of the network device enabled?
      *
@@ -374,6 +431,29 @@ class CsmaNetDevice : public NetDevice
      */
     void Init(bool sendEnable, bool receiveEnable);
 
+    /**
+     * Receive a packet from a connected CsmaChannel.
+     *
+     * @param p a reference to the received packet
+     * @param sender the CsmaNetDevice that transmitted the packet in the first place
+     * @param frame the packet decoded by DecodeFrame, or null if the
+     *        device has to decode it
+     */
+    void DoReceive(Ptr<const Packet> p,
+                   Ptr<CsmaNetDevice> sender,
+                   Ptr<const CsmaDecodedFrame> frame);
+
+    /**
+     * Remove the Ethernet header and trailer, the padding and the LLC/SNAP
+     * header of a received packet.
+     *
+     * @param p the packet, whose headers and trailer are removed if its
+     *        FCS is correct
+     * @param [out] frame the source and destination addresses, the protocol
+     *        number and the result of the FCS check
+     */
+    static void RemoveFrameHeaders(Ptr<Packet> p, CsmaDecodedFrame& frame);
+
     /**
      * Start Sending a Packet Down the Wire.
      *
@@ -22,6 +22,7 @@
 #include "ns3/simulator.h"
 
 #include <iomanip>
+#include <set>
 
 namespace ns3
 {
@@ -101,6 +102,7 @@ RoutingTable::LookupRoute(Ipv4Address id, RoutingTableEntry& rt, bool forRouteIn
 bool
 RoutingTable::DeleteRoute(Ipv4Address dst)
 {
+    m_expiry.Cancel(dst);
     return m_ipv4AddressEntry.erase(dst) != 0;
 }
 
@@ -114,6 +116,10 @@ bool
 RoutingTable::AddRoute(RoutingTableEntry& rt)
 {
     auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    if (result.second)
+    {
+        ScheduleExpiry(rt);
+    }
     return result.second;
 }
 
@@ -126,6 +132,7 @@ RoutingTable::Update(RoutingTableEntry& rt)
         return false;
     }
     i->second = rt;
+    ScheduleExpiry(rt);
     return true;
 }
 
@@ -142,6 +149,7 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
         {
             auto tmp = i;
             ++i;
+            m_expiry.Cancel(tmp->first);
             m_ipv4AddressEntry.erase(tmp);
         }
         else
@@ -216,43 +224,59 @@ RoutingTable::Purge(std::map<Ipv4Address, RoutingTableEntry>& removedAddresses)
     {
         return;
     }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+    // the entries not updated for longer than the hold down time, in the order of the table
+    std::set<Ipv4Address> expired;
+    for (const auto& dst : m_expiry.Expire(Simulator::Now() - m_holddownTime))
     {
-        auto itmp = i;
+        auto i = m_ipv4AddressEntry.find(dst);
+        NS_ASSERT(i != m_ipv4AddressEntry.end());
         if (i->second.GetLifeTime() > m_holddownTime && (i->second.GetHop() > 0))
         {
-            for (auto j = m_ipv4AddressEntry.begin(); j != m_ipv4AddressEntry.end();)
+            expired.insert(dst);
+        }
+        else if (i->second.GetHop() > 0)
+        {
+            // the entry was updated since its expiry was scheduled
+            ScheduleExpiry(i->second);
+        }
+    }
+    for (const auto& dst : expired)
+    {
+        auto i = m_ipv4AddressEntry.find(dst);
+        if (i == m_ipv4AddressEntry.end())
+        {
+            // removed along with a previous expired entry
+            continue;
+        }
+        for (auto j = m_ipv4AddressEntry.begin(); j != m_ipv4AddressEntry.end();)
+        {
+            if ((j->second.GetNextHop() == i->second.GetDestination()) &&
+                (i->second.GetHop() != j->second.GetHop()))
             {
-                if ((j->second.GetNextHop() == i->second.GetDestination()) &&
-                    (i->second.GetHop() != j->second.GetHop()))
-                {
-                    auto jtmp = j;
-                    removedAddresses.insert(std::make_pair(j->first, j->second));
-                    ++j;
-                    m_ipv4AddressEntry.erase(jtmp);
-                }
-                else
-                {
-                    ++j;
-                }
+                auto jtmp = j;
+                removedAddresses.insert(std::make_pair(j->first, j->second));
+                ++j;
+                m_expiry.Cancel(jtmp->first);
+                m_ipv4AddressEntry.erase(jtmp);
+            }
+            else
+            {
+                ++j;
             }
-            removedAddresses.insert(std::make_pair(i->first, i->second));
-            ++i;
-            m_ipv4AddressEntry.erase(itmp);
         }
+        removedAddresses.insert(std::make_pair(i->first, i->second));
+        m_ipv4AddressEntry.erase(i);
         /** @todo Need to decide when to invalidate a route */
-        /*          else if (i->second.GetLifeTime() > m_holddownTime)
-         {
-         ++i;
-         itmp->second.SetFlag(INVALID);
-         }*/
-        else
-        {
-            ++i;
-        }
     }
 }
 
+void
+RoutingTable::ScheduleExpiry(const RoutingTableEntry& rt)
+{
+    // the lifetime of an entry is the time elapsed since its last update
+    m_expiry.Schedule(rt.GetDestination(), Simulator::Now() - rt.GetLifeTime());
+}
+
 void
 RoutingTable::Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit /*= Time::S*/) const
 {
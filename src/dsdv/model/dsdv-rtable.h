@@ -24,6 +24,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/net-device.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/timer.h"
 
 #include <cassert>
@@ -374,6 +375,7 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_expiry.Clear();
     }
 
     /**
@@ -453,6 +455,15 @@ class RoutingTable
     std::map<Ipv4Address, EventId> m_ipv4Events;
     /// hold down time of an expired route
     Time m_holddownTime;
+    /// Time of the last update of the entries, so that Purge() only visits the expired ones
+    TimerWheel<Ipv4Address, Ipv4AddressHash> m_expiry;
+
+    /**
+     * Schedule the expiry of an entry, which must be called whenever an entry of the table
+     * is added or modified.
+     * @param rt the routing table entry
+     */
+    void ScheduleExpiry(const RoutingTableEntry& rt);
 };
 } // namespace dsdv
 } // namespace ns3
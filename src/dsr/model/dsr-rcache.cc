@@ -160,6 +160,7 @@ DsrRouteCache::~DsrRouteCache()
     NS_LOG_FUNCTION_NOARGS();
     // clear the route cache when done
     m_sortedRoutes.clear();
+    m_expiry.Clear();
 }
 
 void
@@ -193,6 +194,7 @@ DsrRouteCache::UpdateRouteEntry(Ipv4Address dst)
          * Save the new route cache along with the destination address in map
          */
         auto result = m_sortedRoutes.insert(std::make_pair(dst, rtVector));
+        ScheduleExpiry(dst);
         return result.second;
     }
     return false;
@@ -256,6 +258,7 @@ DsrRouteCache::LookupRoute(Ipv4Address id, DsrRouteCacheEntry& rt)
                     newVector.sort(CompareRoutesExpire); // sort the route vector first
                     m_sortedRoutes[id] =
                         newVector; // Only get the first sub route and add it in route cache
+                    ScheduleExpiry(id);
                     NS_LOG_INFO("We have a sub-route to " << id << " add it in route cache");
                 }
             }
@@ -662,6 +665,7 @@ DsrRouteCache::AddRoute(DsrRouteCacheEntry& rt)
          * Save the new route cache along with the destination address in map
          */
         auto result = m_sortedRoutes.insert(std::make_pair(dst, rtVector));
+        ScheduleExpiry(dst);
         return result.second;
     }
 
@@ -703,6 +707,7 @@ DsrRouteCache::AddRoute(DsrRouteCacheEntry& rt)
              * Save the new route cache along with the destination address in map
              */
             auto result = m_sortedRoutes.insert(std::make_pair(dst, rtVector));
+            ScheduleExpiry(dst);
             return result.second;
         }
         else
@@ -741,6 +746,7 @@ DsrRouteCache::FindSameRoute(DsrRouteCacheEntry& rt, std::list<DsrRouteCacheEntr
              * Save the new route cache along with the destination address in map
              */
             auto result = m_sortedRoutes.insert(std::make_pair(rt.GetDestination(), rtVector));
+            ScheduleExpiry(rt.GetDestination());
             return result.second;
         }
     }
@@ -754,6 +760,7 @@ DsrRouteCache::DeleteRoute(Ipv4Address dst)
     Purge(); // purge the route cache first to remove timeout entries
     if (m_sortedRoutes.erase(dst) != 0)
     {
+        m_expiry.Cancel(dst);
         NS_LOG_LOGIC("Route deletion to " << dst << " successful");
         return true;
     }
@@ -903,6 +910,7 @@ DsrRouteCache::DeleteAllRoutesIncludeLink(Ipv4Address errorSrc,
             if (!IsLinkCache())
             {
                 m_sortedRoutes.erase(jtmp);
+                m_expiry.Cancel(address);
             }
             if (!rtVector.empty())
             {
@@ -911,6 +919,7 @@ DsrRouteCache::DeleteAllRoutesIncludeLink(Ipv4Address errorSrc,
                  */
                 rtVector.sort(CompareRoutesExpire);
                 m_sortedRoutes[address] = rtVector;
+                ScheduleExpiry(address);
             }
             else
             {
@@ -963,61 +972,72 @@ DsrRouteCache::Purge()
         NS_LOG_DEBUG("The route cache is empty");
         return;
     }
-    for (auto i = m_sortedRoutes.begin(); i != m_sortedRoutes.end();)
+    /*
+     * Only visit the destinations whose earliest route has an expire time that is not in the
+     * future
+     */
+    for (const auto& dst : m_expiry.Expire(Simulator::Now() + TimeStep(1)))
     {
-        // Loop of route cache entry with the route size
-        auto itmp = i;
+        auto i = m_sortedRoutes.find(dst);
+        NS_ASSERT(i != m_sortedRoutes.end());
         /*
          * The route cache entry vector
          */
-        Ipv4Address dst = i->first;
-        std::list<DsrRouteCacheEntry> rtVector = i->second;
+        std::list<DsrRouteCacheEntry>& rtVector = i->second;
         NS_LOG_DEBUG("The route vector size of 1 " << dst << " " << rtVector.size());
-        if (!rtVector.empty())
+        for (auto j = rtVector.begin(); j != rtVector.end();)
         {
-            for (auto j = rtVector.begin(); j != rtVector.end();)
+            NS_LOG_DEBUG("The expire time of every entry with expire time "
+                         << j->GetExpireTime());
+            /*
+             * First verify if the route has expired or not
+             */
+            if (j->GetExpireTime().IsNegative())
             {
-                NS_LOG_DEBUG("The expire time of every entry with expire time "
-                             << j->GetExpireTime());
                 /*
-                 * First verify if the route has expired or not
+                 * When the expire time has passed, erase the certain route
                  */
-                if (j->GetExpireTime().IsNegative())
-                {
-                    /*
-                     * When the expire time has passed, erase the certain route
-                     */
-                    NS_LOG_DEBUG("Erase the expired route for " << dst << " with expire time "
-                                                                << j->GetExpireTime());
-                    j = rtVector.erase(j);
-                }
-                else
-                {
-                    ++j;
-                }
-            }
-            NS_LOG_DEBUG("The route vector size of 2 " << dst << " " << rtVector.size());
-            if (!rtVector.empty())
-            {
-                ++i;
-                m_sortedRoutes.erase(itmp); // erase the entry first
-                /*
-                 * Save the new route cache along with the destination address in map
-                 */
-                m_sortedRoutes.insert(std::make_pair(dst, rtVector));
+                NS_LOG_DEBUG("Erase the expired route for " << dst << " with expire time "
+                                                            << j->GetExpireTime());
+                j = rtVector.erase(j);
             }
             else
             {
-                ++i;
-                m_sortedRoutes.erase(itmp);
+                ++j;
             }
         }
+        NS_LOG_DEBUG("The route vector size of 2 " << dst << " " << rtVector.size());
+        if (!rtVector.empty())
+        {
+            ScheduleExpiry(dst);
+        }
         else
         {
-            ++i;
-            m_sortedRoutes.erase(itmp);
+            m_sortedRoutes.erase(i);
+        }
+    }
+}
+
+void
+DsrRouteCache::ScheduleExpiry(Ipv4Address dst)
+{
+    auto i = m_sortedRoutes.find(dst);
+    if (i == m_sortedRoutes.end())
+    {
+        return;
+    }
+    // a destination without any route is removed at the next purge
+    Time expiry = Simulator::Now();
+    if (!i->second.empty())
+    {
+        Time earliest = i->second.front().GetExpireTime();
+        for (const auto& route : i->second)
+        {
+            earliest = std::min(earliest, route.GetExpireTime());
         }
+        expiry += earliest;
     }
+    m_expiry.Schedule(dst, expiry);
 }
 
 void
@@ -36,6 +36,7 @@
 #include "ns3/nstime.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/simulator.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/timer.h"
 
 #include <cassert>
@@ -771,6 +772,17 @@ class DsrRouteCache : public Object
     std::map<Ipv4Address, routeEntryVector>
         m_sortedRoutes; ///< Map the ipv4Address to route entry vector
 
+    /// Expiry of the earliest route to each destination, so that Purge() only visits the
+    /// destinations having an expired route
+    TimerWheel<Ipv4Address, Ipv4AddressHash> m_expiry;
+
+    /**
+     * Schedule the expiry of the earliest route to a destination, which must be called
+     * whenever the routes to a destination are added or modified.
+     * @param dst the destination
+     */
+    void ScheduleExpiry(Ipv4Address dst);
+
     routeEntryVector m_routeEntryVector; ///< Define the route vector
 
     uint32_t m_maxEntriesEachDst; ///< number of entries for each destination
@@ -14,6 +14,8 @@
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <limits>
+
 namespace ns3
 {
 namespace energy
@@ -166,7 +168,12 @@ BasicEnergySource::UpdateEnergySource()
         NotifyEnergyChanged();
     }
 
-    if (m_energyUpdateEvent.IsExpired())
+    if (IsEventDriven())
+    {
+        m_energyUpdateEvent.Cancel();
+        ScheduleThresholdUpdate();
+    }
+    else if (m_energyUpdateEvent.IsExpired())
     {
         m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
                                                   &BasicEnergySource::UpdateEnergySource,
@@ -208,6 +215,25 @@ BasicEnergySource::HandleEnergyRechargedEvent()
     NotifyEnergyRecharged(); // notify DeviceEnergyModel objects
 }
 
+double
+BasicEnergySource::GetTimeToThreshold(double totalCurrentA)
+{
+    NS_LOG_FUNCTION(this << totalCurrentA);
+    double powerW = totalCurrentA * m_supplyVoltageV;
+    double elapsedS = (Simulator::Now() - m_lastUpdateTime).GetSeconds();
+    if (!m_depleted && powerW > 0)
+    {
+        double energyJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+        return energyJ / powerW - elapsedS;
+    }
+    if (m_depleted && powerW < 0)
+    {
+        double energyJ = m_highBatteryTh * m_initialEnergyJ - m_remainingEnergyJ;
+        return energyJ / -powerW - elapsedS;
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
 void
 BasicEnergySource::CalculateRemainingEnergy()
 {
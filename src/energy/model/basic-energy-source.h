@@ -130,6 +130,15 @@ class BasicEnergySource : public EnergySource
      */
     void CalculateRemainingEnergy();
 
+    /**
+     * @param totalCurrentA Total current draw, in Amperes.
+     * @returns Time until the low (or high, once depleted) battery threshold is
+     * crossed, in seconds.
+     *
+     * Implements EnergySource::GetTimeToThreshold.
+     */
+    double GetTimeToThreshold(double totalCurrentA) override;
+
   private:
     double m_initialEnergyJ; //!< initial energy, in Joules
     double m_supplyVoltageV; //!< supply voltage, in Volts
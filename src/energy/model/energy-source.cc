@@ -13,7 +13,11 @@
 
 #include "energy-source.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <limits>
 
 namespace ns3
 {
@@ -29,11 +33,21 @@ EnergySource::GetTypeId()
     static TypeId tid = TypeId("ns3::energy::EnergySource")
                             .AddDeprecatedName("ns3::EnergySource")
                             .SetParent<Object>()
-                            .SetGroupName("Energy");
+                            .SetGroupName("Energy")
+                            .AddAttribute("EventDriven",
+                                          "If true, the remaining energy is updated when the "
+                                          "current draw changes and when a threshold is "
+                                          "predicted to be crossed, instead of periodically. "
+                                          "Only supported by the energy sources overriding "
+                                          "GetTimeToThreshold.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&EnergySource::m_eventDriven),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 EnergySource::EnergySource()
+    : m_eventDriven(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -139,6 +153,29 @@ EnergySource::ConnectEnergyHarvester(Ptr<EnergyHarvester> energyHarvesterPtr)
  * Private function starts here.
  */
 
+void
+EnergySource::PredictThresholdCrossing()
+{
+    NS_LOG_FUNCTION(this);
+    m_thresholdEvent.Cancel();
+    double timeToThresholdS = GetTimeToThreshold(CalculateTotalCurrent());
+    double maxTimeS = (Simulator::GetMaximumSimulationTime() - Simulator::Now()).GetSeconds();
+    if (!(timeToThresholdS < maxTimeS))
+    {
+        NS_LOG_DEBUG("No threshold crossing predicted");
+        return;
+    }
+    // the update must not happen before the crossing
+    Time delay = Seconds(timeToThresholdS);
+    if (delay.GetSeconds() < timeToThresholdS)
+    {
+        delay += TimeStep(1);
+    }
+    delay = Max(delay, TimeStep(1));
+    NS_LOG_DEBUG("Threshold crossing predicted in " << delay.As(Time::S));
+    m_thresholdEvent = Simulator::Schedule(delay, &EnergySource::UpdateEnergySource, this);
+}
+
 void
 EnergySource::DoDispose()
 {
@@ -221,10 +258,35 @@ EnergySource::NotifyEnergyChanged()
     }
 }
 
+bool
+EnergySource::IsEventDriven() const
+{
+    return m_eventDriven;
+}
+
+void
+EnergySource::ScheduleThresholdUpdate()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_predictionEvent.IsPending())
+    {
+        m_predictionEvent = Simulator::ScheduleNow(&EnergySource::PredictThresholdCrossing, this);
+    }
+}
+
+double
+EnergySource::GetTimeToThreshold(double totalCurrentA)
+{
+    NS_LOG_FUNCTION(this << totalCurrentA);
+    return std::numeric_limits<double>::infinity();
+}
+
 void
 EnergySource::BreakDeviceEnergyModelRefCycle()
 {
     NS_LOG_FUNCTION(this);
+    m_predictionEvent.Cancel();
+    m_thresholdEvent.Cancel();
     m_models.Clear();
     m_harvesters.clear();
     m_node = nullptr;
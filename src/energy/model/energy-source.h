@@ -17,6 +17,7 @@
 #include "device-energy-model-container.h" // #include "device-energy-model.h"
 #include "energy-harvester.h"
 
+#include "ns3/event-id.h"
 #include "ns3/node.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -72,6 +73,13 @@ class EnergyHarvester;
  * energy as (time in seconds * power in Watts). If the energy source stores
  * energy in different units (eg. kWh), a simple converter function should
  * suffice.
+ *
+ * By default, the energy sources update the remaining energy periodically, in
+ * order to detect the crossing of their thresholds. When the EventDriven
+ * attribute is true, the energy sources supporting it update the remaining
+ * energy only when they are notified of a change of the current draw, and
+ * predict the time at which the next threshold will be crossed with the
+ * current draw unchanged, so that a single update is scheduled at that time.
  */
 class EnergySource : public Object
 {
@@ -180,6 +188,12 @@ class EnergySource : public Object
     void ConnectEnergyHarvester(Ptr<EnergyHarvester> energyHarvesterPtr);
 
   private:
+    /**
+     * Predicts the crossing of the next threshold with the current draw of the
+     * device models, and schedules an update of the energy source at that time.
+     */
+    void PredictThresholdCrossing();
+
     /**
      * All child's implementation must call BreakDeviceEnergyModelRefCycle to
      * ensure reference cycles to DeviceEnergyModel objects are broken.
@@ -207,6 +221,10 @@ class EnergySource : public Object
      */
     std::vector<Ptr<EnergyHarvester>> m_harvesters;
 
+    bool m_eventDriven;        //!< True if the remaining energy is updated on changes only
+    EventId m_predictionEvent; //!< Prediction of the next threshold crossing
+    EventId m_thresholdEvent;  //!< Update of the energy source at the next threshold crossing
+
   protected:
     /**
      * @returns Total current draw from all DeviceEnergyModels.
@@ -231,6 +249,34 @@ class EnergySource : public Object
      */
     void NotifyEnergyChanged();
 
+    /**
+     * @returns True if the remaining energy is updated only when the current
+     * draw changes, instead of periodically.
+     */
+    bool IsEventDriven() const;
+
+    /**
+     * Schedules the prediction of the next threshold crossing, replacing the
+     * update scheduled at the previous one. It is called by the child
+     * EnergySource class at the end of each update when IsEventDriven is true.
+     *
+     * The prediction is made once the current event is over, since the device
+     * energy models update the energy source before changing their state.
+     */
+    void ScheduleThresholdUpdate();
+
+    /**
+     * @param totalCurrentA Total current draw from all DeviceEnergyModels, in Amperes.
+     * @returns Time until the next threshold of the energy source is crossed,
+     * in seconds, if the total current draw does not change. Infinity if no
+     * threshold is crossed.
+     *
+     * Child of the EnergySource base class supporting the event-driven updates
+     * must override this function. The default implementation never predicts a
+     * crossing.
+     */
+    virtual double GetTimeToThreshold(double totalCurrentA);
+
     /**
      * This function is called to break reference cycle between EnergySource and
      * DeviceEnergyModel. Child of the EnergySource base class must call this
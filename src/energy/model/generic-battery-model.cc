@@ -18,6 +18,7 @@
 #include "ns3/trace-source-accessor.h"
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -216,8 +217,16 @@ GenericBatteryModel::UpdateEnergySource()
         //       or should it be allowed to continue charging (overcharge)?
     }
 
-    m_energyUpdateEvent =
-        Simulator::Schedule(m_energyUpdateInterval, &GenericBatteryModel::UpdateEnergySource, this);
+    if (IsEventDriven())
+    {
+        ScheduleThresholdUpdate();
+    }
+    else
+    {
+        m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
+                                                  &GenericBatteryModel::UpdateEnergySource,
+                                                  this);
+    }
 }
 
 void
@@ -330,10 +339,19 @@ GenericBatteryModel::GetChargeVoltage(double i)
         {
             m_expZone = A * std::exp(-B * it);
         }
-        double entnPrime = m_entn;
-        double expZonePrime = m_expZone;
-        m_entn = B * std::abs(i) * (-expZonePrime + A);
-        m_expZone = expZonePrime + (m_energyUpdateLapseTime * entnPrime).GetHours();
+        if (IsEventDriven())
+        {
+            // exact solution for the current constant since the last update
+            double decay = std::exp(-B * std::abs(i) * m_energyUpdateLapseTime.GetHours());
+            m_expZone = A + (m_expZone - A) * decay;
+        }
+        else
+        {
+            double entnPrime = m_entn;
+            double expZonePrime = m_expZone;
+            m_entn = B * std::abs(i) * (-expZonePrime + A);
+            m_expZone = expZonePrime + (m_energyUpdateLapseTime * entnPrime).GetHours();
+        }
 
         if (m_batteryType == NIMH_NICD)
         { // For NiMH and NiCd batteries
@@ -403,11 +421,19 @@ GenericBatteryModel::GetVoltage(double i)
             m_expZone = A * exp(-B * it);
         }
 
-        double entnPrime = m_entn;
-        double expZonePrime = m_expZone;
+        if (IsEventDriven())
+        {
+            // exact solution for the current constant since the last update
+            m_expZone *= std::exp(-B * std::abs(i) * m_energyUpdateLapseTime.GetHours());
+        }
+        else
+        {
+            double entnPrime = m_entn;
+            double expZonePrime = m_expZone;
 
-        m_entn = B * std::abs(i) * (-expZonePrime);
-        m_expZone = expZonePrime + (m_energyUpdateLapseTime * entnPrime).GetHours();
+            m_entn = B * std::abs(i) * (-expZonePrime);
+            m_expZone = expZonePrime + (m_energyUpdateLapseTime * entnPrime).GetHours();
+        }
     }
 
     V = E0 - (m_internalResistance * i) - (polResistance * m_currentFiltered) - (polVoltage * it) +
@@ -426,5 +452,112 @@ GenericBatteryModel::GetVoltage(double i)
     return V;
 }
 
+double
+GenericBatteryModel::GetPredictedVoltage(double i, Time t) const
+{
+    NS_LOG_FUNCTION(this << i << t);
+
+    double lapseTime = (t - m_lastUpdateTime).GetHours();
+
+    // state of the battery at time t, as updated by CalculateRemainingEnergy
+    double it = m_drainedCapacity + i * lapseTime;
+    double currentFiltered = i * (1 - 1 / (std::exp((t / Seconds(30)).GetDouble())));
+
+    // same factors as in GetVoltage and GetChargeVoltage
+    double A = m_vFull - m_vExp;
+    double B = 3 / m_qExp;
+    double E0 = m_vFull + m_internalResistance * m_typicalCurrent - A;
+    double expZoneFull = A * std::exp(-B * m_qNom);
+    double K = (E0 - m_vNom - (m_internalResistance * m_typicalCurrent) + expZoneFull) /
+               (m_qMax / (m_qMax - m_qNom) * (m_qNom + m_typicalCurrent));
+
+    double expZone;
+    if (m_batteryType == LION_LIPO)
+    {
+        expZone = A * std::exp(-B * it);
+    }
+    else if (i < 0)
+    {
+        expZone = A + (m_expZone - A) * std::exp(-B * std::abs(i) * lapseTime);
+    }
+    else
+    {
+        expZone = m_expZone * std::exp(-B * std::abs(i) * lapseTime);
+    }
+
+    double polResistance;
+    double polVoltage;
+    if (i < 0)
+    {
+        double charge = (m_batteryType == NIMH_NICD) ? std::abs(it) : it;
+        polResistance = K * m_qMax / (charge + 0.1 * m_qMax);
+        polVoltage = K * m_qMax / (m_qMax - it);
+    }
+    else
+    {
+        polResistance = K * (m_qMax / (m_qMax - it));
+        polVoltage = polResistance;
+    }
+
+    return E0 - (m_internalResistance * i) - (polResistance * currentFiltered) -
+           (polVoltage * it) + expZone;
+}
+
+double
+GenericBatteryModel::GetTimeToThreshold(double totalCurrentA)
+{
+    NS_LOG_FUNCTION(this << totalCurrentA);
+
+    if (totalCurrentA == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // The voltage decreases while discharging until the capacity is drained,
+    // and increases while charging until the drained capacity is zero
+    bool discharge = totalCurrentA > 0;
+    double lapseLimit = (discharge ? m_qMax - m_drainedCapacity : m_drainedCapacity) /
+                        std::abs(totalCurrentA) * 3600;
+    auto crossed = [&](Time t) {
+        if (discharge)
+        {
+            return m_drainedCapacity + totalCurrentA * (t - m_lastUpdateTime).GetHours() >=
+                       m_qMax ||
+                   GetPredictedVoltage(totalCurrentA, t) <= m_cutoffVoltage;
+        }
+        return GetPredictedVoltage(totalCurrentA, t) >= m_vFull;
+    };
+
+    Time lo = Simulator::Now();
+    if (lapseLimit <= 0 || crossed(lo))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    Time hi = Simulator::GetMaximumSimulationTime();
+    if (lapseLimit < (hi - m_lastUpdateTime).GetSeconds())
+    {
+        hi = m_lastUpdateTime + Seconds(lapseLimit);
+    }
+    if (hi <= lo || !crossed(hi))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // first time step at which the threshold is crossed
+    while (hi - lo > TimeStep(1))
+    {
+        Time mid = lo + TimeStep((hi - lo).GetTimeStep() / 2);
+        if (crossed(mid))
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid;
+        }
+    }
+    return (hi - Simulator::Now()).GetSeconds();
+}
+
 } // namespace energy
 } // namespace ns3
@@ -274,6 +274,29 @@ class GenericBatteryModel : public EnergySource
      */
     double GetChargeVoltage(double current);
 
+    /**
+     *  Predict the battery voltage at a given time, if the current does not
+     *  change after the last update of the battery.
+     *
+     *  In the NiMH, NiCd and Lead Acid batteries, the voltage of the exponential
+     *  zone is given by the exact solution of its differential equation for a
+     *  constant current, as when the battery is updated in event-driven mode.
+     *
+     *  @param current The current value (+i for a discharge, -i for a charge).
+     *  @param time The time of the prediction.
+     *  @return The voltage of the battery.
+     */
+    double GetPredictedVoltage(double current, Time time) const;
+
+    /**
+     *  @param totalCurrentA Total current draw, in Amperes.
+     *  @returns Time until the cutoff voltage (when discharging) or the full
+     *  voltage (when charging) is reached, in seconds.
+     *
+     *  Implements EnergySource::GetTimeToThreshold.
+     */
+    double GetTimeToThreshold(double totalCurrentA) override;
+
   private:
     TracedValue<double> m_remainingEnergyJ; //!< Remaining energy, in Joules
     double m_drainedCapacity;               //!< Capacity drained from the battery, in Ah
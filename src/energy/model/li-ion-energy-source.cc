@@ -15,6 +15,7 @@
 #include "ns3/trace-source-accessor.h"
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -225,8 +226,16 @@ LiIonEnergySource::UpdateEnergySource()
         return; // stop periodic update
     }
 
-    m_energyUpdateEvent =
-        Simulator::Schedule(m_energyUpdateInterval, &LiIonEnergySource::UpdateEnergySource, this);
+    if (IsEventDriven())
+    {
+        ScheduleThresholdUpdate();
+    }
+    else
+    {
+        m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
+                                                  &LiIonEnergySource::UpdateEnergySource,
+                                                  this);
+    }
 }
 
 /*
@@ -261,8 +270,19 @@ LiIonEnergySource::CalculateRemainingEnergy()
     double totalCurrentA = CalculateTotalCurrent();
     Time duration = Simulator::Now() - m_lastUpdateTime;
     NS_ASSERT(duration.GetSeconds() >= 0);
-    // energy = current * voltage * time
-    double energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds();
+    double energyToDecreaseJ;
+    if (IsEventDriven())
+    {
+        // the voltage changes between two updates, at which the current changes
+        energyToDecreaseJ = GetDischargeEnergy(
+            totalCurrentA,
+            m_drainedCapacity + (totalCurrentA * duration).GetHours());
+    }
+    else
+    {
+        // energy = current * voltage * time
+        energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds();
+    }
 
     if (m_remainingEnergyJ < energyToDecreaseJ)
     {
@@ -283,9 +303,13 @@ double
 LiIonEnergySource::GetVoltage(double i) const
 {
     NS_LOG_FUNCTION(this << i);
+    return GetVoltage(i, m_drainedCapacity);
+}
 
-    // integral of i in dt, drained capacity in Ah
-    double it = m_drainedCapacity;
+double
+LiIonEnergySource::GetVoltage(double i, double it) const
+{
+    NS_LOG_FUNCTION(this << i << it);
 
     // empirical factors
     double A = m_eFull - m_eExp;
@@ -308,5 +332,82 @@ LiIonEnergySource::GetVoltage(double i) const
     return V;
 }
 
+double
+LiIonEnergySource::GetDischargeEnergy(double i, double it) const
+{
+    NS_LOG_FUNCTION(this << i << it);
+
+    if (it >= m_qRated)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // same factors as in GetVoltage
+    double A = m_eFull - m_eExp;
+    double B = 3 / m_qExp;
+    double K = std::abs((m_eFull - m_eNom + A * (std::exp(-B * m_qNom) - 1)) * (m_qRated - m_qNom) /
+                        m_qNom);
+    double E0 = m_eFull + K + m_internalResistance * m_typCurrent - A;
+
+    // integral of the cell voltage over the drained capacity, in Ah
+    double q0 = m_drainedCapacity;
+    double energy = (E0 - m_internalResistance * i) * (it - q0) +
+                    K * m_qRated * std::log((m_qRated - it) / (m_qRated - q0)) +
+                    A / B * (std::exp(-B * q0) - std::exp(-B * it));
+
+    return energy * 3600;
+}
+
+double
+LiIonEnergySource::GetTimeToThreshold(double totalCurrentA)
+{
+    NS_LOG_FUNCTION(this << totalCurrentA);
+
+    double energyToDrainJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    double q0 = m_drainedCapacity;
+    if (totalCurrentA <= 0 || energyToDrainJ <= 0 || GetVoltage(totalCurrentA, q0) <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // the energy delivered increases with the drained capacity until the voltage is zero
+    double lo = q0;
+    double hi = m_qRated;
+    for (int k = 0; k < 64; k++)
+    {
+        double mid = (lo + hi) / 2;
+        if (GetVoltage(totalCurrentA, mid) > 0)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (GetDischargeEnergy(totalCurrentA, lo) < energyToDrainJ)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    hi = lo;
+    lo = q0;
+    for (int k = 0; k < 64; k++)
+    {
+        double mid = (lo + hi) / 2;
+        if (GetDischargeEnergy(totalCurrentA, mid) < energyToDrainJ)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    Time elapsed = Simulator::Now() - m_lastUpdateTime;
+    return (hi - q0) / totalCurrentA * 3600 - elapsed.GetSeconds();
+}
+
 } // namespace energy
 } // namespace ns3
@@ -189,6 +189,36 @@ LiIonEnergySource : public EnergySource
      */
     double GetVoltage(double current) const;
 
+    /**
+     * Get the cell voltage in function of the discharge current and of the
+     * capacity drained from the cell.
+     *
+     * @param current the discharge current value.
+     * @param drainedCapacity the capacity drained from the cell, in Ah.
+     * @return the cell voltage
+     */
+    double GetVoltage(double current, double drainedCapacity) const;
+
+    /**
+     * Get the energy delivered by the cell at a constant discharge current,
+     * while the drained capacity goes from its current value to the given one.
+     * The voltage curve of GetVoltage is integrated in closed form.
+     *
+     * @param current the discharge current value.
+     * @param drainedCapacity the capacity drained from the cell at the end of
+     * the discharge, in Ah.
+     * @return the energy delivered, in Joules
+     */
+    double GetDischargeEnergy(double current, double drainedCapacity) const;
+
+    /**
+     * @param totalCurrentA Total current draw, in Amperes.
+     * @returns Time until the low battery threshold is crossed, in seconds.
+     *
+     * Implements EnergySource::GetTimeToThreshold.
+     */
+    double GetTimeToThreshold(double totalCurrentA) override;
+
   private:
     double m_initialEnergyJ;                //!< initial energy, in Joules
     TracedValue<double> m_remainingEnergyJ; //!< remaining energy, in Joules
@@ -14,7 +14,9 @@
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -173,8 +175,15 @@ RvBatteryModel::UpdateEnergySource()
 
     m_previousLoad = currentLoad;
     m_lastSampleTime = Simulator::Now();
-    m_currentSampleEvent =
-        Simulator::Schedule(m_samplingInterval, &RvBatteryModel::UpdateEnergySource, this);
+    if (IsEventDriven())
+    {
+        ScheduleThresholdUpdate();
+    }
+    else
+    {
+        m_currentSampleEvent =
+            Simulator::Schedule(m_samplingInterval, &RvBatteryModel::UpdateEnergySource, this);
+    }
 }
 
 void
@@ -370,5 +379,86 @@ RvBatteryModel::RvModelAFunction(Time t, Time sk, Time sk_1, double beta)
     return delta + 2 * sum;
 }
 
+double
+RvBatteryModel::GetTimeToThreshold(double totalCurrentA)
+{
+    NS_LOG_FUNCTION(this << totalCurrentA);
+
+    double load = totalCurrentA * 1000; // must be in mA
+    if (load <= 0 || m_batteryLevel <= m_lowBatteryTh)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    /*
+     * The A function is additive over consecutive intervals, hence if the load
+     * does not change after the last sample, the alpha value at last sample + x
+     * minutes is:
+     *   charge + sum_m coefficient_m * exp (-beta^2 * m^2 * x) + load * A (x)
+     * where A (x) is the A function of the interval [last sample, last sample + x].
+     */
+    Time start = m_lastSampleTime;
+    double charge = 0.0;
+    std::vector<double> coefficients(m_numOfTerms, 0.0);
+    for (uint64_t i = 1; i < m_timeStamps.size(); i++)
+    {
+        double firstDelta = (start - m_timeStamps[i]).GetMinutes();
+        double secondDelta = (start - m_timeStamps[i - 1]).GetMinutes();
+        charge += m_load[i - 1] * (m_timeStamps[i] - m_timeStamps[i - 1]).GetMinutes();
+        for (int m = 1; m <= m_numOfTerms; m++)
+        {
+            double square = m_beta * m_beta * m * m;
+            double difference = std::exp(-square * firstDelta) - std::exp(-square * secondDelta);
+            coefficients[m - 1] += m_load[i - 1] * 2 * difference / square;
+        }
+    }
+    auto crossed = [&](Time t) {
+        double delta = (t - start).GetMinutes();
+        double sum = 0.0;
+        for (int m = 1; m <= m_numOfTerms; m++)
+        {
+            double square = m_beta * m_beta * m * m;
+            double decay = std::exp(-square * delta);
+            sum += coefficients[m - 1] * decay + load * 2 * (1 - decay) / square;
+        }
+        double calculatedAlpha = charge + load * delta + sum;
+        return 1 - (calculatedAlpha / m_alpha) <= m_lowBatteryTh;
+    };
+
+    // the alpha value is at least the charge consumed, once the recovery is over
+    Time lo = Simulator::Now();
+    Time maxTime = Simulator::GetMaximumSimulationTime();
+    double lapseLimit = std::max((m_alpha - charge) / load, 1.0);
+    Time hi;
+    do
+    {
+        if (lapseLimit >= (maxTime - start).GetMinutes())
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        hi = start + Minutes(lapseLimit);
+        lapseLimit *= 2;
+    } while (!crossed(hi));
+    if (hi <= lo || crossed(lo))
+    {
+        return 0;
+    }
+
+    // first time step at which the threshold is crossed
+    while (hi - lo > TimeStep(1))
+    {
+        Time mid = lo + TimeStep((hi - lo).GetTimeStep() / 2);
+        if (crossed(mid))
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid;
+        }
+    }
+    return (hi - Simulator::Now()).GetSeconds();
+}
+
 } // namespace energy
 } // namespace ns3
@@ -211,6 +211,16 @@ class RvBatteryModel : public EnergySource
      */
     double RvModelAFunction(Time t, Time sk, Time sk_1, double beta);
 
+    /**
+     * @param totalCurrentA Total current draw, in Amperes.
+     * @returns Time until the battery level is below the low battery threshold,
+     * in seconds.
+     *
+     * The alpha value is computed as in Discharge, with the load constant after
+     * the last sample. Implements EnergySource::GetTimeToThreshold.
+     */
+    double GetTimeToThreshold(double totalCurrentA) override;
+
   private:
     double m_openCircuitVoltage; //!< Open circuit voltage (in Volts)
     double m_cutoffVoltage;      //!< Cutoff voltage (in Volts)
@@ -0,0 +1,280 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/basic-energy-source.h"
+#include "ns3/boolean.h"
+#include "ns3/generic-battery-model-helper.h"
+#include "ns3/generic-battery-model.h"
+#include "ns3/li-ion-energy-source.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/rv-battery-model.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::energy;
+
+NS_LOG_COMPONENT_DEFINE("EnergySourceEventDrivenTestSuite");
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Device energy model recording the energy depletion notifications.
+ */
+class DepletionRecorderEnergyModel : public SimpleDeviceEnergyModel
+{
+  public:
+    void HandleEnergyDepletion() override
+    {
+        m_depletionTimes.push_back(Simulator::Now());
+    }
+
+    std::vector<Time> m_depletionTimes; //!< Times of the energy depletion notifications
+};
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Compares the energy depletion notified by an energy source in
+ * event-driven mode to the one of the periodic updates, for a piecewise
+ * constant current.
+ */
+class EnergySourceEventDrivenTestCase : public TestCase
+{
+  public:
+    /// Current draw of the device, in Amperes, from a given time
+    using CurrentSteps = std::vector<std::pair<Time, double>>;
+
+    /**
+     * Constructor
+     *
+     * @param name The name of the energy source
+     * @param createSource Function creating the energy source with its periodic update interval
+     * @param currents The current draw of the device
+     * @param stop The end of the simulation
+     * @param tolerance The maximum delay of the periodic notification
+     */
+    EnergySourceEventDrivenTestCase(std::string name,
+                                    std::function<Ptr<EnergySource>()> createSource,
+                                    CurrentSteps currents,
+                                    Time stop,
+                                    Time tolerance);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Discharge an energy source.
+     *
+     * @param eventDriven Whether the energy source is updated in event-driven mode
+     * @param [out] remainingEnergyJ The remaining energy at the end of the simulation
+     * @return The times of the energy depletion notifications
+     */
+    std::vector<Time> Discharge(bool eventDriven, double& remainingEnergyJ);
+
+    std::function<Ptr<EnergySource>()> m_createSource; //!< Creates the energy source
+    CurrentSteps m_currents;                           //!< Current draw of the device
+    Time m_stop;                                       //!< End of the simulation
+    Time m_tolerance; //!< Maximum delay of the periodic notification
+};
+
+EnergySourceEventDrivenTestCase::EnergySourceEventDrivenTestCase(
+    std::string name,
+    std::function<Ptr<EnergySource>()> createSource,
+    CurrentSteps currents,
+    Time stop,
+    Time tolerance)
+    : TestCase("Event-driven updates of " + name),
+      m_createSource(createSource),
+      m_currents(currents),
+      m_stop(stop),
+      m_tolerance(tolerance)
+{
+}
+
+std::vector<Time>
+EnergySourceEventDrivenTestCase::Discharge(bool eventDriven, double& remainingEnergyJ)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<DepletionRecorderEnergyModel> dem = CreateObject<DepletionRecorderEnergyModel>();
+    Ptr<EnergySource> es = m_createSource();
+    es->SetAttribute("EventDriven", BooleanValue(eventDriven));
+
+    es->SetNode(node);
+    dem->SetEnergySource(es);
+    es->AppendDeviceEnergyModel(dem);
+    node->AggregateObject(es);
+
+    for (const auto& [time, current] : m_currents)
+    {
+        Simulator::Schedule(time, &SimpleDeviceEnergyModel::SetCurrentA, dem, current);
+    }
+
+    // the remaining energy is read last, since some sources notify the depletion on each update
+    std::vector<Time> depletionTimes;
+    Simulator::Schedule(m_stop, [&]() {
+        depletionTimes = dem->m_depletionTimes;
+        remainingEnergyJ = es->GetRemainingEnergy();
+    });
+    Simulator::Stop(m_stop);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return depletionTimes;
+}
+
+void
+EnergySourceEventDrivenTestCase::DoRun()
+{
+    double periodicEnergyJ;
+    std::vector<Time> periodic = Discharge(false, periodicEnergyJ);
+    double eventDrivenEnergyJ;
+    std::vector<Time> eventDriven = Discharge(true, eventDrivenEnergyJ);
+
+    NS_TEST_ASSERT_MSG_EQ(periodic.empty(), false, "The energy source is not depleted");
+    NS_TEST_ASSERT_MSG_EQ(eventDriven.size(), 1, "The depletion is notified once");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(eventDriven[0],
+                                periodic[0],
+                                "The depletion is notified later than periodically");
+    NS_TEST_ASSERT_MSG_LT(periodic[0],
+                          eventDriven[0] + m_tolerance,
+                          "The depletion is notified too late");
+    NS_TEST_ASSERT_MSG_EQ_TOL(eventDrivenEnergyJ,
+                              periodicEnergyJ,
+                              std::abs(periodicEnergyJ) * 0.01,
+                              "Incorrect remaining energy");
+}
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Checks that BasicEnergySource notifies the depletion at the exact
+ * time of the threshold crossing in event-driven mode.
+ */
+class BasicEnergySourceEventDrivenTestCase : public TestCase
+{
+  public:
+    BasicEnergySourceEventDrivenTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BasicEnergySourceEventDrivenTestCase::BasicEnergySourceEventDrivenTestCase()
+    : TestCase("Event-driven depletion time of BasicEnergySource")
+{
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<DepletionRecorderEnergyModel> dem = CreateObject<DepletionRecorderEnergyModel>();
+    Ptr<BasicEnergySource> es = CreateObject<BasicEnergySource>();
+    es->SetAttribute("EventDriven", BooleanValue(true));
+    es->SetInitialEnergy(10);
+    es->SetSupplyVoltage(3);
+
+    es->SetNode(node);
+    dem->SetEnergySource(es);
+    es->AppendDeviceEnergyModel(dem);
+    node->AggregateObject(es);
+
+    // 3 J are drained in the first 10 s, then the remaining 6 J above the threshold in 10 s
+    Simulator::Schedule(Seconds(0), &SimpleDeviceEnergyModel::SetCurrentA, dem, 0.1);
+    Simulator::Schedule(Seconds(10), &SimpleDeviceEnergyModel::SetCurrentA, dem, 0.2);
+
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(dem->m_depletionTimes.size(), 1, "The depletion is notified once");
+    NS_TEST_ASSERT_MSG_EQ_TOL(dem->m_depletionTimes[0],
+                              Seconds(20),
+                              NanoSeconds(10),
+                              "Incorrect depletion time");
+}
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Event-driven energy source TestSuite
+ */
+class EnergySourceEventDrivenTestSuite : public TestSuite
+{
+  public:
+    EnergySourceEventDrivenTestSuite();
+};
+
+EnergySourceEventDrivenTestSuite::EnergySourceEventDrivenTestSuite()
+    : TestSuite("energy-source-event-driven", Type::UNIT)
+{
+    AddTestCase(new BasicEnergySourceEventDrivenTestCase, TestCase::Duration::QUICK);
+
+    AddTestCase(new EnergySourceEventDrivenTestCase(
+                    "BasicEnergySource",
+                    []() {
+                        Ptr<BasicEnergySource> es = CreateObject<BasicEnergySource>();
+                        es->SetInitialEnergy(10);
+                        es->SetSupplyVoltage(3);
+                        return es;
+                    },
+                    {{Seconds(0), 0.1}, {Seconds(10), 0.2}},
+                    Seconds(21.5),
+                    Seconds(1)),
+                TestCase::Duration::QUICK);
+
+    AddTestCase(new EnergySourceEventDrivenTestCase(
+                    "LiIonEnergySource",
+                    []() {
+                        NS_WARNING_PUSH_DEPRECATED;
+                        Ptr<LiIonEnergySource> es = CreateObject<LiIonEnergySource>();
+                        NS_WARNING_POP;
+                        return es;
+                    },
+                    {{Seconds(0), 2.33}, {Seconds(600), 1}},
+                    Seconds(6900),
+                    Seconds(1)),
+                TestCase::Duration::QUICK);
+
+    AddTestCase(new EnergySourceEventDrivenTestCase(
+                    "GenericBatteryModel (Li-Ion)",
+                    []() {
+                        GenericBatteryModelHelper helper;
+                        return helper.Install(CreateObject<Node>(), PANASONIC_CGR18650DA_LION);
+                    },
+                    {{Seconds(0), 2}, {Seconds(600), 1}},
+                    Seconds(7600),
+                    Seconds(1)),
+                TestCase::Duration::QUICK);
+
+    AddTestCase(new EnergySourceEventDrivenTestCase(
+                    "GenericBatteryModel (NiMH)",
+                    []() {
+                        GenericBatteryModelHelper helper;
+                        return helper.Install(CreateObject<Node>(), PANASONIC_HHR650D_NIMH);
+                    },
+                    {{Seconds(0), 6.5}, {Seconds(600), 3}},
+                    Seconds(7300),
+                    Seconds(1)),
+                TestCase::Duration::QUICK);
+
+    AddTestCase(new EnergySourceEventDrivenTestCase(
+                    "RvBatteryModel",
+                    []() { return CreateObject<RvBatteryModel>(); },
+                    {{Seconds(0), 0.5}, {Minutes(30), 0.1}},
+                    Minutes(192),
+                    Seconds(1)),
+                TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static EnergySourceEventDrivenTestSuite g_energySourceEventDrivenTestSuite;
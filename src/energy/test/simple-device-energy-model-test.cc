@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/basic-energy-source.h"
+#include "ns3/double.h"
+#include "ns3/node.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::energy;
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Simple device energy model test, checking that the energy drawn
+ * before a change of the current is computed with the previous current.
+ */
+class SimpleDeviceEnergyModelTestCase : public TestCase
+{
+  public:
+    SimpleDeviceEnergyModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SimpleDeviceEnergyModelTestCase::SimpleDeviceEnergyModelTestCase()
+    : TestCase("Energy drawn by a simple device energy model when its current changes")
+{
+}
+
+void
+SimpleDeviceEnergyModelTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource>();
+    source->SetAttribute("BasicEnergySourceInitialEnergyJ", DoubleValue(100));
+    source->SetAttribute("BasicEnergySupplyVoltageV", DoubleValue(2));
+    // no periodic update before the end of the test
+    source->SetAttribute("PeriodicEnergyUpdateInterval", TimeValue(Seconds(1000)));
+    source->SetNode(node);
+    Ptr<SimpleDeviceEnergyModel> model = CreateObject<SimpleDeviceEnergyModel>();
+    model->SetNode(node);
+    model->SetEnergySource(source);
+    source->AppendDeviceEnergyModel(model);
+
+    // 0 A during 1 s, 1 A during 2 s, then 0.25 A during 1 s
+    Simulator::Schedule(Seconds(1), &SimpleDeviceEnergyModel::SetCurrentA, model, 1.0);
+    Simulator::Schedule(Seconds(3), &SimpleDeviceEnergyModel::SetCurrentA, model, 0.25);
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+
+    const double expectedJ = (2 * 1.0 + 1 * 0.25) * 2;
+    NS_TEST_EXPECT_MSG_EQ_TOL(model->GetTotalEnergyConsumption(),
+                              expectedJ,
+                              1e-9,
+                              "Wrong energy consumed by the device");
+    NS_TEST_EXPECT_MSG_EQ_TOL(source->GetRemainingEnergy(),
+                              100 - expectedJ,
+                              1e-9,
+                              "Wrong energy drawn from the source");
+
+    source->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Simple device energy model TestSuite
+ */
+class SimpleDeviceEnergyModelTestSuite : public TestSuite
+{
+  public:
+    SimpleDeviceEnergyModelTestSuite();
+};
+
+SimpleDeviceEnergyModelTestSuite::SimpleDeviceEnergyModelTestSuite()
+    : TestSuite("simple-device-energy-model", Type::UNIT)
+{
+    AddTestCase(new SimpleDeviceEnergyModelTestCase, TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static SimpleDeviceEnergyModelTestSuite g_simpleDeviceEnergyModelTestSuite;
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This example measures the number of frames per second that two
+// FdNetDevices connected by a Unix datagram socket pair can exchange, with
+// and without reading and writing the frames in batches.
+//
+// The first device sends raw Ethernet frames, in bursts of a given number
+// of frames per simulation event, to the second device, which counts the
+// frames received.  Each configuration (one frame at a time, then the
+// given batch size for the RxBatchSize and TxBatchSize attributes) is run
+// with the default simulator and the wall clock time needed to receive the
+// frames is reported, along with the frames dropped.
+//
+// Usage example:
+//
+//   ./ns3 run "fd2fd-batch-throughput --frames=200000 --batch=32"
+
+#include "ns3/core-module.h"
+#include "ns3/fd-net-device-module.h"
+#include "ns3/network-module.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sys/socket.h>
+#include <time.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FdNetDeviceBatchThroughputExample");
+
+/// Parameters and state of a run
+struct Run
+{
+    Ptr<FdNetDevice> sender;   //!< sending device
+    uint32_t nFrames;          //!< number of frames to send
+    uint32_t frameSize;        //!< size of the payload of the frames
+    uint32_t burst;            //!< number of frames sent per event
+    uint32_t nSent{0};         //!< frames sent
+    uint32_t nReceived{0};     //!< frames received
+    uint32_t nLastReceived{0}; //!< frames received at the last check
+    int64_t elapsedMs{0};      //!< time of the last reception since the start
+    SystemWallClockMs clock;   //!< wall clock
+    uint32_t idleChecks{0};    //!< consecutive checks without a reception
+};
+
+/**
+ * Receive callback of the receiving device.
+ * @param run the run
+ * @return true
+ */
+static bool
+Receive(Run* run, Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&)
+{
+    run->nReceived++;
+    return true;
+}
+
+/**
+ * Send a burst of frames, and schedule the next one.
+ * @param run the run
+ */
+static void
+SendBurst(Run* run)
+{
+    for (uint32_t i = 0; i < run->burst && run->nSent < run->nFrames; i++, run->nSent++)
+    {
+        run->sender->Send(Create<Packet>(run->frameSize), Mac48Address::GetBroadcast(), 0x88b5);
+    }
+    if (run->nSent < run->nFrames)
+    {
+        Simulator::Schedule(NanoSeconds(1), &SendBurst, run);
+    }
+}
+
+/**
+ * Check whether all the frames have been received, or whether no frame
+ * has been received for a while; otherwise, wait for the reader thread.
+ * @param run the run
+ */
+static void
+Check(Run* run)
+{
+    if (run->nReceived != run->nLastReceived)
+    {
+        run->nLastReceived = run->nReceived;
+        run->elapsedMs = run->clock.End();
+        run->idleChecks = 0;
+    }
+    else
+    {
+        run->idleChecks++;
+    }
+    if (run->nReceived == run->nFrames || (run->nSent == run->nFrames && run->idleChecks > 1000))
+    {
+        Simulator::Stop();
+        return;
+    }
+    // let the reader thread run
+    struct timespec time = {0, 100000L}; // 100 us
+    nanosleep(&time, nullptr);
+    Simulator::Schedule(MicroSeconds(100), &Check, run);
+}
+
+/**
+ * Exchange frames between two devices.
+ * @param nFrames the number of frames
+ * @param frameSize the size of the payload of the frames
+ * @param burst the number of frames sent per event
+ * @param batch the value of the RxBatchSize and TxBatchSize attributes
+ */
+static void
+Measure(uint32_t nFrames, uint32_t frameSize, uint32_t burst, uint32_t batch)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    FdNetDeviceHelper fd;
+    fd.SetAttribute("RxBatchSize", UintegerValue(batch));
+    fd.SetAttribute("TxBatchSize", UintegerValue(batch));
+    fd.SetAttribute("RxQueueSize", UintegerValue(nFrames));
+    NetDeviceContainer devices = fd.Install(nodes);
+
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) < 0)
+    {
+        NS_FATAL_ERROR("Error creating socket pair=" << strerror(errno));
+    }
+
+    Run run;
+    run.sender = devices.Get(0)->GetObject<FdNetDevice>();
+    run.sender->SetFileDescriptor(sv[0]);
+    Ptr<FdNetDevice> receiver = devices.Get(1)->GetObject<FdNetDevice>();
+    receiver->SetFileDescriptor(sv[1]);
+    receiver->SetReceiveCallback(MakeBoundCallback(&Receive, &run));
+    run.nFrames = nFrames;
+    run.frameSize = frameSize;
+    run.burst = burst;
+
+    // the devices are started at time 0
+    Simulator::Schedule(NanoSeconds(1), [&run]() {
+        run.clock.Start();
+        SendBurst(&run);
+        Check(&run);
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+
+    double seconds = std::max<int64_t>(run.elapsedMs, 1) / 1000.0;
+    std::cout << std::setw(8) << batch << std::setw(10) << run.nSent << std::setw(10)
+              << run.nReceived << std::setw(10) << run.nSent - run.nReceived << std::setw(10)
+              << run.elapsedMs << std::setw(14) << std::fixed << std::setprecision(0)
+              << run.nReceived / seconds << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nFrames = 100000;
+    uint32_t frameSize = 64;
+    uint32_t burst = 64;
+    uint32_t batch = 32;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("frames", "Number of frames to send", nFrames);
+    cmd.AddValue("size", "Size of the payload of the frames, in bytes", frameSize);
+    cmd.AddValue("burst", "Number of frames sent per simulation event", burst);
+    cmd.AddValue("batch", "Number of frames read and written at once in the batched run", batch);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(frameSize > 1500, "The frames cannot be larger than the MTU");
+    NS_ABORT_MSG_IF(burst == 0 || batch == 0, "The burst and batch sizes must be positive");
+
+    std::cout << std::setw(8) << "batch" << std::setw(10) << "sent" << std::setw(10) << "received"
+              << std::setw(10) << "dropped" << std::setw(10) << "ms" << std::setw(14)
+              << "frames/s" << std::endl;
+    Measure(nFrames, frameSize, burst, 1);
+    if (batch > 1)
+    {
+        Measure(nFrames, frameSize, burst, batch);
+    }
+
+    return 0;
+}
@@ -25,7 +25,12 @@
 #include "ns3/uinteger.h"
 
 #include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
 #include <net/ethernet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace ns3
@@ -65,6 +70,155 @@ FdNetDeviceFdReader::DoRead()
     return FdReader::Data(buf, len);
 }
 
+FdNetDeviceBufferPool::FdNetDeviceBufferPool(size_t bufferSize, uint32_t nBuffers)
+    : m_bufferSize(bufferSize)
+{
+    NS_LOG_FUNCTION(this << bufferSize << nBuffers);
+    m_buffers.reserve(nBuffers);
+    for (uint32_t i = 0; i < nBuffers; i++)
+    {
+        auto buf = (uint8_t*)malloc(m_bufferSize);
+        NS_ABORT_MSG_IF(buf == nullptr, "malloc() failed");
+        m_buffers.push_back(buf);
+    }
+}
+
+FdNetDeviceBufferPool::~FdNetDeviceBufferPool()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto buf : m_buffers)
+    {
+        free(buf);
+    }
+}
+
+uint8_t*
+FdNetDeviceBufferPool::Acquire()
+{
+    {
+        std::unique_lock lock{m_mutex};
+        if (!m_buffers.empty())
+        {
+            uint8_t* buf = m_buffers.back();
+            m_buffers.pop_back();
+            return buf;
+        }
+    }
+    auto buf = (uint8_t*)malloc(m_bufferSize);
+    NS_ABORT_MSG_IF(buf == nullptr, "malloc() failed");
+    return buf;
+}
+
+void
+FdNetDeviceBufferPool::Release(uint8_t* buf)
+{
+    std::unique_lock lock{m_mutex};
+    m_buffers.push_back(buf);
+}
+
+size_t
+FdNetDeviceBufferPool::GetBufferSize() const
+{
+    return m_bufferSize;
+}
+
+FdNetDeviceBatchFdReader::FdNetDeviceBatchFdReader(Ptr<FdNetDeviceBufferPool> pool,
+                                                   uint32_t batchSize,
+                                                   Callback<void, const Frames&> batchCallback)
+    : m_pool(pool),
+      m_batchSize(batchSize),
+      m_batchCallback(batchCallback)
+{
+    NS_LOG_FUNCTION(this << pool << batchSize);
+    for (uint32_t i = 0; i < m_batchSize; i++)
+    {
+        m_buffers.push_back(m_pool->Acquire());
+    }
+    m_frames.reserve(m_batchSize);
+}
+
+FdNetDeviceBatchFdReader::~FdNetDeviceBatchFdReader()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto buf : m_buffers)
+    {
+        m_pool->Release(buf);
+    }
+}
+
+FdReader::Data
+FdNetDeviceBatchFdReader::DoRead()
+{
+    NS_LOG_FUNCTION(this);
+
+    const size_t bufferSize = m_pool->GetBufferSize();
+    m_frames.clear();
+
+#ifdef HAVE_SENDMMSG_RECVMMSG
+    struct stat st;
+    if (fstat(m_fd, &st) == 0 && S_ISSOCK(st.st_mode))
+    {
+        std::vector<struct iovec> iov(m_batchSize);
+        std::vector<struct mmsghdr> msgs(m_batchSize);
+        for (uint32_t i = 0; i < m_batchSize; i++)
+        {
+            iov[i].iov_base = m_buffers[i];
+            iov[i].iov_len = bufferSize;
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        // wait for the first frame, then take the ones already available
+        NS_LOG_LOGIC("Calling recvmmsg on fd " << m_fd);
+        int n = recvmmsg(m_fd, msgs.data(), m_batchSize, MSG_WAITFORONE, nullptr);
+        if (n <= 0)
+        {
+            return FdReader::Data(nullptr, 0);
+        }
+        for (int i = 0; i < n; i++)
+        {
+            m_frames.emplace_back(m_buffers[i], msgs[i].msg_len);
+        }
+    }
+    else
+#endif
+    {
+        // read the first frame, then the ones already available
+        for (uint32_t i = 0; i < m_batchSize; i++)
+        {
+            if (i > 0)
+            {
+                struct pollfd pfd = {m_fd, POLLIN, 0};
+                if (poll(&pfd, 1, 0) <= 0 || (pfd.revents & POLLIN) == 0)
+                {
+                    break;
+                }
+            }
+            ssize_t len = read(m_fd, m_buffers[i], bufferSize);
+            if (len <= 0)
+            {
+                break;
+            }
+            m_frames.emplace_back(m_buffers[i], len);
+        }
+        if (m_frames.empty())
+        {
+            return FdReader::Data(nullptr, 0);
+        }
+    }
+    NS_LOG_LOGIC("Read " << m_frames.size() << " frames on fd " << m_fd);
+
+    // the callback owns the buffers of the frames read, which are replaced
+    for (std::size_t i = 0; i < m_frames.size(); i++)
+    {
+        m_buffers[i] = m_pool->Acquire();
+    }
+    m_batchCallback(m_frames);
+
+    // the frames have been processed, the read callback is not invoked
+    return FdReader::Data(nullptr, -1);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FdNetDevice);
 
 TypeId
@@ -105,6 +259,25 @@ FdNetDevice::GetTypeId()
                           UintegerValue(1000),
                           MakeUintegerAccessor(&FdNetDevice::m_maxPendingReads),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("RxBatchSize",
+                          "Maximum number of frames read at once from the file "
+                          "descriptor.  When greater than 1, the frames available "
+                          "are read with recvmmsg() (or successive reads if the file "
+                          "descriptor is not a socket) into a pool of buffers, and "
+                          "passed to the simulator in a single event.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FdNetDevice::m_rxBatchSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("TxBatchSize",
+                          "Maximum number of frames written at once to the file "
+                          "descriptor, if it is a socket.  When greater than 1, the "
+                          "frames sent are written with sendmmsg() once this number "
+                          "of frames is reached or at the end of the current "
+                          "simulation time step, and the frames that cannot be "
+                          "written are reported by the MacTxDrop trace.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FdNetDevice::m_txBatchSize),
+                          MakeUintegerChecker<uint32_t>(1))
             //
             // Trace sources at the "top" of the net device, where packets transition
             // to/from higher layers.  These points do not really correspond to the
@@ -163,6 +336,7 @@ FdNetDevice::FdNetDevice()
       m_fdReader(nullptr),
       m_isBroadcast(true),
       m_isMulticast(false),
+      m_fdIsSocket(false),
       m_startEvent(),
       m_stopEvent()
 {
@@ -237,6 +411,9 @@ FdNetDevice::StartDevice()
         return;
     }
 
+    struct stat st;
+    m_fdIsSocket = (fstat(m_fd, &st) == 0 && S_ISSOCK(st.st_mode));
+
     m_fdReader = DoCreateFdReader();
     m_fdReader->Start(m_fd, MakeCallback(&FdNetDevice::ReceiveCallback, this));
 
@@ -250,8 +427,18 @@ FdNetDevice::DoCreateFdReader()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FdNetDeviceFdReader> fdReader = Create<FdNetDeviceFdReader>();
     // 22 bytes covers 14 bytes Ethernet header with possible 8 bytes LLC/SNAP
+    if (m_rxBatchSize > 1)
+    {
+        m_rxBufferPool =
+            Create<FdNetDeviceBufferPool>(m_mtu + 22, m_maxPendingReads + m_rxBatchSize);
+        return Create<FdNetDeviceBatchFdReader>(
+            m_rxBufferPool,
+            m_rxBatchSize,
+            MakeCallback(&FdNetDevice::ReceiveBatchCallback, this));
+    }
+
+    Ptr<FdNetDeviceFdReader> fdReader = Create<FdNetDeviceFdReader>();
     fdReader->SetBufferSize(m_mtu + 22);
     return fdReader;
 }
@@ -279,6 +466,9 @@ FdNetDevice::StopDevice()
         m_fdReader = nullptr;
     }
 
+    Simulator::Cancel(m_txFlushEvent);
+    FlushTxFrames();
+
     if (m_fd != -1)
     {
         close(m_fd);
@@ -289,8 +479,9 @@ FdNetDevice::StopDevice()
     {
         std::pair<uint8_t*, ssize_t> next = m_pendingQueue.front();
         m_pendingQueue.pop();
-        FreeBuffer(next.first);
+        ReleaseRxBuffer(next.first);
     }
+    m_rxBufferPool = nullptr;
 
     DoFinishStoppingDevice();
 }
@@ -325,6 +516,42 @@ FdNetDevice::ReceiveCallback(uint8_t* buf, ssize_t len)
     }
 }
 
+void
+FdNetDevice::ReceiveBatchCallback(const FdNetDeviceBatchFdReader::Frames& frames)
+{
+    NS_LOG_FUNCTION(this << frames.size());
+    uint32_t nQueued = 0;
+
+    {
+        std::unique_lock lock{m_pendingReadMutex};
+        for (const auto& [buf, len] : frames)
+        {
+            if (m_pendingQueue.size() >= m_maxPendingReads)
+            {
+                NS_LOG_WARN("Packet dropped");
+                m_rxBufferPool->Release(buf);
+            }
+            else
+            {
+                m_pendingQueue.emplace(buf, len);
+                nQueued++;
+            }
+        }
+    }
+
+    if (nQueued > 0)
+    {
+        Simulator::ScheduleWithContext(m_nodeId,
+                                       Time(0),
+                                       MakeEvent(&FdNetDevice::ForwardUpBatch, this, nQueued));
+    }
+    if (nQueued < frames.size())
+    {
+        struct timespec time = {0, 100000000L}; // 100 ms
+        nanosleep(&time, nullptr);
+    }
+}
+
 /**
  * @ingroup fd-net-device
  * @brief Synthesize PI header for the kernel
@@ -371,24 +598,6 @@ AddPIHeader(uint8_t*& buf, size_t& len)
     buf = buf2;
 }
 
-/**
- * @ingroup fd-net-device
- * @brief Removes PI header
- * @param buf the buffer to add the header to
- * @param len the buffer length
- */
-static void
-RemovePIHeader(uint8_t*& buf, ssize_t& len)
-{
-    // strip PI header if present, shrink buffer
-    if (len >= 4)
-    {
-        len -= 4;
-        memmove(buf, buf + 4, len);
-        buf = (uint8_t*)realloc(buf, len);
-    }
-}
-
 uint8_t*
 FdNetDevice::AllocateBuffer(size_t len)
 {
@@ -401,6 +610,19 @@ FdNetDevice::FreeBuffer(uint8_t* buf)
     free(buf);
 }
 
+void
+FdNetDevice::ReleaseRxBuffer(uint8_t* buf)
+{
+    if (m_rxBufferPool)
+    {
+        m_rxBufferPool->Release(buf);
+    }
+    else
+    {
+        FreeBuffer(buf);
+    }
+}
+
 void
 FdNetDevice::ForwardUp()
 {
@@ -424,19 +646,50 @@ FdNetDevice::ForwardUp()
         len = next.second;
     }
 
+    ForwardUpFrame(buf, len);
+}
+
+void
+FdNetDevice::ForwardUpBatch(uint32_t nFrames)
+{
+    NS_LOG_FUNCTION(this << nFrames);
+
+    std::vector<std::pair<uint8_t*, ssize_t>> frames;
+    frames.reserve(nFrames);
+    {
+        std::unique_lock lock{m_pendingReadMutex};
+        // the queue is emptied when the device is stopped
+        while (frames.size() < nFrames && !m_pendingQueue.empty())
+        {
+            frames.push_back(m_pendingQueue.front());
+            m_pendingQueue.pop();
+        }
+    }
+
+    for (const auto& [buf, len] : frames)
+    {
+        ForwardUpFrame(buf, len);
+    }
+}
+
+void
+FdNetDevice::ForwardUpFrame(uint8_t* buf, ssize_t len)
+{
     NS_LOG_LOGIC("buffer: " << static_cast<void*>(buf) << " length: " << len);
 
     // We need to remove the PI header and ignore it
-    if (m_encapMode == DIXPI)
+    const uint8_t* data = buf;
+    if (m_encapMode == DIXPI && len >= 4)
     {
-        RemovePIHeader(buf, len);
+        data += 4;
+        len -= 4;
     }
 
     //
     // Create a packet out of the buffer we received and free that buffer.
     //
-    Ptr<Packet> packet = Create<Packet>(reinterpret_cast<const uint8_t*>(buf), len);
-    FreeBuffer(buf);
+    Ptr<Packet> packet = Create<Packet>(data, len);
+    ReleaseRxBuffer(buf);
     buf = nullptr;
 
     //
@@ -622,6 +875,21 @@ FdNetDevice::SendFrom(Ptr<Packet> packet,
         AddPIHeader(buffer, len);
     }
 
+    if (m_txBatchSize > 1 && m_fdIsSocket)
+    {
+        m_txFrames.push_back({buffer, len, packet});
+        if (m_txFrames.size() >= m_txBatchSize)
+        {
+            Simulator::Cancel(m_txFlushEvent);
+            FlushTxFrames();
+        }
+        else if (!m_txFlushEvent.IsPending())
+        {
+            m_txFlushEvent = Simulator::ScheduleNow(&FdNetDevice::FlushTxFrames, this);
+        }
+        return true;
+    }
+
     ssize_t written = Write(buffer, len);
     FreeBuffer(buffer);
 
@@ -634,6 +902,67 @@ FdNetDevice::SendFrom(Ptr<Packet> packet,
     return true;
 }
 
+void
+FdNetDevice::FlushTxFrames()
+{
+    NS_LOG_FUNCTION(this << m_txFrames.size());
+
+    std::size_t nWritten = 0;
+#ifdef HAVE_SENDMMSG_RECVMMSG
+    std::vector<struct iovec> iov(m_txFrames.size());
+    std::vector<struct mmsghdr> msgs(m_txFrames.size());
+    for (std::size_t i = 0; i < m_txFrames.size(); i++)
+    {
+        iov[i].iov_base = m_txFrames[i].buffer;
+        iov[i].iov_len = m_txFrames[i].length;
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    while (nWritten < m_txFrames.size() && m_fd != -1)
+    {
+        NS_LOG_LOGIC("calling sendmmsg");
+        int n = sendmmsg(m_fd, msgs.data() + nWritten, m_txFrames.size() - nWritten, 0);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            NS_LOG_LOGIC("sendmmsg failed: " << std::strerror(errno));
+            break;
+        }
+        for (int i = 0; i < n; i++, nWritten++)
+        {
+            if (msgs[nWritten].msg_len != m_txFrames[nWritten].length)
+            {
+                m_macTxDropTrace(m_txFrames[nWritten].packet);
+            }
+        }
+    }
+#else
+    for (; nWritten < m_txFrames.size() && m_fd != -1; nWritten++)
+    {
+        const TxFrame& frame = m_txFrames[nWritten];
+        ssize_t written = Write(frame.buffer, frame.length);
+        if (written == -1 || (size_t)written != frame.length)
+        {
+            m_macTxDropTrace(frame.packet);
+        }
+    }
+#endif
+
+    for (std::size_t i = 0; i < m_txFrames.size(); i++)
+    {
+        if (i >= nWritten)
+        {
+            m_macTxDropTrace(m_txFrames[i].packet);
+        }
+        FreeBuffer(m_txFrames[i].buffer);
+    }
+    m_txFrames.clear();
+}
+
 ssize_t
 FdNetDevice::Write(uint8_t* buffer, size_t length)
 {
@@ -25,6 +25,7 @@
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -56,6 +57,89 @@ class FdNetDeviceFdReader : public FdReader
     uint32_t m_bufferSize; //!< size of the read buffer
 };
 
+/**
+ * @ingroup fd-net-device
+ * @brief A pool of receive buffers of the same size.
+ *
+ * The buffers are allocated once and recycled, instead of being allocated
+ * by the reader thread and freed by the simulator for each frame.  Buffers
+ * can be acquired and released from any thread.
+ */
+class FdNetDeviceBufferPool : public SimpleRefCount<FdNetDeviceBufferPool>
+{
+  public:
+    /**
+     * Constructor
+     * @param bufferSize the size of the buffers
+     * @param nBuffers the number of buffers allocated in advance
+     */
+    FdNetDeviceBufferPool(size_t bufferSize, uint32_t nBuffers);
+    ~FdNetDeviceBufferPool();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    FdNetDeviceBufferPool(const FdNetDeviceBufferPool&) = delete;
+    FdNetDeviceBufferPool& operator=(const FdNetDeviceBufferPool&) = delete;
+
+    /**
+     * Get a buffer, which is allocated if the pool is empty.
+     * @return the buffer
+     */
+    uint8_t* Acquire();
+
+    /**
+     * Return a buffer to the pool.
+     * @param buf a buffer obtained from Acquire
+     */
+    void Release(uint8_t* buf);
+
+    /**
+     * @return the size of the buffers
+     */
+    size_t GetBufferSize() const;
+
+  private:
+    size_t m_bufferSize;             //!< size of the buffers
+    std::mutex m_mutex;              //!< protects m_buffers
+    std::vector<uint8_t*> m_buffers; //!< buffers available
+};
+
+/**
+ * @ingroup fd-net-device
+ * @brief This class reads several frames at once from the file descriptor.
+ *
+ * The frames available are read with a single recvmmsg() call if the file
+ * descriptor is a socket, and with successive read() calls otherwise, into
+ * buffers of a FdNetDeviceBufferPool.  They are passed together to a batch
+ * callback, and the read callback given to FdReader::Start is not used.
+ */
+class FdNetDeviceBatchFdReader : public FdReader
+{
+  public:
+    /// Frames read at once, as pairs of a buffer and a length
+    using Frames = std::vector<std::pair<uint8_t*, ssize_t>>;
+
+    /**
+     * Constructor
+     * @param pool the pool of the receive buffers
+     * @param batchSize the maximum number of frames read at once
+     * @param batchCallback the callback invoked with the frames read, which
+     *        then owns their buffers
+     */
+    FdNetDeviceBatchFdReader(Ptr<FdNetDeviceBufferPool> pool,
+                             uint32_t batchSize,
+                             Callback<void, const Frames&> batchCallback);
+    ~FdNetDeviceBatchFdReader() override;
+
+  private:
+    FdReader::Data DoRead() override;
+
+    Ptr<FdNetDeviceBufferPool> m_pool;             //!< pool of the receive buffers
+    uint32_t m_batchSize;                          //!< maximum number of frames read at once
+    Callback<void, const Frames&> m_batchCallback; //!< callback invoked with the frames read
+    std::vector<uint8_t*> m_buffers;               //!< buffers where the next frames are read
+    Frames m_frames;                               //!< frames read by the last call
+};
+
 class Node;
 
 /**
@@ -223,6 +307,13 @@ class FdNetDevice : public NetDevice
      */
     void ReceiveCallback(uint8_t* buf, ssize_t len);
 
+    /**
+     * Callback to invoke when several frames are received at once, which are
+     * forwarded up in a single event.
+     * @param frames the received frames, whose buffers come from m_rxBufferPool
+     */
+    void ReceiveBatchCallback(const FdNetDeviceBatchFdReader::Frames& frames);
+
     /**
      * Mutex to increase pending read counter.
      */
@@ -265,6 +356,31 @@ class FdNetDevice : public NetDevice
      */
     void ForwardUp();
 
+    /**
+     * Forward the next frames to the appropriate callback for processing
+     * @param nFrames the number of frames
+     */
+    void ForwardUpBatch(uint32_t nFrames);
+
+    /**
+     * Forward a frame to the appropriate callback for processing, and free
+     * its buffer.
+     * @param buf a buffer containing the frame
+     * @param len the length of the frame
+     */
+    void ForwardUpFrame(uint8_t* buf, ssize_t len);
+
+    /**
+     * Free a receive buffer, or return it to m_rxBufferPool.
+     * @param buf the buffer
+     */
+    void ReleaseRxBuffer(uint8_t* buf);
+
+    /**
+     * Write the frames waiting in m_txFrames to the file descriptor.
+     */
+    void FlushTxFrames();
+
     /**
      * Start Sending a Packet Down the Wire.
      * @param p packet to send
@@ -348,6 +464,44 @@ class FdNetDevice : public NetDevice
      */
     uint32_t m_maxPendingReads;
 
+    /**
+     * Maximum number of frames read at once from the file descriptor.
+     */
+    uint32_t m_rxBatchSize;
+
+    /**
+     * Pool of the receive buffers, when frames are read in batches.
+     */
+    Ptr<FdNetDeviceBufferPool> m_rxBufferPool;
+
+    /**
+     * Maximum number of frames written at once to the file descriptor.
+     */
+    uint32_t m_txBatchSize;
+
+    /**
+     * Whether the file descriptor is a socket.
+     */
+    bool m_fdIsSocket;
+
+    /// A frame waiting to be written to the file descriptor
+    struct TxFrame
+    {
+        uint8_t* buffer;    //!< buffer containing the frame
+        size_t length;      //!< length of the frame
+        Ptr<Packet> packet; //!< packet of the frame
+    };
+
+    /**
+     * Frames waiting to be written to the file descriptor.
+     */
+    std::vector<TxFrame> m_txFrames;
+
+    /**
+     * Event writing the frames waiting in m_txFrames.
+     */
+    EventId m_txFlushEvent;
+
     /**
      * Time to start spinning up the device
      */
@@ -13,6 +13,7 @@ cpp_examples = [
     ("fd-emu-udp-echo", "False", "True"),
     ("realtime-dummy-network", "False", "True"),
     ("fd2fd-onoff", "True", "True"),
+    ("fd2fd-batch-throughput --frames=1000", "True", "False"),
     ("fd-tap-ping", "False", "True"),
     ("realtime-fd2fd-onoff", "False", "True"),
 ]
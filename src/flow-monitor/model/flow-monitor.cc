@@ -8,10 +8,18 @@
 
 #include "flow-monitor.h"
 
+#include "flow-stats-stream-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <sstream>
@@ -70,7 +78,74 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("ExportFileName",
+                          "The name of the file to which the statistics of the flows that "
+                          "changed are periodically written; empty to disable the export. "
+                          "The file is created by the first export, after which its name "
+                          "cannot be changed.",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::SetExportFileName,
+                                             &FlowMonitor::GetExportFileName),
+                          MakeStringChecker())
+            .AddAttribute("ExportInterval",
+                          "The period of the incremental export.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportInterval),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("ExportFormat",
+                          "The encoding of the incremental export file.",
+                          EnumValue(FlowMonitor::EXPORT_XML),
+                          MakeEnumAccessor<ExportFormat>(&FlowMonitor::m_exportFormat),
+                          MakeEnumChecker(FlowMonitor::EXPORT_XML,
+                                          "Xml",
+                                          FlowMonitor::EXPORT_JSON_LINES,
+                                          "JsonLines",
+                                          FlowMonitor::EXPORT_CBOR,
+                                          "Cbor"))
+            .AddAttribute("ExportHistograms",
+                          "If true, the histograms are included in the incremental export.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_exportHistograms),
+                          MakeBooleanChecker())
+            .AddAttribute("CompactStats",
+                          "If true, no per-flow statistics are collected, neither by the "
+                          "monitor nor by the probes, so that the memory does not grow with "
+                          "the number of flows; instead, the delays are summarized in "
+                          "fixed-size sketches, globally and for each probe, and the flows "
+                          "that transmit the most bytes are tracked with a count-min sketch. "
+                          "It must be set when the monitor is created.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_compactStats),
+                          MakeBooleanChecker())
+            .AddAttribute("SketchRelativeAccuracy",
+                          "The relative accuracy of the delay quantiles in compact mode.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_sketchAccuracy),
+                          MakeDoubleChecker<double>(1e-6, 0.5))
+            .AddAttribute("SketchMaxBins",
+                          "The maximum number of bins (8 bytes each) of each delay sketch "
+                          "in compact mode.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchMaxBins),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("HeavyHitters",
+                          "The number of flows with the most transmitted bytes to report in "
+                          "compact mode.",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&FlowMonitor::m_heavyHitterCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CountMinWidth",
+                          "The number of counters (8 bytes each) in each row of the count-min "
+                          "sketch used in compact mode.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_countMinWidth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("CountMinDepth",
+                          "The number of rows of the count-min sketch used in compact mode.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&FlowMonitor::m_countMinDepth),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -81,7 +156,22 @@ FlowMonitor::GetInstanceTypeId() const
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_enabled(false),
+      m_exportFormat(EXPORT_XML),
+      m_exportHistograms(false),
+      m_compactStats(false),
+      m_sketchAccuracy(0.01),
+      m_sketchMaxBins(1024),
+      m_heavyHitterCount(0),
+      m_countMinWidth(1),
+      m_countMinDepth(1),
+      m_flowTxBytes(1, 1),
+      m_compactLostPackets(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FlowMonitor::~FlowMonitor()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,6 +182,9 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_exportEvent);
+    ExportChangedFlows();
+    m_exportWriter.reset();
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -104,14 +197,236 @@ FlowMonitor::DoDispose()
     Object::DoDispose();
 }
 
-inline FlowMonitor::FlowStats&
-FlowMonitor::GetStatsForFlow(FlowId flowId)
+/// Minimum number of slots of the ring of tracked packets of a flow
+static constexpr std::size_t MIN_RING_SLOTS = 16;
+
+/**
+ * Get the key of a packet in transit in compact mode.
+ * @param flowId the flow identification
+ * @param packetId the packet identification
+ * @return the key
+ */
+static uint64_t
+GetCompactPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+FlowMonitor::TrackedPacket*
+FlowMonitor::TrackedPacketRing::Find(FlowPacketId packetId)
+{
+    if (packetId - m_first < m_span)
+    {
+        TrackedPacket& slot = m_slots[packetId & (m_slots.size() - 1)];
+        if (slot.tracked)
+        {
+            return &slot;
+        }
+    }
+    if (m_overflow.empty())
+    {
+        return nullptr;
+    }
+    auto it = m_overflow.find(packetId);
+    return it != m_overflow.end() ? &it->second : nullptr;
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackedPacketRing::Insert(FlowPacketId packetId)
+{
+    if (TrackedPacket* packet = Find(packetId))
+    {
+        return *packet;
+    }
+    if (m_count == 0)
+    {
+        Reserve(1);
+        m_first = packetId;
+        m_span = 1;
+    }
+    else if (packetId - m_first >= m_span)
+    {
+        // extend the window towards the closest end; ids wrap around
+        uint32_t behind = m_first - packetId;
+        uint32_t ahead = packetId - (m_first + m_span) + 1;
+        if (behind < ahead)
+        {
+            Reserve(m_span + behind);
+            m_first = packetId;
+            m_span += behind;
+        }
+        else
+        {
+            Evict(packetId);
+            if (m_count == 0)
+            {
+                m_first = packetId;
+                m_span = 0;
+            }
+            uint32_t span = packetId - m_first + 1;
+            Reserve(span);
+            m_span = span;
+        }
+    }
+    TrackedPacket& slot = m_slots[packetId & (m_slots.size() - 1)];
+    slot.tracked = true;
+    m_count++;
+    return slot;
+}
+
+void
+FlowMonitor::TrackedPacketRing::Erase(FlowPacketId packetId)
+{
+    if (packetId - m_first < m_span)
+    {
+        TrackedPacket& slot = m_slots[packetId & (m_slots.size() - 1)];
+        if (slot.tracked)
+        {
+            slot.tracked = false;
+            m_count--;
+            Trim();
+            return;
+        }
+    }
+    m_overflow.erase(packetId);
+}
+
+uint32_t
+FlowMonitor::TrackedPacketRing::RemoveLost(Time now, Time maxDelay)
+{
+    uint32_t lost = 0;
+    std::size_t mask = m_slots.size() - 1;
+    for (uint32_t i = 0; i < m_span; i++)
+    {
+        TrackedPacket& slot = m_slots[(m_first + i) & mask];
+        if (slot.tracked && now - slot.lastSeenTime >= maxDelay)
+        {
+            slot.tracked = false;
+            lost++;
+        }
+    }
+    m_count -= lost;
+    if (lost > 0)
+    {
+        Trim();
+    }
+    for (auto it = m_overflow.begin(); it != m_overflow.end();)
+    {
+        if (now - it->second.lastSeenTime >= maxDelay)
+        {
+            it = m_overflow.erase(it);
+            lost++;
+        }
+        else
+        {
+            it++;
+        }
+    }
+    return lost;
+}
+
+std::size_t
+FlowMonitor::TrackedPacketRing::GetCapacity() const
+{
+    return m_slots.size();
+}
+
+std::size_t
+FlowMonitor::TrackedPacketRing::GetOverflowSize() const
+{
+    return m_overflow.size();
+}
+
+void
+FlowMonitor::TrackedPacketRing::Reserve(uint32_t span)
+{
+    if (span <= m_slots.size())
+    {
+        return;
+    }
+    std::size_t capacity = std::max(m_slots.size(), MIN_RING_SLOTS);
+    while (capacity < span)
+    {
+        capacity *= 2;
+    }
+    Reallocate(capacity);
+}
+
+void
+FlowMonitor::TrackedPacketRing::Reallocate(std::size_t capacity)
+{
+    std::vector<TrackedPacket> slots(capacity);
+    for (uint32_t i = 0; i < m_span; i++)
+    {
+        FlowPacketId packetId = m_first + i;
+        const TrackedPacket& slot = m_slots[packetId & (m_slots.size() - 1)];
+        if (slot.tracked)
+        {
+            slots[packetId & (capacity - 1)] = slot;
+        }
+    }
+    m_slots.swap(slots);
+}
+
+void
+FlowMonitor::TrackedPacketRing::Evict(FlowPacketId packetId)
+{
+    std::size_t mask = m_slots.size() - 1;
+    // the window would span the ids up to packetId, with one more tracked packet
+    while (m_count > 0 && packetId - m_first + 1 > MIN_RING_SLOTS &&
+           packetId - m_first + 1 > 4 * (m_count + 1))
+    {
+        TrackedPacket& slot = m_slots[m_first & mask];
+        m_overflow.emplace(m_first, slot);
+        slot.tracked = false;
+        m_count--;
+        // Trim() is not called, as the ring must not shrink before the window grows
+        do
+        {
+            m_first++;
+            m_span--;
+        } while (m_count > 0 && !m_slots[m_first & mask].tracked);
+    }
+}
+
+void
+FlowMonitor::TrackedPacketRing::Trim()
+{
+    if (m_count == 0)
+    {
+        m_span = 0;
+    }
+    else
+    {
+        std::size_t mask = m_slots.size() - 1;
+        while (!m_slots[m_first & mask].tracked)
+        {
+            m_first++;
+            m_span--;
+        }
+        while (!m_slots[(m_first + m_span - 1) & mask].tracked)
+        {
+            m_span--;
+        }
+    }
+    if (m_slots.size() > MIN_RING_SLOTS && 4 * m_span <= m_slots.size())
+    {
+        Reallocate(m_slots.size() / 2);
+    }
+}
+
+FlowMonitor::FlowState&
+FlowMonitor::GetFlowState(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    if (flowId >= m_flows.size())
     {
-        FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        m_flows.resize(flowId + 1);
+    }
+    FlowState& state = m_flows[flowId];
+    if (!state.active)
+    {
+        FlowMonitor::FlowStats& ref = state.stats;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -127,14 +442,74 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
-        return ref;
+        state.active = true;
+    }
+    return state;
+}
+
+void
+FlowMonitor::AddProbePacketStats(Ptr<FlowProbe> probe,
+                                 FlowId flowId,
+                                 uint32_t packetSize,
+                                 Time delayFromFirstProbe)
+{
+    if (m_compactStats)
+    {
+        probe->AddAggregatePacketStats(packetSize, delayFromFirstProbe);
     }
     else
     {
-        return iter->second;
+        probe->AddPacketStats(flowId, packetSize, delayFromFirstProbe);
+    }
+}
+
+void
+FlowMonitor::UpdateHeavyHitters(FlowId flowId, uint32_t packetSize)
+{
+    m_flowTxBytes.Add(flowId, packetSize);
+    if (m_heavyHitterCount == 0)
+    {
+        return;
+    }
+    uint64_t bytes = m_flowTxBytes.Estimate(flowId);
+    auto smallest = m_heavyHitters.end();
+    for (auto it = m_heavyHitters.begin(); it != m_heavyHitters.end(); it++)
+    {
+        if (it->first == flowId)
+        {
+            it->second = bytes;
+            return;
+        }
+        if (smallest == m_heavyHitters.end() || it->second < smallest->second)
+        {
+            smallest = it;
+        }
+    }
+    if (m_heavyHitters.size() < m_heavyHitterCount)
+    {
+        m_heavyHitters.emplace_back(flowId, bytes);
+    }
+    else if (bytes > smallest->second)
+    {
+        *smallest = std::make_pair(flowId, bytes);
     }
 }
 
+FlowMonitor::TrackedPacket*
+FlowMonitor::FindTrackedPacket(FlowId flowId, FlowPacketId packetId)
+{
+    if (m_compactStats)
+    {
+        auto it = m_compactPackets.find(GetCompactPacketKey(flowId, packetId));
+        return it != m_compactPackets.end() ? &it->second : nullptr;
+    }
+    if (flowId >= m_flows.size())
+    {
+        return nullptr;
+    }
+    return m_flows[flowId].packets.Find(packetId);
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -148,16 +523,29 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    if (m_compactStats)
+    {
+        // no state is kept for the flow, only for the packet in transit
+        TrackedPacket& tracked = m_compactPackets[GetCompactPacketKey(flowId, packetId)];
+        tracked.firstSeenTime = now;
+        tracked.lastSeenTime = tracked.firstSeenTime;
+        tracked.timesForwarded = 0;
+        AddProbePacketStats(probe, flowId, packetSize, Seconds(0));
+        UpdateHeavyHitters(flowId, packetSize);
+        return;
+    }
+    FlowState& state = GetFlowState(flowId);
+    TrackedPacket& tracked = state.packets.Insert(packetId);
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
-    probe->AddPacketStats(flowId, packetSize, Seconds(0));
+    AddProbePacketStats(probe, flowId, packetSize, Seconds(0));
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    NotifyFlowChanged(flowId, state);
+    FlowStats& stats = state.stats;
     stats.txBytes += packetSize;
     stats.txPackets++;
     if (stats.txPackets == 1)
@@ -179,20 +567,19 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    TrackedPacket* tracked = FindTrackedPacket(flowId, packetId);
+    if (tracked == nullptr)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    tracked->timesForwarded++;
+    tracked->lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    Time delay = (Simulator::Now() - tracked->firstSeenTime);
+    AddProbePacketStats(probe, flowId, packetSize, delay);
 }
 
 void
@@ -207,8 +594,8 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    TrackedPacket* tracked = FindTrackedPacket(flowId, packetId);
+    if (tracked == nullptr)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
@@ -216,10 +603,19 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    Time delay = (now - tracked->firstSeenTime);
+    AddProbePacketStats(probe, flowId, packetSize, delay);
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    if (m_compactStats)
+    {
+        m_delaySketch.AddValue(delay.GetSeconds());
+        m_compactPackets.erase(GetCompactPacketKey(flowId, packetId));
+        return;
+    }
+
+    FlowState& state = m_flows[flowId];
+    NotifyFlowChanged(flowId, state);
+    FlowStats& stats = state.stats;
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
     if (stats.rxPackets > 0)
@@ -263,12 +659,12 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked->timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    state.packets.Erase(packetId); // we don't need to track this packet anymore
 }
 
 void
@@ -285,9 +681,18 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         return;
     }
 
-    probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    if (m_compactStats)
+    {
+        probe->AddAggregatePacketDropStats(packetSize);
+        m_compactLostPackets++;
+        m_compactPackets.erase(GetCompactPacketKey(flowId, packetId));
+        return;
+    }
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    FlowState& state = GetFlowState(flowId);
+    NotifyFlowChanged(flowId, state);
+    FlowStats& stats = state.stats;
     stats.lostPackets++;
     if (stats.packetsDropped.size() < reasonCode + 1)
     {
@@ -299,20 +704,27 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    TrackedPacket* tracked = state.packets.Find(packetId);
+    if (tracked != nullptr)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        state.packets.Erase(packetId);
     }
 }
 
 const FlowMonitor::FlowStatsContainer&
 FlowMonitor::GetFlowStats() const
 {
+    for (FlowId flowId : m_staleFlows)
+    {
+        const FlowState& state = m_flows[flowId];
+        state.stale = false;
+        m_flowStats[flowId] = state.stats;
+    }
+    m_staleFlows.clear();
     return m_flowStats;
 }
 
@@ -322,21 +734,29 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    for (auto it = m_compactPackets.begin(); it != m_compactPackets.end();)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+        if (now - it->second.lastSeenTime >= maxDelay)
         {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+            m_compactLostPackets++;
+            it = m_compactPackets.erase(it);
         }
         else
         {
-            iter++;
+            it++;
+        }
+    }
+
+    for (FlowId flowId = 0; flowId < m_flows.size(); flowId++)
+    {
+        // the packets not seen for too long are considered lost, add them to the loss
+        // statistics; we won't track them anymore
+        FlowState& state = m_flows[flowId];
+        uint32_t lost = state.packets.RemoveLost(now, maxDelay);
+        if (lost > 0)
+        {
+            state.stats.lostPackets += lost;
+            NotifyFlowChanged(flowId, state);
         }
     }
 }
@@ -359,11 +779,105 @@ FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (m_compactStats)
+    {
+        m_delaySketch = QuantileSketch(m_sketchAccuracy, m_sketchMaxBins);
+        m_flowTxBytes = CountMinSketch(m_countMinWidth, m_countMinDepth);
+    }
+}
+
+void
+FlowMonitor::SetExportFileName(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    NS_ABORT_MSG_IF(m_exportWriter && fileName != m_exportFileName,
+                    "The export file " << m_exportFileName << " is already open");
+    m_exportFileName = fileName;
+    if (!m_exportFileName.empty() && !m_exportEvent.IsPending())
+    {
+        // the attributes may not be all set yet; the first export reschedules
+        // the next ones with the ExportInterval attribute
+        m_exportEvent = Simulator::ScheduleNow(&FlowMonitor::PeriodicExport, this);
+    }
+}
+
+std::string
+FlowMonitor::GetExportFileName() const
+{
+    return m_exportFileName;
+}
+
+void
+FlowMonitor::NotifyFlowChanged(FlowId flowId, FlowState& state)
+{
+    if (!state.stale)
+    {
+        state.stale = true;
+        m_staleFlows.push_back(flowId);
+    }
+    if (!m_exportFileName.empty() && !state.changed)
+    {
+        state.changed = true;
+        m_changedFlows.push_back(flowId);
+    }
+}
+
+void
+FlowMonitor::ExportChangedFlows()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_exportFileName.empty())
+    {
+        return;
+    }
+    if (!m_exportWriter)
+    {
+        // the flows that changed before the file name was set are exported as well
+        for (FlowId flowId = 0; flowId < m_flows.size(); flowId++)
+        {
+            FlowState& state = m_flows[flowId];
+            if (state.active && !state.changed)
+            {
+                state.changed = true;
+                m_changedFlows.push_back(flowId);
+            }
+        }
+    }
+    if (m_changedFlows.empty())
+    {
+        return;
+    }
+    if (!m_exportWriter)
+    {
+        m_exportWriter = std::make_unique<FlowStatsStreamWriter>();
+        m_exportWriter->Open(m_exportFileName, m_exportFormat, m_exportHistograms);
+    }
+    std::sort(m_changedFlows.begin(), m_changedFlows.end());
+    m_exportWriter->BeginSnapshot(Simulator::Now());
+    for (FlowId flowId : m_changedFlows)
+    {
+        FlowState& state = m_flows[flowId];
+        state.changed = false;
+        m_exportWriter->WriteFlow(flowId, state.stats);
+    }
+    m_exportWriter->EndSnapshot();
+    m_changedFlows.clear();
+}
+
+void
+FlowMonitor::PeriodicExport()
+{
+    ExportChangedFlows();
+    m_exportEvent = Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExport, this);
 }
 
 void
 FlowMonitor::AddProbe(Ptr<FlowProbe> probe)
 {
+    if (m_compactStats)
+    {
+        probe->ResetAggregateStats(m_sketchAccuracy, m_sketchMaxBins);
+    }
     m_flowProbes.push_back(probe);
 }
 
@@ -373,6 +887,22 @@ FlowMonitor::GetAllProbes() const
     return m_flowProbes;
 }
 
+const QuantileSketch&
+FlowMonitor::GetDelaySketch() const
+{
+    return m_delaySketch;
+}
+
+FlowMonitor::HeavyHitterContainer
+FlowMonitor::GetHeavyHitters() const
+{
+    HeavyHitterContainer heavyHitters = m_heavyHitters;
+    std::sort(heavyHitters.begin(), heavyHitters.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    return heavyHitters;
+}
+
 void
 FlowMonitor::Start(const Time& time)
 {
@@ -440,53 +970,37 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent += 2;
     os << std::string(indent, ' ') << "<FlowStats>\n";
     indent += 2;
-    for (auto flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++)
-    {
-        os << std::string(indent, ' ');
-#define ATTRIB(name) " " #name "=\"" << flowI->second.name << "\""
-#define ATTRIB_TIME(name) " " #name "=\"" << flowI->second.name.As(Time::NS) << "\""
-        os << "<Flow flowId=\"" << flowI->first << "\"" << ATTRIB_TIME(timeFirstTxPacket)
-           << ATTRIB_TIME(timeFirstRxPacket) << ATTRIB_TIME(timeLastTxPacket)
-           << ATTRIB_TIME(timeLastRxPacket) << ATTRIB_TIME(delaySum) << ATTRIB_TIME(jitterSum)
-           << ATTRIB_TIME(lastDelay) << ATTRIB_TIME(maxDelay) << ATTRIB_TIME(minDelay)
-           << ATTRIB(txBytes) << ATTRIB(rxBytes) << ATTRIB(txPackets) << ATTRIB(rxPackets)
-           << ATTRIB(lostPackets) << ATTRIB(timesForwarded) << ">\n";
-#undef ATTRIB_TIME
-#undef ATTRIB
-
-        indent += 2;
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.packetsDropped.size();
-             reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-               << " number=\"" << flowI->second.packetsDropped[reasonCode] << "\" />\n";
-        }
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.bytesDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-               << " bytes=\"" << flowI->second.bytesDropped[reasonCode] << "\" />\n";
-        }
-        if (enableHistograms)
+    for (FlowId flowId = 0; flowId < m_flows.size(); flowId++)
+    {
+        if (m_flows[flowId].active)
         {
-            flowI->second.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
-            flowI->second.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
-            flowI->second.packetSizeHistogram.SerializeToXmlStream(os,
-                                                                   indent,
-                                                                   "packetSizeHistogram");
-            flowI->second.flowInterruptionsHistogram.SerializeToXmlStream(
-                os,
-                indent,
-                "flowInterruptionsHistogram");
+            FlowStatsStreamWriter::SerializeFlowToXmlStream(os,
+                                                            indent,
+                                                            flowId,
+                                                            m_flows[flowId].stats,
+                                                            enableHistograms);
         }
-        indent -= 2;
-
-        os << std::string(indent, ' ') << "</Flow>\n";
     }
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_compactStats)
+    {
+        os << std::string(indent, ' ') << "<CompactStats"
+           << " rxPackets=\"" << m_delaySketch.GetCount() << "\""
+           << " lostPackets=\"" << m_compactLostPackets << "\""
+           << " delayP50=\"" << Seconds(m_delaySketch.GetQuantile(0.5)).As(Time::NS) << "\""
+           << " delayP99=\"" << Seconds(m_delaySketch.GetQuantile(0.99)).As(Time::NS) << "\""
+           << " delayMax=\"" << Seconds(m_delaySketch.GetMax()).As(Time::NS) << "\""
+           << ">\n";
+        for (const auto& [flowId, txBytes] : GetHeavyHitters())
+        {
+            os << std::string(indent + 2, ' ') << "<HeavyHitter flowId=\"" << flowId << "\""
+               << " txBytes=\"" << txBytes << "\" />\n";
+        }
+        os << std::string(indent, ' ') << "</CompactStats>\n";
+    }
+
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         (*iter)->SerializeToXmlStream(os, indent);
@@ -532,9 +1046,15 @@ FlowMonitor::ResetAllStats()
 {
     NS_LOG_FUNCTION(this);
 
-    for (auto& iter : m_flowStats)
+    for (FlowId flowId = 0; flowId < m_flows.size(); flowId++)
     {
-        auto& flowStat = iter.second;
+        FlowState& state = m_flows[flowId];
+        if (!state.active)
+        {
+            continue;
+        }
+        NotifyFlowChanged(flowId, state);
+        auto& flowStat = state.stats;
         flowStat.delaySum = Seconds(0);
         flowStat.jitterSum = Seconds(0);
         flowStat.lastDelay = Seconds(0);
@@ -554,6 +1074,18 @@ FlowMonitor::ResetAllStats()
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
     }
+
+    if (m_compactStats)
+    {
+        m_delaySketch.Clear();
+        m_compactLostPackets = 0;
+        m_flowTxBytes.Clear();
+        m_heavyHitters.clear();
+        for (auto& probe : m_flowProbes)
+        {
+            probe->ResetAggregateStats(m_sketchAccuracy, m_sketchMaxBins);
+        }
+    }
 }
 
 } // namespace ns3
@@ -12,18 +12,30 @@
 #include "flow-classifier.h"
 #include "flow-probe.h"
 
+#include "ns3/count-min-sketch.h"
 #include "ns3/event-id.h"
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/quantile-sketch.h"
 
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+/// Testcase for the tracking of the packets in transit
+class FlowMonitorTrackedPacketsTestCase;
+/// Testcase for the compact statistics
+class FlowMonitorCompactStatsTestCase;
+
 namespace ns3
 {
 
+class FlowStatsStreamWriter;
+
 /**
  * @defgroup flow-monitor Flow Monitor
  * @brief  Collect and store performance data from a simulation
@@ -39,6 +51,12 @@ namespace ns3
  */
 class FlowMonitor : public Object
 {
+    /**
+     * Declared friend to enable unit tests.
+     */
+    friend class ::FlowMonitorTrackedPacketsTestCase;
+    friend class ::FlowMonitorCompactStatsTestCase;
+
   public:
     /// @brief Structure that represents the measured metrics of an individual packet flow
     struct FlowStats
@@ -131,6 +149,14 @@ class FlowMonitor : public Object
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
     };
 
+    /// Encoding of the incremental export file
+    enum ExportFormat
+    {
+        EXPORT_XML,        //!< XML snapshots
+        EXPORT_JSON_LINES, //!< One JSON object per flow and snapshot
+        EXPORT_CBOR        //!< One CBOR map per flow and snapshot
+    };
+
     // --- basic methods ---
     /**
      * @brief Get the type ID.
@@ -139,6 +165,7 @@ class FlowMonitor : public Object
     static TypeId GetTypeId();
     TypeId GetInstanceTypeId() const override;
     FlowMonitor();
+    ~FlowMonitor() override;
 
     /// Add a FlowClassifier to be used by the flow monitor.
     /// @param classifier the FlowClassifier
@@ -237,6 +264,12 @@ class FlowMonitor : public Object
     /// FlowMonitor has not stopped monitoring yet, you should call
     /// CheckForLostPackets() to make sure all possibly lost packets are
     /// accounted for.
+    ///
+    /// The statistics are kept per flow while the simulation runs.  The
+    /// returned container is a snapshot, which is not updated by later
+    /// reports; each call copies in it the statistics of the flows that
+    /// changed since the previous call, and leaves the others untouched.
+    /// It is empty when the CompactStats attribute is enabled.
     /// @returns the flows statistics
     const FlowStatsContainer& GetFlowStats() const;
 
@@ -244,6 +277,22 @@ class FlowMonitor : public Object
     /// @returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
 
+    /// Container: (FlowId, estimated transmitted bytes)
+    typedef std::vector<std::pair<FlowId, uint64_t>> HeavyHitterContainer;
+
+    /// Get the distribution of the end-to-end delays (in seconds) of all the
+    /// received packets.  It is only collected when the CompactStats
+    /// attribute is enabled.
+    /// @returns the delay sketch
+    const QuantileSketch& GetDelaySketch() const;
+
+    /// Get the flows that transmitted the most bytes, ordered by decreasing
+    /// number of bytes.  They are only collected when the CompactStats
+    /// attribute is enabled, and the number of bytes is estimated with a
+    /// count-min sketch, so it may be slightly larger than the exact one.
+    /// @returns the heavy hitter flows
+    HeavyHitterContainer GetHeavyHitters() const;
+
     /// Serializes the results to an std::ostream in XML format
     /// @param os the output stream
     /// @param indent number of spaces to use as base indentation level
@@ -270,6 +319,15 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// Write the statistics of the flows that changed since the previous
+    /// call to the export file, if one was set with the ExportFileName
+    /// attribute.  The file is created by the first call that writes
+    /// statistics, with the encoding set by the ExportFormat and
+    /// ExportHistograms attributes at that time.  This method is called
+    /// periodically, with the period set by the ExportInterval attribute,
+    /// and when the monitor is disposed.
+    void ExportChangedFlows();
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -281,14 +339,109 @@ class FlowMonitor : public Object
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+        bool tracked{false};     //!< true if the packet is being tracked
     };
 
-    /// FlowId --> FlowStats
-    FlowStatsContainer m_flowStats;
+    /**
+     * The packets of a flow that are being tracked, indexed by packet id.
+     *
+     * The classifiers number the packets of each flow sequentially, so the
+     * packets in transit span a narrow window of ids.  They are stored in a
+     * ring whose capacity is a power of two, at the slot given by the packet
+     * id modulo the capacity; the ring grows when the window does not fit,
+     * and shrinks when the window uses a quarter of it.
+     *
+     * A packet that stays in transit much longer than the next ones, e.g.,
+     * a lost packet, would keep the start of the window while the later
+     * packets are received.  When fewer than a quarter of the ids of the
+     * window are tracked, the first packets of the window are moved to an
+     * overflow map, so that the window only spans the recent packets.
+     */
+    class TrackedPacketRing
+    {
+      public:
+        /**
+         * Find a tracked packet.
+         * @param packetId the packet id
+         * @return the packet, or nullptr if it is not tracked
+         */
+        TrackedPacket* Find(FlowPacketId packetId);
+        /**
+         * Start tracking a packet; if it is already tracked, the existing
+         * entry is returned.
+         * @param packetId the packet id
+         * @return the packet
+         */
+        TrackedPacket& Insert(FlowPacketId packetId);
+        /**
+         * Stop tracking a packet.
+         * @param packetId the id of a tracked packet
+         */
+        void Erase(FlowPacketId packetId);
+        /**
+         * Stop tracking the packets that have not been seen for a while.
+         * @param now the current time
+         * @param maxDelay the time after which a packet is considered lost
+         * @return the number of packets no longer tracked
+         */
+        uint32_t RemoveLost(Time now, Time maxDelay);
+
+        /**
+         * Get the number of slots of the ring.
+         * @return the capacity of the ring
+         */
+        std::size_t GetCapacity() const;
+        /**
+         * Get the number of packets stored out of the ring.
+         * @return the number of packets in the overflow map
+         */
+        std::size_t GetOverflowSize() const;
+
+      private:
+        /**
+         * Make room for a window of packet ids.
+         * @param span the number of ids in the window
+         */
+        void Reserve(uint32_t span);
+        /**
+         * Move the packets of the window to a ring of a given capacity.
+         * @param capacity the new capacity, a power of two that fits the window
+         */
+        void Reallocate(std::size_t capacity);
+        /**
+         * Move the first packets of the window to the overflow map while the
+         * window is sparse.
+         * @param packetId the id of the packet about to be added after the window
+         */
+        void Evict(FlowPacketId packetId);
+        /// Shrink the window to the first and last tracked packets, and the
+        /// ring if the window uses a quarter of it
+        void Trim();
+
+        std::vector<TrackedPacket> m_slots; //!< the ring; its size is a power of two
+        FlowPacketId m_first{0};            //!< id of the first packet of the window
+        uint32_t m_span{0};                 //!< number of ids in the window
+        uint32_t m_count{0};                //!< number of tracked packets in the ring
+        /// packets moved out of the window
+        std::unordered_map<FlowPacketId, TrackedPacket> m_overflow;
+    };
+
+    /// State kept for each flow
+    struct FlowState
+    {
+        bool active{false};        //!< true once the flow has been reported
+        bool changed{false};       //!< true if the stats changed since the last export
+        mutable bool stale{false}; //!< true if the stats changed since the last snapshot
+        FlowStats stats;           //!< the flow statistics
+        TrackedPacketRing packets; //!< the packets of the flow in transit
+    };
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
+    /// FlowId --> FlowState; the flow ids are allocated sequentially by the classifiers
+    std::vector<FlowState> m_flows;
+    /// FlowId --> FlowStats, the snapshot updated from m_flows by GetFlowStats()
+    mutable FlowStatsContainer m_flowStats;
+    /// Flows changed since the last snapshot
+    mutable std::vector<FlowId> m_staleFlows;
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
 
@@ -297,6 +450,7 @@ class FlowMonitor : public Object
 
     EventId m_startEvent;               //!< Start event
     EventId m_stopEvent;                //!< Stop event
+    EventId m_exportEvent;              //!< Next incremental export event
     bool m_enabled;                     //!< FlowMon is enabled
     double m_delayBinWidth;             //!< Delay bin width (for histograms)
     double m_jitterBinWidth;            //!< Jitter bin width (for histograms)
@@ -304,13 +458,70 @@ class FlowMonitor : public Object
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
 
-    /// Get the stats for a given flow
+    std::string m_exportFileName;                          //!< Incremental export file name
+    Time m_exportInterval;                                 //!< Incremental export period
+    ExportFormat m_exportFormat;                           //!< Incremental export encoding
+    bool m_exportHistograms;                               //!< Export also the histograms
+    std::unique_ptr<FlowStatsStreamWriter> m_exportWriter; //!< Incremental export writer
+    std::vector<FlowId> m_changedFlows;                    //!< Flows changed since the last export
+
+    bool m_compactStats;                 //!< Collect sketches instead of histograms
+    double m_sketchAccuracy;             //!< Relative accuracy of the delay sketches
+    uint32_t m_sketchMaxBins;            //!< Maximum number of bins of the delay sketches
+    uint32_t m_heavyHitterCount;         //!< Number of heavy hitter flows to keep
+    uint32_t m_countMinWidth;            //!< Width of the flow bytes count-min sketch
+    uint32_t m_countMinDepth;            //!< Depth of the flow bytes count-min sketch
+    QuantileSketch m_delaySketch;        //!< End-to-end delays of all the flows
+    CountMinSketch m_flowTxBytes;        //!< Transmitted bytes by flow
+    HeavyHitterContainer m_heavyHitters; //!< Flows with the most transmitted bytes
+    uint64_t m_compactLostPackets;       //!< Packets lost or dropped in compact mode
+    /// (FlowId << 32 | FlowPacketId) --> packet in transit, in compact mode
+    std::unordered_map<uint64_t, TrackedPacket> m_compactPackets;
+
+    /// Get the state of a given flow, initializing it if needed
+    /// @param flowId the Flow identification
+    /// @returns the state of the flow
+    FlowState& GetFlowState(FlowId flowId);
+
+    /// Find a tracked packet
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet ID
+    /// @returns the packet, or nullptr if it is not tracked
+    TrackedPacket* FindTrackedPacket(FlowId flowId, FlowPacketId packetId);
+
+    /// Record that the stats of a flow changed, for the snapshot and the
+    /// incremental export
     /// @param flowId the Flow identification
-    /// @returns the stats of the flow
-    FlowStats& GetStatsForFlow(FlowId flowId);
+    /// @param state the state of the flow
+    void NotifyFlowChanged(FlowId flowId, FlowState& state);
+
+    /// Record a packet seen by a probe, in its per-flow or aggregate stats
+    /// @param probe the reporting probe
+    /// @param flowId the Flow identification
+    /// @param packetSize the packet size
+    /// @param delayFromFirstProbe the delay from the first probe
+    void AddProbePacketStats(Ptr<FlowProbe> probe,
+                             FlowId flowId,
+                             uint32_t packetSize,
+                             Time delayFromFirstProbe);
+
+    /// Update the heavy hitter flows after a transmission
+    /// @param flowId the Flow identification
+    /// @param packetSize the packet size
+    void UpdateHeavyHitters(FlowId flowId, uint32_t packetSize);
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Periodic function to export the flows that changed
+    void PeriodicExport();
+
+    /// Set the name of the incremental export file
+    /// @param fileName the file name, empty to disable the export
+    void SetExportFileName(std::string fileName);
+    /// Get the name of the incremental export file
+    /// @return the file name
+    std::string GetExportFileName() const;
 };
 
 } // namespace ns3
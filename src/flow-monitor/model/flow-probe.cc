@@ -64,12 +64,40 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
     flow.bytesDropped[reasonCode] += packetSize;
 }
 
+void
+FlowProbe::AddAggregatePacketStats(uint32_t packetSize, Time delayFromFirstProbe)
+{
+    m_aggregateStats.delayFromFirstProbe.AddValue(delayFromFirstProbe.GetSeconds());
+    m_aggregateStats.bytes += packetSize;
+    ++m_aggregateStats.packets;
+}
+
+void
+FlowProbe::AddAggregatePacketDropStats(uint32_t packetSize)
+{
+    m_aggregateStats.bytesDropped += packetSize;
+    ++m_aggregateStats.packetsDropped;
+}
+
+void
+FlowProbe::ResetAggregateStats(double relativeAccuracy, uint32_t maxBins)
+{
+    m_aggregateStats = AggregateStats();
+    m_aggregateStats.delayFromFirstProbe = QuantileSketch(relativeAccuracy, maxBins);
+}
+
 FlowProbe::Stats
 FlowProbe::GetStats() const
 {
     return m_stats;
 }
 
+const FlowProbe::AggregateStats&
+FlowProbe::GetAggregateStats() const
+{
+    return m_aggregateStats;
+}
+
 void
 FlowProbe::SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t index) const
 {
@@ -102,6 +130,20 @@ FlowProbe::SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t inde
         indent -= 2;
         os << std::string(indent, ' ') << "</FlowStats>\n";
     }
+    if (m_aggregateStats.packets > 0 || m_aggregateStats.packetsDropped > 0)
+    {
+        const QuantileSketch& delay = m_aggregateStats.delayFromFirstProbe;
+        os << std::string(indent, ' ');
+        os << "<AggregateStats"
+           << " packets=\"" << m_aggregateStats.packets << "\""
+           << " bytes=\"" << m_aggregateStats.bytes << "\""
+           << " packetsDropped=\"" << m_aggregateStats.packetsDropped << "\""
+           << " bytesDropped=\"" << m_aggregateStats.bytesDropped << "\""
+           << " delayFromFirstProbeP50=\"" << Seconds(delay.GetQuantile(0.5)).As(Time::NS) << "\""
+           << " delayFromFirstProbeP99=\"" << Seconds(delay.GetQuantile(0.99)).As(Time::NS)
+           << "\""
+           << " />\n";
+    }
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowProbe>\n";
 }
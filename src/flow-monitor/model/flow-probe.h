@@ -13,6 +13,7 @@
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/quantile-sketch.h"
 
 #include <map>
 #include <vector>
@@ -71,6 +72,23 @@ class FlowProbe : public Object
     /// Container to map FlowId -> FlowStats
     typedef std::map<FlowId, FlowStats> Stats;
 
+    /// Structure to hold the statistics of all the flows seen by the
+    /// probe, kept instead of the per-flow statistics when the
+    /// FlowMonitor CompactStats attribute is enabled
+    struct AggregateStats
+    {
+        /// Number of packets seen
+        uint64_t packets{0};
+        /// Number of bytes seen
+        uint64_t bytes{0};
+        /// Number of packets dropped
+        uint64_t packetsDropped{0};
+        /// Number of bytes dropped
+        uint64_t bytesDropped{0};
+        /// Distribution of the delays (in seconds) from the first probe
+        QuantileSketch delayFromFirstProbe;
+    };
+
     /// Add a packet data to the flow stats
     /// @param flowId the flow Identifier
     /// @param packetSize the packet size
@@ -82,12 +100,29 @@ class FlowProbe : public Object
     /// @param reasonCode reason code for the drop
     void AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode);
 
+    /// Add a packet data to the aggregate stats
+    /// @param packetSize the packet size
+    /// @param delayFromFirstProbe packet delay
+    void AddAggregatePacketStats(uint32_t packetSize, Time delayFromFirstProbe);
+    /// Add a packet drop data to the aggregate stats
+    /// @param packetSize the packet size
+    void AddAggregatePacketDropStats(uint32_t packetSize);
+    /// Clear the aggregate stats and set the parameters of their delay sketch
+    /// @param relativeAccuracy the relative accuracy of the delay quantiles
+    /// @param maxBins the maximum number of bins of the delay sketch
+    void ResetAggregateStats(double relativeAccuracy, uint32_t maxBins);
+
     /// Get the partial flow statistics stored in this probe.  With this
     /// information you can, for example, find out what is the delay
     /// from the first probe to this one.
     /// @returns the partial flow statistics
     Stats GetStats() const;
 
+    /// Get the statistics of all the flows seen by this probe, which are
+    /// collected only in the compact mode of the FlowMonitor.
+    /// @returns the aggregate statistics
+    const AggregateStats& GetAggregateStats() const;
+
     /// Serializes the results to an std::ostream in XML format
     /// @param os the output stream
     /// @param indent number of spaces to use as base indentation level
@@ -95,8 +130,9 @@ class FlowProbe : public Object
     void SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t index) const;
 
   protected:
-    Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
-    Stats m_stats;                  //!< The flow stats
+    Ptr<FlowMonitor> m_flowMonitor;  //!< the FlowMonitor instance
+    Stats m_stats;                   //!< The flow stats
+    AggregateStats m_aggregateStats; //!< The stats of all the flows
 };
 
 } // namespace ns3
@@ -0,0 +1,383 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "flow-stats-stream-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FlowStatsStreamWriter");
+
+namespace
+{
+
+/// CBOR major types (RFC 8949, Section 3.1)
+enum CborMajorType : uint8_t
+{
+    CBOR_UNSIGNED = 0, //!< unsigned integer
+    CBOR_NEGATIVE = 1, //!< negative integer
+    CBOR_TEXT = 3,     //!< text string
+    CBOR_ARRAY = 4,    //!< array of data items
+    CBOR_MAP = 5,      //!< map of pairs of data items
+    CBOR_SIMPLE = 7    //!< floating point numbers and simple values
+};
+
+/// Number of pairs in the CBOR map of a flow, without the histograms
+constexpr uint64_t CBOR_FLOW_PAIRS = 19;
+
+/// Number of histograms in a flow
+constexpr uint64_t FLOW_HISTOGRAMS = 4;
+
+} // namespace
+
+FlowStatsStreamWriter::FlowStatsStreamWriter()
+    : m_format(FlowMonitor::EXPORT_XML),
+      m_enableHistograms(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FlowStatsStreamWriter::~FlowStatsStreamWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+FlowStatsStreamWriter::Open(const std::string& fileName,
+                            FlowMonitor::ExportFormat format,
+                            bool enableHistograms)
+{
+    NS_LOG_FUNCTION(this << fileName << format << enableHistograms);
+    Close();
+    m_os.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_os.is_open(), "Unable to open flow statistics file " << fileName);
+    m_format = format;
+    m_enableHistograms = enableHistograms;
+    if (m_format == FlowMonitor::EXPORT_XML)
+    {
+        m_os << "<?xml version=\"1.0\" ?>\n<FlowMonitorStream>\n";
+        m_os.flush();
+    }
+}
+
+void
+FlowStatsStreamWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_os.is_open())
+    {
+        return;
+    }
+    if (m_format == FlowMonitor::EXPORT_XML)
+    {
+        m_os << "</FlowMonitorStream>\n";
+    }
+    m_os.close();
+}
+
+bool
+FlowStatsStreamWriter::IsOpen() const
+{
+    return m_os.is_open();
+}
+
+void
+FlowStatsStreamWriter::BeginSnapshot(Time time)
+{
+    NS_LOG_FUNCTION(this << time);
+    NS_ASSERT(m_os.is_open());
+    m_snapshotTime = time;
+    if (m_format == FlowMonitor::EXPORT_XML)
+    {
+        m_os << "  <Snapshot time=\"" << time.As(Time::NS) << "\">\n";
+    }
+}
+
+void
+FlowStatsStreamWriter::WriteFlow(FlowId flowId, const FlowMonitor::FlowStats& stats)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    switch (m_format)
+    {
+    case FlowMonitor::EXPORT_XML:
+        SerializeFlowToXmlStream(m_os, 4, flowId, stats, m_enableHistograms);
+        break;
+    case FlowMonitor::EXPORT_JSON_LINES:
+        WriteJsonFlow(flowId, stats);
+        break;
+    case FlowMonitor::EXPORT_CBOR:
+        WriteCborFlow(flowId, stats);
+        break;
+    }
+}
+
+void
+FlowStatsStreamWriter::EndSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_format == FlowMonitor::EXPORT_XML)
+    {
+        m_os << "  </Snapshot>\n";
+    }
+    m_os.flush();
+}
+
+void
+FlowStatsStreamWriter::SerializeFlowToXmlStream(std::ostream& os,
+                                                uint16_t indent,
+                                                FlowId flowId,
+                                                const FlowMonitor::FlowStats& stats,
+                                                bool enableHistograms)
+{
+    os << std::string(indent, ' ');
+#define ATTRIB(name) " " #name "=\"" << stats.name << "\""
+#define ATTRIB_TIME(name) " " #name "=\"" << stats.name.As(Time::NS) << "\""
+    os << "<Flow flowId=\"" << flowId << "\"" << ATTRIB_TIME(timeFirstTxPacket)
+       << ATTRIB_TIME(timeFirstRxPacket) << ATTRIB_TIME(timeLastTxPacket)
+       << ATTRIB_TIME(timeLastRxPacket) << ATTRIB_TIME(delaySum) << ATTRIB_TIME(jitterSum)
+       << ATTRIB_TIME(lastDelay) << ATTRIB_TIME(maxDelay) << ATTRIB_TIME(minDelay)
+       << ATTRIB(txBytes) << ATTRIB(rxBytes) << ATTRIB(txPackets) << ATTRIB(rxPackets)
+       << ATTRIB(lostPackets) << ATTRIB(timesForwarded) << ">\n";
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    indent += 2;
+    for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+           << " number=\"" << stats.packetsDropped[reasonCode] << "\" />\n";
+    }
+    for (uint32_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+           << " bytes=\"" << stats.bytesDropped[reasonCode] << "\" />\n";
+    }
+    if (enableHistograms)
+    {
+        stats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+        stats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+        stats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
+        stats.flowInterruptionsHistogram.SerializeToXmlStream(os,
+                                                              indent,
+                                                              "flowInterruptionsHistogram");
+    }
+    indent -= 2;
+
+    os << std::string(indent, ' ') << "</Flow>\n";
+}
+
+void
+FlowStatsStreamWriter::WriteJsonFlow(FlowId flowId, const FlowMonitor::FlowStats& stats)
+{
+#define ATTRIB(name) ",\"" #name "\":" << stats.name
+#define ATTRIB_TIME(name) ",\"" #name "\":" << stats.name.GetNanoSeconds()
+    m_os << "{\"time\":" << m_snapshotTime.GetNanoSeconds() << ",\"flowId\":" << flowId
+         << ATTRIB_TIME(timeFirstTxPacket) << ATTRIB_TIME(timeFirstRxPacket)
+         << ATTRIB_TIME(timeLastTxPacket) << ATTRIB_TIME(timeLastRxPacket)
+         << ATTRIB_TIME(delaySum) << ATTRIB_TIME(jitterSum) << ATTRIB_TIME(lastDelay)
+         << ATTRIB_TIME(maxDelay) << ATTRIB_TIME(minDelay) << ATTRIB(txBytes) << ATTRIB(rxBytes)
+         << ATTRIB(txPackets) << ATTRIB(rxPackets) << ATTRIB(lostPackets)
+         << ATTRIB(timesForwarded);
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    m_os << ",\"packetsDropped\":[";
+    for (std::size_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+    {
+        m_os << (reasonCode > 0 ? "," : "") << stats.packetsDropped[reasonCode];
+    }
+    m_os << "],\"bytesDropped\":[";
+    for (std::size_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++)
+    {
+        m_os << (reasonCode > 0 ? "," : "") << stats.bytesDropped[reasonCode];
+    }
+    m_os << "]";
+
+    if (m_enableHistograms)
+    {
+        m_os << ",\"delayHistogram\":";
+        WriteJsonHistogram(stats.delayHistogram);
+        m_os << ",\"jitterHistogram\":";
+        WriteJsonHistogram(stats.jitterHistogram);
+        m_os << ",\"packetSizeHistogram\":";
+        WriteJsonHistogram(stats.packetSizeHistogram);
+        m_os << ",\"flowInterruptionsHistogram\":";
+        WriteJsonHistogram(stats.flowInterruptionsHistogram);
+    }
+    m_os << "}\n";
+}
+
+void
+FlowStatsStreamWriter::WriteJsonHistogram(const Histogram& histogram)
+{
+    m_os << "{\"binWidth\":" << histogram.GetBinWidth(0) << ",\"bins\":[";
+    bool first = true;
+    for (uint32_t index = 0; index < histogram.GetNBins(); index++)
+    {
+        uint32_t count = histogram.GetBinCount(index);
+        if (count > 0)
+        {
+            m_os << (first ? "" : ",") << "[" << index << "," << count << "]";
+            first = false;
+        }
+    }
+    m_os << "]}";
+}
+
+void
+FlowStatsStreamWriter::WriteCborFlow(FlowId flowId, const FlowMonitor::FlowStats& stats)
+{
+    WriteCborHead(CBOR_MAP, CBOR_FLOW_PAIRS + (m_enableHistograms ? FLOW_HISTOGRAMS : 0));
+    WriteCborText("time");
+    WriteCborInt(m_snapshotTime.GetNanoSeconds());
+    WriteCborText("flowId");
+    WriteCborInt(flowId);
+#define ATTRIB(name)                                                                               \
+    WriteCborText(#name);                                                                          \
+    WriteCborInt(stats.name)
+#define ATTRIB_TIME(name)                                                                          \
+    WriteCborText(#name);                                                                          \
+    WriteCborInt(stats.name.GetNanoSeconds())
+    ATTRIB_TIME(timeFirstTxPacket);
+    ATTRIB_TIME(timeFirstRxPacket);
+    ATTRIB_TIME(timeLastTxPacket);
+    ATTRIB_TIME(timeLastRxPacket);
+    ATTRIB_TIME(delaySum);
+    ATTRIB_TIME(jitterSum);
+    ATTRIB_TIME(lastDelay);
+    ATTRIB_TIME(maxDelay);
+    ATTRIB_TIME(minDelay);
+    ATTRIB(txBytes);
+    ATTRIB(rxBytes);
+    ATTRIB(txPackets);
+    ATTRIB(rxPackets);
+    ATTRIB(lostPackets);
+    ATTRIB(timesForwarded);
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    WriteCborText("packetsDropped");
+    WriteCborHead(CBOR_ARRAY, stats.packetsDropped.size());
+    for (auto packets : stats.packetsDropped)
+    {
+        WriteCborInt(packets);
+    }
+    WriteCborText("bytesDropped");
+    WriteCborHead(CBOR_ARRAY, stats.bytesDropped.size());
+    for (auto bytes : stats.bytesDropped)
+    {
+        WriteCborInt(static_cast<int64_t>(bytes));
+    }
+
+    if (m_enableHistograms)
+    {
+        WriteCborText("delayHistogram");
+        WriteCborHistogram(stats.delayHistogram);
+        WriteCborText("jitterHistogram");
+        WriteCborHistogram(stats.jitterHistogram);
+        WriteCborText("packetSizeHistogram");
+        WriteCborHistogram(stats.packetSizeHistogram);
+        WriteCborText("flowInterruptionsHistogram");
+        WriteCborHistogram(stats.flowInterruptionsHistogram);
+    }
+}
+
+void
+FlowStatsStreamWriter::WriteCborHistogram(const Histogram& histogram)
+{
+    uint64_t nonEmpty = 0;
+    for (uint32_t index = 0; index < histogram.GetNBins(); index++)
+    {
+        nonEmpty += (histogram.GetBinCount(index) > 0);
+    }
+    WriteCborHead(CBOR_MAP, 2);
+    WriteCborText("binWidth");
+    WriteCborDouble(histogram.GetBinWidth(0));
+    WriteCborText("bins");
+    WriteCborHead(CBOR_ARRAY, nonEmpty);
+    for (uint32_t index = 0; index < histogram.GetNBins(); index++)
+    {
+        uint32_t count = histogram.GetBinCount(index);
+        if (count > 0)
+        {
+            WriteCborHead(CBOR_ARRAY, 2);
+            WriteCborInt(index);
+            WriteCborInt(count);
+        }
+    }
+}
+
+void
+FlowStatsStreamWriter::WriteCborHead(uint8_t majorType, uint64_t value)
+{
+    char buffer[9];
+    std::size_t size;
+    uint8_t initial = majorType << 5;
+    if (value < 24)
+    {
+        buffer[0] = static_cast<char>(initial | value);
+        size = 1;
+    }
+    else
+    {
+        // additional information 24..27 for 1, 2, 4 and 8 bytes arguments
+        uint8_t log2Bytes = (value <= 0xff)         ? 0
+                            : (value <= 0xffff)     ? 1
+                            : (value <= 0xffffffff) ? 2
+                                                    : 3;
+        std::size_t bytes = std::size_t{1} << log2Bytes;
+        buffer[0] = static_cast<char>(initial | (24 + log2Bytes));
+        for (std::size_t i = 0; i < bytes; i++)
+        {
+            buffer[bytes - i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+        size = 1 + bytes;
+    }
+    m_os.write(buffer, size);
+}
+
+void
+FlowStatsStreamWriter::WriteCborInt(int64_t value)
+{
+    if (value >= 0)
+    {
+        WriteCborHead(CBOR_UNSIGNED, static_cast<uint64_t>(value));
+    }
+    else
+    {
+        // negative integers are encoded as -1 - n
+        WriteCborHead(CBOR_NEGATIVE, static_cast<uint64_t>(-(value + 1)));
+    }
+}
+
+void
+FlowStatsStreamWriter::WriteCborDouble(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    char buffer[9];
+    buffer[0] = static_cast<char>((CBOR_SIMPLE << 5) | 27);
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        buffer[8 - i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+    }
+    m_os.write(buffer, sizeof(buffer));
+}
+
+void
+FlowStatsStreamWriter::WriteCborText(const std::string& text)
+{
+    WriteCborHead(CBOR_TEXT, text.size());
+    m_os.write(text.data(), text.size());
+}
+
+} // namespace ns3
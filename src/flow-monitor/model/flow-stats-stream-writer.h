@@ -0,0 +1,158 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef FLOW_STATS_STREAM_WRITER_H
+#define FLOW_STATS_STREAM_WRITER_H
+
+#include "flow-monitor.h"
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup flow-monitor
+ * @brief Writes flow statistics records to a file as they are produced
+ *
+ * The writer appends snapshots of the statistics of some flows to a file,
+ * without keeping any of them in memory, and flushes the file after each
+ * snapshot so that external tools can follow it while the simulation runs.
+ * Three encodings are supported:
+ *
+ * - XML: a `FlowMonitorStream` document with a `Snapshot` element per
+ *   snapshot, holding `Flow` elements in the same form used by
+ *   FlowMonitor::SerializeToXmlStream.  The root element is closed by
+ *   Close().
+ * - JSON Lines: a JSON object per line for each flow of each snapshot.
+ * - CBOR: a sequence of CBOR (\RFC{8949}) maps, one for each flow of each
+ *   snapshot, as defined by \RFC{8742}, with the same keys as the JSON
+ *   objects.
+ *
+ * In the JSON Lines and CBOR encodings, times are integer numbers of
+ * nanoseconds, and histograms are maps with the bin width and an array of
+ * [index, count] pairs for the non-empty bins.
+ */
+class FlowStatsStreamWriter
+{
+  public:
+    FlowStatsStreamWriter();
+    ~FlowStatsStreamWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    FlowStatsStreamWriter(const FlowStatsStreamWriter&) = delete;
+    FlowStatsStreamWriter& operator=(const FlowStatsStreamWriter&) = delete;
+
+    /**
+     * Create the output file.
+     * @param fileName name or path of the output file
+     * @param format encoding of the records
+     * @param enableHistograms if true, include also the histograms in the records
+     */
+    void Open(const std::string& fileName,
+              FlowMonitor::ExportFormat format,
+              bool enableHistograms);
+
+    /**
+     * Finish the output file and close it.
+     */
+    void Close();
+
+    /**
+     * @return true if the output file is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * Start a snapshot.
+     * @param time the simulation time of the snapshot
+     */
+    void BeginSnapshot(Time time);
+
+    /**
+     * Write the statistics of a flow in the current snapshot.
+     * @param flowId the flow identification
+     * @param stats the flow statistics
+     */
+    void WriteFlow(FlowId flowId, const FlowMonitor::FlowStats& stats);
+
+    /**
+     * Finish the current snapshot and flush the output file.
+     */
+    void EndSnapshot();
+
+    /**
+     * Serialize the statistics of a flow as a `Flow` XML element.
+     * @param os the output stream
+     * @param indent number of spaces to use as base indentation level
+     * @param flowId the flow identification
+     * @param stats the flow statistics
+     * @param enableHistograms if true, include also the histograms in the output
+     */
+    static void SerializeFlowToXmlStream(std::ostream& os,
+                                         uint16_t indent,
+                                         FlowId flowId,
+                                         const FlowMonitor::FlowStats& stats,
+                                         bool enableHistograms);
+
+  private:
+    /**
+     * Write the statistics of a flow as a JSON object.
+     * @param flowId the flow identification
+     * @param stats the flow statistics
+     */
+    void WriteJsonFlow(FlowId flowId, const FlowMonitor::FlowStats& stats);
+    /**
+     * Write a histogram as a JSON object.
+     * @param histogram the histogram
+     */
+    void WriteJsonHistogram(const Histogram& histogram);
+
+    /**
+     * Write the statistics of a flow as a CBOR map.
+     * @param flowId the flow identification
+     * @param stats the flow statistics
+     */
+    void WriteCborFlow(FlowId flowId, const FlowMonitor::FlowStats& stats);
+    /**
+     * Write a histogram as a CBOR map.
+     * @param histogram the histogram
+     */
+    void WriteCborHistogram(const Histogram& histogram);
+    /**
+     * Write the head of a CBOR data item.
+     * @param majorType the major type
+     * @param value the argument of the head
+     */
+    void WriteCborHead(uint8_t majorType, uint64_t value);
+    /**
+     * Write a CBOR integer.
+     * @param value the value
+     */
+    void WriteCborInt(int64_t value);
+    /**
+     * Write a CBOR double precision floating point number.
+     * @param value the value
+     */
+    void WriteCborDouble(double value);
+    /**
+     * Write a CBOR text string.
+     * @param text the string
+     */
+    void WriteCborText(const std::string& text);
+
+    std::ofstream m_os;                 //!< the output file
+    FlowMonitor::ExportFormat m_format; //!< encoding of the records
+    bool m_enableHistograms;            //!< true if histograms are written
+    Time m_snapshotTime;                //!< time of the current snapshot
+};
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_STREAM_WRITER_H */
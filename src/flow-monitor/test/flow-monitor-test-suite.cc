@@ -0,0 +1,341 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/boolean.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <string>
+
+/**
+ * @ingroup flow-monitor
+ * @defgroup flow-monitor-test flow-monitor module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Probe reporting the packets chosen by the tests to the FlowMonitor.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check the statistics of the flows and the ring of the packets in transit
+ * when the packets are received out of order or lost.
+ */
+class FlowMonitorTrackedPacketsTestCase : public TestCase
+{
+  public:
+    FlowMonitorTrackedPacketsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the packets in transit of a flow.
+     * @param flowId the flow
+     * @return the ring of the packets of the flow
+     */
+    const FlowMonitor::TrackedPacketRing& GetPackets(FlowId flowId) const;
+
+    /// Receive a window of packets in reverse order
+    void OutOfOrder();
+    /// Lose a packet, and receive a packet long after the next ones
+    void Lost();
+
+    Ptr<FlowMonitor> m_monitor;        //!< the monitor
+    Ptr<FlowMonitorTestProbe> m_probe; //!< the probe of the monitor
+};
+
+FlowMonitorTrackedPacketsTestCase::FlowMonitorTrackedPacketsTestCase()
+    : TestCase("Check the packets in transit of the flows")
+{
+}
+
+const FlowMonitor::TrackedPacketRing&
+FlowMonitorTrackedPacketsTestCase::GetPackets(FlowId flowId) const
+{
+    return m_monitor->m_flows[flowId].packets;
+}
+
+void
+FlowMonitorTrackedPacketsTestCase::OutOfOrder()
+{
+    // 40 packets are sent at 0 s, and packet i is received at (40 - i) ms
+    for (FlowPacketId packetId = 0; packetId < 40; packetId++)
+    {
+        m_monitor->ReportFirstTx(m_probe, 0, packetId, 100);
+        Simulator::Schedule(MilliSeconds(40 - packetId),
+                            &FlowMonitor::ReportLastRx,
+                            m_monitor,
+                            m_probe,
+                            0,
+                            packetId,
+                            100);
+    }
+    NS_TEST_EXPECT_MSG_EQ(GetPackets(0).GetCapacity(), 64, "The ring should fit 40 packets");
+    Simulator::Stop(MilliSeconds(50));
+    Simulator::Run();
+
+    const auto& stats = m_monitor->GetFlowStats().at(0);
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, 40, "Wrong number of transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 40, "Wrong number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxBytes, 4000, "Wrong number of received bytes");
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets, 0, "No packet should be lost");
+    NS_TEST_EXPECT_MSG_EQ(stats.delaySum, MilliSeconds(820), "Wrong sum of the delays");
+    NS_TEST_EXPECT_MSG_EQ(stats.minDelay, MilliSeconds(1), "Wrong minimum delay");
+    NS_TEST_EXPECT_MSG_EQ(stats.maxDelay, MilliSeconds(40), "Wrong maximum delay");
+    NS_TEST_EXPECT_MSG_EQ(stats.jitterSum, MilliSeconds(39), "Wrong sum of the jitters");
+    NS_TEST_EXPECT_MSG_EQ(GetPackets(0).GetCapacity(), 16, "The ring should shrink when empty");
+}
+
+void
+FlowMonitorTrackedPacketsTestCase::Lost()
+{
+    // packet 0 of flows 1 and 2 is sent at 0 s; packet i > 0 is sent at i ms and
+    // received 100 us later
+    m_monitor->ReportFirstTx(m_probe, 1, 0, 100);
+    m_monitor->ReportFirstTx(m_probe, 2, 0, 100);
+    for (FlowPacketId packetId = 1; packetId <= 100; packetId++)
+    {
+        for (FlowId flowId : {1, 2})
+        {
+            Simulator::Schedule(MilliSeconds(packetId),
+                                &FlowMonitor::ReportFirstTx,
+                                m_monitor,
+                                m_probe,
+                                flowId,
+                                packetId,
+                                100);
+            Simulator::Schedule(MilliSeconds(packetId) + MicroSeconds(100),
+                                &FlowMonitor::ReportLastRx,
+                                m_monitor,
+                                m_probe,
+                                flowId,
+                                packetId,
+                                100);
+        }
+    }
+    Simulator::Stop(MilliSeconds(101));
+    Simulator::Run();
+
+    // packet 0 no longer holds the start of the window
+    for (FlowId flowId : {1, 2})
+    {
+        NS_TEST_EXPECT_MSG_EQ(GetPackets(flowId).GetCapacity(),
+                              16,
+                              "The ring should not span the packets received after packet 0");
+        NS_TEST_EXPECT_MSG_EQ(GetPackets(flowId).GetOverflowSize(),
+                              1,
+                              "Packet 0 should be moved out of the ring");
+    }
+
+    // packet 0 of flow 2 is received late, the one of flow 1 is lost
+    m_monitor->ReportLastRx(m_probe, 2, 0, 100);
+    m_monitor->CheckForLostPackets(MilliSeconds(50));
+    const auto& stats = m_monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).rxPackets, 100, "Wrong number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).lostPackets, 1, "Packet 0 of flow 1 should be lost");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).rxPackets, 101, "Wrong number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).lostPackets, 0, "No packet of flow 2 should be lost");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).maxDelay, MilliSeconds(101), "Wrong delay of packet 0");
+    for (FlowId flowId : {1, 2})
+    {
+        NS_TEST_EXPECT_MSG_EQ(GetPackets(flowId).GetOverflowSize(), 0, "No packet left");
+    }
+}
+
+void
+FlowMonitorTrackedPacketsTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_probe = Create<FlowMonitorTestProbe>(m_monitor);
+    m_monitor->StartRightNow();
+
+    OutOfOrder();
+    Lost();
+
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_probe = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check that the statistics returned by FlowMonitor::GetFlowStats are only
+ * updated by the next call.
+ */
+class FlowMonitorSnapshotTestCase : public TestCase
+{
+  public:
+    FlowMonitorSnapshotTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSnapshotTestCase::FlowMonitorSnapshotTestCase()
+    : TestCase("Check the snapshot of the flow statistics")
+{
+}
+
+void
+FlowMonitorSnapshotTestCase::DoRun()
+{
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor>();
+    Ptr<FlowMonitorTestProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+    monitor->StartRightNow();
+
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().empty(), true, "No flow should be reported");
+    monitor->ReportFirstTx(probe, 1, 0, 100);
+    monitor->ReportFirstTx(probe, 3, 0, 200);
+    const auto& stats = monitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 2, "Two flows should be reported");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).txBytes, 100, "Wrong number of bytes of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(3).txBytes, 200, "Wrong number of bytes of flow 3");
+
+    monitor->ReportFirstTx(probe, 1, 1, 100);
+    monitor->ReportDrop(probe, 3, 0, 200, 0);
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).txPackets, 1, "The snapshot should not be updated");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(3).lostPackets, 0, "The snapshot should not be updated");
+
+    const auto& updated = monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(&updated, &stats, "The snapshot should be updated in place");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).txPackets, 2, "Wrong number of packets of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(3).lostPackets, 1, "Wrong number of lost packets of flow 3");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(3).packetsDropped.size(), 1, "Wrong drop reasons of flow 3");
+
+    monitor->ResetAllStats();
+    monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.size(), 2, "The flows should still be reported");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(1).txPackets, 0, "The statistics should be reset");
+
+    monitor->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check that the compact statistics do not keep any state for the flows.
+ */
+class FlowMonitorCompactStatsTestCase : public TestCase
+{
+  public:
+    FlowMonitorCompactStatsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorCompactStatsTestCase::FlowMonitorCompactStatsTestCase()
+    : TestCase("Check the compact statistics")
+{
+}
+
+void
+FlowMonitorCompactStatsTestCase::DoRun()
+{
+    Ptr<FlowMonitor> monitor = CreateObjectWithAttributes<FlowMonitor>("CompactStats",
+                                                                       BooleanValue(true),
+                                                                       "HeavyHitters",
+                                                                       UintegerValue(2));
+    Ptr<FlowMonitorTestProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+    monitor->StartRightNow();
+
+    // 100 flows send a packet of 100 bytes, and flows 5 and 7 send 10 more
+    // packets; all the packets are received 1 ms later, except the one of
+    // flow 9, which is dropped, and the one of flow 11, which is lost
+    for (FlowId flowId = 0; flowId < 100; flowId++)
+    {
+        FlowPacketId nPackets = (flowId == 5 || flowId == 7) ? 11 : 1;
+        for (FlowPacketId packetId = 0; packetId < nPackets; packetId++)
+        {
+            monitor->ReportFirstTx(probe, flowId, packetId, 100);
+            if (flowId != 9 && flowId != 11)
+            {
+                Simulator::Schedule(MilliSeconds(1),
+                                    &FlowMonitor::ReportLastRx,
+                                    monitor,
+                                    probe,
+                                    flowId,
+                                    packetId,
+                                    100);
+            }
+        }
+    }
+    monitor->ReportDrop(probe, 9, 0, 100, 0);
+    NS_TEST_EXPECT_MSG_EQ(monitor->m_compactPackets.size(), 119, "Wrong packets in transit");
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    monitor->CheckForLostPackets(MilliSeconds(5));
+
+    NS_TEST_EXPECT_MSG_EQ(monitor->m_flows.empty(), true, "No flow state should be kept");
+    NS_TEST_EXPECT_MSG_EQ(monitor->m_compactPackets.empty(), true, "No packet should be left");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().empty(), true, "No flow should be reported");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetDelaySketch().GetCount(), 118, "Wrong received packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(monitor->GetDelaySketch().GetQuantile(0.5),
+                              0.001,
+                              0.001 * 0.01,
+                              "Wrong median delay");
+    NS_TEST_EXPECT_MSG_EQ(monitor->m_compactLostPackets, 2, "Wrong lost packets");
+    auto heavyHitters = monitor->GetHeavyHitters();
+    NS_TEST_ASSERT_MSG_EQ(heavyHitters.size(), 2, "Wrong number of heavy hitters");
+    NS_TEST_EXPECT_MSG_EQ(heavyHitters[0].first, 5, "Flow 5 should be a heavy hitter");
+    NS_TEST_EXPECT_MSG_EQ(heavyHitters[1].first, 7, "Flow 7 should be a heavy hitter");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(heavyHitters[0].second, 1100, "Underestimated bytes");
+    std::string xml = monitor->SerializeToXmlString(0, false, false);
+    NS_TEST_EXPECT_MSG_NE(xml.find("rxPackets=\"118\" lostPackets=\"2\""),
+                          std::string::npos,
+                          "Wrong compact statistics in the XML output");
+
+    monitor->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", Type::UNIT)
+{
+    AddTestCase(new FlowMonitorTrackedPacketsTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorSnapshotTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorCompactStatsTestCase, TestCase::Duration::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
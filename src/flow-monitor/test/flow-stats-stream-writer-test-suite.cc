@@ -0,0 +1,664 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/enum.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/flow-stats-stream-writer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Probe reporting the packets chosen by the test to the FlowMonitor.
+ */
+class ExportTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor
+     */
+    ExportTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/// Simulation time of the snapshots written by the tests
+const Time SNAPSHOT_TIME = Seconds(2);
+
+/**
+ * Get the statistics of a flow with small values, which are printed exactly
+ * in all the encodings.
+ * @return the flow statistics
+ */
+FlowMonitor::FlowStats
+GetFlowStats()
+{
+    FlowMonitor::FlowStats stats;
+    stats.timeFirstTxPacket = NanoSeconds(1500);
+    stats.timeFirstRxPacket = NanoSeconds(2500);
+    stats.timeLastTxPacket = NanoSeconds(100000);
+    stats.timeLastRxPacket = NanoSeconds(101000);
+    stats.delaySum = NanoSeconds(3000);
+    stats.jitterSum = NanoSeconds(500);
+    stats.lastDelay = NanoSeconds(1000);
+    stats.maxDelay = NanoSeconds(1200);
+    stats.minDelay = NanoSeconds(800);
+    stats.txBytes = 5000;
+    stats.rxBytes = 4000;
+    stats.txPackets = 5;
+    stats.rxPackets = 4;
+    stats.lostPackets = 1;
+    stats.timesForwarded = 8;
+    stats.packetsDropped = {0, 1};
+    stats.bytesDropped = {0, 1000};
+    stats.delayHistogram.SetDefaultBinWidth(0.001);
+    stats.delayHistogram.AddValue(0.0008);
+    stats.delayHistogram.AddValue(0.0012);
+    stats.delayHistogram.AddValue(0.0012);
+    stats.jitterHistogram.SetDefaultBinWidth(0.0005);
+    stats.jitterHistogram.AddValue(0.0002);
+    stats.packetSizeHistogram.SetDefaultBinWidth(20);
+    for (int i = 0; i < 5; i++)
+    {
+        stats.packetSizeHistogram.AddValue(1000);
+    }
+    stats.flowInterruptionsHistogram.SetDefaultBinWidth(0.25);
+    return stats;
+}
+
+/**
+ * Get the statistics of a flow whose values are at the limits of the sizes
+ * of the CBOR integers.
+ * @return the flow statistics
+ */
+FlowMonitor::FlowStats
+GetEdgeFlowStats()
+{
+    FlowMonitor::FlowStats stats;
+    stats.timeFirstTxPacket = NanoSeconds(-1);
+    stats.timeFirstRxPacket = NanoSeconds(-24);
+    stats.timeLastTxPacket = NanoSeconds(-25);
+    stats.timeLastRxPacket = NanoSeconds(-256);
+    stats.delaySum = NanoSeconds(-257);
+    stats.jitterSum = NanoSeconds(std::numeric_limits<int64_t>::min());
+    stats.lastDelay = NanoSeconds(std::numeric_limits<int64_t>::max());
+    stats.maxDelay = NanoSeconds(4294967296);
+    stats.minDelay = NanoSeconds(65536);
+    stats.txBytes = 4294967295;
+    stats.rxBytes = 65535;
+    stats.txPackets = 256;
+    stats.rxPackets = 255;
+    stats.lostPackets = 24;
+    stats.timesForwarded = 23;
+    stats.packetsDropped = {0};
+    stats.bytesDropped = {static_cast<uint64_t>(std::numeric_limits<int64_t>::max())};
+    return stats;
+}
+
+/**
+ * Get the scalar fields of the record of a flow.
+ * @param flowId the flow identification
+ * @param stats the flow statistics
+ * @return the values of the fields, by name, with the times in nanoseconds
+ */
+std::map<std::string, int64_t>
+GetFields(FlowId flowId, const FlowMonitor::FlowStats& stats)
+{
+    return {
+        {"flowId", flowId},
+        {"timeFirstTxPacket", stats.timeFirstTxPacket.GetNanoSeconds()},
+        {"timeFirstRxPacket", stats.timeFirstRxPacket.GetNanoSeconds()},
+        {"timeLastTxPacket", stats.timeLastTxPacket.GetNanoSeconds()},
+        {"timeLastRxPacket", stats.timeLastRxPacket.GetNanoSeconds()},
+        {"delaySum", stats.delaySum.GetNanoSeconds()},
+        {"jitterSum", stats.jitterSum.GetNanoSeconds()},
+        {"lastDelay", stats.lastDelay.GetNanoSeconds()},
+        {"maxDelay", stats.maxDelay.GetNanoSeconds()},
+        {"minDelay", stats.minDelay.GetNanoSeconds()},
+        {"txBytes", static_cast<int64_t>(stats.txBytes)},
+        {"rxBytes", static_cast<int64_t>(stats.rxBytes)},
+        {"txPackets", stats.txPackets},
+        {"rxPackets", stats.rxPackets},
+        {"lostPackets", stats.lostPackets},
+        {"timesForwarded", stats.timesForwarded},
+    };
+}
+
+/**
+ * Write a snapshot with a flow to a file.
+ * @param fileName the name of the file
+ * @param format the encoding
+ * @param enableHistograms whether to write the histograms
+ * @param flowId the flow identification
+ * @param stats the flow statistics
+ */
+void
+WriteSnapshot(const std::string& fileName,
+              FlowMonitor::ExportFormat format,
+              bool enableHistograms,
+              FlowId flowId,
+              const FlowMonitor::FlowStats& stats)
+{
+    FlowStatsStreamWriter writer;
+    writer.Open(fileName, format, enableHistograms);
+    writer.BeginSnapshot(SNAPSHOT_TIME);
+    writer.WriteFlow(flowId, stats);
+    writer.EndSnapshot();
+    writer.Close();
+}
+
+/**
+ * Read a whole file.
+ * @param fileName the name of the file
+ * @return the content of the file
+ */
+std::string
+ReadFile(const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    std::ostringstream content;
+    content << is.rdbuf();
+    return content.str();
+}
+
+/**
+ * Convert a string of hexadecimal digits to bytes.
+ * @param hex the hexadecimal digits
+ * @return the bytes
+ */
+std::string
+FromHex(const std::string& hex)
+{
+    std::string bytes;
+    for (std::size_t i = 0; i + 1 < hex.size(); i += 2)
+    {
+        bytes.push_back(static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+/// CBOR data item decoded by CborReader
+struct CborItem
+{
+    uint8_t majorType{0};         //!< major type
+    int64_t integer{0};           //!< value of an integer
+    double number{0};             //!< value of a floating point number
+    std::string text;             //!< value of a text string
+    std::vector<CborItem> items;  //!< items of an array, keys and values of a map
+    std::vector<std::string> key; //!< keys of a map, in order
+
+    /**
+     * Get the value of a key of a map.
+     * @param name the key
+     * @return the value
+     */
+    const CborItem& operator[](const std::string& name) const
+    {
+        for (std::size_t i = 0; i < key.size(); i++)
+        {
+            if (key[i] == name)
+            {
+                return items[i];
+            }
+        }
+        static const CborItem missing;
+        return missing;
+    }
+};
+
+/**
+ * Decoder of the subset of CBOR written by FlowStatsStreamWriter.
+ */
+class CborReader
+{
+  public:
+    /**
+     * Constructor
+     * @param buffer the encoded data items
+     */
+    CborReader(const std::string& buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    /// @return true if all the data items were decoded
+    bool AtEnd() const
+    {
+        return m_pos >= m_buffer.size();
+    }
+
+    /// @return the next data item
+    CborItem Read()
+    {
+        CborItem item;
+        uint8_t initial = Byte();
+        item.majorType = initial >> 5;
+        uint8_t info = initial & 0x1f;
+        if (item.majorType == 7)
+        {
+            uint64_t bits = Argument(27);
+            std::memcpy(&item.number, &bits, sizeof(bits));
+            return item;
+        }
+        uint64_t argument = Argument(info);
+        switch (item.majorType)
+        {
+        case 0:
+            item.integer = static_cast<int64_t>(argument);
+            break;
+        case 1:
+            item.integer = -1 - static_cast<int64_t>(argument);
+            break;
+        case 3:
+            item.text = m_buffer.substr(m_pos, argument);
+            m_pos += argument;
+            break;
+        case 4:
+            for (uint64_t i = 0; i < argument; i++)
+            {
+                item.items.push_back(Read());
+            }
+            break;
+        case 5:
+            for (uint64_t i = 0; i < argument; i++)
+            {
+                item.key.push_back(Read().text);
+                item.items.push_back(Read());
+            }
+            break;
+        }
+        return item;
+    }
+
+  private:
+    /// @return the next byte
+    uint8_t Byte()
+    {
+        return static_cast<uint8_t>(m_buffer.at(m_pos++));
+    }
+
+    /**
+     * Read the argument of a head.
+     * @param info the additional information of the head
+     * @return the argument
+     */
+    uint64_t Argument(uint8_t info)
+    {
+        if (info < 24)
+        {
+            return info;
+        }
+        uint64_t argument = 0;
+        for (std::size_t i = 0; i < (std::size_t{1} << (info - 24)); i++)
+        {
+            argument = (argument << 8) | Byte();
+        }
+        return argument;
+    }
+
+    const std::string& m_buffer; //!< the encoded data items
+    std::size_t m_pos{0};        //!< position of the next byte
+};
+
+} // namespace
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check the XML encoding of FlowStatsStreamWriter.
+ */
+class FlowStatsStreamWriterXmlTestCase : public TestCase
+{
+  public:
+    FlowStatsStreamWriterXmlTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowStatsStreamWriterXmlTestCase::FlowStatsStreamWriterXmlTestCase()
+    : TestCase("Check the XML encoding of the flow statistics")
+{
+}
+
+void
+FlowStatsStreamWriterXmlTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("flow-stats-stream-writer.xml");
+    WriteSnapshot(fileName, FlowMonitor::EXPORT_XML, true, 7, GetFlowStats());
+    std::string content = ReadFile(fileName);
+
+    std::string golden =
+        "<?xml version=\"1.0\" ?>\n"
+        "<FlowMonitorStream>\n"
+        "  <Snapshot time=\"+2e+09ns\">\n"
+        "    <Flow flowId=\"7\" timeFirstTxPacket=\"+1500ns\" timeFirstRxPacket=\"+2500ns\" "
+        "timeLastTxPacket=\"+100000ns\" timeLastRxPacket=\"+101000ns\" delaySum=\"+3000ns\" "
+        "jitterSum=\"+500ns\" lastDelay=\"+1000ns\" maxDelay=\"+1200ns\" minDelay=\"+800ns\" "
+        "txBytes=\"5000\" rxBytes=\"4000\" txPackets=\"5\" rxPackets=\"4\" lostPackets=\"1\" "
+        "timesForwarded=\"8\">\n"
+        "      <packetsDropped reasonCode=\"0\" number=\"0\" />\n"
+        "      <packetsDropped reasonCode=\"1\" number=\"1\" />\n"
+        "      <bytesDropped reasonCode=\"0\" bytes=\"0\" />\n"
+        "      <bytesDropped reasonCode=\"1\" bytes=\"1000\" />\n"
+        "      <delayHistogram nBins=\"2\" >\n"
+        "        <bin index=\"0\" start=\"0\" width=\"0.001\" count=\"1\" />\n"
+        "        <bin index=\"1\" start=\"0.001\" width=\"0.001\" count=\"2\" />\n"
+        "      </delayHistogram>\n"
+        "      <jitterHistogram nBins=\"1\" >\n"
+        "        <bin index=\"0\" start=\"0\" width=\"0.0005\" count=\"1\" />\n"
+        "      </jitterHistogram>\n"
+        "      <packetSizeHistogram nBins=\"51\" >\n"
+        "        <bin index=\"50\" start=\"1000\" width=\"20\" count=\"5\" />\n"
+        "      </packetSizeHistogram>\n"
+        "      <flowInterruptionsHistogram nBins=\"0\" >\n"
+        "      </flowInterruptionsHistogram>\n"
+        "    </Flow>\n"
+        "  </Snapshot>\n"
+        "</FlowMonitorStream>\n";
+    NS_TEST_EXPECT_MSG_EQ(content, golden, "Wrong XML encoding");
+
+    // parse back the attributes of the Flow element
+    std::smatch flow;
+    NS_TEST_ASSERT_MSG_EQ(std::regex_search(content, flow, std::regex("<Flow ([^>]*)>")),
+                          true,
+                          "No Flow element");
+    std::map<std::string, int64_t> fields;
+    std::string attributes = flow[1].str();
+    std::regex attribute("(\\w+)=\"\\+?(-?[0-9]+)(ns)?\"");
+    for (auto it = std::sregex_iterator(attributes.begin(), attributes.end(), attribute);
+         it != std::sregex_iterator();
+         it++)
+    {
+        fields[(*it)[1].str()] = std::stoll((*it)[2].str());
+    }
+    NS_TEST_EXPECT_MSG_EQ((fields == GetFields(7, GetFlowStats())),
+                          true,
+                          "The attributes do not match the flow statistics");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check the JSON Lines encoding of FlowStatsStreamWriter.
+ */
+class FlowStatsStreamWriterJsonTestCase : public TestCase
+{
+  public:
+    FlowStatsStreamWriterJsonTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowStatsStreamWriterJsonTestCase::FlowStatsStreamWriterJsonTestCase()
+    : TestCase("Check the JSON Lines encoding of the flow statistics")
+{
+}
+
+void
+FlowStatsStreamWriterJsonTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("flow-stats-stream-writer.jsonl");
+    WriteSnapshot(fileName, FlowMonitor::EXPORT_JSON_LINES, true, 7, GetFlowStats());
+    std::string golden =
+        "{\"time\":2000000000,\"flowId\":7,\"timeFirstTxPacket\":1500,\"timeFirstRxPacket\":2500,"
+        "\"timeLastTxPacket\":100000,\"timeLastRxPacket\":101000,\"delaySum\":3000,"
+        "\"jitterSum\":500,\"lastDelay\":1000,\"maxDelay\":1200,\"minDelay\":800,"
+        "\"txBytes\":5000,\"rxBytes\":4000,\"txPackets\":5,\"rxPackets\":4,\"lostPackets\":1,"
+        "\"timesForwarded\":8,\"packetsDropped\":[0,1],\"bytesDropped\":[0,1000],"
+        "\"delayHistogram\":{\"binWidth\":0.001,\"bins\":[[0,1],[1,2]]},"
+        "\"jitterHistogram\":{\"binWidth\":0.0005,\"bins\":[[0,1]]},"
+        "\"packetSizeHistogram\":{\"binWidth\":20,\"bins\":[[50,5]]},"
+        "\"flowInterruptionsHistogram\":{\"binWidth\":0.25,\"bins\":[]}}\n";
+    NS_TEST_EXPECT_MSG_EQ(ReadFile(fileName), golden, "Wrong JSON Lines encoding");
+
+    // parse back the fields of a flow with large and negative values
+    WriteSnapshot(fileName, FlowMonitor::EXPORT_JSON_LINES, false, 9, GetEdgeFlowStats());
+    std::string content = ReadFile(fileName);
+    std::map<std::string, int64_t> fields;
+    std::regex field("\"(\\w+)\":(-?[0-9]+)[,}]");
+    for (auto it = std::sregex_iterator(content.begin(), content.end(), field);
+         it != std::sregex_iterator();
+         it++)
+    {
+        fields[(*it)[1].str()] = std::stoll((*it)[2].str());
+    }
+    auto expected = GetFields(9, GetEdgeFlowStats());
+    expected["time"] = SNAPSHOT_TIME.GetNanoSeconds();
+    NS_TEST_EXPECT_MSG_EQ((fields == expected), true, "The fields do not match the statistics");
+    NS_TEST_EXPECT_MSG_EQ(content.substr(content.find("\"packetsDropped\"")),
+                          "\"packetsDropped\":[0],\"bytesDropped\":[9223372036854775807]}\n",
+                          "Wrong drop counters");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check the CBOR encoding of FlowStatsStreamWriter.
+ */
+class FlowStatsStreamWriterCborTestCase : public TestCase
+{
+  public:
+    FlowStatsStreamWriterCborTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowStatsStreamWriterCborTestCase::FlowStatsStreamWriterCborTestCase()
+    : TestCase("Check the CBOR encoding of the flow statistics")
+{
+}
+
+void
+FlowStatsStreamWriterCborTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("flow-stats-stream-writer.cbor");
+    WriteSnapshot(fileName, FlowMonitor::EXPORT_CBOR, true, 7, GetFlowStats());
+    std::string content = ReadFile(fileName);
+    std::string golden = FromHex(
+        "b76474696d651a7735940066666c6f774964077174696d65466972737454785061636b65741905dc"
+        "7174696d65466972737452785061636b65741909c47074696d654c61737454785061636b65741a00"
+        "0186a07074696d654c61737452785061636b65741a00018a886864656c617953756d190bb8696a69"
+        "7474657253756d1901f4696c61737444656c61791903e8686d617844656c61791904b0686d696e44"
+        "656c617919032067747842797465731913886772784279746573190fa06974785061636b65747305"
+        "6972785061636b657473046b6c6f73745061636b657473016e74696d6573466f7277617264656408"
+        "6e7061636b65747344726f707065648200016c627974657344726f7070656482001903e86e64656c"
+        "6179486973746f6772616da26862696e5769647468fb3f50624dd2f1a9fc6462696e738282000182"
+        "01026f6a6974746572486973746f6772616da26862696e5769647468fb3f40624dd2f1a9fc646269"
+        "6e7381820001737061636b657453697a65486973746f6772616da26862696e5769647468fb403400"
+        "00000000006462696e738182183205781a666c6f77496e74657272757074696f6e73486973746f67"
+        "72616da26862696e5769647468fb3fd00000000000006462696e7380");
+    NS_TEST_EXPECT_MSG_EQ((content == golden), true, "Wrong CBOR encoding");
+
+    // decode the histograms
+    CborReader reader(content);
+    CborItem record = reader.Read();
+    NS_TEST_EXPECT_MSG_EQ(reader.AtEnd(), true, "A single record should be written");
+    const auto& delay = record["delayHistogram"];
+    NS_TEST_EXPECT_MSG_EQ(delay["binWidth"].number, 0.001, "Wrong bin width");
+    NS_TEST_ASSERT_MSG_EQ(delay["bins"].items.size(), 2, "Wrong number of bins");
+    NS_TEST_EXPECT_MSG_EQ(delay["bins"].items[1].items[0].integer, 1, "Wrong bin index");
+    NS_TEST_EXPECT_MSG_EQ(delay["bins"].items[1].items[1].integer, 2, "Wrong bin count");
+    const auto& packetSize = record["packetSizeHistogram"];
+    NS_TEST_EXPECT_MSG_EQ(packetSize["binWidth"].number, 20, "Wrong bin width");
+    NS_TEST_EXPECT_MSG_EQ(packetSize["bins"].items[0].items[0].integer, 50, "Wrong bin index");
+    NS_TEST_EXPECT_MSG_EQ(record["flowInterruptionsHistogram"]["bins"].items.size(),
+                          0,
+                          "The histogram should be empty");
+
+    // each edge value is encoded with the smallest head, right after its key
+    WriteSnapshot(fileName, FlowMonitor::EXPORT_CBOR, false, 9, GetEdgeFlowStats());
+    content = ReadFile(fileName);
+    const std::vector<std::pair<std::string, std::string>> encodings = {
+        {"timeFirstTxPacket", "20"},
+        {"timeFirstRxPacket", "37"},
+        {"timeLastTxPacket", "3818"},
+        {"timeLastRxPacket", "38ff"},
+        {"delaySum", "390100"},
+        {"jitterSum", "3b7fffffffffffffff"},
+        {"lastDelay", "1b7fffffffffffffff"},
+        {"maxDelay", "1b0000000100000000"},
+        {"minDelay", "1a00010000"},
+        {"txBytes", "1affffffff"},
+        {"rxBytes", "19ffff"},
+        {"txPackets", "190100"},
+        {"rxPackets", "18ff"},
+        {"lostPackets", "1818"},
+        {"timesForwarded", "17"},
+        {"packetsDropped", "8100"},
+    };
+    for (const auto& [key, hex] : encodings)
+    {
+        std::string encoded = static_cast<char>(0x60 + key.size()) + key + FromHex(hex);
+        NS_TEST_EXPECT_MSG_NE(content.find(encoded),
+                              std::string::npos,
+                              "Wrong encoding of " << key);
+    }
+
+    // decode the record
+    CborReader edgeReader(content);
+    record = edgeReader.Read();
+    NS_TEST_EXPECT_MSG_EQ(edgeReader.AtEnd(), true, "A single record should be written");
+    NS_TEST_EXPECT_MSG_EQ(record.majorType, 5, "The record should be a map");
+    NS_TEST_EXPECT_MSG_EQ(record.key.size(), 19, "Wrong number of fields");
+    auto expected = GetFields(9, GetEdgeFlowStats());
+    expected["time"] = SNAPSHOT_TIME.GetNanoSeconds();
+    for (const auto& [key, value] : expected)
+    {
+        NS_TEST_EXPECT_MSG_EQ(record[key].integer, value, "Wrong value of " << key);
+    }
+    NS_TEST_EXPECT_MSG_EQ(record["bytesDropped"].items.at(0).integer,
+                          std::numeric_limits<int64_t>::max(),
+                          "Wrong drop counter");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * Check that the export file of FlowMonitor is created by the first export,
+ * also when its name is set after the monitor has started.
+ */
+class FlowMonitorExportTestCase : public TestCase
+{
+  public:
+    FlowMonitorExportTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the lines of the export file.
+     * @param nLines the expected number of lines
+     */
+    void CheckLines(std::size_t nLines);
+
+    std::string m_fileName; //!< name of the export file
+};
+
+FlowMonitorExportTestCase::FlowMonitorExportTestCase()
+    : TestCase("Check the creation of the export file")
+{
+}
+
+void
+FlowMonitorExportTestCase::CheckLines(std::size_t nLines)
+{
+    std::ifstream is(m_fileName);
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), (nLines > 0), "Wrong existence of the export file");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(is, line);)
+    {
+        lines.push_back(line);
+    }
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), nLines, "Wrong number of records");
+    if (nLines > 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[0].substr(0, 29),
+                              "{\"time\":500000000,\"flowId\":1,",
+                              "Flow 1 should be exported when the file name is set");
+    }
+    if (nLines > 1)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[1].substr(0, 30),
+                              "{\"time\":1200000000,\"flowId\":2,",
+                              "Flow 2 should be exported when the monitor is disposed");
+    }
+}
+
+void
+FlowMonitorExportTestCase::DoRun()
+{
+    m_fileName = CreateTempDirFilename("flow-monitor-export.jsonl");
+    std::remove(m_fileName.c_str());
+
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor>();
+    Ptr<FlowProbe> probe = Create<ExportTestProbe>(monitor);
+    monitor->StartRightNow();
+    monitor->ReportFirstTx(probe, 1, 0, 100);
+
+    Simulator::Schedule(MilliSeconds(400), &FlowMonitorExportTestCase::CheckLines, this, 0);
+    Simulator::Schedule(MilliSeconds(500), [=, this]() {
+        monitor->SetAttribute("ExportFormat", EnumValue(FlowMonitor::EXPORT_JSON_LINES));
+        monitor->SetAttribute("ExportFileName", StringValue(m_fileName));
+    });
+    Simulator::Schedule(MilliSeconds(700), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 0, 100);
+    Simulator::Stop(MilliSeconds(1200));
+    Simulator::Run();
+    CheckLines(1);
+
+    // setting the same name again has no effect
+    monitor->SetAttribute("ExportFileName", StringValue(m_fileName));
+    monitor->Dispose();
+    CheckLines(2);
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * FlowStatsStreamWriter TestSuite
+ */
+class FlowStatsStreamWriterTestSuite : public TestSuite
+{
+  public:
+    FlowStatsStreamWriterTestSuite();
+};
+
+FlowStatsStreamWriterTestSuite::FlowStatsStreamWriterTestSuite()
+    : TestSuite("flow-stats-stream-writer", Type::UNIT)
+{
+    AddTestCase(new FlowStatsStreamWriterXmlTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowStatsStreamWriterJsonTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowStatsStreamWriterCborTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorExportTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowStatsStreamWriterTestSuite g_flowStatsStreamWriterTestSuite;
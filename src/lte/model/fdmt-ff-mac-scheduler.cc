@@ -1335,7 +1335,7 @@ FdMtFfMacScheduler::DoSchedUlTriggerReq(
         }
     }
 
-    std::map<uint16_t, uint32_t>::iterator it;
+    FfMacUeStateTable<uint32_t>::iterator it;
     int nflows = 0;
 
     for (it = m_ceBsrRxed.begin(); it != m_ceBsrRxed.end(); it++)
@@ -1798,9 +1798,7 @@ FdMtFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itP10).first);
             NS_LOG_INFO(this << " P10-CQI expired for user " << (*itP10).first);
             m_p10CqiRxed.erase(itMap);
-            auto temp = itP10;
-            itP10++;
-            m_p10CqiTimers.erase(temp);
+            itP10 = m_p10CqiTimers.erase(itP10);
         }
         else
         {
@@ -1823,9 +1821,7 @@ FdMtFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itA30).first);
             NS_LOG_INFO(this << " A30-CQI expired for user " << (*itA30).first);
             m_a30CqiRxed.erase(itMap);
-            auto temp = itA30;
-            itA30++;
-            m_a30CqiTimers.erase(temp);
+            itA30 = m_a30CqiTimers.erase(itA30);
         }
         else
         {
@@ -1853,9 +1849,7 @@ FdMtFfMacScheduler::RefreshUlCqiMaps()
             NS_LOG_INFO(this << " UL-CQI exired for user " << (*itUl).first);
             (*itMap).second.clear();
             m_ueCqi.erase(itMap);
-            auto temp = itUl;
-            itUl++;
-            m_ueCqiTimers.erase(temp);
+            itUl = m_ueCqiTimers.erase(itUl);
         }
         else
         {
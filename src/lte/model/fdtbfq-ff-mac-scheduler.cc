@@ -979,7 +979,7 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
     while (totalRbg < rbgNum)
     {
         // select UE with largest metric
-        std::map<uint16_t, fdtbfqsFlowPerf_t>::iterator it;
+        FfMacUeStateTable<fdtbfqsFlowPerf_t>::iterator it;
         auto itMax = m_flowStatsDl.end();
         double metricMax = 0.0;
         bool firstRnti = true;
@@ -1630,7 +1630,8 @@ FdTbfqFfMacScheduler::DoSchedUlTriggerReq(
                          << (0xF & params.m_sfnSf) << " size " << params.m_ulInfoList.size());
 
     RefreshUlCqiMaps();
-    m_ffrSapProvider->ReportUlCqiInfo(m_ueCqi);
+    m_ffrSapProvider->ReportUlCqiInfo(
+        std::map<uint16_t, std::vector<double>>(m_ueCqi.begin(), m_ueCqi.end()));
 
     // Generate RBs map
     FfMacSchedSapUser::SchedUlConfigIndParameters ret;
@@ -1747,7 +1748,7 @@ FdTbfqFfMacScheduler::DoSchedUlTriggerReq(
         }
     }
 
-    std::map<uint16_t, uint32_t>::iterator it;
+    FfMacUeStateTable<uint32_t>::iterator it;
     int nflows = 0;
 
     for (it = m_ceBsrRxed.begin(); it != m_ceBsrRxed.end(); it++)
@@ -2221,9 +2222,7 @@ FdTbfqFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itP10).first);
             NS_LOG_INFO(this << " P10-CQI expired for user " << (*itP10).first);
             m_p10CqiRxed.erase(itMap);
-            auto temp = itP10;
-            itP10++;
-            m_p10CqiTimers.erase(temp);
+            itP10 = m_p10CqiTimers.erase(itP10);
         }
         else
         {
@@ -2246,9 +2245,7 @@ FdTbfqFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itA30).first);
             NS_LOG_INFO(this << " A30-CQI expired for user " << (*itA30).first);
             m_a30CqiRxed.erase(itMap);
-            auto temp = itA30;
-            itA30++;
-            m_a30CqiTimers.erase(temp);
+            itA30 = m_a30CqiTimers.erase(itA30);
         }
         else
         {
@@ -2276,9 +2273,7 @@ FdTbfqFfMacScheduler::RefreshUlCqiMaps()
             NS_LOG_INFO(this << " UL-CQI exired for user " << (*itUl).first);
             (*itMap).second.clear();
             m_ueCqi.erase(itMap);
-            auto temp = itUl;
-            itUl++;
-            m_ueCqiTimers.erase(temp);
+            itUl = m_ueCqiTimers.erase(itUl);
         }
         else
         {
@@ -0,0 +1,253 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FF_MAC_UE_STATE_TABLE_H
+#define FF_MAC_UE_STATE_TABLE_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup ff-api
+ *
+ * @brief Dense table of the per-UE state of an FF MAC scheduler
+ *
+ * The FF MAC schedulers look up the state of each UE (flow statistics, CQI
+ * reports, transmission mode...) by RNTI many times per TTI. This table
+ * stores the entries of all the UEs contiguously, sorted by RNTI, so that
+ * lookups are binary searches over a compact array of RNTIs and iterating
+ * over the UEs visits them in the same order as a std::map would. The
+ * position of a UE in the table (its slot) can be used to index arrays
+ * computed per TTI.
+ *
+ * The interface is the subset of the std::map interface used by the
+ * schedulers. Unlike std::map, inserting or erasing an entry invalidates the
+ * iterators pointing to the entries that follow it, which is not an issue
+ * since UEs are only added or removed when they are (re)configured or when
+ * their reports expire.
+ *
+ * @tparam T the type of the per-UE state
+ */
+template <typename T>
+class FfMacUeStateTable
+{
+  public:
+    /// Type of the entries of the table
+    using value_type = std::pair<uint16_t, T>;
+    /// Iterator over the entries of the table
+    using iterator = typename std::vector<value_type>::iterator;
+    /// Const iterator over the entries of the table
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    /// @return an iterator to the entry with the lowest RNTI
+    iterator begin()
+    {
+        return m_entries.begin();
+    }
+
+    /// @return an iterator past the entry with the highest RNTI
+    iterator end()
+    {
+        return m_entries.end();
+    }
+
+    /// @return a const iterator to the entry with the lowest RNTI
+    const_iterator begin() const
+    {
+        return m_entries.begin();
+    }
+
+    /// @return a const iterator past the entry with the highest RNTI
+    const_iterator end() const
+    {
+        return m_entries.end();
+    }
+
+    /// @return the number of UEs in the table
+    std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    /// @return whether the table is empty
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    /// Remove all the entries
+    void clear()
+    {
+        m_rntis.clear();
+        m_entries.clear();
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return the slot of the UE, or the size of the table if there is no entry for the UE
+     */
+    std::size_t GetSlot(uint16_t rnti) const
+    {
+        auto it = std::lower_bound(m_rntis.begin(), m_rntis.end(), rnti);
+        if (it == m_rntis.end() || *it != rnti)
+        {
+            return m_rntis.size();
+        }
+        return it - m_rntis.begin();
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return an iterator to the entry of the UE, or end() if there is none
+     */
+    iterator find(uint16_t rnti)
+    {
+        return m_entries.begin() + GetSlot(rnti);
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return a const iterator to the entry of the UE, or end() if there is none
+     */
+    const_iterator find(uint16_t rnti) const
+    {
+        return m_entries.begin() + GetSlot(rnti);
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return 1 if there is an entry for the UE, 0 otherwise
+     */
+    std::size_t count(uint16_t rnti) const
+    {
+        return (GetSlot(rnti) < m_rntis.size()) ? 1 : 0;
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return a reference to the state of the UE, which must be in the table
+     */
+    T& at(uint16_t rnti)
+    {
+        auto slot = GetSlot(rnti);
+        NS_ASSERT_MSG(slot < m_rntis.size(), "No entry for RNTI " << rnti);
+        return m_entries[slot].second;
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return a const reference to the state of the UE, which must be in the table
+     */
+    const T& at(uint16_t rnti) const
+    {
+        auto slot = GetSlot(rnti);
+        NS_ASSERT_MSG(slot < m_rntis.size(), "No entry for RNTI " << rnti);
+        return m_entries[slot].second;
+    }
+
+    /**
+     * @param rnti the RNTI of the UE
+     * @return a reference to the state of the UE, which is value-initialized if the UE was
+     *         not in the table
+     */
+    T& operator[](uint16_t rnti)
+    {
+        return Insert(rnti, T()).first->second;
+    }
+
+    /**
+     * Insert an entry, unless there is already one for the same UE.
+     * @param value the RNTI and the state of the UE
+     * @return an iterator to the entry of the UE and whether the entry was inserted
+     */
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return Insert(value.first, value.second);
+    }
+
+    /**
+     * Insert an entry built from the given arguments, unless there is already one for the
+     * same UE.
+     * @tparam Args the types of the arguments
+     * @param rnti the RNTI of the UE
+     * @param args the arguments of the constructor of the state of the UE
+     * @return an iterator to the entry of the UE and whether the entry was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(uint16_t rnti, Args&&... args)
+    {
+        return Insert(rnti, T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Remove the entry of a UE, if any.
+     * @param rnti the RNTI of the UE
+     * @return the number of removed entries
+     */
+    std::size_t erase(uint16_t rnti)
+    {
+        auto slot = GetSlot(rnti);
+        if (slot == m_rntis.size())
+        {
+            return 0;
+        }
+        erase(m_entries.begin() + slot);
+        return 1;
+    }
+
+    /**
+     * Remove an entry.
+     * @param it an iterator to the entry
+     * @return an iterator to the entry that followed the removed one
+     */
+    iterator erase(iterator it)
+    {
+        m_rntis.erase(m_rntis.begin() + (it - m_entries.begin()));
+        return m_entries.erase(it);
+    }
+
+  private:
+    /**
+     * Insert an entry at its position in the table, unless there is already one for the UE.
+     * @param rnti the RNTI of the UE
+     * @param state the state of the UE
+     * @return an iterator to the entry of the UE and whether the entry was inserted
+     */
+    std::pair<iterator, bool> Insert(uint16_t rnti, T&& state)
+    {
+        auto it = std::lower_bound(m_rntis.begin(), m_rntis.end(), rnti);
+        auto slot = it - m_rntis.begin();
+        if (it != m_rntis.end() && *it == rnti)
+        {
+            return {m_entries.begin() + slot, false};
+        }
+        m_rntis.insert(it, rnti);
+        return {m_entries.emplace(m_entries.begin() + slot, rnti, std::move(state)), true};
+    }
+
+    /**
+     * Insert an entry at its position in the table, unless there is already one for the UE.
+     * @param rnti the RNTI of the UE
+     * @param state the state of the UE
+     * @return an iterator to the entry of the UE and whether the entry was inserted
+     */
+    std::pair<iterator, bool> Insert(uint16_t rnti, const T& state)
+    {
+        return Insert(rnti, T(state));
+    }
+
+    std::vector<uint16_t> m_rntis;     //!< The RNTIs of the UEs, in increasing order
+    std::vector<value_type> m_entries; //!< The RNTI and the state of each UE, by slot
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_UE_STATE_TABLE_H */
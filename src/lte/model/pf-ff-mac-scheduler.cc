@@ -17,6 +17,7 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 
+#include <array>
 #include <cfloat>
 #include <set>
 
@@ -901,121 +902,126 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
-    for (int i = 0; i < rbgNum; i++)
+    // Gather once per TTI the state of the UEs that can be allocated RBGs in contiguous
+    // arrays, indexed by the slot of the UE in m_flowStatsDl, so that the metric of all the
+    // UEs for a given RBG is computed in a tight loop without any lookup
+    const std::size_t nUes = m_flowStatsDl.size();
+    std::vector<uint8_t> ueEligible(nUes, 0);
+    std::vector<uint8_t> ueLayers(nUes, 0);
+    std::vector<const SbMeasResult_s*> ueSbMeas(nUes, nullptr);
+    std::vector<double> ueAvgThroughput(nUes, 0.0);
+    std::vector<unsigned int> ueLcActive(nUes, 0);
+    for (const auto& [flowId, rlcBufferReq] : m_rlcBufferReq)
     {
-        NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
-        if (!rbgMap.at(i))
+        if ((rlcBufferReq.m_rlcTransmissionQueueSize > 0) ||
+            (rlcBufferReq.m_rlcRetransmissionQueueSize > 0) ||
+            (rlcBufferReq.m_rlcStatusPduSize > 0))
         {
-            auto itMax = m_flowStatsDl.end();
-            double rcqiMax = 0.0;
-            for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            if (auto slot = m_flowStatsDl.GetSlot(flowId.m_rnti); slot < nUes)
             {
-                if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first))
-                {
-                    continue;
-                }
-
-                auto itRnti = rntiAllocated.find((*it).first);
-                if (itRnti != rntiAllocated.end() || !HarqProcessAvailability((*it).first))
-                {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx"
-                                          << (uint16_t)(*it).first);
-                    }
-                    if (!HarqProcessAvailability((*it).first))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ id"
-                                          << (uint16_t)(*it).first);
-                    }
-                    continue;
-                }
-                auto itCqi = m_a30CqiRxed.find((*it).first);
-                auto itTxMode = m_uesTxMode.find((*it).first);
-                if (itTxMode == m_uesTxMode.end())
-                {
-                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    sbCqi = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
-                uint8_t cqi1 = sbCqi.at(0);
-                uint8_t cqi2 = 0;
-                if (sbCqi.size() > 1)
-                {
-                    cqi2 = sbCqi.at(1);
-                }
-
-                if ((cqi1 > 0) ||
-                    (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                    if (LcActivePerFlow((*it).first) > 0)
-                    {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        uint8_t mcs = 0;
-                        for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                            if (sbCqi.size() > k)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
-                        }
-
-                        double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                        NS_LOG_INFO(this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs
-                                         << " achievableRate " << achievableRate << " avgThr "
-                                         << (*it).second.lastAveragedThroughput << " RCQI "
-                                         << rcqi);
+                ueLcActive[slot]++;
+            }
+        }
+    }
+    for (std::size_t u = 0; u < nUes; u++)
+    {
+        const auto& [rnti, flowStats] = *(m_flowStatsDl.begin() + u);
+        if (rntiAllocated.contains(rnti) || !HarqProcessAvailability(rnti))
+        {
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            NS_LOG_DEBUG(this << " RNTI " << rnti << " discarded for HARQ");
+            continue;
+        }
+        auto itTxMode = m_uesTxMode.find(rnti);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << rnti);
+        }
+        if (ueLcActive[u] == 0)
+        {
+            // this UE has no data to transmit
+            continue;
+        }
+        ueEligible[u] = 1;
+        ueLayers[u] = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        auto itCqi = m_a30CqiRxed.find(rnti);
+        ueSbMeas[u] = (itCqi == m_a30CqiRxed.end()) ? nullptr : &(*itCqi).second;
+        ueAvgThroughput[u] = flowStats.lastAveragedThroughput;
+    }
 
-                        if (rcqi > rcqiMax)
-                        {
-                            rcqiMax = rcqi;
-                            itMax = it;
-                        }
-                    }
-                } // end if cqi
-            }     // end for m_rlcBufferReq
+    // achievable rate (TB size / TTI) of an RBG for each CQI value
+    std::array<double, 16> cqiRate;
+    for (uint8_t cqi = 0; cqi < cqiRate.size(); cqi++)
+    {
+        cqiRate[cqi] = (m_amc->GetDlTbSizeFromMcs(m_amc->GetMcsFromCqi(cqi), rbgSize) / 8) / 0.001;
+    }
+    // achievable rate of an RBG for a layer with no info on the subband -> worst MCS
+    const double noCqiRate = (m_amc->GetDlTbSizeFromMcs(0, rbgSize) / 8) / 0.001;
 
-            if (itMax == m_flowStatsDl.end())
+    std::vector<double> rcqi(nUes);
+    for (int i = 0; i < rbgNum; i++)
+    {
+        NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
+        if (rbgMap.at(i))
+        {
+            continue;
+        }
+        for (std::size_t u = 0; u < nUes; u++)
+        {
+            rcqi[u] = 0.0;
+            if (!ueEligible[u] ||
+                !m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*(m_flowStatsDl.begin() + u)).first))
             {
-                // no UE available for this RB
-                NS_LOG_INFO(this << " any UE found");
+                continue;
             }
-            else
+            const auto nLayer = ueLayers[u];
+            uint8_t sbCqi[2] = {1, 1}; // no CQI report: start with lowest value
+            uint8_t nSbCqi = nLayer;
+            if (ueSbMeas[u])
             {
-                rbgMap.at(i) = true;
-                auto itMap = allocationMap.find((*itMax).first);
-                if (itMap == allocationMap.end())
-                {
-                    // insert new element
-                    std::vector<uint16_t> tempMap;
-                    tempMap.push_back(i);
-                    allocationMap[(*itMax).first] = tempMap;
-                }
-                else
-                {
-                    (*itMap).second.push_back(i);
-                }
-                NS_LOG_INFO(this << " UE assigned " << (*itMax).first);
+                const auto& cqis = ueSbMeas[u]->m_higherLayerSelected.at(i).m_sbCqi;
+                nSbCqi = std::min<std::size_t>(cqis.size(), 2);
+                sbCqi[0] = cqis.at(0);
+                sbCqi[1] = (nSbCqi > 1) ? cqis[1] : 0;
+            }
+            // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+            if (sbCqi[0] == 0 && (nSbCqi < 2 || sbCqi[1] == 0))
+            {
+                continue;
+            }
+            double achievableRate = 0.0;
+            for (uint8_t k = 0; k < nLayer; k++)
+            {
+                achievableRate += (k < nSbCqi) ? cqiRate[sbCqi[k]] : noCqiRate;
             }
-        } // end for RBG free
-    }     // end for RBGs
+            rcqi[u] = achievableRate / ueAvgThroughput[u];
+        }
+
+        // select the UE with the highest metric (the first one in case of a tie)
+        std::size_t uMax = nUes;
+        double rcqiMax = 0.0;
+        for (std::size_t u = 0; u < nUes; u++)
+        {
+            if (rcqi[u] > rcqiMax)
+            {
+                rcqiMax = rcqi[u];
+                uMax = u;
+            }
+        }
+
+        if (uMax == nUes)
+        {
+            // no UE available for this RB
+            NS_LOG_INFO(this << " any UE found");
+        }
+        else
+        {
+            const auto rnti = (*(m_flowStatsDl.begin() + uMax)).first;
+            NS_LOG_INFO(this << " UE assigned " << rnti << " RCQI " << rcqiMax);
+            rbgMap.at(i) = true;
+            allocationMap[rnti].push_back(i);
+        }
+    } // end for RBGs
 
     // reset TTI stats of users
     for (auto itStats = m_flowStatsDl.begin(); itStats != m_flowStatsDl.end(); itStats++)
@@ -1339,7 +1345,8 @@ PfFfMacScheduler::DoSchedUlTriggerReq(
                          << (0xF & params.m_sfnSf) << " size " << params.m_ulInfoList.size());
 
     RefreshUlCqiMaps();
-    m_ffrSapProvider->ReportUlCqiInfo(m_ueCqi);
+    m_ffrSapProvider->ReportUlCqiInfo(
+        std::map<uint16_t, std::vector<double>>(m_ueCqi.begin(), m_ueCqi.end()));
 
     // Generate RBs map
     FfMacSchedSapUser::SchedUlConfigIndParameters ret;
@@ -1456,7 +1463,7 @@ PfFfMacScheduler::DoSchedUlTriggerReq(
         }
     }
 
-    std::map<uint16_t, uint32_t>::iterator it;
+    FfMacUeStateTable<uint32_t>::iterator it;
     int nflows = 0;
 
     for (it = m_ceBsrRxed.begin(); it != m_ceBsrRxed.end(); it++)
@@ -1960,9 +1967,7 @@ PfFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itP10).first);
             NS_LOG_INFO(this << " P10-CQI expired for user " << (*itP10).first);
             m_p10CqiRxed.erase(itMap);
-            auto temp = itP10;
-            itP10++;
-            m_p10CqiTimers.erase(temp);
+            itP10 = m_p10CqiTimers.erase(itP10);
         }
         else
         {
@@ -1985,9 +1990,7 @@ PfFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itA30).first);
             NS_LOG_INFO(this << " A30-CQI expired for user " << (*itA30).first);
             m_a30CqiRxed.erase(itMap);
-            auto temp = itA30;
-            itA30++;
-            m_a30CqiTimers.erase(temp);
+            itA30 = m_a30CqiTimers.erase(itA30);
         }
         else
         {
@@ -2015,9 +2018,7 @@ PfFfMacScheduler::RefreshUlCqiMaps()
             NS_LOG_INFO(this << " UL-CQI exired for user " << (*itUl).first);
             (*itMap).second.clear();
             m_ueCqi.erase(itMap);
-            auto temp = itUl;
-            itUl++;
-            m_ueCqiTimers.erase(temp);
+            itUl = m_ueCqiTimers.erase(itUl);
         }
         else
         {
@@ -12,6 +12,7 @@
 #include "ff-mac-csched-sap.h"
 #include "ff-mac-sched-sap.h"
 #include "ff-mac-scheduler.h"
+#include "ff-mac-ue-state-table.h"
 #include "lte-amc.h"
 #include "lte-common.h"
 #include "lte-ffr-sap.h"
@@ -290,30 +291,30 @@ class PfFfMacScheduler : public FfMacScheduler
     /**
      * Map of UE statistics (per RNTI basis) in downlink
      */
-    std::map<uint16_t, pfsFlowPerf_t> m_flowStatsDl;
+    FfMacUeStateTable<pfsFlowPerf_t> m_flowStatsDl;
 
     /**
      * Map of UE statistics (per RNTI basis)
      */
-    std::map<uint16_t, pfsFlowPerf_t> m_flowStatsUl;
+    FfMacUeStateTable<pfsFlowPerf_t> m_flowStatsUl;
 
     /**
      * Map of UE's DL CQI P01 received
      */
-    std::map<uint16_t, uint8_t> m_p10CqiRxed;
+    FfMacUeStateTable<uint8_t> m_p10CqiRxed;
     /**
      * Map of UE's timers on DL CQI P01 received
      */
-    std::map<uint16_t, uint32_t> m_p10CqiTimers;
+    FfMacUeStateTable<uint32_t> m_p10CqiTimers;
 
     /**
      * Map of UE's DL CQI A30 received
      */
-    std::map<uint16_t, SbMeasResult_s> m_a30CqiRxed;
+    FfMacUeStateTable<SbMeasResult_s> m_a30CqiRxed;
     /**
      * Map of UE's timers on DL CQI A30 received
      */
-    std::map<uint16_t, uint32_t> m_a30CqiTimers;
+    FfMacUeStateTable<uint32_t> m_a30CqiTimers;
 
     /**
      * Map of previous allocated UE per RBG
@@ -324,16 +325,16 @@ class PfFfMacScheduler : public FfMacScheduler
     /**
      * Map of UEs' UL-CQI per RBG
      */
-    std::map<uint16_t, std::vector<double>> m_ueCqi;
+    FfMacUeStateTable<std::vector<double>> m_ueCqi;
     /**
      * Map of UEs' timers on UL-CQI per RBG
      */
-    std::map<uint16_t, uint32_t> m_ueCqiTimers;
+    FfMacUeStateTable<uint32_t> m_ueCqiTimers;
 
     /**
      * Map of UE's buffer status reports received
      */
-    std::map<uint16_t, uint32_t> m_ceBsrRxed;
+    FfMacUeStateTable<uint32_t> m_ceBsrRxed;
 
     // MAC SAPs
     FfMacCschedSapUser* m_cschedSapUser;         ///< CSched SAP user
@@ -355,31 +356,31 @@ class PfFfMacScheduler : public FfMacScheduler
 
     uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
 
-    std::map<uint16_t, uint8_t> m_uesTxMode; ///< txMode of the UEs
+    FfMacUeStateTable<uint8_t> m_uesTxMode; ///< txMode of the UEs
 
     // HARQ attributes
     /**
      * m_harqOn when false inhibit the HARQ mechanisms (by default active)
      */
     bool m_harqOn;
-    std::map<uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
+    FfMacUeStateTable<uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
     // HARQ status
     //  0: process Id available
     //  x>0: process Id equal to `x` transmission count
-    std::map<uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
-    std::map<uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;   ///< DL HARQ process timer
-    std::map<uint16_t, DlHarqProcessesDciBuffer_t>
+    FfMacUeStateTable<DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
+    FfMacUeStateTable<DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;   ///< DL HARQ process timer
+    FfMacUeStateTable<DlHarqProcessesDciBuffer_t>
         m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-    std::map<uint16_t, DlHarqRlcPduListBuffer_t>
+    FfMacUeStateTable<DlHarqRlcPduListBuffer_t>
         m_dlHarqProcessesRlcPduListBuffer;                 ///< DL HARQ process RLC PDU list buffer
     std::vector<DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
 
-    std::map<uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
+    FfMacUeStateTable<uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
     // HARQ status
     //  0: process Id available
     //  x>0: process Id equal to `x` transmission count
-    std::map<uint16_t, UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
-    std::map<uint16_t, UlHarqProcessesDciBuffer_t>
+    FfMacUeStateTable<UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
+    FfMacUeStateTable<UlHarqProcessesDciBuffer_t>
         m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer
 
     // RACH attributes
@@ -1373,7 +1373,8 @@ TdTbfqFfMacScheduler::DoSchedUlTriggerReq(
                          << (0xF & params.m_sfnSf) << " size " << params.m_ulInfoList.size());
 
     RefreshUlCqiMaps();
-    m_ffrSapProvider->ReportUlCqiInfo(m_ueCqi);
+    m_ffrSapProvider->ReportUlCqiInfo(
+        std::map<uint16_t, std::vector<double>>(m_ueCqi.begin(), m_ueCqi.end()));
 
     // Generate RBs map
     FfMacSchedSapUser::SchedUlConfigIndParameters ret;
@@ -1490,7 +1491,7 @@ TdTbfqFfMacScheduler::DoSchedUlTriggerReq(
         }
     }
 
-    std::map<uint16_t, uint32_t>::iterator it;
+    FfMacUeStateTable<uint32_t>::iterator it;
     int nflows = 0;
 
     for (it = m_ceBsrRxed.begin(); it != m_ceBsrRxed.end(); it++)
@@ -1964,9 +1965,7 @@ TdTbfqFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itP10).first);
             NS_LOG_INFO(this << " P10-CQI expired for user " << (*itP10).first);
             m_p10CqiRxed.erase(itMap);
-            auto temp = itP10;
-            itP10++;
-            m_p10CqiTimers.erase(temp);
+            itP10 = m_p10CqiTimers.erase(itP10);
         }
         else
         {
@@ -1989,9 +1988,7 @@ TdTbfqFfMacScheduler::RefreshDlCqiMaps()
                           " Does not find CQI report for user " << (*itA30).first);
             NS_LOG_INFO(this << " A30-CQI expired for user " << (*itA30).first);
             m_a30CqiRxed.erase(itMap);
-            auto temp = itA30;
-            itA30++;
-            m_a30CqiTimers.erase(temp);
+            itA30 = m_a30CqiTimers.erase(itA30);
         }
         else
         {
@@ -2019,9 +2016,7 @@ TdTbfqFfMacScheduler::RefreshUlCqiMaps()
             NS_LOG_INFO(this << " UL-CQI exired for user " << (*itUl).first);
             (*itMap).second.clear();
             m_ueCqi.erase(itMap);
-            auto temp = itUl;
-            itUl++;
-            m_ueCqiTimers.erase(temp);
+            itUl = m_ueCqiTimers.erase(itUl);
         }
         else
         {
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ff-mac-ue-state-table.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestFfMacUeStateTable");
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test case that checks that FfMacUeStateTable keeps its entries sorted
+ * by RNTI and behaves as a std::map for the operations used by the schedulers.
+ */
+class LteFfMacUeStateTableTestCase : public TestCase
+{
+  public:
+    LteFfMacUeStateTableTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LteFfMacUeStateTableTestCase::LteFfMacUeStateTableTestCase()
+    : TestCase("Check the insertion, lookup and removal of UEs in the table")
+{
+}
+
+void
+LteFfMacUeStateTableTestCase::DoRun()
+{
+    FfMacUeStateTable<double> table;
+    NS_TEST_ASSERT_MSG_EQ(table.empty(), true, "A new table should be empty");
+
+    table[7] = 7.5;
+    auto [it, inserted] = table.insert({3, 3.5});
+    NS_TEST_EXPECT_MSG_EQ(inserted, true, "RNTI 3 should have been inserted");
+    NS_TEST_EXPECT_MSG_EQ(it->first, 3, "Wrong RNTI of the inserted entry");
+    table.emplace(11, 11.5);
+    table.emplace(1, 1.5);
+    bool insertedAgain = table.insert({3, 0.0}).second;
+    NS_TEST_EXPECT_MSG_EQ(insertedAgain, false, "RNTI 3 should not be inserted twice");
+    NS_TEST_EXPECT_MSG_EQ(table.at(3), 3.5, "The state of RNTI 3 should not be overwritten");
+    NS_TEST_ASSERT_MSG_EQ(table.size(), 4, "Wrong number of UEs");
+
+    // the entries are visited in increasing order of RNTI, their slot being their position
+    std::vector<uint16_t> rntis;
+    for (const auto& [rnti, state] : table)
+    {
+        NS_TEST_EXPECT_MSG_EQ(state, rnti + 0.5, "Wrong state of RNTI " << rnti);
+        NS_TEST_EXPECT_MSG_EQ(table.GetSlot(rnti), rntis.size(), "Wrong slot of RNTI " << rnti);
+        rntis.push_back(rnti);
+    }
+    NS_TEST_EXPECT_MSG_EQ((rntis == std::vector<uint16_t>{1, 3, 7, 11}),
+                          true,
+                          "The UEs should be sorted by RNTI");
+
+    NS_TEST_EXPECT_MSG_EQ((table.find(5) == table.end()), true, "RNTI 5 should not be found");
+    NS_TEST_EXPECT_MSG_EQ(table.GetSlot(5), table.size(), "RNTI 5 should not have a slot");
+    NS_TEST_EXPECT_MSG_EQ(table.count(11), 1, "RNTI 11 should be found");
+    table.find(7)->second = 70;
+    NS_TEST_EXPECT_MSG_EQ(table[7], 70, "The state of RNTI 7 should have been updated");
+
+    NS_TEST_EXPECT_MSG_EQ(table.erase(5), 0, "RNTI 5 should not be erased");
+    NS_TEST_EXPECT_MSG_EQ(table.erase(3), 1, "RNTI 3 should be erased");
+    auto next = table.erase(table.find(1));
+    NS_TEST_EXPECT_MSG_EQ(next->first, 7, "Erasing RNTI 1 should return RNTI 7");
+    NS_TEST_EXPECT_MSG_EQ(table.GetSlot(11), 1, "The slot of RNTI 11 should have been updated");
+    NS_TEST_EXPECT_MSG_EQ(table[2], 0, "A new entry should be value-initialized");
+    NS_TEST_EXPECT_MSG_EQ(table.begin()->first, 2, "RNTI 2 should be first");
+
+    table.clear();
+    NS_TEST_EXPECT_MSG_EQ(table.size(), 0, "The table should be empty after clear()");
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test suite for the per-UE state table of the FF MAC schedulers.
+ */
+class LteFfMacUeStateTableTestSuite : public TestSuite
+{
+  public:
+    LteFfMacUeStateTableTestSuite();
+};
+
+LteFfMacUeStateTableTestSuite::LteFfMacUeStateTableTestSuite()
+    : TestSuite("lte-ff-mac-ue-state-table", Type::UNIT)
+{
+    AddTestCase(new LteFfMacUeStateTableTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteFfMacUeStateTableTestSuite g_lteFfMacUeStateTableTestSuite;
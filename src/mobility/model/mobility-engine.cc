@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mobility-engine.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityEngine");
+
+NS_OBJECT_ENSURE_REGISTERED(MobilityEngine);
+
+TypeId
+MobilityEngine::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MobilityEngine")
+            .SetParent<Object>()
+            .SetGroupName("Mobility")
+            .AddConstructor<MobilityEngine>()
+            .AddAttribute("Tick",
+                          "The interval between two updates of all the positions. Between two "
+                          "updates, the position at the previous update is returned. Zero means "
+                          "that the positions are computed exactly when they are requested. "
+                          "This attribute must be set before adding any mobility model.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&MobilityEngine::m_tick),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+MobilityEngine::MobilityEngine()
+    : m_nMoving(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MobilityEngine::~MobilityEngine()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& model : m_models)
+    {
+        model->m_engine = nullptr;
+    }
+}
+
+void
+MobilityEngine::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    for (const auto& model : m_models)
+    {
+        model->m_engine = nullptr;
+    }
+    m_models.clear();
+    m_nMoving = 0;
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_vz.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+MobilityEngine::Add(Ptr<MobilityModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    NS_ABORT_MSG_IF(model->m_engine, "The mobility model already belongs to an engine");
+    if (m_models.empty())
+    {
+        m_reference = Simulator::Now();
+    }
+    uint32_t index = m_models.size();
+    m_models.push_back(model);
+    m_x.push_back(0);
+    m_y.push_back(0);
+    m_z.push_back(0);
+    m_vx.push_back(0);
+    m_vy.push_back(0);
+    m_vz.push_back(0);
+    Sync(index);
+    model->m_engine = this;
+    model->m_engineIndex = index;
+    return index;
+}
+
+uint32_t
+MobilityEngine::GetN() const
+{
+    return m_models.size();
+}
+
+Ptr<MobilityModel>
+MobilityEngine::Get(uint32_t index) const
+{
+    NS_ASSERT(index < m_models.size());
+    return m_models[index];
+}
+
+Vector
+MobilityEngine::GetPosition(uint32_t index) const
+{
+    NS_ASSERT(index < m_models.size());
+    if (m_tick.IsStrictlyPositive())
+    {
+        return Vector(m_x[index], m_y[index], m_z[index]);
+    }
+    double dt = (Simulator::Now() - m_reference).GetSeconds();
+    return Vector(m_x[index] + m_vx[index] * dt,
+                  m_y[index] + m_vy[index] * dt,
+                  m_z[index] + m_vz[index] * dt);
+}
+
+void
+MobilityEngine::GetPositions(std::vector<Vector>& positions) const
+{
+    const std::size_t n = m_models.size();
+    positions.resize(n);
+    double dt = m_tick.IsStrictlyPositive() ? 0 : (Simulator::Now() - m_reference).GetSeconds();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        positions[i] =
+            Vector(m_x[i] + m_vx[i] * dt, m_y[i] + m_vy[i] * dt, m_z[i] + m_vz[i] * dt);
+    }
+}
+
+void
+MobilityEngine::Sync(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    const auto& model = m_models[index];
+    Vector position = model->DoGetPosition();
+    Vector velocity = model->DoGetVelocity();
+    if (m_tick.IsStrictlyPositive() && !m_event.IsPending())
+    {
+        // no model was moving, hence the stored positions are valid at any time
+        m_reference = Simulator::Now();
+    }
+    bool wasMoving = (m_vx[index] != 0 || m_vy[index] != 0 || m_vz[index] != 0);
+    bool isMoving = (velocity.x != 0 || velocity.y != 0 || velocity.z != 0);
+    if (isMoving && !wasMoving)
+    {
+        m_nMoving++;
+    }
+    else if (wasMoving && !isMoving)
+    {
+        m_nMoving--;
+    }
+    // store the position at the reference time along the new course, so that
+    // all the positions are still advanced by the same amount of time
+    double dt = (Simulator::Now() - m_reference).GetSeconds();
+    m_x[index] = position.x - velocity.x * dt;
+    m_y[index] = position.y - velocity.y * dt;
+    m_z[index] = position.z - velocity.z * dt;
+    m_vx[index] = velocity.x;
+    m_vy[index] = velocity.y;
+    m_vz[index] = velocity.z;
+    if (m_tick.IsStrictlyPositive() && m_nMoving > 0 && !m_event.IsPending())
+    {
+        m_event = Simulator::Schedule(m_tick, &MobilityEngine::Advance, this);
+    }
+}
+
+void
+MobilityEngine::Advance()
+{
+    NS_LOG_FUNCTION(this);
+    const Time now = Simulator::Now();
+    const double dt = (now - m_reference).GetSeconds();
+    const std::size_t n = m_models.size();
+    // one loop per coordinate over contiguous arrays, which the compiler vectorizes
+    auto advance = [n, dt](double* position, const double* velocity) {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            position[i] += velocity[i] * dt;
+        }
+    };
+    advance(m_x.data(), m_vx.data());
+    advance(m_y.data(), m_vy.data());
+    advance(m_z.data(), m_vz.data());
+    m_reference = now;
+    // stop ticking when no model moves, so that the simulation can end; the
+    // next course change of a moving model restarts the ticks
+    if (m_nMoving > 0)
+    {
+        m_event = Simulator::Schedule(m_tick, &MobilityEngine::Advance, this);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef MOBILITY_ENGINE_H
+#define MOBILITY_ENGINE_H
+
+#include "mobility-model.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ * @brief A central store of the positions and velocities of a set of mobility models
+ *
+ * The mobility models added to an engine keep their public API, but their
+ * GetPosition() method is served by the engine, which stores the positions
+ * and the velocities of all the models in separate arrays (one per
+ * coordinate) instead of asking each model for its position.  The engine is
+ * updated whenever a model notifies a course change.
+ *
+ * Between two course changes, the position of a model is extrapolated from
+ * its velocity.  The engine is therefore only suitable for the models whose
+ * velocity never changes without a course change notification, e.g.,
+ * ConstantPositionMobilityModel, ConstantVelocityMobilityModel,
+ * RandomWaypointMobilityModel, RandomWalk2dMobilityModel,
+ * RandomDirection2dMobilityModel and GaussMarkovMobilityModel.  It must not
+ * be used with ConstantAccelerationMobilityModel, or with a
+ * WaypointMobilityModel whose LazyNotify attribute is true.
+ *
+ * If the Tick attribute is zero, the positions are computed exactly each
+ * time they are requested.  Otherwise, all the positions are advanced in a
+ * single batch every tick, and the position returned between two ticks is
+ * the one at the previous tick.  The error is then at most the distance
+ * covered in a tick, and the positions are exact at each tick.  The batch
+ * updates are only scheduled while at least one model has a non-zero
+ * velocity, so they do not keep the simulation running once all the models
+ * have stopped.
+ */
+class MobilityEngine : public Object
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MobilityEngine();
+    ~MobilityEngine() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MobilityEngine(const MobilityEngine&) = delete;
+    MobilityEngine& operator=(const MobilityEngine&) = delete;
+
+    /**
+     * Add a mobility model to the engine.  From now on, the position of the
+     * model is served by the engine.  A model can belong to a single engine.
+     *
+     * @param model the mobility model
+     * @return the index of the model in the engine
+     */
+    uint32_t Add(Ptr<MobilityModel> model);
+
+    /**
+     * @return the number of mobility models in the engine
+     */
+    uint32_t GetN() const;
+
+    /**
+     * @param index the index of a mobility model
+     * @return the mobility model
+     */
+    Ptr<MobilityModel> Get(uint32_t index) const;
+
+    /**
+     * @param index the index of a mobility model
+     * @return the current position of the mobility model
+     */
+    Vector GetPosition(uint32_t index) const;
+
+    /**
+     * Get the current positions of all the mobility models.
+     * @param [out] positions the positions, by index of the mobility models
+     */
+    void GetPositions(std::vector<Vector>& positions) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class MobilityModel;
+
+    /**
+     * Read the position and the velocity of a mobility model, after a course
+     * change, and start the batch updates if the model is the only one that
+     * moves.
+     * @param index the index of the mobility model
+     */
+    void Sync(uint32_t index);
+
+    /**
+     * Advance all the positions to the current time.
+     */
+    void Advance();
+
+    Time m_tick;        //!< Interval between two batch updates (zero if exact)
+    Time m_reference;   //!< Time at which the stored positions are valid
+    EventId m_event;    //!< Next batch update
+    uint32_t m_nMoving; //!< Number of models with a non-zero velocity
+
+    std::vector<Ptr<MobilityModel>> m_models; //!< Mobility models, by index
+    std::vector<double> m_x;                  //!< x coordinates at m_reference
+    std::vector<double> m_y;                  //!< y coordinates at m_reference
+    std::vector<double> m_z;                  //!< z coordinates at m_reference
+    std::vector<double> m_vx;                 //!< x components of the velocities
+    std::vector<double> m_vy;                 //!< y components of the velocities
+    std::vector<double> m_vz;                 //!< z components of the velocities
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_ENGINE_H */
@@ -8,6 +8,8 @@
 
 #include "mobility-model.h"
 
+#include "mobility-engine.h"
+
 #include "ns3/trace-source-accessor.h"
 
 #include <cmath>
@@ -45,6 +47,8 @@ MobilityModel::GetTypeId()
 }
 
 MobilityModel::MobilityModel()
+    : m_engine(nullptr),
+      m_engineIndex(0)
 {
 }
 
@@ -55,6 +59,10 @@ MobilityModel::~MobilityModel()
 Vector
 MobilityModel::GetPosition() const
 {
+    if (m_engine)
+    {
+        return m_engine->GetPosition(m_engineIndex);
+    }
     return DoGetPosition();
 }
 
@@ -86,8 +94,8 @@ MobilityModel::SetPosition(const Vector& position)
 double
 MobilityModel::GetDistanceFrom(Ptr<const MobilityModel> other) const
 {
-    Vector oPosition = other->DoGetPosition();
-    Vector position = DoGetPosition();
+    Vector oPosition = other->GetPosition();
+    Vector position = GetPosition();
     return CalculateDistance(position, oPosition);
 }
 
@@ -100,6 +108,10 @@ MobilityModel::GetRelativeSpeed(Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange() const
 {
+    if (m_engine)
+    {
+        m_engine->Sync(m_engineIndex);
+    }
     m_courseChangeTrace(this);
 }
 
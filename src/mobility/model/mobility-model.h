@@ -15,6 +15,8 @@
 namespace ns3
 {
 
+class MobilityEngine;
+
 /**
  * @ingroup mobility
  * @brief Keep track of the current position and velocity of an object.
@@ -37,7 +39,8 @@ class MobilityModel : public Object
     ~MobilityModel() override = 0;
 
     /**
-     * @return the current position
+     * @return the current position; if the model belongs to a MobilityEngine,
+     *         the position is the one stored by the engine
      */
     Vector GetPosition() const;
     /**
@@ -95,6 +98,8 @@ class MobilityModel : public Object
     void NotifyCourseChange() const;
 
   private:
+    friend class MobilityEngine;
+
     /**
      * @return the current position.
      *
@@ -138,6 +143,9 @@ class MobilityModel : public Object
      * or position has occurred.
      */
     ns3::TracedCallback<Ptr<const MobilityModel>> m_courseChangeTrace;
+
+    MobilityEngine* m_engine; //!< The engine serving the position, if any
+    uint32_t m_engineIndex;   //!< The index of this model in m_engine
 };
 
 } // namespace ns3
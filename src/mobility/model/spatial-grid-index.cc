@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "spatial-grid-index.h"
+
+#include "ns3/abort.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGridIndex");
+
+SpatialGridIndex::SpatialGridIndex(double cellSize)
+    : m_cellSize(cellSize),
+      m_maxSpeed(0)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ABORT_MSG_UNLESS(cellSize > 0, "The cell size must be positive");
+}
+
+SpatialGridIndex::~SpatialGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, items] : m_itemsByMobility)
+    {
+        m_items[items.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGridIndex::CourseChanged, this));
+    }
+}
+
+uint64_t
+SpatialGridIndex::GetCellKey(int64_t x, int64_t y)
+{
+    return (static_cast<uint64_t>(x) << 32) ^ (static_cast<uint64_t>(y) & 0xffffffff);
+}
+
+uint64_t
+SpatialGridIndex::GetCell(const Vector& position) const
+{
+    return GetCellKey(static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+                      static_cast<int64_t>(std::floor(position.y / m_cellSize)));
+}
+
+uint32_t
+SpatialGridIndex::Add(Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto id = static_cast<uint32_t>(m_items.size());
+    m_items.push_back({mobility, Vector(), 0, false});
+    if (!mobility)
+    {
+        m_unlocated.push_back(id);
+        return id;
+    }
+    auto& items = m_itemsByMobility[PeekPointer(mobility)];
+    if (items.empty())
+    {
+        mobility->TraceConnectWithoutContext("CourseChange",
+                                             MakeCallback(&SpatialGridIndex::CourseChanged, this));
+    }
+    items.push_back(id);
+    Update(id);
+    return id;
+}
+
+uint32_t
+SpatialGridIndex::GetN() const
+{
+    return m_items.size();
+}
+
+void
+SpatialGridIndex::Link(uint32_t id)
+{
+    Item& item = m_items[id];
+    item.position = item.mobility->GetPosition();
+    item.cell = GetCell(item.position);
+    m_cells[item.cell].push_back(id);
+}
+
+void
+SpatialGridIndex::Unlink(uint32_t id)
+{
+    Item& item = m_items[id];
+    auto& cell = m_cells[item.cell];
+    cell.erase(std::find(cell.begin(), cell.end(), id));
+    if (cell.empty())
+    {
+        m_cells.erase(item.cell);
+    }
+}
+
+void
+SpatialGridIndex::Update(uint32_t id)
+{
+    Item& item = m_items[id];
+    Vector velocity = item.mobility->GetVelocity();
+    bool moving = (velocity.x != 0 || velocity.y != 0 || velocity.z != 0);
+    if (item.moving && !moving)
+    {
+        auto it = std::find(m_moving.begin(), m_moving.end(), id);
+        *it = m_moving.back();
+        m_moving.pop_back();
+    }
+    else if (!item.moving && moving)
+    {
+        if (m_moving.empty())
+        {
+            m_maxSpeed = 0;
+            m_linkTime = Simulator::Now();
+        }
+        m_moving.push_back(id);
+    }
+    item.moving = moving;
+    if (moving)
+    {
+        m_maxSpeed = std::max(m_maxSpeed, velocity.GetLength());
+    }
+    Link(id);
+    NS_LOG_LOGIC("item " << id << " at " << item.position << (moving ? " moving" : ""));
+}
+
+void
+SpatialGridIndex::RelinkMovingItems()
+{
+    NS_LOG_FUNCTION(this << m_moving.size());
+    m_maxSpeed = 0;
+    m_linkTime = Simulator::Now();
+    for (auto id : m_moving)
+    {
+        Unlink(id);
+        Link(id);
+        m_maxSpeed = std::max(m_maxSpeed, m_items[id].mobility->GetVelocity().GetLength());
+    }
+}
+
+void
+SpatialGridIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_itemsByMobility.find(PeekPointer(mobility));
+    if (it == m_itemsByMobility.end())
+    {
+        return;
+    }
+    for (auto id : it->second)
+    {
+        Unlink(id);
+        Update(id);
+    }
+}
+
+void
+SpatialGridIndex::GetItemsWithinDistance(const Vector& position,
+                                         double distance,
+                                         std::vector<uint32_t>& items)
+{
+    NS_LOG_FUNCTION(this << position << distance);
+    items.clear();
+    // the moving items may have left their cells by this distance
+    double drift = m_maxSpeed * (Simulator::Now() - m_linkTime).GetSeconds();
+    if (drift > m_cellSize)
+    {
+        RelinkMovingItems();
+        drift = 0;
+    }
+    const double distance2 = distance * distance;
+    auto isWithinDistance = [&](const Vector& p) {
+        double dx = p.x - position.x;
+        double dy = p.y - position.y;
+        double dz = p.z - position.z;
+        return dx * dx + dy * dy + dz * dz <= distance2;
+    };
+
+    const double range = distance + drift;
+    auto xMin = static_cast<int64_t>(std::floor((position.x - range) / m_cellSize));
+    auto xMax = static_cast<int64_t>(std::floor((position.x + range) / m_cellSize));
+    auto yMin = static_cast<int64_t>(std::floor((position.y - range) / m_cellSize));
+    auto yMax = static_cast<int64_t>(std::floor((position.y + range) / m_cellSize));
+    auto addCell = [&](const std::vector<uint32_t>& cell) {
+        for (auto id : cell)
+        {
+            const Item& item = m_items[id];
+            if (isWithinDistance(item.moving ? item.mobility->GetPosition() : item.position))
+            {
+                items.push_back(id);
+            }
+        }
+    };
+    if (static_cast<double>(xMax - xMin + 1) * (yMax - yMin + 1) > m_cells.size())
+    {
+        // fewer occupied cells than cells in the query range
+        for (const auto& [key, cell] : m_cells)
+        {
+            addCell(cell);
+        }
+    }
+    else
+    {
+        for (int64_t x = xMin; x <= xMax; x++)
+        {
+            for (int64_t y = yMin; y <= yMax; y++)
+            {
+                auto cell = m_cells.find(GetCellKey(x, y));
+                if (cell != m_cells.end())
+                {
+                    addCell(cell->second);
+                }
+            }
+        }
+    }
+    items.insert(items.end(), m_unlocated.begin(), m_unlocated.end());
+    std::sort(items.begin(), items.end());
+}
+
+} // namespace ns3
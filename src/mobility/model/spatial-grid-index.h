@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef SPATIAL_GRID_INDEX_H
+#define SPATIAL_GRID_INDEX_H
+
+#include "mobility-model.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ * @brief A uniform grid of the positions of a set of mobility models
+ *
+ * This index answers the question "which of the items are within a given
+ * distance from a position?" without computing the distance to every item.
+ * It is used by channels to skip the receivers that are out of range of a
+ * transmitter before any propagation computation.
+ *
+ * Each item is associated with a MobilityModel (several items may share the
+ * same model).  The items are stored in the cells of a grid in the x-y
+ * plane; the index listens to the CourseChange trace of their mobility
+ * models to move them across the cells.  Since the position of a moving
+ * node changes without any notification between two course changes, a
+ * moving item stays in the cell of the position it had when it was put in
+ * the grid, and a query also looks at the cells within the distance that
+ * the fastest item may have moved since then, checking the moving items
+ * against their current position.  When that distance exceeds the size of
+ * a cell, all the moving items are put back in the cells of their current
+ * positions.  The items without a mobility model are always returned.  The
+ * index is therefore exact for any mobility model that notifies a course
+ * change whenever its velocity changes.
+ */
+class SpatialGridIndex : public SimpleRefCount<SpatialGridIndex>
+{
+  public:
+    /**
+     * Constructor
+     * @param cellSize the size (in meters) of the side of a grid cell; a good
+     *        choice is the query distance
+     */
+    SpatialGridIndex(double cellSize);
+    ~SpatialGridIndex();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialGridIndex(const SpatialGridIndex&) = delete;
+    SpatialGridIndex& operator=(const SpatialGridIndex&) = delete;
+
+    /**
+     * Add an item to the index.
+     * @param mobility the mobility model giving the position of the item,
+     *        or nullptr if the item has no position
+     * @return the identifier of the item, which is the number of items
+     *         added before it
+     */
+    uint32_t Add(Ptr<MobilityModel> mobility);
+
+    /**
+     * @return the number of items in the index
+     */
+    uint32_t GetN() const;
+
+    /**
+     * Find the items within a distance from a position.  The items without
+     * a mobility model are always included.
+     *
+     * @param position the position
+     * @param distance the distance (in meters)
+     * @param [out] items the identifiers of the items, in increasing order
+     */
+    void GetItemsWithinDistance(const Vector& position,
+                                double distance,
+                                std::vector<uint32_t>& items);
+
+  private:
+    /// An item of the index
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model of the item
+        Vector position;             //!< the position of the item when put in its cell
+        uint64_t cell;               //!< the cell of the item
+        bool moving;                 //!< true if the velocity of the item is not zero
+    };
+
+    /**
+     * Get the cell containing a position.
+     * @param position the position
+     * @return the key of the cell
+     */
+    uint64_t GetCell(const Vector& position) const;
+    /**
+     * Get the key of a cell.
+     * @param x the cell coordinate along the x axis
+     * @param y the cell coordinate along the y axis
+     * @return the key of the cell
+     */
+    static uint64_t GetCellKey(int64_t x, int64_t y);
+    /**
+     * Put an item in the cell of its current position.
+     * @param id the identifier of the item
+     */
+    void Link(uint32_t id);
+    /**
+     * Remove an item from its cell.
+     * @param id the identifier of the item
+     */
+    void Unlink(uint32_t id);
+    /**
+     * Update the position and the velocity of an item.
+     * @param id the identifier of an item with a mobility model
+     */
+    void Update(uint32_t id);
+    /// Put the moving items in the cells of their current positions
+    void RelinkMovingItems();
+    /**
+     * Callback for the CourseChange trace of the mobility models.
+     * @param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;         //!< Size of a cell
+    std::vector<Item> m_items; //!< Items, by identifier
+    /// Items with a mobility model, by cell
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    /// Items without a mobility model
+    std::vector<uint32_t> m_unlocated;
+    /// Moving items
+    std::vector<uint32_t> m_moving;
+    /// Upper bound of the speed of the moving items
+    double m_maxSpeed;
+    /// Time before which none of the moving items was put in its cell
+    Time m_linkTime;
+    /// Items, by mobility model
+    std::unordered_map<const MobilityModel*, std::vector<uint32_t>> m_itemsByMobility;
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_INDEX_H */
@@ -0,0 +1,252 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/gauss-markov-mobility-model.h"
+#include "ns3/mobility-engine.h"
+#include "ns3/pointer.h"
+#include "ns3/position-allocator.h"
+#include "ns3/random-waypoint-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Compare the positions served by a MobilityEngine with the ones of
+ * identical mobility models that do not belong to the engine
+ */
+class MobilityEngineTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param tick the Tick attribute of the engine
+     */
+    MobilityEngineTestCase(Time tick);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a mobility model and a twin model that moves identically.
+     * @param index the index of the pair, used to select the model type and
+     *        the random variable streams
+     */
+    void CreatePair(uint32_t index);
+
+    /**
+     * Check the positions of the models of the engine against their twins.
+     */
+    void Check();
+
+    Time m_tick;                         //!< Tick of the engine
+    Ptr<MobilityEngine> m_engine;        //!< The engine under test
+    std::vector<Ptr<MobilityModel>> m_a; //!< Models of the engine
+    std::vector<Ptr<MobilityModel>> m_b; //!< Twin models, outside of the engine
+    static constexpr double MAX_SPEED = 10; //!< Maximum speed of the models, in m/s
+};
+
+MobilityEngineTestCase::MobilityEngineTestCase(Time tick)
+    : TestCase("Check the positions served by MobilityEngine, tick=" +
+               std::to_string(tick.GetMilliSeconds()) + "ms"),
+      m_tick(tick)
+{
+}
+
+void
+MobilityEngineTestCase::CreatePair(uint32_t index)
+{
+    std::vector<Ptr<MobilityModel>> models;
+    for (int i = 0; i < 2; i++)
+    {
+        Ptr<MobilityModel> model;
+        switch (index % 4)
+        {
+        case 0: {
+            auto allocator = CreateObject<RandomRectanglePositionAllocator>();
+            allocator->SetAttribute("X", StringValue("ns3::UniformRandomVariable[Min=0|Max=500]"));
+            allocator->SetAttribute("Y", StringValue("ns3::UniformRandomVariable[Min=0|Max=500]"));
+            allocator->AssignStreams(10 * index);
+            model = CreateObjectWithAttributes<RandomWaypointMobilityModel>(
+                "Speed",
+                StringValue("ns3::UniformRandomVariable[Min=1|Max=10]"),
+                "Pause",
+                StringValue("ns3::UniformRandomVariable[Min=0|Max=2]"),
+                "PositionAllocator",
+                PointerValue(allocator));
+            model->SetPosition(allocator->GetNext());
+            break;
+        }
+        case 1:
+            model = CreateObjectWithAttributes<GaussMarkovMobilityModel>(
+                "MeanVelocity",
+                StringValue("ns3::UniformRandomVariable[Min=1|Max=3]"),
+                "NormalVelocity",
+                StringValue("ns3::NormalRandomVariable[Mean=0|Variance=1|Bound=2]"),
+                "TimeStep",
+                TimeValue(MilliSeconds(700)));
+            break;
+        case 2: {
+            auto cv = CreateObject<ConstantVelocityMobilityModel>();
+            cv->SetPosition(Vector(index, -3.0 * index, 1.5));
+            cv->SetVelocity(Vector(2.5, -4, 0.1 * index));
+            model = cv;
+            Simulator::Schedule(Seconds(3.3), [cv]() { cv->SetVelocity(Vector(-6, 1, 0)); });
+            Simulator::Schedule(Seconds(5.1), [cv]() { cv->SetPosition(Vector(0, 0, 0)); });
+            break;
+        }
+        default:
+            model = CreateObject<ConstantPositionMobilityModel>();
+            model->SetPosition(Vector(7.0 * index, 2, 0));
+            break;
+        }
+        model->AssignStreams(10 * index + 1);
+        model->Initialize();
+        models.push_back(model);
+    }
+    m_a.push_back(models[0]);
+    m_b.push_back(models[1]);
+    uint32_t engineIndex = m_engine->Add(models[0]);
+    NS_TEST_EXPECT_MSG_EQ(engineIndex, index, "Wrong index in the engine");
+}
+
+void
+MobilityEngineTestCase::Check()
+{
+    // in exact mode, the only difference comes from rounding errors
+    double tolerance = 1e-6 + MAX_SPEED * m_tick.GetSeconds();
+    std::vector<Vector> positions;
+    m_engine->GetPositions(positions);
+    NS_TEST_ASSERT_MSG_EQ(positions.size(), m_a.size(), "Wrong number of positions");
+    for (std::size_t i = 0; i < m_a.size(); i++)
+    {
+        Vector expected = m_b[i]->GetPosition();
+        Vector position = m_a[i]->GetPosition();
+        double error = CalculateDistance(position, expected);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(error,
+                                    tolerance,
+                                    "Wrong position of model " << i << " at t="
+                                                               << Simulator::Now().As(Time::S)
+                                                               << ": " << position << " instead of "
+                                                               << expected);
+        error = CalculateDistance(positions[i], position);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(error, 1e-9, "GetPositions differs from GetPosition");
+    }
+}
+
+void
+MobilityEngineTestCase::DoRun()
+{
+    m_engine = CreateObjectWithAttributes<MobilityEngine>("Tick", TimeValue(m_tick));
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        CreatePair(i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_engine->GetN(), m_a.size(), "Wrong number of models");
+
+    for (Time t = Seconds(0); t < Seconds(20); t += MilliSeconds(130))
+    {
+        Simulator::Schedule(t, &MobilityEngineTestCase::Check, this);
+    }
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    m_engine->Dispose();
+    m_engine = nullptr;
+    m_a.clear();
+    m_b.clear();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check that a ticked MobilityEngine only ticks while a model moves,
+ * so that Simulator::Run() returns without Simulator::Stop()
+ */
+class MobilityEngineStopTestCase : public TestCase
+{
+  public:
+    MobilityEngineStopTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MobilityEngineStopTestCase::MobilityEngineStopTestCase()
+    : TestCase("Check that the ticks of MobilityEngine stop when no model moves")
+{
+}
+
+void
+MobilityEngineStopTestCase::DoRun()
+{
+    auto engine = CreateObjectWithAttributes<MobilityEngine>("Tick", TimeValue(MilliSeconds(50)));
+    auto still = CreateObject<ConstantPositionMobilityModel>();
+    still->SetPosition(Vector(1, 2, 3));
+    engine->Add(still);
+    auto cv = CreateObject<ConstantVelocityMobilityModel>();
+    engine->Add(cv);
+
+    // the model moves from 1 s to 2 s, and from 3 s to 4 s
+    Simulator::Schedule(Seconds(1), [cv]() { cv->SetVelocity(Vector(10, 0, 0)); });
+    Simulator::Schedule(Seconds(2), [cv]() { cv->SetVelocity(Vector(0, 0, 0)); });
+    Simulator::Schedule(Seconds(3), [cv]() { cv->SetVelocity(Vector(0, -10, 0)); });
+    Simulator::Schedule(Seconds(4), [cv]() { cv->SetVelocity(Vector(0, 0, 0)); });
+    Simulator::Schedule(Seconds(2.5), [this, cv]() {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(CalculateDistance(cv->GetPosition(), Vector(10, 0, 0)),
+                                    1e-9,
+                                    "Wrong position while the model is stopped");
+    });
+    // between two ticks, the error is at most the distance covered in a tick
+    Simulator::Schedule(Seconds(3.5), [this, cv]() {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(CalculateDistance(cv->GetPosition(), Vector(10, -5, 0)),
+                                    0.5 + 1e-9,
+                                    "Wrong position after the restart of the ticks");
+    });
+    // no Simulator::Stop(): Run() returns once the engine stops ticking
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(Simulator::Now(),
+                                Seconds(4) + MilliSeconds(50),
+                                "The engine kept ticking after the last course change");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(CalculateDistance(cv->GetPosition(), Vector(10, -10, 0)),
+                                1e-9,
+                                "Wrong final position");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(CalculateDistance(still->GetPosition(), Vector(1, 2, 3)),
+                                1e-9,
+                                "Wrong position of the model that never moves");
+    Simulator::Destroy();
+    engine->Dispose();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief MobilityEngine test suite
+ */
+class MobilityEngineTestSuite : public TestSuite
+{
+  public:
+    MobilityEngineTestSuite();
+};
+
+MobilityEngineTestSuite::MobilityEngineTestSuite()
+    : TestSuite("mobility-engine", Type::UNIT)
+{
+    AddTestCase(new MobilityEngineTestCase(Seconds(0)), TestCase::Duration::QUICK);
+    AddTestCase(new MobilityEngineTestCase(MilliSeconds(50)), TestCase::Duration::QUICK);
+    AddTestCase(new MobilityEngineStopTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MobilityEngineTestSuite g_mobilityEngineTestSuite;
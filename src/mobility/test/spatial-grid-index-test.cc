@@ -0,0 +1,172 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Compare the items returned by SpatialGridIndex with a brute-force search
+ */
+class SpatialGridIndexTestCase : public TestCase
+{
+  public:
+    SpatialGridIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check a query against the distance to every mobility model.
+     * @param position the query position
+     * @param distance the query distance
+     */
+    void Check(const Vector& position, double distance);
+
+    Ptr<SpatialGridIndex> m_index;                //!< The index under test
+    std::vector<Ptr<MobilityModel>> m_mobilities; //!< Mobility models of the items
+};
+
+SpatialGridIndexTestCase::SpatialGridIndexTestCase()
+    : TestCase("Check the items within a distance against a brute-force search")
+{
+}
+
+void
+SpatialGridIndexTestCase::Check(const Vector& position, double distance)
+{
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < m_mobilities.size(); id++)
+    {
+        if (!m_mobilities[id] ||
+            CalculateDistance(m_mobilities[id]->GetPosition(), position) <= distance)
+        {
+            expected.push_back(id);
+        }
+    }
+    std::vector<uint32_t> items;
+    m_index->GetItemsWithinDistance(position, distance, items);
+    NS_TEST_ASSERT_MSG_EQ(items.size(),
+                          expected.size(),
+                          "Wrong number of items at t=" << Simulator::Now().As(Time::S)
+                                                        << " around " << position);
+    NS_TEST_ASSERT_MSG_EQ((items == expected),
+                          true,
+                          "Wrong items at t=" << Simulator::Now().As(Time::S) << " around "
+                                              << position);
+}
+
+void
+SpatialGridIndexTestCase::DoRun()
+{
+    m_index = Create<SpatialGridIndex>(100);
+
+    // stationary items on a grid, including negative coordinates
+    for (int x = -500; x <= 500; x += 70)
+    {
+        for (int y = -300; y <= 300; y += 90)
+        {
+            auto mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(x, y, 0));
+            m_mobilities.push_back(mobility);
+        }
+    }
+    // two items sharing a moving mobility model
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(-400, 0, 0));
+    moving->SetVelocity(Vector(100, 0, 0));
+    m_mobilities.push_back(moving);
+    m_mobilities.push_back(moving);
+    // items moving across several cells between the checks, without any
+    // course change
+    for (const auto& velocity :
+         {Vector(30, -20, 0), Vector(-60, 45, 0), Vector(0, 250, 0), Vector(0, 0, 5)})
+    {
+        auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+        mobility->SetPosition(Vector(20, -10, 0));
+        mobility->SetVelocity(velocity);
+        m_mobilities.push_back(mobility);
+    }
+    // an item without mobility model
+    m_mobilities.push_back(nullptr);
+    // a stationary item that is moved later
+    auto jumping = CreateObject<ConstantPositionMobilityModel>();
+    jumping->SetPosition(Vector(1000, 1000, 0));
+    m_mobilities.push_back(jumping);
+
+    for (const auto& mobility : m_mobilities)
+    {
+        m_index->Add(mobility);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_index->GetN(), m_mobilities.size(), "Wrong number of items");
+
+    const std::vector<Vector> positions = {Vector(0, 0, 0),
+                                           Vector(-410, 5, 0),
+                                           Vector(1000, 950, 0),
+                                           Vector(35, -45, 20)};
+    const std::vector<double> distances = {10, 99, 150, 400, 5000};
+    auto checkAll = [&]() {
+        for (const auto& position : positions)
+        {
+            for (auto distance : distances)
+            {
+                Check(position, distance);
+            }
+        }
+        // around the moving items, which may have left the cells where they were put
+        for (const auto& mobility : m_mobilities)
+        {
+            if (mobility && mobility->GetVelocity().GetLength() > 0)
+            {
+                Check(mobility->GetPosition(), 10);
+            }
+        }
+    };
+
+    checkAll();
+    for (int i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(MilliSeconds(300 + 700 * i), checkAll);
+    }
+    Simulator::Schedule(Seconds(4), checkAll);
+    Simulator::Schedule(Seconds(5), [&]() {
+        jumping->SetPosition(Vector(0, 30, 0));
+        moving->SetVelocity(Vector(0, 0, 0));
+    });
+    Simulator::Schedule(Seconds(6), checkAll);
+    Simulator::Schedule(Seconds(7), [&]() { jumping->SetPosition(Vector(-1000, 30, 0)); });
+    Simulator::Schedule(Seconds(8), checkAll);
+    Simulator::Run();
+    Simulator::Destroy();
+    m_index = nullptr;
+    m_mobilities.clear();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief SpatialGridIndex test suite
+ */
+class SpatialGridIndexTestSuite : public TestSuite
+{
+  public:
+    SpatialGridIndexTestSuite();
+};
+
+SpatialGridIndexTestSuite::SpatialGridIndexTestSuite()
+    : TestSuite("mobility-spatial-grid-index", Type::UNIT)
+{
+    AddTestCase(new SpatialGridIndexTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SpatialGridIndexTestSuite g_spatialGridIndexTestSuite;
@@ -62,9 +62,12 @@ static bool initialized = false; //!< Initialization flag
 
 // Public methods
 
-AnimationInterface::AnimationInterface(const std::string fn)
+AnimationInterface::AnimationInterface(const std::string fn, TraceFormat format)
     : m_f(nullptr),
       m_routingF(nullptr),
+      m_traceFormat(format),
+      m_mobilityPollMinDistance(0),
+      m_packetSampling(1),
       m_mobilityPollInterval(Seconds(0.25)),
       m_outputFileName(fn),
       gAnimUid(0),
@@ -310,6 +313,36 @@ AnimationInterface::SetMobilityPollInterval(Time t)
     m_mobilityPollInterval = t;
 }
 
+void
+AnimationInterface::SetMobilityPollMinDistance(double distance)
+{
+    m_mobilityPollMinDistance = distance;
+}
+
+void
+AnimationInterface::SetPacketSampling(uint32_t n)
+{
+    NS_ABORT_MSG_IF(n == 0, "The packet sampling period must be at least 1");
+    m_packetSampling = n;
+}
+
+void
+AnimationInterface::ConvertBinaryTrace(const std::string& binaryFileName,
+                                       const std::string& xmlFileName)
+{
+    AnimBinaryTraceReader reader(binaryFileName);
+    std::ofstream xml(xmlFileName);
+    if (!xml)
+    {
+        NS_FATAL_ERROR("Unable to open output file:" << xmlFileName);
+    }
+    std::string record;
+    while (reader.Read(record))
+    {
+        xml << record;
+    }
+}
+
 void
 AnimationInterface::SetConstantPosition(Ptr<Node> n, double x, double y, double z)
 {
@@ -457,6 +490,10 @@ bool
 AnimationInterface::NodeHasMoved(Ptr<Node> n, Vector newLocation)
 {
     Vector oldLocation = GetPosition(n);
+    if (m_mobilityPollMinDistance > 0)
+    {
+        return CalculateDistance(oldLocation, newLocation) >= m_mobilityPollMinDistance;
+    }
     bool moved = !((ceil(oldLocation.x) == ceil(newLocation.x)) &&
                    (ceil(oldLocation.y) == ceil(newLocation.y)));
     return moved;
@@ -555,6 +592,29 @@ AnimationInterface::WriteN(const char* data, uint32_t count, FILE* f)
     return written;
 }
 
+void
+AnimationInterface::WriteElement(const AnimXmlElement& element, bool routing, bool autoClose)
+{
+    FILE* f = routing ? m_routingF : m_f;
+    if (m_traceFormat == XML_TRACE)
+    {
+        WriteN(autoClose ? element.ToString() : element.ToString(false) + ">\n", f);
+        return;
+    }
+    if (!f)
+    {
+        return;
+    }
+    if (m_writeCallback)
+    {
+        // the callback still listens to the XML text of the records
+        std::string st = autoClose ? element.ToString() : element.ToString(false) + ">\n";
+        m_writeCallback(st.c_str());
+    }
+    auto& writer = routing ? m_binaryRoutingF : m_binaryF;
+    writer->WriteElement(element, autoClose, Simulator::Now());
+}
+
 void
 AnimationInterface::WriteRoutePath(uint32_t nodeId,
                                    std::string destination,
@@ -823,6 +883,10 @@ AnimationInterface::DevTxTrace(std::string context,
     double lbTx = (now + txTime).GetSeconds();
     double fbRx = (now + rxTime - txTime).GetSeconds();
     double lbRx = (now + rxTime).GetSeconds();
+    if (!IsPacketSampled(tx->GetNode()->GetId(), rx->GetNode()->GetId()))
+    {
+        return;
+    }
     CheckMaxPktsPerTraceFile();
     WriteXmlP("p",
               tx->GetNode()->GetId(),
@@ -1120,7 +1184,7 @@ AnimationInterface::LteSpectrumPhyTxStart(std::string context, Ptr<const PacketB
         AnimPacketInfo pktInfo(ndev, Simulator::Now());
         AddByteTag(gAnimUid, p);
         AddPendingPacket(AnimationInterface::LTE, gAnimUid, pktInfo);
-        OutputWirelessPacketTxInfo(p, pktInfo, gAnimUid);
+        OutputWirelessPacketTxInfo(p, m_pendingLtePackets[gAnimUid], gAnimUid);
     }
 }
 
@@ -1241,7 +1305,6 @@ AnimationInterface::OutputWirelessPacketTxInfo(Ptr<const Packet> p,
                                                AnimPacketInfo& pktInfo,
                                                uint64_t animUid)
 {
-    CheckMaxPktsPerTraceFile();
     uint32_t nodeId = 0;
     if (pktInfo.m_txnd)
     {
@@ -1251,6 +1314,13 @@ AnimationInterface::OutputWirelessPacketTxInfo(Ptr<const Packet> p,
     {
         nodeId = pktInfo.m_txNodeId;
     }
+    // the receptions of a wireless packet are traced if its transmission is
+    pktInfo.m_sampled = IsPacketSampled(nodeId, nodeId);
+    if (!pktInfo.m_sampled)
+    {
+        return;
+    }
+    CheckMaxPktsPerTraceFile();
     WriteXmlPRef(animUid,
                  nodeId,
                  pktInfo.m_fbTx,
@@ -1262,6 +1332,10 @@ AnimationInterface::OutputWirelessPacketRxInfo(Ptr<const Packet> p,
                                                AnimPacketInfo& pktInfo,
                                                uint64_t animUid)
 {
+    if (!pktInfo.m_sampled)
+    {
+        return;
+    }
     CheckMaxPktsPerTraceFile();
     uint32_t rxId = pktInfo.m_rxnd->GetNode()->GetId();
     WriteXmlP(animUid, "wpr", rxId, pktInfo.m_fbRx, pktInfo.m_lbRx);
@@ -1270,10 +1344,14 @@ AnimationInterface::OutputWirelessPacketRxInfo(Ptr<const Packet> p,
 void
 AnimationInterface::OutputCsmaPacket(Ptr<const Packet> p, AnimPacketInfo& pktInfo)
 {
-    CheckMaxPktsPerTraceFile();
     NS_ASSERT(pktInfo.m_txnd);
     uint32_t nodeId = pktInfo.m_txnd->GetNode()->GetId();
     uint32_t rxId = pktInfo.m_rxnd->GetNode()->GetId();
+    if (!IsPacketSampled(nodeId, rxId))
+    {
+        return;
+    }
+    CheckMaxPktsPerTraceFile();
 
     WriteXmlP("p",
               nodeId,
@@ -1442,6 +1520,11 @@ AnimationInterface::StopAnimation(bool onlyAnimation)
     {
         // Terminate the anim element
         WriteXmlClose("anim");
+        if (m_binaryF)
+        {
+            m_binaryF->Close();
+            m_binaryF.reset();
+        }
         std::fclose(m_f);
         m_f = nullptr;
     }
@@ -1452,6 +1535,11 @@ AnimationInterface::StopAnimation(bool onlyAnimation)
     if (m_routingF)
     {
         WriteXmlClose("anim", true);
+        if (m_binaryRoutingF)
+        {
+            m_binaryRoutingF->Close();
+            m_binaryRoutingF.reset();
+        }
         std::fclose(m_routingF);
         m_routingF = nullptr;
     }
@@ -2080,7 +2168,7 @@ AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
 
     NS_LOG_INFO("Creating new trace file:" << fn);
     FILE* f = nullptr;
-    f = std::fopen(fn.c_str(), "w");
+    f = std::fopen(fn.c_str(), m_traceFormat == BINARY_TRACE ? "wb" : "w");
     if (!f)
     {
         NS_FATAL_ERROR("Unable to open output file:" << fn);
@@ -2096,6 +2184,10 @@ AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
         m_f = f;
         m_outputFileName = fn;
     }
+    if (m_traceFormat == BINARY_TRACE)
+    {
+        (routing ? m_binaryRoutingF : m_binaryF) = std::make_unique<AnimBinaryTraceWriter>(f);
+    }
 }
 
 void
@@ -2111,6 +2203,16 @@ AnimationInterface::CheckMaxPktsPerTraceFile()
     StopAnimation(true);
 }
 
+bool
+AnimationInterface::IsPacketSampled(uint32_t fromId, uint32_t toId)
+{
+    if (m_packetSampling == 1)
+    {
+        return true;
+    }
+    return m_linkPktCount[{fromId, toId}]++ % m_packetSampling == 0;
+}
+
 std::string
 AnimationInterface::GetNetAnimVersion()
 {
@@ -2391,7 +2493,6 @@ AnimationInterface::WriteXmlAnim(bool routing)
 {
     AnimXmlElement element("anim");
     element.AddAttribute("ver", GetNetAnimVersion());
-    FILE* f = m_f;
     if (!routing)
     {
         element.AddAttribute("filetype", "animation");
@@ -2399,14 +2500,28 @@ AnimationInterface::WriteXmlAnim(bool routing)
     else
     {
         element.AddAttribute("filetype", "routing");
-        f = m_routingF;
     }
-    WriteN(element.ToString(false) + ">\n", f);
+    WriteElement(element, routing, false);
 }
 
 void
 AnimationInterface::WriteXmlClose(std::string name, bool routing)
 {
+    if (m_traceFormat == BINARY_TRACE)
+    {
+        auto& writer = routing ? m_binaryRoutingF : m_binaryF;
+        if (!writer)
+        {
+            return;
+        }
+        if (m_writeCallback)
+        {
+            m_writeCallback(("</" + name + ">\n").c_str());
+        }
+        // no simulation time, the trace is usually closed after the simulator was destroyed
+        writer->WriteClose(name);
+        return;
+    }
     std::string closeString = "</" + name + ">\n";
     if (!routing)
     {
@@ -2426,7 +2541,7 @@ AnimationInterface::WriteXmlNode(uint32_t id, uint32_t sysId, double locX, doubl
     element.AddAttribute("sysId", sysId);
     element.AddAttribute("locX", locX);
     element.AddAttribute("locY", locY);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2437,7 +2552,7 @@ AnimationInterface::WriteXmlUpdateLink(uint32_t fromId, uint32_t toId, std::stri
     element.AddAttribute("fromId", fromId);
     element.AddAttribute("toId", toId);
     element.AddAttribute("ld", linkDescription, true);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2466,7 +2581,7 @@ AnimationInterface::WriteXmlLink(uint32_t fromId, uint32_t toLp, uint32_t toId)
     element.AddAttribute("fd", lprop.fromNodeDescription, true);
     element.AddAttribute("td", lprop.toNodeDescription, true);
     element.AddAttribute("ld", lprop.linkDescription, true);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2480,7 +2595,7 @@ AnimationInterface::WriteXmlIpv4Addresses(uint32_t nodeId, std::vector<std::stri
         valueElement.SetText(*i);
         element.AppendChild(valueElement);
     }
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2494,7 +2609,7 @@ AnimationInterface::WriteXmlIpv6Addresses(uint32_t nodeId, std::vector<std::stri
         valueElement.SetText(*i);
         element.AppendChild(valueElement);
     }
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2504,7 +2619,7 @@ AnimationInterface::WriteXmlRouting(uint32_t nodeId, std::string routingInfo)
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("info", routingInfo.c_str(), true);
-    WriteN(element.ToString(), m_routingF);
+    WriteElement(element, true);
 }
 
 void
@@ -2525,7 +2640,7 @@ AnimationInterface::WriteXmlRp(uint32_t nodeId,
         rpeElement.AddAttribute("nH", rpElement.nextHop.c_str());
         element.AppendChild(rpeElement);
     }
-    WriteN(element.ToString(), m_routingF);
+    WriteElement(element, true);
 }
 
 void
@@ -2539,7 +2654,7 @@ AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, st
     {
         element.AddAttribute("meta-info", metaInfo.c_str(), true);
     }
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2554,7 +2669,7 @@ AnimationInterface::WriteXmlP(uint64_t animUid,
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2578,7 +2693,7 @@ AnimationInterface::WriteXmlP(std::string pktType,
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2590,7 +2705,7 @@ AnimationInterface::WriteXmlAddNodeCounter(uint32_t nodeCounterId,
     element.AddAttribute("ncId", nodeCounterId);
     element.AddAttribute("n", counterName);
     element.AddAttribute("t", CounterTypeToString(counterType));
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2599,7 +2714,7 @@ AnimationInterface::WriteXmlAddResource(uint32_t resourceId, std::string resourc
     AnimXmlElement element("res");
     element.AddAttribute("rid", resourceId);
     element.AddAttribute("p", resourcePath);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2610,7 +2725,7 @@ AnimationInterface::WriteXmlUpdateNodeImage(uint32_t nodeId, uint32_t resourceId
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("rid", resourceId);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2622,7 +2737,7 @@ AnimationInterface::WriteXmlUpdateNodeSize(uint32_t nodeId, double width, double
     element.AddAttribute("id", nodeId);
     element.AddAttribute("w", width);
     element.AddAttribute("h", height);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2634,7 +2749,7 @@ AnimationInterface::WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double
     element.AddAttribute("id", nodeId);
     element.AddAttribute("x", x);
     element.AddAttribute("y", y);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2647,7 +2762,7 @@ AnimationInterface::WriteXmlUpdateNodeColor(uint32_t nodeId, uint8_t r, uint8_t
     element.AddAttribute("r", (uint32_t)r);
     element.AddAttribute("g", (uint32_t)g);
     element.AddAttribute("b", (uint32_t)b);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2661,7 +2776,7 @@ AnimationInterface::WriteXmlUpdateNodeDescription(uint32_t nodeId)
     {
         element.AddAttribute("descr", m_nodeDescriptions[nodeId], true);
     }
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2674,7 +2789,7 @@ AnimationInterface::WriteXmlUpdateNodeCounter(uint32_t nodeCounterId,
     element.AddAttribute("i", nodeId);
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("v", counterValue);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2692,7 +2807,7 @@ AnimationInterface::WriteXmlUpdateBackground(std::string fileName,
     element.AddAttribute("sx", scaleX);
     element.AddAttribute("sy", scaleY);
     element.AddAttribute("o", opacity);
-    WriteN(element.ToString(), m_f);
+    WriteElement(element);
 }
 
 void
@@ -2704,112 +2819,7 @@ AnimationInterface::WriteXmlNonP2pLinkProperties(uint32_t id,
     element.AddAttribute("id", id);
     element.AddAttribute("ipAddress", ipAddress);
     element.AddAttribute("channelType", channelType);
-    WriteN(element.ToString(), m_f);
-}
-
-/***** AnimXmlElement  *****/
-
-AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emptyElement)
-    : m_tagName(tagName),
-      m_text("")
-{
-}
-
-template <typename T>
-void
-AnimationInterface::AnimXmlElement::AddAttribute(std::string attribute, T value, bool xmlEscape)
-{
-    std::ostringstream oss;
-    oss << std::setprecision(10);
-    oss << value;
-    std::string attributeString = attribute;
-    if (xmlEscape)
-    {
-        attributeString += "=\"";
-        std::string valueStr = oss.str();
-        for (auto it = valueStr.begin(); it != valueStr.end(); ++it)
-        {
-            switch (*it)
-            {
-            case '&':
-                attributeString += "&amp;";
-                break;
-            case '\"':
-                attributeString += "&quot;";
-                break;
-            case '\'':
-                attributeString += "&apos;";
-                break;
-            case '<':
-                attributeString += "&lt;";
-                break;
-            case '>':
-                attributeString += "&gt;";
-                break;
-            default:
-                attributeString += *it;
-                break;
-            }
-        }
-        attributeString += "\" ";
-    }
-    else
-    {
-        attributeString += "=\"" + oss.str() + "\" ";
-    }
-    m_attributes.push_back(attributeString);
-}
-
-void
-AnimationInterface::AnimXmlElement::AppendChild(AnimXmlElement e)
-{
-    m_children.push_back(e.ToString());
-}
-
-void
-AnimationInterface::AnimXmlElement::SetText(std::string text)
-{
-    m_text = text;
-}
-
-std::string
-AnimationInterface::AnimXmlElement::ToString(bool autoClose)
-{
-    std::string elementString = "<" + m_tagName + " ";
-
-    for (auto i = m_attributes.begin(); i != m_attributes.end(); ++i)
-    {
-        elementString += *i;
-    }
-    if (m_children.empty() && m_text.empty())
-    {
-        if (autoClose)
-        {
-            elementString += "/>";
-        }
-    }
-    else
-    {
-        elementString += ">";
-        if (!m_text.empty())
-        {
-            elementString += m_text;
-        }
-        if (!m_children.empty())
-        {
-            elementString += "\n";
-            for (auto i = m_children.begin(); i != m_children.end(); ++i)
-            {
-                elementString += *i + "\n";
-            }
-        }
-        if (autoClose)
-        {
-            elementString += "</" + m_tagName + ">";
-        }
-    }
-
-    return elementString + ((autoClose) ? "\n" : "");
+    WriteElement(element);
 }
 
 /***** AnimByteTag *****/
@@ -2871,7 +2881,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo()
       m_txNodeId(0),
       m_fbTx(0),
       m_lbTx(0),
-      m_lbRx(0)
+      m_lbRx(0),
+      m_sampled(true)
 {
 }
 
@@ -2882,6 +2893,7 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo(const AnimPacketInfo& pInfo)
     m_fbTx = pInfo.m_fbTx;
     m_lbTx = pInfo.m_lbTx;
     m_lbRx = pInfo.m_lbRx;
+    m_sampled = pInfo.m_sampled;
 }
 
 AnimationInterface::AnimPacketInfo::AnimPacketInfo(Ptr<const NetDevice> txnd,
@@ -2891,7 +2903,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo(Ptr<const NetDevice> txnd,
       m_txNodeId(0),
       m_fbTx(fbTx.GetSeconds()),
       m_lbTx(0),
-      m_lbRx(0)
+      m_lbRx(0),
+      m_sampled(true)
 {
     if (!m_txnd)
     {
@@ -12,6 +12,8 @@
 #ifndef ANIMATION_INTERFACE__H
 #define ANIMATION_INTERFACE__H
 
+#include "animation-trace.h"
+
 #include "ns3/config.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4.h"
@@ -32,6 +34,7 @@
 
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace ns3
@@ -76,12 +79,22 @@ class WifiPsdu;
 class AnimationInterface
 {
   public:
+    /**
+     * Trace file formats
+     */
+    enum TraceFormat
+    {
+        XML_TRACE,   ///< XML trace, read by the animator
+        BINARY_TRACE ///< Compact binary trace, converted to XML by ConvertBinaryTrace()
+    };
+
     /**
      * @brief Constructor
      * @param filename The Filename for the trace file used by the Animator
+     * @param format The format of the trace file, and of the routing trace file if any
      *
      */
-    AnimationInterface(const std::string filename);
+    AnimationInterface(const std::string filename, TraceFormat format = XML_TRACE);
 
     /**
      * Counter Types
@@ -225,6 +238,40 @@ class AnimationInterface
      */
     void SetMobilityPollInterval(Time t);
 
+    /**
+     * @brief Set the minimum distance a node must have moved for its position
+     * to be written by the mobility poll
+     *
+     * @param distance Distance in meters from the last known position of the
+     * node. Default: 0, i.e., the position is written whenever its rounded
+     * up coordinates change
+     *
+     */
+    void SetMobilityPollMinDistance(double distance);
+
+    /**
+     * @brief Trace only one packet out of every n on each link
+     *
+     * Point-to-point and CSMA packets are sampled per pair of nodes, wireless
+     * packets per transmitting node. The packets that are not sampled are
+     * neither written to the trace file nor counted by SetMaxPktsPerTraceFile().
+     *
+     * @param n The sampling period, in packets. Default: 1, i.e., all the packets are traced
+     *
+     */
+    void SetPacketSampling(uint32_t n);
+
+    /**
+     * @brief Convert a binary trace file to the XML trace file that
+     * AnimationInterface would have written in the XML format
+     *
+     * @param binaryFileName The binary trace file
+     * @param xmlFileName The XML trace file to write
+     *
+     */
+    static void ConvertBinaryTrace(const std::string& binaryFileName,
+                                   const std::string& xmlFileName);
+
     /**
      * @brief Set a callback function to listen to AnimationInterface write events
      *
@@ -454,6 +501,7 @@ class AnimationInterface
         double m_fbRx;               ///< fb receive
         double m_lbRx;               ///< lb receive
         Ptr<const NetDevice> m_rxnd; ///< receive device
+        bool m_sampled;              ///< whether the packet is written to the trace
         /**
          * Process receive begin
          * @param nd the device
@@ -560,53 +608,18 @@ class AnimationInterface
     // Node Counters
     typedef std::map<uint32_t, uint64_t> NodeCounterMap64; ///< NodeCounterMap64 typedef
 
-    /// AnimXmlElement class
-    class AnimXmlElement
-    {
-      public:
-        /**
-         * Constructor
-         *
-         * @param tagName tag name
-         * @param emptyElement empty element?
-         */
-        AnimXmlElement(std::string tagName, bool emptyElement = true);
-        template <typename T>
-        /**
-         * Add attribute function
-         * @param attribute the attribute name
-         * @param value the attribute value
-         * @param xmlEscape true to escape
-         */
-        void AddAttribute(std::string attribute, T value, bool xmlEscape = false);
-        /**
-         * Set text function
-         * @param text the text for the element
-         */
-        void SetText(std::string text);
-        /**
-         * Append child function
-         * @param e the element to add as a child
-         */
-        void AppendChild(AnimXmlElement e);
-        /**
-         * Get text for the element function
-         * @param autoClose auto close the element
-         * @returns the text
-         */
-        std::string ToString(bool autoClose = true);
-
-      private:
-        std::string m_tagName;                 ///< tag name
-        std::string m_text;                    ///< element string
-        std::vector<std::string> m_attributes; ///< list of attributes
-        std::vector<std::string> m_children;   ///< list of children
-    };
+    typedef AnimTraceElement AnimXmlElement; ///< AnimXmlElement typedef
 
     // ##### State #####
 
     FILE* m_f;                             ///< File handle for output (0 if none)
     FILE* m_routingF;                      ///< File handle for routing table output (0 if None);
+    TraceFormat m_traceFormat;             ///< format of the trace files
+    std::unique_ptr<AnimBinaryTraceWriter> m_binaryF;        ///< binary writer of m_f
+    std::unique_ptr<AnimBinaryTraceWriter> m_binaryRoutingF; ///< binary writer of m_routingF
+    double m_mobilityPollMinDistance;      ///< minimum distance to write a polled position
+    uint32_t m_packetSampling;             ///< packet sampling period
+    std::map<std::pair<uint32_t, uint32_t>, uint64_t> m_linkPktCount; ///< packets per link
     Time m_mobilityPollInterval;           ///< mobility poll interval
     std::string m_outputFileName;          ///< output file name
     uint64_t gAnimUid;                     ///< Packet unique identifier used by AnimationInterface
@@ -871,6 +884,13 @@ class AnimationInterface
     bool IsInTimeWindow();
     /// Check maximum packets per trace file function
     void CheckMaxPktsPerTraceFile();
+    /**
+     * Sample the packets of a link, one out of every m_packetSampling
+     * @param fromId the transmitting node ID
+     * @param toId the receiving node ID, or the transmitting one for wireless packets
+     * @returns true if the packet is traced
+     */
+    bool IsPacketSampled(uint32_t fromId, uint32_t toId);
 
     /// Track wifi phy counters function
     void TrackWifiPhyCounters();
@@ -1294,6 +1314,13 @@ class AnimationInterface
     void WriteNodeSizes();
     /// Write node energies function
     void WriteNodeEnergies();
+    /**
+     * Write an element to the trace file in its format
+     * @param element the element
+     * @param routing true to write it to the routing trace file
+     * @param autoClose false to leave the element open, to be closed by WriteXmlClose()
+     */
+    void WriteElement(const AnimXmlElement& element, bool routing = false, bool autoClose = true);
     /**
      * Write XML anim function
      * @param routing the routing
@@ -0,0 +1,617 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "animation-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AnimationTrace");
+
+/// Magic bytes at the start of a binary trace
+static const char BINARY_TRACE_MAGIC[] = "NSANIMB1";
+/// Magic bytes at the end of a binary trace with an index
+static const char BINARY_INDEX_MAGIC[] = "NSANIMIX";
+/// Length of the magic bytes
+static const std::size_t MAGIC_LENGTH = 8;
+/// Number of encoded bytes handed at once to the background thread
+static const std::size_t BINARY_TRACE_CHUNK = 64 * 1024;
+
+/***** AnimTraceElement *****/
+
+AnimTraceElement::AnimTraceElement(std::string tagName, bool emptyElement)
+    : m_tagName(tagName),
+      m_text("")
+{
+}
+
+void
+AnimTraceElement::AppendChild(AnimTraceElement e)
+{
+    m_children.push_back(std::move(e));
+}
+
+void
+AnimTraceElement::SetText(std::string text)
+{
+    m_text = text;
+}
+
+std::string
+AnimTraceElement::Attribute::GetValue() const
+{
+    std::ostringstream oss;
+    oss << std::setprecision(10);
+    switch (type)
+    {
+    case UNSIGNED:
+        oss << integer;
+        break;
+    case SIGNED:
+        oss << static_cast<int64_t>(integer);
+        break;
+    case DOUBLE:
+        oss << real;
+        break;
+    case STRING:
+        oss << text;
+        break;
+    }
+    return oss.str();
+}
+
+std::string
+AnimTraceElement::ToString(bool autoClose) const
+{
+    std::string elementString = "<" + m_tagName + " ";
+
+    for (const auto& attribute : m_attributes)
+    {
+        elementString += attribute.name + "=\"";
+        std::string valueStr = attribute.GetValue();
+        if (!attribute.xmlEscape)
+        {
+            elementString += valueStr;
+        }
+        else
+        {
+            for (auto it = valueStr.begin(); it != valueStr.end(); ++it)
+            {
+                switch (*it)
+                {
+                case '&':
+                    elementString += "&amp;";
+                    break;
+                case '\"':
+                    elementString += "&quot;";
+                    break;
+                case '\'':
+                    elementString += "&apos;";
+                    break;
+                case '<':
+                    elementString += "&lt;";
+                    break;
+                case '>':
+                    elementString += "&gt;";
+                    break;
+                default:
+                    elementString += *it;
+                    break;
+                }
+            }
+        }
+        elementString += "\" ";
+    }
+    if (m_children.empty() && m_text.empty())
+    {
+        if (autoClose)
+        {
+            elementString += "/>";
+        }
+    }
+    else
+    {
+        elementString += ">";
+        if (!m_text.empty())
+        {
+            elementString += m_text;
+        }
+        if (!m_children.empty())
+        {
+            elementString += "\n";
+            for (const auto& child : m_children)
+            {
+                elementString += child.ToString() + "\n";
+            }
+        }
+        if (autoClose)
+        {
+            elementString += "</" + m_tagName + ">";
+        }
+    }
+
+    return elementString + ((autoClose) ? "\n" : "");
+}
+
+/***** AnimBinaryTraceWriter *****/
+
+AnimBinaryTraceWriter::AnimBinaryTraceWriter(FILE* f, Time indexInterval)
+    : m_f(f),
+      m_indexInterval(indexInterval),
+      m_nextIndexTime(),
+      m_offset(0),
+      m_stop(false),
+      m_closed(false)
+{
+    NS_LOG_FUNCTION(this << f << indexInterval);
+    NS_ASSERT(f);
+    m_buffer.reserve(BINARY_TRACE_CHUNK);
+    m_buffer.insert(m_buffer.end(), BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC + MAGIC_LENGTH);
+    m_thread = std::thread(&AnimBinaryTraceWriter::Run, this);
+}
+
+AnimBinaryTraceWriter::~AnimBinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+AnimBinaryTraceWriter::WriteElement(const AnimTraceElement& element, bool autoClose, Time now)
+{
+    NS_ASSERT_MSG(!m_closed, "The trace is closed");
+    StartRecord(now);
+    InternNames(element);
+    m_buffer.push_back(autoClose ? ELEMENT : OPEN);
+    EncodeElement(element);
+    Submit();
+}
+
+void
+AnimBinaryTraceWriter::WriteClose(const std::string& tagName)
+{
+    NS_ASSERT_MSG(!m_closed, "The trace is closed");
+    uint64_t id = Intern(tagName);
+    m_buffer.push_back(CLOSE);
+    EncodeVarint(id);
+    Submit();
+}
+
+void
+AnimBinaryTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_closed)
+    {
+        return;
+    }
+    m_closed = true;
+
+    uint64_t indexOffset = m_offset + m_buffer.size();
+    m_buffer.push_back(INDEX);
+    EncodeVarint(m_names.size());
+    for (const auto& name : m_names)
+    {
+        EncodeString(name);
+    }
+    EncodeVarint(m_index.size());
+    int64_t previousTime = 0;
+    uint64_t previousOffset = 0;
+    for (const auto& [time, offset] : m_index)
+    {
+        EncodeVarint(time.GetTimeStep() - previousTime);
+        EncodeVarint(offset - previousOffset);
+        previousTime = time.GetTimeStep();
+        previousOffset = offset;
+    }
+    EncodeU64(indexOffset);
+    m_buffer.insert(m_buffer.end(), BINARY_INDEX_MAGIC, BINARY_INDEX_MAGIC + MAGIC_LENGTH);
+    Submit(true);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    std::fflush(m_f);
+}
+
+void
+AnimBinaryTraceWriter::StartRecord(Time now)
+{
+    if (now >= m_nextIndexTime)
+    {
+        m_index.emplace_back(now, m_offset + m_buffer.size());
+        m_nextIndexTime = now + m_indexInterval;
+    }
+}
+
+uint64_t
+AnimBinaryTraceWriter::Intern(const std::string& name)
+{
+    auto [it, inserted] = m_ids.emplace(name, m_names.size());
+    if (inserted)
+    {
+        m_names.push_back(name);
+        m_buffer.push_back(NAME);
+        EncodeVarint(it->second);
+        EncodeString(name);
+    }
+    return it->second;
+}
+
+void
+AnimBinaryTraceWriter::InternNames(const AnimTraceElement& element)
+{
+    Intern(element.m_tagName);
+    for (const auto& attribute : element.m_attributes)
+    {
+        Intern(attribute.name);
+    }
+    for (const auto& child : element.m_children)
+    {
+        InternNames(child);
+    }
+}
+
+void
+AnimBinaryTraceWriter::EncodeElement(const AnimTraceElement& element)
+{
+    EncodeVarint(m_ids.at(element.m_tagName));
+    EncodeVarint(element.m_attributes.size());
+    for (const auto& attribute : element.m_attributes)
+    {
+        EncodeVarint(m_ids.at(attribute.name));
+        m_buffer.push_back(attribute.type | (attribute.xmlEscape ? 0x80 : 0));
+        switch (attribute.type)
+        {
+        case AnimTraceElement::UNSIGNED:
+            EncodeVarint(attribute.integer);
+            break;
+        case AnimTraceElement::SIGNED:
+            // zigzag encoding, for the small negative integers to be short too
+            EncodeVarint((attribute.integer << 1) ^
+                         static_cast<uint64_t>(static_cast<int64_t>(attribute.integer) >> 63));
+            break;
+        case AnimTraceElement::DOUBLE: {
+            uint64_t bits;
+            std::memcpy(&bits, &attribute.real, sizeof(bits));
+            EncodeU64(bits);
+            break;
+        }
+        case AnimTraceElement::STRING:
+            EncodeString(attribute.text);
+            break;
+        }
+    }
+    EncodeString(element.m_text);
+    EncodeVarint(element.m_children.size());
+    for (const auto& child : element.m_children)
+    {
+        EncodeElement(child);
+    }
+}
+
+void
+AnimBinaryTraceWriter::EncodeVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    m_buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void
+AnimBinaryTraceWriter::EncodeString(const std::string& s)
+{
+    EncodeVarint(s.size());
+    m_buffer.insert(m_buffer.end(), s.begin(), s.end());
+}
+
+void
+AnimBinaryTraceWriter::EncodeU64(uint64_t value)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        m_buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void
+AnimBinaryTraceWriter::Submit(bool force)
+{
+    if (m_buffer.empty() || (!force && m_buffer.size() < BINARY_TRACE_CHUNK))
+    {
+        return;
+    }
+    {
+        // wait until the background thread is done with the previous records
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_pending.empty(); });
+        m_pending.swap(m_buffer);
+        m_offset += m_pending.size();
+    }
+    m_cv.notify_all();
+    m_buffer.reserve(BINARY_TRACE_CHUNK);
+}
+
+void
+AnimBinaryTraceWriter::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+        if (m_pending.empty())
+        {
+            break;
+        }
+        // the records are left in m_pending, which the simulation does not touch until
+        // it is empty, while they are written
+        lock.unlock();
+        if (std::fwrite(m_pending.data(), 1, m_pending.size(), m_f) != m_pending.size())
+        {
+            NS_LOG_WARN("Unable to write the binary animation trace");
+        }
+        lock.lock();
+        m_pending.clear();
+        m_cv.notify_all();
+    }
+}
+
+/***** AnimBinaryTraceReader *****/
+
+AnimBinaryTraceReader::AnimBinaryTraceReader(const std::string& fileName)
+    : m_in(fileName, std::ios::binary),
+      m_end(0),
+      m_hasIndex(false)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    char magic[MAGIC_LENGTH];
+    if (!m_in.read(magic, MAGIC_LENGTH) ||
+        std::memcmp(magic, BINARY_TRACE_MAGIC, MAGIC_LENGTH) != 0)
+    {
+        NS_FATAL_ERROR("Not a binary animation trace: " << fileName);
+    }
+    m_in.seekg(0, std::ios::end);
+    m_end = m_in.tellg();
+
+    // a trace without an index was not closed; its records are read until the end of the file
+    if (m_end >= 3 * MAGIC_LENGTH)
+    {
+        m_in.seekg(m_end - MAGIC_LENGTH);
+        m_in.read(magic, MAGIC_LENGTH);
+        if (std::memcmp(magic, BINARY_INDEX_MAGIC, MAGIC_LENGTH) == 0)
+        {
+            m_in.seekg(m_end - 2 * MAGIC_LENGTH);
+            uint64_t indexOffset = DecodeU64();
+            m_in.seekg(indexOffset);
+            NS_ABORT_MSG_IF(m_in.get() != AnimBinaryTraceWriter::INDEX,
+                            "Corrupted index in " << fileName);
+            m_names.resize(DecodeVarint());
+            for (auto& name : m_names)
+            {
+                name = DecodeString();
+            }
+            m_index.resize(DecodeVarint());
+            int64_t time = 0;
+            uint64_t offset = 0;
+            for (auto& entry : m_index)
+            {
+                time += DecodeVarint();
+                offset += DecodeVarint();
+                entry = {TimeStep(time), offset};
+            }
+            NS_ABORT_MSG_IF(!m_in, "Corrupted index in " << fileName);
+            m_end = indexOffset;
+            m_hasIndex = true;
+        }
+    }
+    m_in.clear();
+    m_in.seekg(MAGIC_LENGTH);
+}
+
+bool
+AnimBinaryTraceReader::Seek(Time time)
+{
+    NS_LOG_FUNCTION(this << time);
+    if (!m_hasIndex || m_index.empty())
+    {
+        return false;
+    }
+    auto it = std::upper_bound(m_index.begin(),
+                               m_index.end(),
+                               time,
+                               [](Time t, const auto& entry) { return t < entry.first; });
+    if (it != m_index.begin())
+    {
+        --it;
+    }
+    m_in.clear();
+    m_in.seekg(it->second);
+    return true;
+}
+
+bool
+AnimBinaryTraceReader::Read(std::string& xml)
+{
+    while (m_in && static_cast<uint64_t>(m_in.tellg()) < m_end)
+    {
+        int type = m_in.get();
+        switch (type)
+        {
+        case AnimBinaryTraceWriter::NAME: {
+            uint64_t id = DecodeVarint();
+            std::string name = DecodeString();
+            if (m_in)
+            {
+                m_names.resize(std::max<uint64_t>(m_names.size(), id + 1));
+                m_names[id] = name;
+            }
+            break;
+        }
+        case AnimBinaryTraceWriter::ELEMENT:
+        case AnimBinaryTraceWriter::OPEN: {
+            AnimTraceElement element = DecodeElement();
+            if (!m_in)
+            {
+                // a truncated record at the end of a trace that was not closed
+                return false;
+            }
+            if (type == AnimBinaryTraceWriter::ELEMENT)
+            {
+                xml = element.ToString();
+            }
+            else
+            {
+                xml = element.ToString(false) + ">\n";
+            }
+            return true;
+        }
+        case AnimBinaryTraceWriter::CLOSE: {
+            uint64_t id = DecodeVarint();
+            if (!m_in)
+            {
+                return false;
+            }
+            xml = "</" + GetName(id) + ">\n";
+            return true;
+        }
+        default:
+            if (!m_in)
+            {
+                return false;
+            }
+            NS_FATAL_ERROR("Unknown record type " << type << " in binary animation trace");
+        }
+    }
+    return false;
+}
+
+AnimTraceElement
+AnimBinaryTraceReader::DecodeElement()
+{
+    AnimTraceElement element(GetName(DecodeVarint()));
+    uint64_t nAttributes = DecodeVarint();
+    for (uint64_t i = 0; i < nAttributes && m_in; i++)
+    {
+        AnimTraceElement::Attribute attribute{GetName(DecodeVarint()),
+                                              AnimTraceElement::STRING,
+                                              false,
+                                              0,
+                                              0,
+                                              ""};
+        int flags = m_in.get();
+        attribute.type = static_cast<AnimTraceElement::ValueType>(flags & 0x7f);
+        attribute.xmlEscape = (flags & 0x80) != 0;
+        switch (attribute.type)
+        {
+        case AnimTraceElement::UNSIGNED:
+            attribute.integer = DecodeVarint();
+            break;
+        case AnimTraceElement::SIGNED: {
+            uint64_t zigzag = DecodeVarint();
+            attribute.integer = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+            break;
+        }
+        case AnimTraceElement::DOUBLE: {
+            uint64_t bits = DecodeU64();
+            std::memcpy(&attribute.real, &bits, sizeof(bits));
+            break;
+        }
+        case AnimTraceElement::STRING:
+            attribute.text = DecodeString();
+            break;
+        default:
+            if (m_in)
+            {
+                NS_FATAL_ERROR("Unknown attribute type in binary animation trace");
+            }
+        }
+        element.m_attributes.push_back(std::move(attribute));
+    }
+    element.m_text = DecodeString();
+    uint64_t nChildren = DecodeVarint();
+    for (uint64_t i = 0; i < nChildren && m_in; i++)
+    {
+        element.m_children.push_back(DecodeElement());
+    }
+    return element;
+}
+
+uint64_t
+AnimBinaryTraceReader::DecodeVarint()
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        int byte = m_in.get();
+        if (!m_in)
+        {
+            return 0;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+std::string
+AnimBinaryTraceReader::DecodeString()
+{
+    uint64_t length = DecodeVarint();
+    if (!m_in || length > m_end)
+    {
+        m_in.setstate(std::ios::failbit);
+        return "";
+    }
+    std::string s(length, '\0');
+    m_in.read(s.data(), length);
+    return s;
+}
+
+uint64_t
+AnimBinaryTraceReader::DecodeU64()
+{
+    uint8_t bytes[8] = {};
+    m_in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+const std::string&
+AnimBinaryTraceReader::GetName(uint64_t id) const
+{
+    static const std::string unknown;
+    if (id >= m_names.size())
+    {
+        if (m_in)
+        {
+            NS_FATAL_ERROR("Undefined name " << id << " in binary animation trace");
+        }
+        return unknown;
+    }
+    return m_names[id];
+}
+
+} // namespace ns3
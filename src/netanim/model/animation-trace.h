@@ -0,0 +1,322 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ANIMATION_TRACE_H
+#define ANIMATION_TRACE_H
+
+#include "ns3/nstime.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup netanim
+ * ns3::AnimTraceElement, ns3::AnimBinaryTraceWriter and ns3::AnimBinaryTraceReader
+ * declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup netanim
+ *
+ * @brief Element of an animation trace.
+ *
+ * The attributes keep their type and are formatted only when the XML text of
+ * the element is requested, so that the element can be stored in a binary
+ * trace without going through its text representation.
+ */
+class AnimTraceElement
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param tagName tag name
+     * @param emptyElement empty element?
+     */
+    AnimTraceElement(std::string tagName, bool emptyElement = true);
+    /**
+     * Add attribute function
+     * @param attribute the attribute name
+     * @param value the attribute value, either a number or a string
+     * @param xmlEscape true to escape
+     */
+    template <typename T>
+    void AddAttribute(std::string attribute, T value, bool xmlEscape = false);
+    /**
+     * Set text function
+     * @param text the text for the element
+     */
+    void SetText(std::string text);
+    /**
+     * Append child function
+     * @param e the element to add as a child
+     */
+    void AppendChild(AnimTraceElement e);
+    /**
+     * Get text for the element function
+     * @param autoClose auto close the element
+     * @returns the text
+     */
+    std::string ToString(bool autoClose = true) const;
+
+  private:
+    friend class AnimBinaryTraceWriter;
+    friend class AnimBinaryTraceReader;
+
+    /// Type of the value of an attribute
+    enum ValueType : uint8_t
+    {
+        UNSIGNED = 0,
+        SIGNED = 1,
+        DOUBLE = 2,
+        STRING = 3
+    };
+
+    /// Attribute of an element
+    struct Attribute
+    {
+        std::string name; ///< attribute name
+        ValueType type;   ///< type of the value
+        bool xmlEscape;   ///< whether the value must be escaped
+        uint64_t integer; ///< value of an integer attribute
+        double real;      ///< value of a double attribute
+        std::string text; ///< value of a string attribute
+
+        /// @return the value, formatted as in the XML trace
+        std::string GetValue() const;
+    };
+
+    std::string m_tagName;                    ///< tag name
+    std::string m_text;                       ///< element string
+    std::vector<Attribute> m_attributes;      ///< list of attributes
+    std::vector<AnimTraceElement> m_children; ///< list of children
+};
+
+/**
+ * @ingroup netanim
+ *
+ * @brief Writer of a binary animation trace.
+ *
+ * The binary trace holds the same elements as the XML trace, with the tag and
+ * attribute names interned, the integers encoded as variable length integers
+ * and the doubles stored as is. The records are written by a background
+ * thread, so that the simulation only pays for their encoding. When the trace
+ * is closed, an index of the offset of the first record written after each
+ * index interval of simulated time is appended, so that a reader can start
+ * from any point of the trace.
+ *
+ * The format of the trace is:
+ * - the 8 bytes "NSANIMB1";
+ * - a sequence of records, each starting with its type: the definition of a
+ *   name, an element, the opening or the closing of an element;
+ * - an index record, holding all the names and the (time, offset) pairs;
+ * - the offset of the index record, as 8 little endian bytes, and the 8 bytes
+ *   "NSANIMIX".
+ */
+class AnimBinaryTraceWriter
+{
+  public:
+    /// Type of a record
+    enum RecordType : uint8_t
+    {
+        NAME = 0,
+        ELEMENT = 1,
+        OPEN = 2,
+        CLOSE = 3,
+        INDEX = 4
+    };
+
+    /**
+     * Constructor
+     * @param f the file to write, opened in binary mode
+     * @param indexInterval the simulated time between two entries of the index
+     */
+    AnimBinaryTraceWriter(FILE* f, Time indexInterval = Seconds(1));
+    ~AnimBinaryTraceWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AnimBinaryTraceWriter(const AnimBinaryTraceWriter&) = delete;
+    AnimBinaryTraceWriter& operator=(const AnimBinaryTraceWriter&) = delete;
+
+    /**
+     * Write an element.
+     * @param element the element
+     * @param autoClose false if the element is left open, to be closed by WriteClose()
+     * @param now the current simulation time
+     */
+    void WriteElement(const AnimTraceElement& element, bool autoClose, Time now);
+    /**
+     * Close an element opened by WriteElement().
+     * @param tagName the tag name of the element
+     */
+    void WriteClose(const std::string& tagName);
+    /**
+     * Write the index, wait until all the records are written and flush the
+     * file, which is not closed. Nothing can be written afterwards.
+     */
+    void Close();
+
+  private:
+    /**
+     * Start a record, adding an entry to the index if needed.
+     * @param now the current simulation time
+     */
+    void StartRecord(Time now);
+    /**
+     * @param name a tag or attribute name
+     * @return the identifier of the name, writing its definition the first time
+     */
+    uint64_t Intern(const std::string& name);
+    /**
+     * Define the names of an element and its children.
+     * @param element the element
+     */
+    void InternNames(const AnimTraceElement& element);
+    /**
+     * Encode an element and its children.
+     * @param element the element
+     */
+    void EncodeElement(const AnimTraceElement& element);
+    /**
+     * Encode a variable length integer.
+     * @param value the integer
+     */
+    void EncodeVarint(uint64_t value);
+    /**
+     * Encode a string, preceded by its length.
+     * @param s the string
+     */
+    void EncodeString(const std::string& s);
+    /**
+     * Encode an integer as 8 little endian bytes.
+     * @param value the integer
+     */
+    void EncodeU64(uint64_t value);
+    /**
+     * Hand the encoded records to the background thread, once there are enough of them.
+     * @param force true to hand them whatever their size
+     */
+    void Submit(bool force = false);
+    /// Body of the background thread, writing the submitted records to the file
+    void Run();
+
+    FILE* m_f;                                       ///< the file
+    Time m_indexInterval;                            ///< time between two index entries
+    Time m_nextIndexTime;                            ///< time of the next index entry
+    std::vector<std::pair<Time, uint64_t>> m_index;  ///< (time, offset) index entries
+    std::unordered_map<std::string, uint64_t> m_ids; ///< identifiers of the names
+    std::vector<std::string> m_names;                ///< names, by identifier
+    uint64_t m_offset;                               ///< number of bytes submitted
+    std::vector<uint8_t> m_buffer;                   ///< records not submitted yet
+    std::vector<uint8_t> m_pending;                  ///< records being written
+    bool m_stop;                                     ///< whether the thread must stop
+    bool m_closed;                                   ///< whether the trace was closed
+    std::mutex m_mutex;                              ///< protects m_pending and m_stop
+    std::condition_variable m_cv;                    ///< signals m_pending and m_stop changes
+    std::thread m_thread;                            ///< the background thread
+};
+
+/**
+ * @ingroup netanim
+ *
+ * @brief Reader of a binary animation trace, producing the XML text of its records.
+ */
+class AnimBinaryTraceReader
+{
+  public:
+    /**
+     * Constructor
+     * @param fileName the name of the binary trace
+     */
+    AnimBinaryTraceReader(const std::string& fileName);
+
+    /**
+     * Move to the last record of the index written no later than the given
+     * time. The trace must have an index, i.e., it was completely written.
+     * @param time the simulation time
+     * @return false if the trace has no index
+     */
+    bool Seek(Time time);
+    /**
+     * Read the next record.
+     * @param xml [out] the XML text of the record
+     * @return false at the end of the trace
+     */
+    bool Read(std::string& xml);
+
+  private:
+    /**
+     * Decode an element and its children.
+     * @return the element
+     */
+    AnimTraceElement DecodeElement();
+    /**
+     * @return the next variable length integer
+     */
+    uint64_t DecodeVarint();
+    /**
+     * @return the next string, preceded by its length
+     */
+    std::string DecodeString();
+    /**
+     * @return the next integer stored as 8 little endian bytes
+     */
+    uint64_t DecodeU64();
+    /**
+     * @param id the identifier of a name
+     * @return the name
+     */
+    const std::string& GetName(uint64_t id) const;
+
+    std::ifstream m_in;                             ///< the trace
+    uint64_t m_end;                                 ///< offset of the end of the records
+    bool m_hasIndex;                                ///< whether the trace has an index
+    std::vector<std::pair<Time, uint64_t>> m_index; ///< (time, offset) index entries
+    std::vector<std::string> m_names;               ///< names, by identifier
+};
+
+/*************************************************
+ **  Template implementation
+ ************************************************/
+
+template <typename T>
+void
+AnimTraceElement::AddAttribute(std::string attribute, T value, bool xmlEscape)
+{
+    Attribute a{std::move(attribute), STRING, xmlEscape, 0, 0, ""};
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        a.type = DOUBLE;
+        a.real = value;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        // characters and booleans are not written as numbers
+        static_assert(!std::is_same_v<T, bool> && sizeof(T) > 1,
+                      "Convert the value to a wider integer or to a string");
+        a.type = std::is_signed_v<T> ? SIGNED : UNSIGNED;
+        a.integer = static_cast<uint64_t>(value);
+    }
+    else
+    {
+        a.text = value;
+    }
+    m_attributes.push_back(std::move(a));
+}
+
+} // namespace ns3
+
+#endif /* ANIMATION_TRACE_H */
@@ -20,7 +20,9 @@
 #include "ns3/simple-device-energy-model.h"
 #include "ns3/udp-echo-helper.h"
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 using namespace ns3;
 using namespace ns3::energy;
@@ -231,6 +233,113 @@ AnimationRemainingEnergyTestCase::CheckLogic()
                               "Wrong remaining energy value was traced");
 }
 
+/**
+ * @ingroup netanim-test
+ *
+ * @brief Animation Binary Trace Test Case: the same network is traced in the
+ * XML and binary formats, and with packet sampling.
+ */
+class AnimationBinaryTraceTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor.
+     */
+    AnimationBinaryTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a whole file
+     * @param fileName the file name
+     * @returns the content of the file
+     */
+    std::string ReadFile(const std::string& fileName);
+};
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase()
+    : TestCase("Verify the binary trace format and the packet sampling")
+{
+}
+
+std::string
+AnimationBinaryTraceTestCase::ReadFile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void
+AnimationBinaryTraceTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    AnimationInterface::SetConstantPosition(nodes.Get(0), 0, 10);
+    AnimationInterface::SetConstantPosition(nodes.Get(1), 1, 10);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    UdpEchoServerHelper echoServer(9);
+    ApplicationContainer serverApps = echoServer.Install(nodes.Get(1));
+    serverApps.Start(Seconds(1));
+    serverApps.Stop(Seconds(10));
+
+    UdpEchoClientHelper echoClient(interfaces.GetAddress(1), 9);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(100));
+    echoClient.SetAttribute("Interval", TimeValue(Seconds(1)));
+    echoClient.SetAttribute("PacketSize", UintegerValue(1024));
+    ApplicationContainer clientApps = echoClient.Install(nodes.Get(0));
+    clientApps.Start(Seconds(2));
+    clientApps.Stop(Seconds(10));
+
+    auto xmlAnim = new AnimationInterface("netanim-test-xml.xml");
+    auto binaryAnim =
+        new AnimationInterface("netanim-test-binary.bin", AnimationInterface::BINARY_TRACE);
+    auto sampledAnim = new AnimationInterface("netanim-test-sampled.xml");
+    sampledAnim->SetPacketSampling(3);
+
+    Simulator::Stop(Seconds(12));
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(xmlAnim->GetTracePktCount(), 16, "Expected 16 packets traced");
+    NS_TEST_EXPECT_MSG_EQ(binaryAnim->GetTracePktCount(), 16, "Expected 16 packets traced");
+    // packets 1, 4 and 7 of each of the 8 packets of both directions
+    NS_TEST_EXPECT_MSG_EQ(sampledAnim->GetTracePktCount(), 6, "Expected 6 packets traced");
+    delete xmlAnim;
+    delete binaryAnim;
+    delete sampledAnim;
+
+    AnimationInterface::ConvertBinaryTrace("netanim-test-binary.bin", "netanim-test-binary.xml");
+    std::string xml = ReadFile("netanim-test-xml.xml");
+    NS_TEST_EXPECT_MSG_NE(xml.find("</anim>"), std::string::npos, "Incomplete XML trace");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile("netanim-test-binary.xml") == xml),
+                          true,
+                          "The converted binary trace differs from the XML trace");
+    NS_TEST_EXPECT_MSG_LT(ReadFile("netanim-test-binary.bin").size(),
+                          xml.size(),
+                          "The binary trace should be smaller than the XML trace");
+
+    for (auto fileName : {"netanim-test-xml.xml",
+                          "netanim-test-binary.bin",
+                          "netanim-test-binary.xml",
+                          "netanim-test-sampled.xml"})
+    {
+        remove(fileName);
+    }
+}
+
 /**
  * @ingroup netanim-test
  *
@@ -244,5 +353,6 @@ static class AnimationInterfaceTestSuite : public TestSuite
     {
         AddTestCase(new AnimationInterfaceTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new AnimationRemainingEnergyTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new AnimationBinaryTraceTestCase(), TestCase::Duration::QUICK);
     }
 } g_animationInterfaceTestSuite; ///< the test suite
@@ -14,6 +14,7 @@
  */
 
 #include "ns3/address.h"
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 #include "ns3/double.h"
 #include "ns3/error-model.h"
@@ -29,6 +30,9 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <cmath>
+#include <vector>
+
 using namespace ns3;
 
 static void
@@ -277,6 +281,193 @@ BurstErrorModelSimple::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_drops, 260, "Wrong number of drops.");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * RateErrorModel unit tests with precomputed loss schedules.
+ */
+class RateErrorModelScheduledTest : public TestCase
+{
+  public:
+    RateErrorModelScheduledTest();
+
+  private:
+    void DoRun() override;
+};
+
+RateErrorModelScheduledTest::RateErrorModelScheduledTest()
+    : TestCase("RateErrorModel loss rate with ScheduleLosses")
+{
+}
+
+void
+RateErrorModelScheduledTest::DoRun()
+{
+    RngSeedManager::SetSeed(3);
+    RngSeedManager::SetRun(1);
+
+    const uint32_t nPackets = 200000;
+
+    // Packet unit: the long-run loss rate must match the error rate
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetAttribute("ErrorRate", DoubleValue(0.01));
+    em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+    em->SetAttribute("ScheduleLosses", BooleanValue(true));
+    em->AssignStreams(10);
+    Ptr<Packet> pkt = Create<Packet>(100);
+    uint32_t drops = 0;
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        drops += em->IsCorrupt(pkt) ? 1 : 0;
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(drops / static_cast<double>(nPackets),
+                              0.01,
+                              0.001,
+                              "Wrong packet loss rate");
+
+    // Byte unit: the packet error rate is 1 - (1 - rate)^size
+    em->SetAttribute("ErrorRate", DoubleValue(1e-4));
+    em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_BYTE"));
+    drops = 0;
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        drops += em->IsCorrupt(pkt) ? 1 : 0;
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(drops / static_cast<double>(nPackets),
+                              1 - std::pow(1 - 1e-4, 100),
+                              0.001,
+                              "Wrong byte-unit packet loss rate");
+
+    // Edge rates
+    em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+    em->SetAttribute("ErrorRate", DoubleValue(0.0));
+    bool corrupt = false;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        corrupt |= em->IsCorrupt(pkt);
+    }
+    NS_TEST_ASSERT_MSG_EQ(corrupt, false, "No packet should be lost with a zero error rate");
+    em->SetAttribute("ErrorRate", DoubleValue(1.0));
+    NS_TEST_ASSERT_MSG_EQ(em->IsCorrupt(pkt), true, "Packet should be lost with a unit error rate");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * GilbertElliottErrorModel unit tests.
+ */
+class GilbertElliottErrorModelTest : public TestCase
+{
+  public:
+    GilbertElliottErrorModelTest();
+
+  private:
+    void DoRun() override;
+};
+
+GilbertElliottErrorModelTest::GilbertElliottErrorModelTest()
+    : TestCase("GilbertElliottErrorModel stationary loss rate and burst length")
+{
+}
+
+void
+GilbertElliottErrorModelTest::DoRun()
+{
+    RngSeedManager::SetSeed(3);
+    RngSeedManager::SetRun(1);
+
+    const double p = 0.01;
+    const double r = 0.25;
+    Ptr<GilbertElliottErrorModel> em = CreateObject<GilbertElliottErrorModel>();
+    em->SetAttribute("GoodToBadProbability", DoubleValue(p));
+    em->SetAttribute("BadToGoodProbability", DoubleValue(r));
+    em->AssignStreams(20);
+
+    const uint32_t nPackets = 500000;
+    Ptr<Packet> pkt = Create<Packet>(100);
+    uint32_t drops = 0;
+    uint32_t bursts = 0;
+    bool lastCorrupt = false;
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        bool corrupt = em->IsCorrupt(pkt);
+        NS_TEST_ASSERT_MSG_EQ(corrupt,
+                              (em->GetState() == GilbertElliottErrorModel::BAD),
+                              "Gilbert model loses exactly the packets in the Bad state");
+        if (corrupt)
+        {
+            drops++;
+            bursts += lastCorrupt ? 0 : 1;
+        }
+        lastCorrupt = corrupt;
+    }
+    // Stationary probability of the Bad state is p / (p + r), and the mean
+    // sojourn time in the Bad state is 1 / r
+    NS_TEST_ASSERT_MSG_EQ_TOL(drops / static_cast<double>(nPackets),
+                              p / (p + r),
+                              0.003,
+                              "Wrong stationary loss rate");
+    NS_TEST_ASSERT_MSG_EQ_TOL(drops / static_cast<double>(bursts),
+                              1 / r,
+                              0.2,
+                              "Wrong mean burst length");
+
+    em->Reset();
+    em->SetAttribute("GoodToBadProbability", DoubleValue(0.0));
+    bool corrupt = false;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        corrupt |= em->IsCorrupt(pkt);
+    }
+    NS_TEST_ASSERT_MSG_EQ(corrupt, false, "No packet should be lost in the Good state");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * TraceErrorModel unit tests.
+ */
+class TraceErrorModelTest : public TestCase
+{
+  public:
+    TraceErrorModelTest();
+
+  private:
+    void DoRun() override;
+};
+
+TraceErrorModelTest::TraceErrorModelTest()
+    : TestCase("TraceErrorModel pattern replay")
+{
+}
+
+void
+TraceErrorModelTest::DoRun()
+{
+    Ptr<TraceErrorModel> em = CreateObject<TraceErrorModel>();
+    std::vector<bool> pattern = {false, true, true, false, false};
+    em->SetPattern(pattern);
+    Ptr<Packet> pkt = Create<Packet>(100);
+    for (uint32_t i = 0; i < 3 * pattern.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(em->IsCorrupt(pkt),
+                              pattern[i % pattern.size()],
+                              "Pattern not replayed at packet " << i);
+    }
+
+    em->Reset();
+    em->SetAttribute("Loop", BooleanValue(false));
+    uint32_t drops = 0;
+    for (uint32_t i = 0; i < 3 * pattern.size(); i++)
+    {
+        drops += em->IsCorrupt(pkt) ? 1 : 0;
+    }
+    NS_TEST_ASSERT_MSG_EQ(drops, 2, "Pattern should be replayed only once");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -298,6 +489,9 @@ ErrorModelTestSuite::ErrorModelTestSuite()
 {
     AddTestCase(new ErrorModelSimple, TestCase::Duration::QUICK);
     AddTestCase(new BurstErrorModelSimple, TestCase::Duration::QUICK);
+    AddTestCase(new RateErrorModelScheduledTest, TestCase::Duration::QUICK);
+    AddTestCase(new GilbertElliottErrorModelTest, TestCase::Duration::QUICK);
+    AddTestCase(new TraceErrorModelTest, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -50,6 +50,7 @@
 
 #include "error-model.h"
 
+#include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
@@ -59,13 +60,52 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <cctype>
 #include <cmath>
+#include <fstream>
+#include <limits>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("ErrorModel");
 
+namespace
+{
+
+/**
+ * Draw the number of error-free units that precede the next errored unit,
+ * when each unit is independently in error with the given probability.
+ *
+ * The result is geometrically distributed and is obtained by inversion of
+ * a single Uniform(0,1) variate.
+ *
+ * @param ranvar the Uniform(0,1) random variable to draw from
+ * @param rate the per-unit error probability
+ * @return the length of the error-free run; the maximum uint64_t value if rate is zero
+ */
+uint64_t
+DrawErrorFreeRun(Ptr<RandomVariableStream> ranvar, double rate)
+{
+    if (rate <= 0)
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    if (rate >= 1)
+    {
+        return 0;
+    }
+    double u = 1.0 - ranvar->GetValue(); // in (0,1]
+    double run = std::floor(std::log(u) / std::log1p(-rate));
+    if (!(run < static_cast<double>(std::numeric_limits<uint64_t>::max())))
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return static_cast<uint64_t>(run);
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(ErrorModel);
 
 TypeId
@@ -165,11 +205,20 @@ RateErrorModel::GetTypeId()
                           "The decision variable attached to this error model.",
                           StringValue("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
                           MakePointerAccessor(&RateErrorModel::m_ranvar),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("ScheduleLosses",
+                          "If true, draw the number of error-free units before the next error "
+                          "instead of drawing a random variate for every packet. RanVar must "
+                          "then be a Uniform(0,1) random variable.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RateErrorModel::m_scheduleLosses),
+                          MakeBooleanChecker());
     return tid;
 }
 
 RateErrorModel::RateErrorModel()
+    : m_scheduleValid(false),
+      m_unitsToNextError(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -230,6 +279,22 @@ RateErrorModel::DoCorrupt(Ptr<Packet> p)
     {
         return false;
     }
+    if (m_scheduleLosses)
+    {
+        switch (m_unit)
+        {
+        case ERROR_UNIT_PACKET:
+            return DoCorruptScheduled(1);
+        case ERROR_UNIT_BYTE:
+            return DoCorruptScheduled(p->GetSize());
+        case ERROR_UNIT_BIT:
+            return DoCorruptScheduled(8 * static_cast<uint64_t>(p->GetSize()));
+        default:
+            NS_ASSERT_MSG(false, "m_unit not supported yet");
+            break;
+        }
+        return false;
+    }
     switch (m_unit)
     {
     case ERROR_UNIT_PACKET:
@@ -245,6 +310,40 @@ RateErrorModel::DoCorrupt(Ptr<Packet> p)
     return false;
 }
 
+bool
+RateErrorModel::DoCorruptScheduled(uint64_t units)
+{
+    NS_LOG_FUNCTION(this << units);
+    if (!m_scheduleValid || m_scheduledRate != m_rate || m_scheduledUnit != m_unit)
+    {
+        // (re)start the schedule; the error process is memoryless
+        m_unitsToNextError = DrawErrorFreeRun(m_ranvar, m_rate);
+        m_scheduledRate = m_rate;
+        m_scheduledUnit = m_unit;
+        m_scheduleValid = true;
+    }
+    if (m_unitsToNextError >= units)
+    {
+        m_unitsToNextError -= units;
+        return false;
+    }
+    // The next errored unit falls within this packet; skip over any further
+    // errored units in the remainder of the packet
+    uint64_t consumed = m_unitsToNextError + 1;
+    while (true)
+    {
+        uint64_t run = DrawErrorFreeRun(m_ranvar, m_rate);
+        if (run >= units - consumed)
+        {
+            m_unitsToNextError = run - (units - consumed);
+            break;
+        }
+        consumed += run + 1;
+    }
+    NS_LOG_DEBUG("Packet corrupted; " << m_unitsToNextError << " error-free units scheduled");
+    return true;
+}
+
 bool
 RateErrorModel::DoCorruptPkt(Ptr<Packet> p)
 {
@@ -274,7 +373,7 @@ void
 RateErrorModel::DoReset()
 {
     NS_LOG_FUNCTION(this);
-    /* re-initialize any state; no-op for now */
+    m_scheduleValid = false;
 }
 
 //
@@ -408,6 +507,259 @@ BurstErrorModel::DoReset()
     m_currentBurstSz = 0;
 }
 
+//
+// GilbertElliottErrorModel
+//
+
+NS_OBJECT_ENSURE_REGISTERED(GilbertElliottErrorModel);
+
+TypeId
+GilbertElliottErrorModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::GilbertElliottErrorModel")
+            .SetParent<ErrorModel>()
+            .SetGroupName("Network")
+            .AddConstructor<GilbertElliottErrorModel>()
+            .AddAttribute("GoodToBadProbability",
+                          "The probability of moving from the Good to the Bad state, per packet.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&GilbertElliottErrorModel::m_goodToBad),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("BadToGoodProbability",
+                          "The probability of moving from the Bad to the Good state, per packet.",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&GilbertElliottErrorModel::m_badToGood),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("GoodErrorRate",
+                          "The packet error rate in the Good state.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&GilbertElliottErrorModel::m_goodRate),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("BadErrorRate",
+                          "The packet error rate in the Bad state.",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&GilbertElliottErrorModel::m_badRate),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("RanVar",
+                          "The decision variable attached to this error model. "
+                          "It must be a Uniform(0,1) random variable.",
+                          StringValue("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
+                          MakePointerAccessor(&GilbertElliottErrorModel::m_ranvar),
+                          MakePointerChecker<RandomVariableStream>());
+    return tid;
+}
+
+GilbertElliottErrorModel::GilbertElliottErrorModel()
+    : m_state(GOOD),
+      m_started(false),
+      m_packetsInState(0),
+      m_packetsToNextError(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+GilbertElliottErrorModel::~GilbertElliottErrorModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+GilbertElliottErrorModel::State
+GilbertElliottErrorModel::GetState() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_state;
+}
+
+void
+GilbertElliottErrorModel::SetRandomVariable(Ptr<RandomVariableStream> ranvar)
+{
+    NS_LOG_FUNCTION(this << ranvar);
+    m_ranvar = ranvar;
+}
+
+int64_t
+GilbertElliottErrorModel::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_ranvar->SetStream(stream);
+    return 1;
+}
+
+void
+GilbertElliottErrorModel::EnterState(State state)
+{
+    NS_LOG_FUNCTION(this << state);
+    m_state = state;
+    // The sojourn time is at least one packet; the state is left with the
+    // exit probability after each packet
+    double exitProbability = (state == GOOD) ? m_goodToBad : m_badToGood;
+    uint64_t run = DrawErrorFreeRun(m_ranvar, exitProbability);
+    m_packetsInState = (run == std::numeric_limits<uint64_t>::max()) ? run : run + 1;
+    m_packetsToNextError = DrawErrorFreeRun(m_ranvar, (state == GOOD) ? m_goodRate : m_badRate);
+    NS_LOG_DEBUG("Entered state " << (state == GOOD ? "Good" : "Bad") << " for "
+                                  << m_packetsInState << " packets");
+}
+
+bool
+GilbertElliottErrorModel::DoCorrupt(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+    if (!IsEnabled())
+    {
+        return false;
+    }
+    if (!m_started)
+    {
+        m_started = true;
+        EnterState(GOOD);
+    }
+    else if (m_packetsInState == 0)
+    {
+        EnterState(m_state == GOOD ? BAD : GOOD);
+    }
+    if (m_packetsInState != std::numeric_limits<uint64_t>::max())
+    {
+        m_packetsInState--;
+    }
+    if (m_packetsToNextError > 0)
+    {
+        if (m_packetsToNextError != std::numeric_limits<uint64_t>::max())
+        {
+            m_packetsToNextError--;
+        }
+        return false;
+    }
+    m_packetsToNextError = DrawErrorFreeRun(m_ranvar, (m_state == GOOD) ? m_goodRate : m_badRate);
+    return true;
+}
+
+void
+GilbertElliottErrorModel::DoReset()
+{
+    NS_LOG_FUNCTION(this);
+    m_state = GOOD;
+    m_started = false;
+    m_packetsInState = 0;
+    m_packetsToNextError = 0;
+}
+
+//
+// TraceErrorModel
+//
+
+NS_OBJECT_ENSURE_REGISTERED(TraceErrorModel);
+
+TypeId
+TraceErrorModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TraceErrorModel")
+            .SetParent<ErrorModel>()
+            .SetGroupName("Network")
+            .AddConstructor<TraceErrorModel>()
+            .AddAttribute("TraceFile",
+                          "The name of a file holding the loss pattern, one character per "
+                          "packet: '1' for a lost packet, '0' for a received one.",
+                          StringValue(""),
+                          MakeStringAccessor(&TraceErrorModel::SetTraceFile),
+                          MakeStringChecker())
+            .AddAttribute("Loop",
+                          "Whether to replay the loss pattern from the beginning once exhausted.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&TraceErrorModel::m_loop),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+TraceErrorModel::TraceErrorModel()
+    : m_position(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TraceErrorModel::~TraceErrorModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::vector<bool>
+TraceErrorModel::GetPattern() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_pattern;
+}
+
+void
+TraceErrorModel::SetPattern(const std::vector<bool>& pattern)
+{
+    NS_LOG_FUNCTION(this << pattern.size());
+    m_pattern = pattern;
+    m_position = 0;
+}
+
+void
+TraceErrorModel::SetTraceFile(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_traceFile = filename;
+    if (filename.empty())
+    {
+        return;
+    }
+    std::ifstream file(filename);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open loss trace file " << filename);
+    std::vector<bool> pattern;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line[0] == '#')
+        {
+            continue;
+        }
+        for (char c : line)
+        {
+            if (c == '0' || c == '1')
+            {
+                pattern.push_back(c == '1');
+            }
+            else
+            {
+                NS_ABORT_MSG_UNLESS(std::isspace(static_cast<unsigned char>(c)),
+                                    "Invalid character '" << c << "' in loss trace file "
+                                                          << filename);
+            }
+        }
+    }
+    SetPattern(pattern);
+}
+
+bool
+TraceErrorModel::DoCorrupt(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+    if (!IsEnabled())
+    {
+        return false;
+    }
+    if (m_position == m_pattern.size())
+    {
+        if (!m_loop || m_pattern.empty())
+        {
+            return false;
+        }
+        m_position = 0;
+    }
+    return m_pattern[m_position++];
+}
+
+void
+TraceErrorModel::DoReset()
+{
+    NS_LOG_FUNCTION(this);
+    m_position = 0;
+}
+
 //
 // ListErrorModel
 //
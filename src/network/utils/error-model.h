@@ -55,6 +55,8 @@
 #include "ns3/random-variable-stream.h"
 
 #include <list>
+#include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -99,8 +101,9 @@ class Packet;
  *   }
  * @endcode
  *
- * Four practical error models, a RateErrorModel, a BurstErrorModel,
- * a ListErrorModel, and a ReceiveListErrorModel, are currently implemented.
+ * Six practical error models, a RateErrorModel, a BurstErrorModel,
+ * a GilbertElliottErrorModel, a TraceErrorModel, a ListErrorModel, and a
+ * ReceiveListErrorModel, are currently implemented.
  */
 class ErrorModel : public Object
 {
@@ -164,8 +167,16 @@ class ErrorModel : public Object
  * unit (which may be per-bit, per-byte, and per-packet).
  * Users can optionally provide a RandomVariableStream object; the default
  * is to use a Uniform(0,1) distribution.
-
- * Reset() on this model will do nothing
+ *
+ * By default one random variate is drawn per packet.  If the ScheduleLosses
+ * attribute is set, the model instead draws the length of the next run of
+ * error-free units from its geometric distribution and counts it down, so
+ * that random variates are only consumed when an error occurs.  The loss
+ * process is statistically identical, but the decision variable must then
+ * be a Uniform(0,1) random variable.
+ *
+ * Reset() on this model discards the remaining length of the current run of
+ * error-free units, if any; a new length is drawn at the next packet.
  *
  * IsCorrupt() will not modify the packet data buffer
  */
@@ -226,6 +237,16 @@ class RateErrorModel : public ErrorModel
 
   private:
     bool DoCorrupt(Ptr<Packet> p) override;
+    /**
+     * Corrupt a packet by consuming a precomputed run of error-free units.
+     *
+     * Used when the ScheduleLosses attribute is set; a new run length is
+     * drawn only when an errored unit falls within the packet.
+     *
+     * @param units the number of error units (packets, bytes or bits) in the packet
+     * @returns true if the packet is corrupted
+     */
+    bool DoCorruptScheduled(uint64_t units);
     /**
      * Corrupt a packet (packet unit).
      * @param p the packet to corrupt
@@ -250,6 +271,12 @@ class RateErrorModel : public ErrorModel
     double m_rate;    //!< Error rate
 
     Ptr<RandomVariableStream> m_ranvar; //!< rng stream
+
+    bool m_scheduleLosses;       //!< True if error-free runs are drawn instead of per-unit draws
+    bool m_scheduleValid;        //!< True if m_unitsToNextError matches m_rate and m_unit
+    uint64_t m_unitsToNextError; //!< Error-free units remaining before the next errored unit
+    double m_scheduledRate;      //!< Error rate used to draw m_unitsToNextError
+    ErrorUnit m_scheduledUnit;   //!< Error unit used to draw m_unitsToNextError
 };
 
 /**
@@ -341,6 +368,144 @@ class BurstErrorModel : public ErrorModel
     uint32_t m_currentBurstSz; //!< the current burst size
 };
 
+/**
+ * @brief Two-state (Gilbert-Elliott) correlated packet loss model.
+ *
+ * The model alternates between a Good and a Bad state, following a
+ * discrete-time Markov chain advanced once per packet.  In the Good state
+ * packets are lost with probability GoodErrorRate and in the Bad state with
+ * probability BadErrorRate.  With the default error rates (0 and 1) this is
+ * the classic Gilbert model.
+ *
+ * Instead of drawing a random number per packet, the number of packets
+ * spent in the current state and the number of error-free packets before
+ * the next loss are both drawn from their geometric distributions, so the
+ * per-packet cost is a pair of counter decrements and random numbers are
+ * only consumed on state changes and losses.  The decision variable must
+ * therefore be a Uniform(0,1) random variable.
+ *
+ * Reset() on this model returns it to the Good state.
+ *
+ * IsCorrupt() will not modify the packet data buffer
+ */
+class GilbertElliottErrorModel : public ErrorModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    GilbertElliottErrorModel();
+    ~GilbertElliottErrorModel() override;
+
+    /**
+     * State of the Markov chain.
+     */
+    enum State
+    {
+        GOOD,
+        BAD
+    };
+
+    /**
+     * @return the state the model was in when the last packet was evaluated
+     */
+    State GetState() const;
+
+    /**
+     * @param ranvar A random variable distribution to generate random variates
+     */
+    void SetRandomVariable(Ptr<RandomVariableStream> ranvar);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model.  Return the number of streams (possibly zero) that
+     * have been assigned.
+     *
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  private:
+    bool DoCorrupt(Ptr<Packet> p) override;
+    void DoReset() override;
+
+    /**
+     * Enter the given state and draw its sojourn time and first loss position.
+     * @param state the state to enter
+     */
+    void EnterState(State state);
+
+    double m_goodToBad;                 //!< Transition probability from Good to Bad, per packet
+    double m_badToGood;                 //!< Transition probability from Bad to Good, per packet
+    double m_goodRate;                  //!< Packet error rate in the Good state
+    double m_badRate;                   //!< Packet error rate in the Bad state
+    Ptr<RandomVariableStream> m_ranvar; //!< rng stream
+
+    State m_state;                 //!< Current state
+    bool m_started;                //!< True once the initial state has been entered
+    uint64_t m_packetsInState;     //!< Packets remaining before leaving the current state
+    uint64_t m_packetsToNextError; //!< Error-free packets remaining before the next loss
+};
+
+/**
+ * @brief Replay a recorded packet loss pattern.
+ *
+ * The pattern is a sequence of per-packet loss indications, in the order
+ * packets are received by this error model.  It can be set programmatically
+ * or loaded from the file named by the TraceFile attribute, which holds one
+ * character per packet: '1' for a lost packet and '0' for a received one.
+ * Whitespace is ignored, and lines starting with '#' are comments.
+ *
+ * When the end of the pattern is reached, it is replayed from the beginning
+ * if the Loop attribute is true; otherwise no further packets are lost.
+ * Each packet costs a single indexed lookup.
+ *
+ * Reset() on this model rewinds the pattern.
+ *
+ * IsCorrupt() will not modify the packet data buffer
+ */
+class TraceErrorModel : public ErrorModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TraceErrorModel();
+    ~TraceErrorModel() override;
+
+    /**
+     * @return a copy of the loss pattern
+     */
+    std::vector<bool> GetPattern() const;
+    /**
+     * @param pattern the loss pattern; true entries mark lost packets.
+     *
+     * This method overwrites any previously provided pattern and rewinds it.
+     */
+    void SetPattern(const std::vector<bool>& pattern);
+    /**
+     * Load the loss pattern from a file.
+     *
+     * @param filename the name of the trace file
+     */
+    void SetTraceFile(std::string filename);
+
+  private:
+    bool DoCorrupt(Ptr<Packet> p) override;
+    void DoReset() override;
+
+    std::string m_traceFile;     //!< Name of the trace file the pattern was loaded from
+    bool m_loop;                 //!< True if the pattern is replayed when exhausted
+    std::vector<bool> m_pattern; //!< Per-packet loss pattern
+    std::size_t m_position;      //!< Index of the next pattern entry
+};
+
 /**
  * @brief Provide a list of Packet uids to corrupt
  *
@@ -62,6 +62,13 @@ NixVectorHelper<T>::Create(Ptr<Node> node) const
     return agent;
 }
 
+template <typename T>
+void
+NixVectorHelper<T>::Set(std::string name, const AttributeValue& value)
+{
+    m_agentFactory.Set(name, value);
+}
+
 template <typename T>
 void
 NixVectorHelper<T>::PrintRoutingPathAt(Time printTime,
@@ -14,6 +14,7 @@
 #include "nix-vector-routing.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
@@ -21,6 +22,7 @@
 
 #include <iomanip>
 #include <queue>
+#include <thread>
 
 namespace ns3
 {
@@ -44,6 +46,15 @@ template <typename T>
 typename NixVectorRouting<T>::NetDeviceToIpInterfaceMap
     NixVectorRouting<T>::g_netdeviceToIpInterfaceMap;
 
+template <typename T>
+std::vector<uint32_t> NixVectorRouting<T>::g_reverseLinkOffsets;
+
+template <typename T>
+std::vector<uint32_t> NixVectorRouting<T>::g_reverseLinks;
+
+template <typename T>
+std::vector<std::vector<uint32_t>> NixVectorRouting<T>::g_nextHops;
+
 template <typename T>
 TypeId
 NixVectorRouting<T>::GetTypeId()
@@ -60,13 +71,25 @@ NixVectorRouting<T>::GetTypeId()
     static TypeId tid = TypeId("ns3::" + name + "NixVectorRouting")
                             .SetParent<T>()
                             .SetGroupName("NixVectorRouting")
-                            .template AddConstructor<NixVectorRouting<T>>();
+                            .template AddConstructor<NixVectorRouting<T>>()
+                            .AddAttribute("SharedCache",
+                                          "If true, the routes towards a destination are "
+                                          "computed by a single breadth first search from the "
+                                          "destination, whose result is shared by all the "
+                                          "nodes, instead of a search from each source. When "
+                                          "several shortest paths exist, the chosen one may "
+                                          "differ from the one found from the source.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(
+                                              &NixVectorRouting<T>::m_useSharedCache),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting()
-    : m_totalNeighbors(0)
+    : m_totalNeighbors(0),
+      m_useSharedCache(false)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -157,6 +180,11 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
     // IP address to node mapping is potentially invalid so clear it.
     // Will be repopulated in lazy evaluation when mapping is needed.
     g_ipAddressToNodeMap.clear();
+
+    // Same for the shared links and next hops
+    g_reverseLinkOffsets.clear();
+    g_reverseLinks.clear();
+    g_nextHops.clear();
 }
 
 template <typename T>
@@ -206,6 +234,17 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
     {
         // otherwise proceed as normal
         // and build the nix vector
+        if (m_useSharedCache && !oif)
+        {
+            const auto& nextHops = GetSharedNextHops(destNode->GetId());
+            if (BuildNixVectorFromNextHops(nextHops, source->GetId(), destNode->GetId(), nixVector))
+            {
+                return nixVector;
+            }
+            NS_LOG_ERROR("No routing path exists");
+            return nullptr;
+        }
+
         std::vector<Ptr<Node>> parentVector;
 
         if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
@@ -287,7 +326,49 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
         return false;
     }
 
-    Ptr<Node> parentNode = parentVector.at(dest);
+    AddNeighborIndex(parentVector.at(dest), dest, nixVector);
+
+    // recurse through T vector, grabbing the path
+    // and building the nix vector
+    BuildNixVector(parentVector, source, (parentVector.at(dest))->GetId(), nixVector);
+    return true;
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::BuildNixVectorFromNextHops(const std::vector<uint32_t>& nextHops,
+                                                uint32_t source,
+                                                uint32_t dest,
+                                                Ptr<NixVector> nixVector) const
+{
+    NS_LOG_FUNCTION(this << source << dest << nixVector);
+
+    if (source >= nextHops.size() || nextHops[source] == NO_NEXT_HOP)
+    {
+        return false;
+    }
+
+    std::vector<uint32_t> path{source};
+    while (path.back() != dest)
+    {
+        path.push_back(nextHops[path.back()]);
+    }
+
+    // the neighbor indices are added starting from the last hop, as BuildNixVector does
+    for (std::size_t i = path.size() - 1; i > 0; i--)
+    {
+        AddNeighborIndex(NodeList::GetNode(path[i - 1]), path[i], nixVector);
+    }
+    return true;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::AddNeighborIndex(Ptr<Node> parentNode,
+                                      uint32_t dest,
+                                      Ptr<NixVector> nixVector) const
+{
+    NS_LOG_FUNCTION(this << parentNode << dest << nixVector);
 
     uint32_t numberOfDevices = parentNode->GetNDevices();
     uint32_t destId = 0;
@@ -338,11 +419,6 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
     NS_LOG_LOGIC("Adding Nix: " << destId << " with " << nixVector->BitCount(totalNeighbors)
                                 << " bits, for node " << parentNode->GetId());
     nixVector->AddNeighborIndex(destId, nixVector->BitCount(totalNeighbors));
-
-    // recurse through T vector, grabbing the path
-    // and building the nix vector
-    BuildNixVector(parentVector, source, (parentVector.at(dest))->GetId(), nixVector);
-    return true;
 }
 
 template <typename T>
@@ -1270,6 +1346,158 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
     return false;
 }
 
+template <typename T>
+void
+NixVectorRouting<T>::BuildSharedTopology() const
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t numberOfNodes = NodeList::GetNNodes();
+    std::vector<std::pair<uint32_t, uint32_t>> links; // (receiving node, sending node)
+
+    for (uint32_t n = 0; n < numberOfNodes; n++)
+    {
+        Ptr<Node> node = NodeList::GetNode(n);
+        Ptr<IpL3Protocol> ip = node->GetObject<IpL3Protocol>();
+
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> localNetDevice = node->GetDevice(i);
+
+            // make sure that we can go this way
+            if (ip)
+            {
+                int32_t interfaceIndex = ip->GetInterfaceForDevice(localNetDevice);
+                if (interfaceIndex != -1 && !ip->IsUp(interfaceIndex))
+                {
+                    continue;
+                }
+            }
+            if (!localNetDevice->IsLinkUp())
+            {
+                continue;
+            }
+            Ptr<Channel> channel = localNetDevice->GetChannel();
+            if (!channel)
+            {
+                continue;
+            }
+
+            NetDeviceContainer netDeviceContainer;
+            GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
+            for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End(); iter++)
+            {
+                // GetAdjacentNetDevices only returns the devices whose IpInterface is up
+                links.emplace_back((*iter)->GetNode()->GetId(), n);
+            }
+        }
+    }
+
+    // group the links by receiving node
+    g_reverseLinkOffsets.assign(numberOfNodes + 1, 0);
+    for (const auto& link : links)
+    {
+        g_reverseLinkOffsets[link.first + 1]++;
+    }
+    for (uint32_t n = 0; n < numberOfNodes; n++)
+    {
+        g_reverseLinkOffsets[n + 1] += g_reverseLinkOffsets[n];
+    }
+    g_reverseLinks.resize(links.size());
+    std::vector<uint32_t> next(g_reverseLinkOffsets.begin(), g_reverseLinkOffsets.end() - 1);
+    for (const auto& link : links)
+    {
+        g_reverseLinks[next[link.first]++] = link.second;
+    }
+
+    g_nextHops.assign(numberOfNodes, {});
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::ReverseBFS(uint32_t dest, std::vector<uint32_t>& nextHops)
+{
+    uint32_t numberOfNodes = g_reverseLinkOffsets.size() - 1;
+    nextHops.assign(numberOfNodes, NO_NEXT_HOP);
+    nextHops[dest] = dest;
+
+    // the queue holds the discovered nodes, in the order of discovery
+    std::vector<uint32_t> queue;
+    queue.reserve(numberOfNodes);
+    queue.push_back(dest);
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+        uint32_t currNode = queue[head];
+        for (uint32_t i = g_reverseLinkOffsets[currNode]; i < g_reverseLinkOffsets[currNode + 1];
+             i++)
+        {
+            uint32_t prevNode = g_reverseLinks[i];
+            if (nextHops[prevNode] == NO_NEXT_HOP)
+            {
+                nextHops[prevNode] = currNode;
+                queue.push_back(prevNode);
+            }
+        }
+    }
+}
+
+template <typename T>
+const std::vector<uint32_t>&
+NixVectorRouting<T>::GetSharedNextHops(uint32_t dest) const
+{
+    NS_LOG_FUNCTION(this << dest);
+
+    if (g_reverseLinkOffsets.empty())
+    {
+        BuildSharedTopology();
+    }
+    NS_ASSERT_MSG(dest < g_nextHops.size(), "Node " << dest << " was created after the last flush");
+
+    if (g_nextHops[dest].empty())
+    {
+        NS_LOG_LOGIC("Computing the next hops towards Node " << dest);
+        ReverseBFS(dest, g_nextHops[dest]);
+    }
+    return g_nextHops[dest];
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::PrecomputeSharedCache(uint32_t nThreads) const
+{
+    NS_LOG_FUNCTION(this << nThreads);
+    NS_ASSERT_MSG(nThreads > 0, "At least one thread is needed");
+
+    CheckCacheStateAndFlush();
+    if (g_reverseLinkOffsets.empty())
+    {
+        BuildSharedTopology();
+    }
+
+    // the destinations are divided among the threads, each thread only writes to
+    // the next hops of its destinations and only reads the shared links
+    auto computeNextHops = [nThreads](uint32_t first) {
+        for (uint32_t dest = first; dest < g_nextHops.size(); dest += nThreads)
+        {
+            if (g_nextHops[dest].empty())
+            {
+                ReverseBFS(dest, g_nextHops[dest]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < nThreads; t++)
+    {
+        threads.emplace_back(computeNextHops, t);
+    }
+    computeNextHops(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
 template <typename T>
 void
 NixVectorRouting<T>::PrintRoutingPath(Ptr<Node> source,
@@ -1432,5 +1660,7 @@ template void NixVectorRouting<Ipv6RoutingProtocol>::PrintRoutingPath(
     IpAddress dest,
     Ptr<OutputStreamWrapper> stream,
     Time::Unit unit) const;
+template void NixVectorRouting<Ipv4RoutingProtocol>::PrecomputeSharedCache(uint32_t nThreads) const;
+template void NixVectorRouting<Ipv6RoutingProtocol>::PrecomputeSharedCache(uint32_t nThreads) const;
 
 } // namespace ns3
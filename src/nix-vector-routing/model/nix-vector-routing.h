@@ -30,6 +30,7 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
+#include <limits>
 #include <map>
 #include <unordered_map>
 
@@ -131,6 +132,18 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                           Ptr<OutputStreamWrapper> stream,
                           Time::Unit unit) const;
 
+    /**
+     * @brief Compute the shared next hops of all the nodes towards every node
+     *
+     * When the SharedCache attribute is set, the next hops towards a destination
+     * are otherwise computed the first time a node needs a route to it. This
+     * method computes them upfront, dividing the destinations among the given
+     * number of threads. The next hops are computed again after a topology change.
+     *
+     * @param nThreads the number of threads to use
+     */
+    void PrecomputeSharedCache(uint32_t nThreads = 1) const;
+
   private:
     /**
      * Flushes the cache which stores nix-vector based on
@@ -218,6 +231,29 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                         uint32_t dest,
                         Ptr<NixVector> nixVector) const;
 
+    /**
+     * Follows the shared next hops from the source to the destination and builds
+     * the nixvector
+     * @param [in] nextHops Next hop of every node towards the destination
+     * @param [in] source Source Node index
+     * @param [in] dest Destination Node index
+     * @param [out] nixVector the NixVector to be used for routing
+     * @returns true on success, false otherwise.
+     */
+    bool BuildNixVectorFromNextHops(const std::vector<uint32_t>& nextHops,
+                                    uint32_t source,
+                                    uint32_t dest,
+                                    Ptr<NixVector> nixVector) const;
+
+    /**
+     * Adds to the nixvector the index of a node among the neighbors of the
+     * previous node on the path
+     * @param [in] parentNode the previous node on the path
+     * @param [in] dest the index of the node
+     * @param [out] nixVector the NixVector to be used for routing
+     */
+    void AddNeighborIndex(Ptr<Node> parentNode, uint32_t dest, Ptr<NixVector> nixVector) const;
+
     /**
      * Simply iterates through the nodes net-devices and determines
      * how many neighbors the node has.
@@ -260,6 +296,28 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
              std::vector<Ptr<Node>>& parentVector,
              Ptr<NetDevice> oif) const;
 
+    /**
+     * Builds the shared list of the links that can be used by the packets,
+     * applying the same rules as BFS.
+     */
+    void BuildSharedTopology() const;
+
+    /**
+     * @brief Breadth first search from a destination along the reversed
+     * shared links, which gives the next hop of all the nodes at once.
+     * @param [in] dest Destination Node index
+     * @param [out] nextHops Next hop of every node towards the destination
+     *              (NO_NEXT_HOP if the destination cannot be reached)
+     */
+    static void ReverseBFS(uint32_t dest, std::vector<uint32_t>& nextHops);
+
+    /**
+     * Returns the shared next hops towards a destination, computing them if needed
+     * @param dest Destination Node index
+     * @returns the next hop of every node towards the destination
+     */
+    const std::vector<uint32_t>& GetSharedNextHops(uint32_t dest) const;
+
     /**
      * \sa Ipv4RoutingProtocol::DoInitialize
      * \sa Ipv6RoutingProtocol::DoInitialize
@@ -492,6 +550,26 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     /** Total neighbors used for nix-vector to determine number of bits */
     uint32_t m_totalNeighbors;
 
+    /** Whether the next hops computed by a reverse BFS shared by all the nodes are used */
+    bool m_useSharedCache;
+
+    /// Next hop of the nodes that cannot reach a destination
+    static constexpr uint32_t NO_NEXT_HOP = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Links usable by the packets, grouped by the node at their receiving end:
+     * the nodes having a link towards node n are stored in g_reverseLinks from
+     * index g_reverseLinkOffsets[n] to index g_reverseLinkOffsets[n + 1].
+     */
+    static std::vector<uint32_t> g_reverseLinkOffsets;
+    static std::vector<uint32_t> g_reverseLinks; //!< Sources of the usable links
+
+    /**
+     * Next hop of every node towards each destination node, indexed by the
+     * destination node. Empty for the destinations not computed yet.
+     */
+    static std::vector<std::vector<uint32_t>> g_nextHops;
+
     /**
      * Mapping of IP address to ns-3 node.
      *
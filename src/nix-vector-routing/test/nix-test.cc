@@ -6,6 +6,7 @@
  * Author: Ameya Deshpande <ameyanrd@outlook.com>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -49,6 +50,8 @@ using namespace ns3;
  * (Set down the interface of nC on nB-nC channel.)
  * - Test that routing is not possible from nSrc to nDst.
  *
+ * The test is run with and without the next hops shared by all the nodes.
+ *
  * @brief IPv4 Nix-Vector Routing Test
  */
 class NixVectorRoutingTest : public TestCase
@@ -87,7 +90,12 @@ class NixVectorRoutingTest : public TestCase
 
   public:
     void DoRun() override;
-    NixVectorRoutingTest();
+
+    /**
+     * Constructor
+     * @param sharedCache whether the nodes use the shared next hops
+     */
+    NixVectorRoutingTest(bool sharedCache = false);
 
     /**
      * @brief Receive data.
@@ -96,10 +104,13 @@ class NixVectorRoutingTest : public TestCase
     void ReceivePkt(Ptr<Socket> socket);
 
     std::vector<uint32_t> m_receivedPacketSizes; //!< Received packet sizes
+    bool m_sharedCache; //!< Whether the nodes use the shared next hops
 };
 
-NixVectorRoutingTest::NixVectorRoutingTest()
-    : TestCase("three router, two path test")
+NixVectorRoutingTest::NixVectorRoutingTest(bool sharedCache)
+    : TestCase(std::string("three router, two path test") +
+               (sharedCache ? " with shared cache" : "")),
+      m_sharedCache(sharedCache)
 {
 }
 
@@ -197,6 +208,8 @@ NixVectorRoutingTest::DoRun()
     // NixHelper to install nix-vector routing on all nodes
     Ipv4NixVectorHelper ipv4NixRouting;
     Ipv6NixVectorHelper ipv6NixRouting;
+    ipv4NixRouting.Set("SharedCache", BooleanValue(m_sharedCache));
+    ipv6NixRouting.Set("SharedCache", BooleanValue(m_sharedCache));
     InternetStackHelper stack;
     stack.SetRoutingHelper(ipv4NixRouting); // has effect on the next Install ()
     stack.SetRoutingHelper(ipv6NixRouting); // has effect on the next Install ()
@@ -395,6 +408,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingTest(true), TestCase::Duration::QUICK);
     }
 };
 
@@ -41,8 +41,11 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 /********** Useful macros **********/
 
@@ -647,19 +650,20 @@ RoutingProtocol::RecvOlsr(Ptr<Socket> socket)
 int
 RoutingProtocol::Degree(const NeighborTuple& tuple)
 {
+    // The 2-hop neighbor tuples are only counted if their neighbor, i.e., the
+    // neighbor of the given tuple, is not in the neighbor set: check it once.
+    if (m_state.FindNeighborTuple(tuple.neighborMainAddr) != nullptr)
+    {
+        return 0;
+    }
+
     int degree = 0;
     for (auto it = m_state.GetTwoHopNeighbors().begin(); it != m_state.GetTwoHopNeighbors().end();
          it++)
     {
-        const TwoHopNeighborTuple& nb2hop_tuple = *it;
-        if (nb2hop_tuple.neighborMainAddr == tuple.neighborMainAddr)
+        if (it->neighborMainAddr == tuple.neighborMainAddr)
         {
-            const NeighborTuple* nb_tuple =
-                m_state.FindNeighborTuple(nb2hop_tuple.neighborMainAddr);
-            if (nb_tuple == nullptr)
-            {
-                degree++;
-            }
+            degree++;
         }
     }
     return degree;
@@ -706,6 +710,16 @@ RoutingProtocol::MprComputation()
 {
     NS_LOG_FUNCTION(this);
 
+    // The MPR set only depends on the neighbor and 2-hop neighbor sets, hence
+    // it does not need to be computed again if they did not change.
+    std::vector<uint32_t> inputs = GetMprComputationInputs();
+    if (inputs == m_mprComputationInputs)
+    {
+        NS_LOG_LOGIC("Neighborhood unchanged, keeping the MPR set");
+        return;
+    }
+    m_mprComputationInputs = std::move(inputs);
+
     // MPR computation should be done for each interface. See section 8.3.1
     // (RFC 3626) for details.
     MprSet mprSet;
@@ -722,6 +736,13 @@ RoutingProtocol::MprComputation()
         }
     }
 
+    // first member of N for each neighbor main address
+    std::unordered_map<Ipv4Address, const NeighborTuple*, Ipv4AddressHash> firstInN;
+    for (const auto& neighbor : N)
+    {
+        firstInN.emplace(neighbor.neighborMainAddr, &neighbor);
+    }
+
     // N2 is the set of 2-hop neighbors reachable from "the interface
     // I", excluding:
     // (i)   the nodes only reachable by members of N with willingness Willingness::NEVER
@@ -742,16 +763,8 @@ RoutingProtocol::MprComputation()
 
         //  excluding:
         // (i)   the nodes only reachable by members of N with willingness Willingness::NEVER
-        bool ok = false;
-        for (auto neigh = N.begin(); neigh != N.end(); neigh++)
-        {
-            if (neigh->neighborMainAddr == twoHopNeigh->neighborMainAddr)
-            {
-                ok = (neigh->willingness != Willingness::NEVER);
-                break;
-            }
-        }
-        if (!ok)
+        auto neigh = firstInN.find(twoHopNeigh->neighborMainAddr);
+        if (neigh == firstInN.end() || neigh->second->willingness == Willingness::NEVER)
         {
             continue;
         }
@@ -759,16 +772,7 @@ RoutingProtocol::MprComputation()
         // excluding:
         // (iii) all the symmetric neighbors: the nodes for which there exists a symmetric
         //       link to this node on some interface.
-        for (auto neigh = N.begin(); neigh != N.end(); neigh++)
-        {
-            if (neigh->neighborMainAddr == twoHopNeigh->twoHopNeighborAddr)
-            {
-                ok = false;
-                break;
-            }
-        }
-
-        if (ok)
+        if (firstInN.count(twoHopNeigh->twoHopNeighborAddr) == 0)
         {
             N2.push_back(*twoHopNeigh);
         }
@@ -811,20 +815,30 @@ RoutingProtocol::MprComputation()
 
     // 3. Add to the MPR set those nodes in N, which are the *only*
     // nodes to provide reachability to a node in N2.
-    std::set<Ipv4Address> coveredTwoHopNeighbors;
-    for (auto twoHopNeigh = N2.begin(); twoHopNeigh != N2.end(); twoHopNeigh++)
+
+    // for each 2-hop neighbor in N2, the first neighbor that can reach it and
+    // whether another neighbor can reach it too
+    std::unordered_map<Ipv4Address, std::pair<Ipv4Address, bool>, Ipv4AddressHash> reachedBy;
+    // the 2-hop neighbors in N2 reachable through each neighbor
+    std::unordered_map<Ipv4Address, std::vector<Ipv4Address>, Ipv4AddressHash> reachableThrough;
+    for (const auto& twoHopNeigh : N2)
     {
-        bool onlyOne = true;
-        // try to find another neighbor that can reach twoHopNeigh->twoHopNeighborAddr
-        for (auto otherTwoHopNeigh = N2.begin(); otherTwoHopNeigh != N2.end(); otherTwoHopNeigh++)
+        auto [it, inserted] =
+            reachedBy.emplace(twoHopNeigh.twoHopNeighborAddr,
+                              std::make_pair(twoHopNeigh.neighborMainAddr, false));
+        if (!inserted && it->second.first != twoHopNeigh.neighborMainAddr)
         {
-            if (otherTwoHopNeigh->twoHopNeighborAddr == twoHopNeigh->twoHopNeighborAddr &&
-                otherTwoHopNeigh->neighborMainAddr != twoHopNeigh->neighborMainAddr)
-            {
-                onlyOne = false;
-                break;
-            }
+            it->second.second = true;
         }
+        reachableThrough[twoHopNeigh.neighborMainAddr].push_back(twoHopNeigh.twoHopNeighborAddr);
+    }
+
+    std::set<Ipv4Address> coveredTwoHopNeighbors;
+    std::set<Ipv4Address> onlyOneNeighbors;
+    for (auto twoHopNeigh = N2.begin(); twoHopNeigh != N2.end(); twoHopNeigh++)
+    {
+        // check whether another neighbor can reach twoHopNeigh->twoHopNeighborAddr
+        bool onlyOne = !reachedBy.at(twoHopNeigh->twoHopNeighborAddr).second;
         if (onlyOne)
         {
             NS_LOG_LOGIC("Neighbor " << twoHopNeigh->neighborMainAddr
@@ -834,13 +848,10 @@ RoutingProtocol::MprComputation()
             mprSet.insert(twoHopNeigh->neighborMainAddr);
 
             // take note of all the 2-hop neighbors reachable by the newly elected MPR
-            for (auto otherTwoHopNeigh = N2.begin(); otherTwoHopNeigh != N2.end();
-                 otherTwoHopNeigh++)
+            if (onlyOneNeighbors.insert(twoHopNeigh->neighborMainAddr).second)
             {
-                if (otherTwoHopNeigh->neighborMainAddr == twoHopNeigh->neighborMainAddr)
-                {
-                    coveredTwoHopNeighbors.insert(otherTwoHopNeigh->twoHopNeighborAddr);
-                }
+                const auto& reachable = reachableThrough.at(twoHopNeigh->neighborMainAddr);
+                coveredTwoHopNeighbors.insert(reachable.begin(), reachable.end());
             }
         }
     }
@@ -890,20 +901,18 @@ RoutingProtocol::MprComputation()
         // number of nodes in N2 which are not yet covered by at
         // least one node in the MPR set, and which are reachable
         // through this 1-hop neighbor
+        std::unordered_map<Ipv4Address, int, Ipv4AddressHash> nReachable;
+        for (const auto& nb2hop_tuple : N2)
+        {
+            nReachable[nb2hop_tuple.neighborMainAddr]++;
+        }
         std::map<int, std::vector<const NeighborTuple*>> reachability;
         std::set<int> rs;
         for (auto it = N.begin(); it != N.end(); it++)
         {
             const NeighborTuple& nb_tuple = *it;
-            int r = 0;
-            for (auto it2 = N2.begin(); it2 != N2.end(); it2++)
-            {
-                const TwoHopNeighborTuple& nb2hop_tuple = *it2;
-                if (nb_tuple.neighborMainAddr == nb2hop_tuple.neighborMainAddr)
-                {
-                    r++;
-                }
-            }
+            auto reachable = nReachable.find(nb_tuple.neighborMainAddr);
+            int r = (reachable != nReachable.end()) ? reachable->second : 0;
             rs.insert(r);
             reachability[r].push_back(&nb_tuple);
         }
@@ -1003,9 +1012,36 @@ RoutingProtocol::RoutingTableComputation()
     NS_LOG_DEBUG(Simulator::Now().As(Time::S)
                  << " : Node " << m_mainAddress << ": RoutingTableComputation begin...");
 
+    // The routing table only depends on the sets below, hence it does not need
+    // to be computed again if they did not change.
+    std::vector<uint32_t> inputs = GetRoutingTableComputationInputs();
+    if (inputs == m_routingTableComputationInputs)
+    {
+        NS_LOG_DEBUG("Node " << m_mainAddress << ": RoutingTableComputation end (unchanged).");
+        m_routingTableChanged(GetSize());
+        return;
+    }
+    m_routingTableComputationInputs = std::move(inputs);
+
     // 1. All the entries from the routing table are removed.
     Clear();
 
+    // main address of each interface address, see GetMainAddress
+    std::unordered_map<Ipv4Address, Ipv4Address, Ipv4AddressHash> mainAddresses;
+    for (const auto& tuple : m_state.GetIfaceAssocSet())
+    {
+        mainAddresses.emplace(tuple.ifaceAddr, tuple.mainAddr);
+    }
+    // link tuples of each neighbor main address, in the order of the link set
+    std::unordered_map<Ipv4Address, std::vector<const LinkTuple*>, Ipv4AddressHash> links;
+    for (const auto& link_tuple : m_state.GetLinks())
+    {
+        auto mainAddress = mainAddresses.find(link_tuple.neighborIfaceAddr);
+        links[mainAddress != mainAddresses.end() ? mainAddress->second
+                                                 : link_tuple.neighborIfaceAddr]
+            .push_back(&link_tuple);
+    }
+
     // 2. The new routing entries are added starting with the
     // symmetric neighbors (h=1) as the destination nodes.
     const NeighborSet& neighborSet = m_state.GetNeighbors();
@@ -1013,19 +1049,18 @@ RoutingProtocol::RoutingTableComputation()
     {
         const NeighborTuple& nb_tuple = *it;
         NS_LOG_DEBUG("Looking at neighbor tuple: " << nb_tuple);
-        if (nb_tuple.status == NeighborTuple::STATUS_SYM)
+        auto nb_links = links.find(nb_tuple.neighborMainAddr);
+        if (nb_tuple.status == NeighborTuple::STATUS_SYM && nb_links != links.end())
         {
             bool nb_main_addr = false;
             const LinkTuple* lt = nullptr;
-            const LinkSet& linkSet = m_state.GetLinks();
-            for (auto it2 = linkSet.begin(); it2 != linkSet.end(); it2++)
+            for (const auto* link : nb_links->second)
             {
-                const LinkTuple& link_tuple = *it2;
+                const LinkTuple& link_tuple = *link;
                 NS_LOG_DEBUG("Looking at link tuple: "
                              << link_tuple
                              << (link_tuple.time >= Simulator::Now() ? "" : " (expired)"));
-                if ((GetMainAddress(link_tuple.neighborIfaceAddr) == nb_tuple.neighborMainAddr) &&
-                    link_tuple.time >= Simulator::Now())
+                if (link_tuple.time >= Simulator::Now())
                 {
                     NS_LOG_LOGIC("Link tuple matches neighbor "
                                  << nb_tuple.neighborMainAddr
@@ -1042,11 +1077,8 @@ RoutingProtocol::RoutingTableComputation()
                 }
                 else
                 {
-                    NS_LOG_LOGIC("Link tuple: linkMainAddress= "
-                                 << GetMainAddress(link_tuple.neighborIfaceAddr)
-                                 << "; neighborMainAddr =  " << nb_tuple.neighborMainAddr
-                                 << "; expired=" << int(link_tuple.time < Simulator::Now())
-                                 << " => IGNORE");
+                    NS_LOG_LOGIC("Link tuple of neighbor " << nb_tuple.neighborMainAddr
+                                                           << " expired => IGNORE");
                 }
             }
 
@@ -1073,6 +1105,19 @@ RoutingProtocol::RoutingTableComputation()
     //  least one entry in the 2-hop neighbor set where
     //  N_neighbor_main_addr correspond to a neighbor node with
     //  willingness different of Willingness::NEVER,
+    std::unordered_set<Ipv4Address, Ipv4AddressHash> symNeighbors;
+    std::unordered_set<Ipv4Address, Ipv4AddressHash> willingNeighbors;
+    for (const auto& neighbor : neighborSet)
+    {
+        if (neighbor.status == NeighborTuple::STATUS_SYM)
+        {
+            symNeighbors.insert(neighbor.neighborMainAddr);
+        }
+        if (neighbor.willingness != Willingness::NEVER)
+        {
+            willingNeighbors.insert(neighbor.neighborMainAddr);
+        }
+    }
     const TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
     for (auto it = twoHopNeighbors.begin(); it != twoHopNeighbors.end(); it++)
     {
@@ -1081,7 +1126,7 @@ RoutingProtocol::RoutingTableComputation()
         NS_LOG_LOGIC("Looking at two-hop neighbor tuple: " << nb2hop_tuple);
 
         // a 2-hop neighbor which is not a neighbor node or the node itself
-        if (m_state.FindSymNeighborTuple(nb2hop_tuple.twoHopNeighborAddr))
+        if (symNeighbors.count(nb2hop_tuple.twoHopNeighborAddr) != 0)
         {
             NS_LOG_LOGIC("Two-hop neighbor tuple is also neighbor; skipped.");
             continue;
@@ -1096,17 +1141,7 @@ RoutingProtocol::RoutingTableComputation()
         // ...and such that there exist at least one entry in the 2-hop
         // neighbor set where N_neighbor_main_addr correspond to a
         // neighbor node with willingness different of Willingness::NEVER...
-        bool nb2hopOk = false;
-        for (auto neighbor = neighborSet.begin(); neighbor != neighborSet.end(); neighbor++)
-        {
-            if (neighbor->neighborMainAddr == nb2hop_tuple.neighborMainAddr &&
-                neighbor->willingness != Willingness::NEVER)
-            {
-                nb2hopOk = true;
-                break;
-            }
-        }
-        if (!nb2hopOk)
+        if (willingNeighbors.count(nb2hop_tuple.neighborMainAddr) == 0)
         {
             NS_LOG_LOGIC("Two-hop neighbor tuple skipped: 2-hop neighbor "
                          << nb2hop_tuple.twoHopNeighborAddr << " is attached to neighbor "
@@ -1140,58 +1175,76 @@ RoutingProtocol::RoutingTableComputation()
         }
     }
 
-    for (uint32_t h = 2;; h++)
+    // 3.1. For each topology entry in the topology table, if its
+    // T_dest_addr does not correspond to R_dest_addr of any
+    // route entry in the routing table AND its T_last_addr
+    // corresponds to R_dest_addr of a route entry whose R_dist
+    // is equal to h, then a new route entry MUST be recorded in
+    // the routing table (if it does not already exist)
+    //
+    // The routes of distance h, starting from h=2, are only added while
+    // looking at the routes of distance h-1, hence only the topology tuples
+    // whose T_last_addr is the destination of a route added at the previous
+    // step need to be looked at, in the order of the topology table.
+    const TopologySet& topology = m_state.GetTopologySet();
+    std::unordered_map<Ipv4Address, std::vector<std::size_t>, Ipv4AddressHash> topologyByLastAddr;
+    for (std::size_t i = 0; i < topology.size(); i++)
     {
-        bool added = false;
-
-        // 3.1. For each topology entry in the topology table, if its
-        // T_dest_addr does not correspond to R_dest_addr of any
-        // route entry in the routing table AND its T_last_addr
-        // corresponds to R_dest_addr of a route entry whose R_dist
-        // is equal to h, then a new route entry MUST be recorded in
-        // the routing table (if it does not already exist)
-        const TopologySet& topology = m_state.GetTopologySet();
-        for (auto it = topology.begin(); it != topology.end(); it++)
+        topologyByLastAddr[topology[i].lastAddr].push_back(i);
+    }
+    std::vector<Ipv4Address> lastAddrs; // destinations of the routes of distance h
+    for (const auto& [dest, entry] : m_table)
+    {
+        if (entry.distance == 2)
         {
-            const TopologyTuple& topology_tuple = *it;
-            NS_LOG_LOGIC("Looking at topology tuple: " << topology_tuple);
+            lastAddrs.push_back(dest);
+        }
+    }
 
-            RoutingTableEntry destAddrEntry;
-            RoutingTableEntry lastAddrEntry;
-            bool have_destAddrEntry = Lookup(topology_tuple.destAddr, destAddrEntry);
-            bool have_lastAddrEntry = Lookup(topology_tuple.lastAddr, lastAddrEntry);
-            if (!have_destAddrEntry && have_lastAddrEntry && lastAddrEntry.distance == h)
+    for (uint32_t h = 2; !lastAddrs.empty(); h++)
+    {
+        std::vector<std::size_t> tuples;
+        for (const auto& lastAddr : lastAddrs)
+        {
+            auto it = topologyByLastAddr.find(lastAddr);
+            if (it != topologyByLastAddr.end())
             {
-                NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
-                // then a new route entry MUST be recorded in
-                //                the routing table (if it does not already exist) where:
-                //                     R_dest_addr  = T_dest_addr;
-                //                     R_next_addr  = R_next_addr of the recorded
-                //                                    route entry where:
-                //                                    R_dest_addr == T_last_addr
-                //                     R_dist       = h+1; and
-                //                     R_iface_addr = R_iface_addr of the recorded
-                //                                    route entry where:
-                //                                       R_dest_addr == T_last_addr.
-                AddEntry(topology_tuple.destAddr,
-                         lastAddrEntry.nextAddr,
-                         lastAddrEntry.interface,
-                         h + 1);
-                added = true;
+                tuples.insert(tuples.end(), it->second.begin(), it->second.end());
             }
-            else
+        }
+        std::sort(tuples.begin(), tuples.end());
+        lastAddrs.clear();
+
+        for (auto i : tuples)
+        {
+            const TopologyTuple& topology_tuple = topology[i];
+            NS_LOG_LOGIC("Looking at topology tuple: " << topology_tuple);
+
+            if (m_table.find(topology_tuple.destAddr) != m_table.end())
             {
                 NS_LOG_LOGIC("NOT adding routing table entry based on the topology tuple: "
-                             "have_destAddrEntry="
-                             << have_destAddrEntry << " have_lastAddrEntry=" << have_lastAddrEntry
-                             << " lastAddrEntry.distance=" << (int)lastAddrEntry.distance
-                             << " (h=" << h << ")");
+                             "have_destAddrEntry=1 (h="
+                             << h << ")");
+                continue;
             }
-        }
 
-        if (!added)
-        {
-            break;
+            NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
+            // then a new route entry MUST be recorded in
+            //                the routing table (if it does not already exist) where:
+            //                     R_dest_addr  = T_dest_addr;
+            //                     R_next_addr  = R_next_addr of the recorded
+            //                                    route entry where:
+            //                                    R_dest_addr == T_last_addr
+            //                     R_dist       = h+1; and
+            //                     R_iface_addr = R_iface_addr of the recorded
+            //                                    route entry where:
+            //                                       R_dest_addr == T_last_addr.
+            const RoutingTableEntry& lastAddrEntry = m_table.at(topology_tuple.lastAddr);
+            AddEntry(topology_tuple.destAddr,
+                     lastAddrEntry.nextAddr,
+                     lastAddrEntry.interface,
+                     h + 1);
+            lastAddrs.push_back(topology_tuple.destAddr);
         }
     }
 
@@ -1228,7 +1281,7 @@ RoutingProtocol::RoutingTableComputation()
     const AssociationSet& associationSet = m_state.GetAssociationSet();
 
     // Clear HNA routing table
-    for (uint32_t i = 0; i < m_hnaRoutingTable->GetNRoutes(); i++)
+    while (m_hnaRoutingTable->GetNRoutes() > 0)
     {
         m_hnaRoutingTable->RemoveRoute(0);
     }
@@ -1304,6 +1357,73 @@ RoutingProtocol::RoutingTableComputation()
     m_routingTableChanged(GetSize());
 }
 
+std::vector<uint32_t>
+RoutingProtocol::GetMprComputationInputs() const
+{
+    const NeighborSet& neighbors = m_state.GetNeighbors();
+    const TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
+
+    std::vector<uint32_t> inputs;
+    inputs.reserve(3 + 3 * neighbors.size() + 2 * twoHopNeighbors.size());
+    inputs.push_back(m_mainAddress.Get());
+    inputs.push_back(neighbors.size());
+    for (const auto& neighbor : neighbors)
+    {
+        inputs.push_back(neighbor.neighborMainAddr.Get());
+        inputs.push_back(neighbor.status);
+        inputs.push_back(static_cast<uint32_t>(neighbor.willingness));
+    }
+    inputs.push_back(twoHopNeighbors.size());
+    for (const auto& twoHopNeighbor : twoHopNeighbors)
+    {
+        inputs.push_back(twoHopNeighbor.neighborMainAddr.Get());
+        inputs.push_back(twoHopNeighbor.twoHopNeighborAddr.Get());
+    }
+    return inputs;
+}
+
+std::vector<uint32_t>
+RoutingProtocol::GetRoutingTableComputationInputs() const
+{
+    std::vector<uint32_t> inputs = GetMprComputationInputs();
+    Time now = Simulator::Now();
+
+    // only the link tuples that did not expire are used
+    inputs.push_back(m_state.GetLinks().size());
+    for (const auto& link : m_state.GetLinks())
+    {
+        inputs.push_back(link.localIfaceAddr.Get());
+        inputs.push_back(link.neighborIfaceAddr.Get());
+        inputs.push_back(link.time >= now);
+    }
+    inputs.push_back(m_state.GetTopologySet().size());
+    for (const auto& topology : m_state.GetTopologySet())
+    {
+        inputs.push_back(topology.destAddr.Get());
+        inputs.push_back(topology.lastAddr.Get());
+    }
+    inputs.push_back(m_state.GetIfaceAssocSet().size());
+    for (const auto& ifaceAssoc : m_state.GetIfaceAssocSet())
+    {
+        inputs.push_back(ifaceAssoc.ifaceAddr.Get());
+        inputs.push_back(ifaceAssoc.mainAddr.Get());
+    }
+    inputs.push_back(m_state.GetAssociationSet().size());
+    for (const auto& association : m_state.GetAssociationSet())
+    {
+        inputs.push_back(association.gatewayAddr.Get());
+        inputs.push_back(association.networkAddr.Get());
+        inputs.push_back(association.netmask.Get());
+    }
+    inputs.push_back(m_state.GetAssociations().size());
+    for (const auto& association : m_state.GetAssociations())
+    {
+        inputs.push_back(association.networkAddr.Get());
+        inputs.push_back(association.netmask.Get());
+    }
+    return inputs;
+}
+
 void
 RoutingProtocol::ProcessHello(const olsr::MessageHeader& msg,
                               const Ipv4Address& receiverIface,
@@ -3058,21 +3178,29 @@ RoutingProtocol::RouteInput(Ptr<const Packet> p,
 void
 RoutingProtocol::NotifyInterfaceUp(uint32_t i)
 {
+    // the interface of the routes may change
+    m_routingTableComputationInputs.clear();
 }
 
 void
 RoutingProtocol::NotifyInterfaceDown(uint32_t i)
 {
+    // the interface of the routes may change
+    m_routingTableComputationInputs.clear();
 }
 
 void
 RoutingProtocol::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
+    // the interface of the routes may change
+    m_routingTableComputationInputs.clear();
 }
 
 void
 RoutingProtocol::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
+    // the interface of the routes may change
+    m_routingTableComputationInputs.clear();
 }
 
 void
@@ -33,6 +33,8 @@
 
 /// Testcase for MPR computation mechanism
 class OlsrMprTestCase;
+class OlsrHnaRoutingTableTestCase;
+class OlsrRoutingTableTestCase;
 
 namespace ns3
 {
@@ -77,6 +79,8 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      * Declared friend to enable unit tests.
      */
     friend class ::OlsrMprTestCase;
+    friend class ::OlsrHnaRoutingTableTestCase;
+    friend class ::OlsrRoutingTableTestCase;
 
     static const uint16_t OLSR_PORT_NUMBER; //!< port number (698)
 
@@ -389,6 +393,26 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      */
     void RoutingTableComputation();
 
+    /**
+     * @brief Gets the inputs of the MPR computation, i.e., the neighbor and 2-hop
+     * neighbor sets, in a form that can be compared with the inputs of a previous
+     * computation.
+     * @return the inputs of the MPR computation.
+     */
+    std::vector<uint32_t> GetMprComputationInputs() const;
+
+    /**
+     * @brief Gets the inputs of the routing table computation, i.e., the inputs of the
+     * MPR computation plus the link, topology and association sets, in a form that can
+     * be compared with the inputs of a previous computation.
+     * @return the inputs of the routing table computation.
+     */
+    std::vector<uint32_t> GetRoutingTableComputationInputs() const;
+
+    std::vector<uint32_t> m_mprComputationInputs; //!< Inputs of the last MPR computation
+    /// Inputs of the last routing table computation
+    std::vector<uint32_t> m_routingTableComputationInputs;
+
   public:
     /**
      * @brief Gets the main address associated with a given interface address.
@@ -8,9 +8,14 @@
  *          Gustavo J. A. M. Carneiro <gjc@inescporto.pt>
  */
 
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/olsr-repositories.h"
 #include "ns3/olsr-routing-protocol.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
 
 /**
@@ -163,6 +168,204 @@ OlsrMprTestCase::DoRun()
                           "Node 1 must NOT select node 8 as MPR");
 }
 
+/**
+ * @ingroup olsr-test
+ * @ingroup tests
+ *
+ * Testcase for the routing table computation, in particular when the topology
+ * set changes between two computations.
+ */
+class OlsrRoutingTableTestCase : public TestCase
+{
+  public:
+    OlsrRoutingTableTestCase();
+    void DoRun() override;
+};
+
+OlsrRoutingTableTestCase::OlsrRoutingTableTestCase()
+    : TestCase("Check OLSR routing table computation")
+{
+}
+
+void
+OlsrRoutingTableTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper devices;
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    addresses.Assign(devices.Install(node));
+
+    Ptr<RoutingProtocol> protocol = CreateObject<RoutingProtocol>();
+    protocol->SetIpv4(node->GetObject<Ipv4>());
+    protocol->m_mainAddress = Ipv4Address("10.0.0.1");
+    OlsrState& state = protocol->m_state;
+
+    /*
+     *  1 -- 2 -- 3 -- 4 -- 5
+     *
+     * 2 is a neighbor, 3 a 2-hop neighbor, the other links are known from TC messages.
+     */
+    LinkTuple link;
+    link.localIfaceAddr = Ipv4Address("10.0.0.1");
+    link.neighborIfaceAddr = Ipv4Address("10.0.0.2");
+    link.symTime = Seconds(3600);
+    link.asymTime = Seconds(3600);
+    link.time = Seconds(3600);
+    state.InsertLinkTuple(link);
+    NeighborTuple neighbor;
+    neighbor.status = NeighborTuple::STATUS_SYM;
+    neighbor.willingness = Willingness::DEFAULT;
+    neighbor.neighborMainAddr = Ipv4Address("10.0.0.2");
+    state.InsertNeighborTuple(neighbor);
+    TwoHopNeighborTuple twoHopNeighbor;
+    twoHopNeighbor.expirationTime = Seconds(3600);
+    twoHopNeighbor.neighborMainAddr = Ipv4Address("10.0.0.2");
+    twoHopNeighbor.twoHopNeighborAddr = Ipv4Address("10.0.0.3");
+    state.InsertTwoHopNeighborTuple(twoHopNeighbor);
+    TopologyTuple topology;
+    topology.expirationTime = Seconds(3600);
+    topology.sequenceNumber = 1;
+    topology.destAddr = Ipv4Address("10.0.0.5");
+    topology.lastAddr = Ipv4Address("10.0.0.4");
+    state.InsertTopologyTuple(topology);
+    topology.destAddr = Ipv4Address("10.0.0.4");
+    topology.lastAddr = Ipv4Address("10.0.0.3");
+    state.InsertTopologyTuple(topology);
+
+    protocol->RoutingTableComputation();
+    for (uint32_t i = 2; i <= 5; i++)
+    {
+        Ipv4Address dest(0x0a000000 + i);
+        RoutingTableEntry entry;
+        bool found = protocol->Lookup(dest, entry);
+        NS_TEST_ASSERT_MSG_EQ(found, true, "There should be a route to " << dest);
+        NS_TEST_EXPECT_MSG_EQ(entry.distance, i - 1, "Wrong distance to " << dest);
+        NS_TEST_EXPECT_MSG_EQ(entry.nextAddr, Ipv4Address("10.0.0.2"), "Wrong next hop");
+    }
+
+    /*
+     *  1 -- 2 -- 3    4 -- 5
+     *
+     * 4 and 5 are no longer reachable.
+     */
+    state.EraseTopologyTuple(topology);
+    protocol->RoutingTableComputation();
+    RoutingTableEntry entry;
+    bool found = protocol->Lookup(Ipv4Address("10.0.0.3"), entry);
+    NS_TEST_EXPECT_MSG_EQ(found, true, "There should be a route to 10.0.0.3");
+    found = protocol->Lookup(Ipv4Address("10.0.0.5"), entry);
+    NS_TEST_EXPECT_MSG_EQ(found, false, "There should be no route to 10.0.0.5");
+
+    /*
+     *  1 -- 2 -- 3 -- 5 -- 4
+     */
+    topology.destAddr = Ipv4Address("10.0.0.5");
+    topology.lastAddr = Ipv4Address("10.0.0.3");
+    state.InsertTopologyTuple(topology);
+    topology.destAddr = Ipv4Address("10.0.0.4");
+    topology.lastAddr = Ipv4Address("10.0.0.5");
+    state.InsertTopologyTuple(topology);
+    protocol->RoutingTableComputation();
+    found = protocol->Lookup(Ipv4Address("10.0.0.4"), entry);
+    NS_TEST_EXPECT_MSG_EQ(found, true, "There should be a route to 10.0.0.4");
+    NS_TEST_EXPECT_MSG_EQ(entry.distance, 4, "Wrong distance to 10.0.0.4");
+    found = protocol->Lookup(Ipv4Address("10.0.0.5"), entry);
+    NS_TEST_EXPECT_MSG_EQ(found, true, "There should be a route to 10.0.0.5");
+    NS_TEST_EXPECT_MSG_EQ(entry.distance, 3, "Wrong distance to 10.0.0.5");
+
+    /*
+     * The link to 2 expires: no route is left.
+     */
+    Simulator::Schedule(Seconds(3601), &RoutingProtocol::RoutingTableComputation, protocol);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(protocol->GetSize(), 0, "The routing table should be empty");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup olsr-test
+ * @ingroup tests
+ *
+ * Testcase for the HNA routing table, which must only hold the routes of the
+ * current association tuples after the routing table computation.
+ */
+class OlsrHnaRoutingTableTestCase : public TestCase
+{
+  public:
+    OlsrHnaRoutingTableTestCase();
+    void DoRun() override;
+};
+
+OlsrHnaRoutingTableTestCase::OlsrHnaRoutingTableTestCase()
+    : TestCase("Check OLSR HNA routing table computation")
+{
+}
+
+void
+OlsrHnaRoutingTableTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper devices;
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    addresses.Assign(devices.Install(node));
+
+    Ptr<RoutingProtocol> protocol = CreateObject<RoutingProtocol>();
+    protocol->SetIpv4(node->GetObject<Ipv4>());
+    protocol->m_mainAddress = Ipv4Address("10.0.0.1");
+    OlsrState& state = protocol->m_state;
+
+    /*
+     * 2 is a neighbor of 1 and the gateway of the networks 192.168.1.0/24,
+     * 192.168.2.0/24 and 192.168.3.0/24.
+     */
+    LinkTuple link;
+    link.localIfaceAddr = Ipv4Address("10.0.0.1");
+    link.neighborIfaceAddr = Ipv4Address("10.0.0.2");
+    link.symTime = Seconds(3600);
+    link.asymTime = Seconds(3600);
+    link.time = Seconds(3600);
+    state.InsertLinkTuple(link);
+    NeighborTuple neighbor;
+    neighbor.status = NeighborTuple::STATUS_SYM;
+    neighbor.willingness = Willingness::DEFAULT;
+    neighbor.neighborMainAddr = Ipv4Address("10.0.0.2");
+    state.InsertNeighborTuple(neighbor);
+    AssociationTuple association;
+    association.gatewayAddr = Ipv4Address("10.0.0.2");
+    association.netmask = Ipv4Mask("255.255.255.0");
+    association.expirationTime = Seconds(3600);
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        association.networkAddr = Ipv4Address(0xc0a80000 + (i << 8));
+        state.InsertAssociationTuple(association);
+    }
+
+    protocol->RoutingTableComputation();
+    Ptr<const Ipv4StaticRouting> hnaRoutingTable = protocol->GetRoutingTableAssociation();
+    NS_TEST_ASSERT_MSG_EQ(hnaRoutingTable->GetNRoutes(), 3, "There should be a route per network");
+
+    /*
+     * 2 is no longer the gateway of 192.168.3.0/24: the routes computed before
+     * must all be removed, so that no route to this network is left.
+     */
+    state.EraseAssociationTuple(association);
+    protocol->RoutingTableComputation();
+    NS_TEST_ASSERT_MSG_EQ(hnaRoutingTable->GetNRoutes(), 2, "There should be a route per network");
+    for (uint32_t i = 0; i < hnaRoutingTable->GetNRoutes(); i++)
+    {
+        NS_TEST_EXPECT_MSG_NE(hnaRoutingTable->GetRoute(i).GetDestNetwork(),
+                              Ipv4Address("192.168.3.0"),
+                              "There should be no route to 192.168.3.0/24");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup olsr-test
  * @ingroup tests
@@ -179,6 +382,8 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite()
     : TestSuite("routing-olsr", Type::UNIT)
 {
     AddTestCase(new OlsrMprTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrRoutingTableTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrHnaRoutingTableTestCase(), TestCase::Duration::QUICK);
 }
 
 static OlsrProtocolTestSuite g_olsrProtocolTestSuite; //!< Static variable for test initialization
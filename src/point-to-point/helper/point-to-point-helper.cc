@@ -8,6 +8,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/config.h"
+#include "ns3/error-model.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device-queue-interface.h"
@@ -238,6 +239,12 @@ PointToPointHelper::Install(Ptr<Node> a, Ptr<Node> b)
     b->AddDevice(devB);
     Ptr<Queue<Packet>> queueB = m_queueFactory.Create<Queue<Packet>>();
     devB->SetQueue(queueB);
+    if (m_errorModelFactory.IsTypeIdSet())
+    {
+        // one instance per device, so that error model state is never shared
+        devA->SetReceiveErrorModel(m_errorModelFactory.Create<ErrorModel>());
+        devB->SetReceiveErrorModel(m_errorModelFactory.Create<ErrorModel>());
+    }
     if (m_enableFlowControl)
     {
         // Aggregate NetDeviceQueueInterface objects
@@ -57,6 +57,25 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
     template <typename... Ts>
     void SetQueue(std::string type, Ts&&... args);
 
+    /**
+     * Each point to point net device may have an error model applied to the
+     * packets it receives.  This method allows one to set the type of the
+     * error model that is automatically created for each device, so that
+     * stateful error models (e.g., those with precomputed loss schedules)
+     * are never shared between devices.
+     *
+     * @tparam Ts \deduced Argument types
+     * @param type the type of error model
+     * @param [in] args Name and AttributeValue pairs to set.
+     *
+     * Set the type of error model to create and associate as the
+     * ReceiveErrorModel of each PointToPointNetDevice created through
+     * PointToPointHelper::Install.  This overrides any ReceiveErrorModel
+     * set through SetDeviceAttribute.
+     */
+    template <typename... Ts>
+    void SetReceiveErrorModel(std::string type, Ts&&... args);
+
     /**
      * Set an attribute value to be propagated to each NetDevice created by the
      * helper.
@@ -175,10 +194,11 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
                              Ptr<NetDevice> nd,
                              bool explicitFilename) override;
 
-    ObjectFactory m_queueFactory;   //!< Queue Factory
-    ObjectFactory m_channelFactory; //!< Channel Factory
-    ObjectFactory m_deviceFactory;  //!< Device Factory
-    bool m_enableFlowControl;       //!< whether to enable flow control
+    ObjectFactory m_queueFactory;      //!< Queue Factory
+    ObjectFactory m_channelFactory;    //!< Channel Factory
+    ObjectFactory m_deviceFactory;     //!< Device Factory
+    ObjectFactory m_errorModelFactory; //!< Receive error model Factory
+    bool m_enableFlowControl;          //!< whether to enable flow control
 };
 
 /***************************************************************
@@ -195,6 +215,14 @@ PointToPointHelper::SetQueue(std::string type, Ts&&... args)
     m_queueFactory.Set(std::forward<Ts>(args)...);
 }
 
+template <typename... Ts>
+void
+PointToPointHelper::SetReceiveErrorModel(std::string type, Ts&&... args)
+{
+    m_errorModelFactory.SetTypeId(type);
+    m_errorModelFactory.Set(std::forward<Ts>(args)...);
+}
+
 } // namespace ns3
 
 #endif /* POINT_TO_POINT_HELPER_H */
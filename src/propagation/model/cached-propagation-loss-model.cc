@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "cached-propagation-loss-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <functional>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("PropagationLossModel",
+                          "The propagation loss model whose results are cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetPropagationLossModel,
+                                              &CachedPropagationLossModel::GetPropagationLossModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("MaxEntries",
+                          "The maximum number of cached values. When the cache is full, the "
+                          "least recently used value is evicted.",
+                          UintegerValue(100000),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::m_maxEntries),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Lifetime",
+                          "The time after which a cached value is computed again, even if "
+                          "the nodes did not move. Zero means that the values are kept "
+                          "until a course change of one of the nodes.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&CachedPropagationLossModel::m_lifetime),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+    : m_maxEntries(100000),
+      m_hits(0),
+      m_misses(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+    Untrack();
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Untrack();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetPropagationLossModel(Ptr<PropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    Clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetPropagationLossModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_entries.clear();
+    m_index.clear();
+}
+
+uint64_t
+CachedPropagationLossModel::GetNHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetNMisses() const
+{
+    return m_misses;
+}
+
+double
+CachedPropagationLossModel::GetHitRate() const
+{
+    uint64_t total = m_hits + m_misses;
+    return (total == 0) ? 0.0 : static_cast<double>(m_hits) / total;
+}
+
+uint32_t
+CachedPropagationLossModel::GetNEntries() const
+{
+    return m_entries.size();
+}
+
+std::size_t
+CachedPropagationLossModel::PathKeyHash::operator()(const PathKey& key) const
+{
+    // the paths a->b and b->a are different keys
+    std::size_t h = std::hash<const void*>()(key.first);
+    return h ^ (std::hash<const void*>()(key.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+CachedPropagationLossModel::TrackedMobility&
+CachedPropagationLossModel::Track(Ptr<MobilityModel> mobility) const
+{
+    auto [it, inserted] = m_mobilities.try_emplace(PeekPointer(mobility), TrackedMobility{});
+    if (inserted)
+    {
+        it->second.mobility = mobility;
+        it->second.version = 0;
+        // the callback does not modify the cached values, only the versions
+        auto self = const_cast<CachedPropagationLossModel*>(this);
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::CourseChanged, self));
+    }
+    return it->second;
+}
+
+void
+CachedPropagationLossModel::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_mobilities.find(PeekPointer(mobility));
+    if (it != m_mobilities.end())
+    {
+        // the values computed with the previous position become stale; they
+        // are evicted when they are looked up or when they become the least
+        // recently used
+        it->second.version++;
+    }
+}
+
+void
+CachedPropagationLossModel::Untrack()
+{
+    for (auto& [ptr, tracked] : m_mobilities)
+    {
+        tracked.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::CourseChanged, this));
+    }
+    m_mobilities.clear();
+    Clear();
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "No propagation loss model to cache");
+
+    auto isMoving = [](Ptr<MobilityModel> mobility) {
+        Vector velocity = mobility->GetVelocity();
+        return velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+    };
+    if (isMoving(a) || isMoving(b))
+    {
+        m_misses++;
+        return m_model->CalcRxPower(txPowerDbm, a, b);
+    }
+
+    uint64_t srcVersion = Track(a).version;
+    uint64_t dstVersion = Track(b).version;
+    Time now = Simulator::Now();
+    PathKey key{PeekPointer(a), PeekPointer(b)};
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        auto entry = it->second;
+        if (entry->txPowerDbm == txPowerDbm && entry->srcVersion == srcVersion &&
+            entry->dstVersion == dstVersion && (m_lifetime.IsZero() || now < entry->expirationTime))
+        {
+            m_hits++;
+            m_entries.splice(m_entries.begin(), m_entries, entry);
+            return entry->rxPowerDbm;
+        }
+        m_entries.erase(entry);
+        m_index.erase(it);
+    }
+
+    m_misses++;
+    double rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+    NS_LOG_LOGIC("caching rxPower=" << rxPowerDbm << "dBm for txPower=" << txPowerDbm << "dBm");
+    m_entries.push_front({key, txPowerDbm, rxPowerDbm, srcVersion, dstVersion, now + m_lifetime});
+    m_index[key] = m_entries.begin();
+    while (m_entries.size() > m_maxEntries)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-loss-model.h"
+
+#include "ns3/nstime.h"
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * @ingroup propagation
+ *
+ * @brief A cache of the received power computed by another propagation loss model
+ *
+ * This model wraps a propagation loss model (possibly a chain of models) and
+ * stores the received power it computes for each pair of mobility models, so
+ * that the wrapped model is not evaluated again as long as the two nodes do
+ * not move.  It is meant for expensive deterministic models (e.g.,
+ * ThreeGppPropagationLossModel or ItuR1411LosPropagationLossModel) in
+ * deployments where most of the nodes are static or move rarely.
+ *
+ * A cached value is used only if
+ *  - the transmission power is the same as the one it was computed with,
+ *  - neither of the two mobility models notified a course change since it
+ *    was computed, and
+ *  - it is more recent than the Lifetime attribute (if not zero).
+ *
+ * The pairs in which one of the nodes has a non-zero velocity are never
+ * cached, since the position of such a node changes without any course
+ * change notification.  The number of cached values is bounded by the
+ * MaxEntries attribute; when the cache is full, the least recently used
+ * value is evicted.
+ *
+ * The wrapped model is evaluated at most once per pair between two course
+ * changes, hence stochastic models (e.g., NakagamiPropagationLossModel)
+ * should not be wrapped, unless a constant fading per pair is desired.  The
+ * models whose output changes over time for fixed positions (e.g., because
+ * the channel condition is updated periodically) need the Lifetime
+ * attribute to be set accordingly.  Models chained after this one with
+ * SetNext() are not cached.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * Set the propagation loss model whose results are cached.  The cache
+     * is cleared.
+     * @param model the propagation loss model
+     */
+    void SetPropagationLossModel(Ptr<PropagationLossModel> model);
+    /**
+     * @return the propagation loss model whose results are cached
+     */
+    Ptr<PropagationLossModel> GetPropagationLossModel() const;
+
+    /**
+     * Remove all the cached values.  The hit and miss counters are not reset.
+     */
+    void Clear();
+
+    /**
+     * @return the number of received powers served from the cache
+     */
+    uint64_t GetNHits() const;
+    /**
+     * @return the number of received powers computed by the wrapped model
+     */
+    uint64_t GetNMisses() const;
+    /**
+     * @return the ratio of the hits to the number of received powers
+     *         requested, or zero if none was requested
+     */
+    double GetHitRate() const;
+    /**
+     * @return the number of cached values
+     */
+    uint32_t GetNEntries() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /// A mobility model whose course changes are followed
+    struct TrackedMobility
+    {
+        Ptr<MobilityModel> mobility; //!< The mobility model
+        uint64_t version;            //!< Number of course changes notified
+    };
+
+    /// The source and destination mobility models of a path
+    typedef std::pair<const MobilityModel*, const MobilityModel*> PathKey;
+
+    /// Hasher for a PathKey
+    struct PathKeyHash
+    {
+        /**
+         * @param key the key
+         * @return the hash of the key
+         */
+        std::size_t operator()(const PathKey& key) const;
+    };
+
+    /// A cached received power
+    struct Entry
+    {
+        PathKey key;         //!< The path
+        double txPowerDbm;   //!< Transmission power
+        double rxPowerDbm;   //!< Received power
+        uint64_t srcVersion; //!< Version of the source mobility model
+        uint64_t dstVersion; //!< Version of the destination mobility model
+        Time expirationTime; //!< Time after which the value is not used
+    };
+
+    /**
+     * Get the tracking record of a mobility model, connecting to its
+     * CourseChange trace the first time.
+     * @param mobility the mobility model
+     * @return the tracking record
+     */
+    TrackedMobility& Track(Ptr<MobilityModel> mobility) const;
+    /**
+     * Callback for the CourseChange trace of the mobility models.
+     * @param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+    /**
+     * Disconnect from the traces of the mobility models and forget them.
+     */
+    void Untrack();
+
+    Ptr<PropagationLossModel> m_model; //!< The model whose results are cached
+    uint32_t m_maxEntries;             //!< Maximum number of cached values
+    Time m_lifetime;                   //!< Maximum age of a cached value (zero if unlimited)
+
+    /// Cached values, from the most to the least recently used
+    mutable std::list<Entry> m_entries;
+    /// Cached values, by path
+    mutable std::unordered_map<PathKey, std::list<Entry>::iterator, PathKeyHash> m_index;
+    /// Mobility models whose course changes are followed
+    mutable std::unordered_map<const MobilityModel*, TrackedMobility> m_mobilities;
+    mutable uint64_t m_hits;   //!< Number of cache hits
+    mutable uint64_t m_misses; //!< Number of cache misses
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
@@ -71,6 +71,30 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPowers(double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel>>& b,
+                                   std::vector<double>& rxPowerDbm) const
+{
+    rxPowerDbm.assign(b.size(), txPowerDbm);
+    for (const PropagationLossModel* model = this; model; model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowers(a, b, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                     const std::vector<Ptr<MobilityModel>>& b,
+                                     std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        rxPowerDbm[i] = DoCalcRxPower(rxPowerDbm[i], a, b[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
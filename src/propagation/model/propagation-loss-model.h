@@ -17,6 +17,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -90,6 +91,23 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Power of a transmission from a source to several
+     * destinations, taking into account all the PropagationLossModel(s)
+     * chained to the current one.  The result is the same as calling
+     * CalcRxPower() for each destination in turn, but each model of the
+     * chain handles all the destinations in a single call.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param [out] rxPowerDbm the reception powers (in dBm), one per destination
+     */
+    void CalcRxPowers(double txPowerDbm,
+                      Ptr<MobilityModel> a,
+                      const std::vector<Ptr<MobilityModel>>& b,
+                      std::vector<double>& rxPowerDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -128,6 +146,22 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Apply this model to the powers received by several destinations.
+     *
+     * The default implementation calls DoCalcRxPower() for each destination.
+     * Subclasses may override it to avoid the per-destination overhead; the
+     * result must be the same as the one of the default implementation.
+     *
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param [in,out] rxPowerDbm the powers (in dBm) before this model, replaced by the
+     *                 powers after this model
+     */
+    virtual void DoCalcRxPowers(Ptr<MobilityModel> a,
+                                const std::vector<Ptr<MobilityModel>>& b,
+                                std::vector<double>& rxPowerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -5,13 +5,18 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -478,6 +483,210 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief CachedPropagationLossModel Test
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+    Ptr<MobilityModel> c = CreateObject<ConstantPositionMobilityModel>();
+    c->SetPosition(Vector(0, 200, 0));
+
+    auto reference = CreateObject<LogDistancePropagationLossModel>();
+    auto cache = CreateObject<CachedPropagationLossModel>();
+    cache->SetAttribute("MaxEntries", UintegerValue(2));
+    cache->SetAttribute("Lifetime", TimeValue(Seconds(10)));
+    cache->SetPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+    const double tolerance = 1e-9;
+    double expected = reference->CalcRxPower(10, a, b);
+    double rxPower = cache->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, expected, tolerance, "Wrong received power a->b");
+    rxPower = cache->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, expected, tolerance, "Wrong cached received power a->b");
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNHits(), 1, "The second computation should be a hit");
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), 1, "The first computation should be a miss");
+
+    // a different transmission power is not served from the cache
+    rxPower = cache->CalcRxPower(20, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower,
+                              reference->CalcRxPower(20, a, b),
+                              tolerance,
+                              "Wrong received power for another transmission power");
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), 2, "A new transmission power should be a miss");
+
+    // the paths a->b and b->a are distinct, the least recently used one is evicted
+    cache->CalcRxPower(20, b, a);
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNEntries(), 2, "Wrong number of entries");
+    cache->CalcRxPower(20, a, b);
+    cache->CalcRxPower(20, a, c);
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNEntries(), 2, "The cache should be bounded");
+    uint64_t misses = cache->GetNMisses();
+    cache->CalcRxPower(20, a, b);
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), misses, "a->b should not have been evicted");
+    cache->CalcRxPower(20, b, a);
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), misses + 1, "b->a should have been evicted");
+
+    // a course change invalidates the paths of the node
+    b->SetPosition(Vector(300, 0, 0));
+    rxPower = cache->CalcRxPower(20, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower,
+                              reference->CalcRxPower(20, a, b),
+                              tolerance,
+                              "Wrong received power after a course change");
+    NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), misses + 2, "A course change should be a miss");
+
+    // the paths of a moving node are never cached
+    Ptr<ConstantVelocityMobilityModel> d = CreateObject<ConstantVelocityMobilityModel>();
+    d->SetPosition(Vector(50, 50, 0));
+    d->SetVelocity(Vector(10, 0, 0));
+    misses = cache->GetNMisses();
+    Simulator::Schedule(Seconds(1), [&]() {
+        double rxPower = cache->CalcRxPower(20, a, d);
+        NS_TEST_EXPECT_MSG_EQ_TOL(rxPower,
+                                  reference->CalcRxPower(20, a, d),
+                                  tolerance,
+                                  "Wrong received power from a moving node");
+        NS_TEST_EXPECT_MSG_EQ(cache->GetNMisses(), misses + 1, "A moving node should be a miss");
+    });
+    // the values expire after their lifetime
+    Simulator::Schedule(Seconds(20), [&]() {
+        uint64_t hits = cache->GetNHits();
+        cache->CalcRxPower(20, a, b);
+        NS_TEST_EXPECT_MSG_EQ(cache->GetNHits(), hits, "An expired value should be a miss");
+        cache->CalcRxPower(20, a, b);
+        NS_TEST_EXPECT_MSG_EQ(cache->GetNHits(), hits + 1, "A refreshed value should be a hit");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Check that CalcRxPowers returns the same powers as CalcRxPower
+ */
+class BatchPropagationLossModelTestCase : public TestCase
+{
+  public:
+    BatchPropagationLossModelTestCase();
+    ~BatchPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a propagation loss model (possibly a chain of models).
+     * @param index the index of the model
+     * @return the propagation loss model
+     */
+    Ptr<PropagationLossModel> CreateModel(uint32_t index) const;
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase()
+    : TestCase("Test CalcRxPowers against CalcRxPower")
+{
+}
+
+BatchPropagationLossModelTestCase::~BatchPropagationLossModelTestCase()
+{
+}
+
+Ptr<PropagationLossModel>
+BatchPropagationLossModelTestCase::CreateModel(uint32_t index) const
+{
+    switch (index)
+    {
+    case 0:
+        return CreateObject<FriisPropagationLossModel>();
+    case 1:
+        return CreateObjectWithAttributes<TwoRayGroundPropagationLossModel>("HeightAboveZ",
+                                                                           DoubleValue(1.5));
+    case 2:
+        return CreateObject<LogDistancePropagationLossModel>();
+    case 3:
+        return CreateObject<NakagamiPropagationLossModel>();
+    case 4:
+        return CreateObjectWithAttributes<RangePropagationLossModel>("MaxRange", DoubleValue(150));
+    case 5:
+        // a model without a batch implementation
+        return CreateObjectWithAttributes<FixedRssLossModel>("Rss", DoubleValue(-60));
+    default: {
+        Ptr<PropagationLossModel> chain = CreateObject<LogDistancePropagationLossModel>();
+        Ptr<PropagationLossModel> nakagami = CreateObject<NakagamiPropagationLossModel>();
+        nakagami->SetNext(CreateObject<RandomPropagationLossModel>());
+        chain->SetNext(nakagami);
+        return chain;
+    }
+    }
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(10, -20, 3));
+    std::vector<Ptr<MobilityModel>> b;
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(7.3 * i, 200 - 11.1 * i, 0.25 * (i % 5)));
+        b.push_back(mobility);
+    }
+    // the source itself is a possible destination
+    b.push_back(a);
+
+    for (uint32_t index = 0; index < 7; index++)
+    {
+        Ptr<PropagationLossModel> scalar = CreateModel(index);
+        Ptr<PropagationLossModel> batch = CreateModel(index);
+        scalar->AssignStreams(1);
+        batch->AssignStreams(1);
+
+        for (uint32_t run = 0; run < 3; run++)
+        {
+            std::vector<double> rxPowers;
+            batch->CalcRxPowers(16.0, a, b, rxPowers);
+            NS_TEST_ASSERT_MSG_EQ(rxPowers.size(), b.size(), "Wrong number of powers");
+            for (std::size_t i = 0; i < b.size(); i++)
+            {
+                double expected = scalar->CalcRxPower(16.0, a, b[i]);
+                double rxPower = rxPowers[i];
+                NS_TEST_EXPECT_MSG_EQ(rxPower,
+                                      expected,
+                                      "Model " << index << ", destination " << i
+                                               << ": wrong received power");
+            }
+        }
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -489,6 +698,8 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
+ *   - the batch computation of the received powers
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -504,6 +715,8 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BatchPropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
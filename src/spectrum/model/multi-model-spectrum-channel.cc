@@ -26,6 +26,7 @@
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
 
 #include <algorithm>
 #include <iostream>
@@ -70,7 +71,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_maxRange{0}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -81,6 +83,8 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_index = nullptr;
+    m_indexedPhys.clear();
     SpectrumChannel::DoDispose();
 }
 
@@ -91,8 +95,16 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+                            .AddAttribute(
+                                "MaxRange",
+                                "The distance (in meters) beyond which a signal is not "
+                                "delivered to a receiver, without computing its propagation "
+                                "loss. It should be set to a distance at which the received "
+                                "power is always negligible. The receivers without a mobility "
+                                "model are never skipped. Zero means no limit.",
+                                DoubleValue(0),
+                                MakeDoubleAccessor(&MultiModelSpectrumChannel::m_maxRange),
+                                MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -105,6 +117,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     // we need to scan for all rxSpectrumModel values since we don't
     // know which spectrum model the phy had when it was previously added
     // (it's probably different than the current one)
+    m_index = nullptr;
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -268,6 +281,23 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
+    if (m_maxRange > 0 && txMobility)
+    {
+        // the identifiers of the receivers follow the order of m_rxSpectrumModelInfoMap,
+        // so the receivers in range are visited in the same order as below
+        std::vector<uint32_t> ids;
+        GetReceiversInRange(txMobility, ids);
+        for (auto id : ids)
+        {
+            const auto& [rxSpectrumModelUid, rxPhy] = m_indexedPhys[id];
+            if (convertedPsds.contains(rxSpectrumModelUid))
+            {
+                ScheduleStartRx(txParams, txMobility, rxSpectrumModelUid, rxPhy, convertedPsds);
+            }
+        }
+        return;
+    }
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -285,84 +315,119 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
              rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
              ++rxPhyIterator)
         {
-            NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
-                          "SpectrumModel change was not notified to MultiModelSpectrumChannel "
-                          "(i.e., AddRx should be called again after model is changed)");
+            ScheduleStartRx(txParams, txMobility, rxSpectrumModelUid, *rxPhyIterator, convertedPsds);
+        }
+    }
+}
+
+void
+MultiModelSpectrumChannel::ScheduleStartRx(
+    Ptr<SpectrumSignalParameters> txParams,
+    Ptr<MobilityModel> txMobility,
+    SpectrumModelUid_t rxSpectrumModelUid,
+    Ptr<SpectrumPhy> rxPhy,
+    const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& convertedPsds)
+{
+    NS_ASSERT_MSG(rxPhy->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+                  "SpectrumModel change was not notified to MultiModelSpectrumChannel "
+                  "(i.e., AddRx should be called again after model is changed)");
+
+    if (rxPhy == txParams->txPhy)
+    {
+        return;
+    }
+
+    auto txAntennaGain{0.0};
+    auto rxNetDevice = rxPhy->GetDevice();
+    auto txNetDevice = txParams->txPhy->GetDevice();
+
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
+        {
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return;
+        }
+    }
 
-            auto txAntennaGain{0.0};
-            if ((*rxPhyIterator) != txParams->txPhy)
+    if (m_filter && m_filter->Filter(txParams, rxPhy))
+    {
+        return;
+    }
+
+    NS_LOG_LOGIC("copying signal parameters " << txParams);
+    auto rxParams = txParams->Copy();
+    rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
+    Time delay{0};
+
+    auto receiverMobility = rxPhy->GetMobility();
+
+    if (txMobility && receiverMobility)
+    {
+        if (rxParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
+            txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+            NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+        }
+        if (m_propagationDelay)
+        {
+            delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
+        }
+    }
+
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        auto dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &MultiModelSpectrumChannel::StartRx,
+                                       this,
+                                       txParams->psd,
+                                       txAntennaGain,
+                                       rxParams,
+                                       rxPhy,
+                                       convertedPsds);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay,
+                            &MultiModelSpectrumChannel::StartRx,
+                            this,
+                            txParams->psd,
+                            txAntennaGain,
+                            rxParams,
+                            rxPhy,
+                            convertedPsds);
+    }
+}
+
+void
+MultiModelSpectrumChannel::GetReceiversInRange(Ptr<const MobilityModel> txMobility,
+                                               std::vector<uint32_t>& ids)
+{
+    NS_LOG_FUNCTION(this << txMobility);
+    if (!m_index)
+    {
+        m_index = Create<SpatialGridIndex>(m_maxRange);
+        m_indexedPhys.clear();
+        for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+        {
+            for (const auto& phy : rxInfo.m_rxPhys)
             {
-                auto rxNetDevice = (*rxPhyIterator)->GetDevice();
-                auto txNetDevice = txParams->txPhy->GetDevice();
-
-                if (rxNetDevice && txNetDevice)
-                {
-                    // we assume that devices are attached to a node
-                    if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-                    {
-                        NS_LOG_DEBUG(
-                            "Skipping the pathloss calculation among different antennas of the "
-                            "same node, not supported yet by any pathloss model in ns-3.");
-                        continue;
-                    }
-                }
-
-                if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
-                {
-                    continue;
-                }
-
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
-                Time delay{0};
-
-                auto receiverMobility = (*rxPhyIterator)->GetMobility();
-
-                if (txMobility && receiverMobility)
-                {
-                    if (rxParams->txAntenna)
-                    {
-                        Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                        NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    }
-                    if (m_propagationDelay)
-                    {
-                        delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
-                    }
-                }
-
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   txParams->psd,
-                                                   txAntennaGain,
-                                                   rxParams,
-                                                   *rxPhyIterator,
-                                                   convertedPsds);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        txParams->psd,
-                                        txAntennaGain,
-                                        rxParams,
-                                        *rxPhyIterator,
-                                        convertedPsds);
-                }
+                m_index->Add(phy->GetMobility());
+                m_indexedPhys.emplace_back(rxSpectrumModelUid, phy);
             }
         }
     }
+    m_index->GetItemsWithinDistance(txMobility->GetPosition(), m_maxRange, ids);
+    NS_LOG_LOGIC(ids.size() << " of " << m_indexedPhys.size() << " receivers within "
+                                  << m_maxRange << "m");
 }
 
 void
@@ -18,10 +18,14 @@
 
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
 
+class SpatialGridIndex;
+
 /**
  * @ingroup spectrum
  * Container: SpectrumModelUid_t, SpectrumConverter
@@ -88,6 +92,14 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * When the MaxRange attribute is set, the receivers farther than MaxRange
+ * from the transmitter are skipped before any propagation computation.  The
+ * receivers are located through a SpatialGridIndex, which follows the course
+ * changes of the receivers, and only the receivers it returns are visited,
+ * grouped by RX spectrum model, so that the cost of a transmission grows with
+ * the number of receivers in range rather than with the number of receivers
+ * attached to the channel.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -142,6 +154,33 @@ class MultiModelSpectrumChannel : public SpectrumChannel
         Ptr<SpectrumPhy> receiver,
         const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds);
 
+    /**
+     * Schedule the reception of a signal by a receiver, unless the receiver
+     * is the transmitter, belongs to the same node, or is filtered out.
+     *
+     * @param txParams The signal parameters.
+     * @param txMobility The mobility model of the transmitter.
+     * @param rxSpectrumModelUid The RX spectrum model of the receiver.
+     * @param rxPhy The receiver.
+     * @param convertedPsds The TX PSD converted to each RX spectrum model.
+     */
+    void ScheduleStartRx(Ptr<SpectrumSignalParameters> txParams,
+                         Ptr<MobilityModel> txMobility,
+                         SpectrumModelUid_t rxSpectrumModelUid,
+                         Ptr<SpectrumPhy> rxPhy,
+                         const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& convertedPsds);
+
+    /**
+     * Find the receivers that are within MaxRange from a transmitter,
+     * building the index of the receivers if needed.
+     *
+     * @param txMobility the mobility model of the transmitter
+     * @param [out] ids the identifiers in m_indexedPhys of the receivers in
+     *        range and of the receivers without a mobility model, in
+     *        increasing order
+     */
+    void GetReceiversInRange(Ptr<const MobilityModel> txMobility, std::vector<uint32_t>& ids);
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -160,6 +199,23 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * Maximum distance between a transmitter and a receiver (0 if unlimited).
+     */
+    double m_maxRange;
+
+    /**
+     * Index of the positions of the receivers, built on the first
+     * transmission after a receiver is added or removed.
+     */
+    Ptr<SpatialGridIndex> m_index;
+
+    /**
+     * The receivers in m_index and their RX spectrum model, by identifier.
+     * The receivers are added in the order of m_rxSpectrumModelInfoMap.
+     */
+    std::vector<std::pair<SpectrumModelUid_t, Ptr<SpectrumPhy>>> m_indexedPhys;
 };
 
 } // namespace ns3
@@ -12,11 +12,161 @@
 #include "ns3/log.h"
 #include "ns3/math.h"
 
+#include <cstddef>
+#include <utility>
+
+/**
+ * @ingroup spectrum
+ * Attribute of the element-wise kernels of SpectrumValue: on x86-64
+ * platforms with function multi-versioning, each kernel is compiled for
+ * AVX-512, AVX2 and the baseline instruction set, and the version matching
+ * the CPU is selected when the program is loaded.
+ */
+#if defined(__x86_64__) && defined(__ELF__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SPECTRUM_VALUE_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef SPECTRUM_VALUE_KERNEL
+#define SPECTRUM_VALUE_KERNEL
+#endif
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("SpectrumValue");
 
+namespace
+{
+
+// The kernels below are element-wise, hence the vectorized versions give the
+// same results as the scalar one. The output may alias one of the inputs.
+
+/**
+ * Element-wise addition
+ * @param out the output array
+ * @param a the first input array
+ * @param b the second input array
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+AddKernel(double* out, const double* a, const double* b, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+/**
+ * Element-wise subtraction
+ * @param out the output array
+ * @param a the first input array
+ * @param b the second input array
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+SubtractKernel(double* out, const double* a, const double* b, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] - b[i];
+    }
+}
+
+/**
+ * Element-wise multiplication
+ * @param out the output array
+ * @param a the first input array
+ * @param b the second input array
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+MultiplyKernel(double* out, const double* a, const double* b, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/**
+ * Element-wise division
+ * @param out the output array
+ * @param a the first input array
+ * @param b the second input array
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+DivideKernel(double* out, const double* a, const double* b, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] / b[i];
+    }
+}
+
+/**
+ * Addition of a flat value, in place
+ * @param x the array
+ * @param s the flat value
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+AddScalarKernel(double* x, double s, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        x[i] += s;
+    }
+}
+
+/**
+ * Multiplication by a flat value, in place
+ * @param x the array
+ * @param s the flat value
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+MultiplyScalarKernel(double* x, double s, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        x[i] *= s;
+    }
+}
+
+/**
+ * Division by a flat value, in place
+ * @param x the array
+ * @param s the flat value
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+DivideScalarKernel(double* x, double s, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        x[i] /= s;
+    }
+}
+
+/**
+ * Change of sign, in place
+ * @param x the array
+ * @param n the number of elements
+ */
+SPECTRUM_VALUE_KERNEL void
+ChangeSignKernel(double* x, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        x[i] = -x[i];
+    }
+}
+
+} // namespace
+
 SpectrumValue::SpectrumValue()
 {
 }
@@ -90,47 +240,23 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
-    {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
-    }
+    AddKernel(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 += s;
-        ++it1;
-    }
+    AddScalarKernel(m_values.data(), s, m_values.size());
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
-    {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
-    }
+    SubtractKernel(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
@@ -142,72 +268,36 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
-    {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
-    }
+    MultiplyKernel(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 *= s;
-        ++it1;
-    }
+    MultiplyScalarKernel(m_values.data(), s, m_values.size());
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
-    {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
-    }
+    DivideKernel(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 /= s;
-        ++it1;
-    }
+    DivideScalarKernel(m_values.data(), s, m_values.size());
 }
 
 void
 SpectrumValue::ChangeSign()
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 = -(*it1);
-        ++it1;
-    }
+    ChangeSignKernel(m_values.data(), m_values.size());
 }
 
 void
@@ -323,12 +413,13 @@ Norm(const SpectrumValue& x)
 double
 Sum(const SpectrumValue& x)
 {
+    // the values are accumulated in order, so that the result does not
+    // depend on the vectorization of the loop
     double s = 0;
-    auto it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
+    const double* values = x.m_values.data();
+    for (std::size_t i = 0; i < x.m_values.size(); i++)
     {
-        s += (*it1);
-        ++it1;
+        s += values[i];
     }
     return s;
 }
@@ -349,17 +440,16 @@ Prod(const SpectrumValue& x)
 double
 Integral(const SpectrumValue& arg)
 {
+    NS_ASSERT(arg.m_values.size() == arg.m_spectrumModel->GetNumBands());
+    // the values are accumulated in order, so that the result does not
+    // depend on the vectorization of the loop
     double i = 0;
-    auto vit = arg.ConstValuesBegin();
+    const double* values = arg.m_values.data();
     auto bit = arg.ConstBandsBegin();
-    while (vit != arg.ConstValuesEnd())
+    for (std::size_t k = 0; k < arg.m_values.size(); k++, ++bit)
     {
-        NS_ASSERT(bit != arg.ConstBandsEnd());
-        i += (*vit) * (bit->fh - bit->fl);
-        ++vit;
-        ++bit;
+        i += values[k] * (bit->fh - bit->fl);
     }
-    NS_ASSERT(bit == arg.ConstBandsEnd());
     return i;
 }
 
@@ -401,11 +491,19 @@ operator<<(std::ostream& os, const SpectrumValue& pvf)
 }
 
 SpectrumValue
-operator+(const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator+(SpectrumValue lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = lhs;
-    res.Add(rhs);
-    return res;
+    lhs.Add(rhs);
+    return lhs;
+}
+
+SpectrumValue
+operator+(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    NS_ASSERT(lhs.m_spectrumModel == rhs.m_spectrumModel);
+    NS_ASSERT(lhs.m_values.size() == rhs.m_values.size());
+    AddKernel(rhs.m_values.data(), lhs.m_values.data(), rhs.m_values.data(), rhs.m_values.size());
+    return std::move(rhs);
 }
 
 bool
@@ -421,92 +519,116 @@ operator!=(const SpectrumValue& lhs, const SpectrumValue& rhs)
 }
 
 SpectrumValue
-operator+(const SpectrumValue& lhs, double rhs)
+operator+(SpectrumValue lhs, double rhs)
 {
-    SpectrumValue res = lhs;
-    res.Add(rhs);
-    return res;
+    lhs.Add(rhs);
+    return lhs;
 }
 
 SpectrumValue
-operator+(double lhs, const SpectrumValue& rhs)
+operator+(double lhs, SpectrumValue rhs)
 {
-    SpectrumValue res = rhs;
-    res.Add(lhs);
-    return res;
+    rhs.Add(lhs);
+    return rhs;
 }
 
 SpectrumValue
-operator-(const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator-(SpectrumValue lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = rhs;
-    res.ChangeSign();
-    res.Add(lhs);
-    return res;
+    lhs.Subtract(rhs);
+    return lhs;
 }
 
 SpectrumValue
-operator-(const SpectrumValue& lhs, double rhs)
+operator-(const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-    SpectrumValue res = lhs;
-    res.Subtract(rhs);
-    return res;
+    NS_ASSERT(lhs.m_spectrumModel == rhs.m_spectrumModel);
+    NS_ASSERT(lhs.m_values.size() == rhs.m_values.size());
+    SubtractKernel(rhs.m_values.data(),
+                   lhs.m_values.data(),
+                   rhs.m_values.data(),
+                   rhs.m_values.size());
+    return std::move(rhs);
 }
 
 SpectrumValue
-operator-(double lhs, const SpectrumValue& rhs)
+operator-(SpectrumValue lhs, double rhs)
 {
-    SpectrumValue res = rhs;
-    res.Subtract(lhs);
-    return res;
+    lhs.Subtract(rhs);
+    return lhs;
 }
 
 SpectrumValue
-operator*(const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator-(double lhs, SpectrumValue rhs)
 {
-    SpectrumValue res = lhs;
-    res.Multiply(rhs);
-    return res;
+    rhs.Subtract(lhs);
+    return rhs;
 }
 
 SpectrumValue
-operator*(const SpectrumValue& lhs, double rhs)
+operator*(SpectrumValue lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = lhs;
-    res.Multiply(rhs);
-    return res;
+    lhs.Multiply(rhs);
+    return lhs;
 }
 
 SpectrumValue
-operator*(double lhs, const SpectrumValue& rhs)
+operator*(const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-    SpectrumValue res = rhs;
-    res.Multiply(lhs);
-    return res;
+    NS_ASSERT(lhs.m_spectrumModel == rhs.m_spectrumModel);
+    NS_ASSERT(lhs.m_values.size() == rhs.m_values.size());
+    MultiplyKernel(rhs.m_values.data(),
+                   lhs.m_values.data(),
+                   rhs.m_values.data(),
+                   rhs.m_values.size());
+    return std::move(rhs);
 }
 
 SpectrumValue
-operator/(const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator*(SpectrumValue lhs, double rhs)
 {
-    SpectrumValue res = lhs;
-    res.Divide(rhs);
-    return res;
+    lhs.Multiply(rhs);
+    return lhs;
 }
 
 SpectrumValue
-operator/(const SpectrumValue& lhs, double rhs)
+operator*(double lhs, SpectrumValue rhs)
 {
-    SpectrumValue res = lhs;
-    res.Divide(rhs);
-    return res;
+    rhs.Multiply(lhs);
+    return rhs;
 }
 
 SpectrumValue
-operator/(double lhs, const SpectrumValue& rhs)
+operator/(SpectrumValue lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = rhs;
-    res.Divide(lhs);
-    return res;
+    lhs.Divide(rhs);
+    return lhs;
+}
+
+SpectrumValue
+operator/(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    NS_ASSERT(lhs.m_spectrumModel == rhs.m_spectrumModel);
+    NS_ASSERT(lhs.m_values.size() == rhs.m_values.size());
+    DivideKernel(rhs.m_values.data(),
+                 lhs.m_values.data(),
+                 rhs.m_values.data(),
+                 rhs.m_values.size());
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return lhs;
+}
+
+SpectrumValue
+operator/(double lhs, SpectrumValue rhs)
+{
+    rhs.Divide(lhs);
+    return rhs;
 }
 
 SpectrumValue
@@ -516,11 +638,10 @@ operator+(const SpectrumValue& rhs)
 }
 
 SpectrumValue
-operator-(const SpectrumValue& rhs)
+operator-(SpectrumValue rhs)
 {
-    SpectrumValue res = rhs;
-    res.ChangeSign();
-    return res;
+    rhs.ChangeSign();
+    return rhs;
 }
 
 SpectrumValue
@@ -45,6 +45,13 @@ typedef std::vector<double> Values;
  * The intended use of this class is to represent frequency-dependent
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
+ *
+ * The arithmetic operators store their result in the storage of their
+ * temporary operands when there is one, so that an expression such as
+ * a * b + c allocates a single SpectrumValue.  The element-wise loops are
+ * compiled for several instruction sets (e.g., AVX2 and AVX-512 on x86-64,
+ * when the compiler supports function multi-versioning), the best one being
+ * selected at run time; the results do not depend on the instruction set.
  */
 class SpectrumValue : public SimpleRefCount<SpectrumValue>
 {
@@ -207,7 +214,17 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs + rhs
      */
-    friend SpectrumValue operator+(const SpectrumValue& lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator+(SpectrumValue lhs, const SpectrumValue& rhs);
+
+    /**
+     *  addition operator, storing the result in the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(const SpectrumValue& lhs, SpectrumValue&& rhs);
 
     /**
      *  addition operator
@@ -217,7 +234,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs + rhs
      */
-    friend SpectrumValue operator+(const SpectrumValue& lhs, double rhs);
+    friend SpectrumValue operator+(SpectrumValue lhs, double rhs);
 
     /**
      *  addition operator
@@ -227,7 +244,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs + rhs
      */
-    friend SpectrumValue operator+(double lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator+(double lhs, SpectrumValue rhs);
 
     /**
      *  subtraction operator
@@ -237,7 +254,17 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs - rhs
      */
-    friend SpectrumValue operator-(const SpectrumValue& lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator-(SpectrumValue lhs, const SpectrumValue& rhs);
+
+    /**
+     *  subtraction operator, storing the result in the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(const SpectrumValue& lhs, SpectrumValue&& rhs);
 
     /**
      *  subtraction operator
@@ -247,7 +274,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs - rhs
      */
-    friend SpectrumValue operator-(const SpectrumValue& lhs, double rhs);
+    friend SpectrumValue operator-(SpectrumValue lhs, double rhs);
 
     /**
      *  subtraction operator
@@ -257,7 +284,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs - rhs
      */
-    friend SpectrumValue operator-(double lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator-(double lhs, SpectrumValue rhs);
 
     /**
      *  multiplication component-by-component (Schur product)
@@ -267,7 +294,17 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs * rhs
      */
-    friend SpectrumValue operator*(const SpectrumValue& lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator*(SpectrumValue lhs, const SpectrumValue& rhs);
+
+    /**
+     *  multiplication operator, storing the result in the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(const SpectrumValue& lhs, SpectrumValue&& rhs);
 
     /**
      *  multiplication by a scalar
@@ -277,7 +314,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs * rhs
      */
-    friend SpectrumValue operator*(const SpectrumValue& lhs, double rhs);
+    friend SpectrumValue operator*(SpectrumValue lhs, double rhs);
 
     /**
      *  multiplication of a scalar
@@ -287,7 +324,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs * rhs
      */
-    friend SpectrumValue operator*(double lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator*(double lhs, SpectrumValue rhs);
 
     /**
      *  division component-by-component
@@ -297,7 +334,17 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of lhs / rhs
      */
-    friend SpectrumValue operator/(const SpectrumValue& lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator/(SpectrumValue lhs, const SpectrumValue& rhs);
+
+    /**
+     *  division operator, storing the result in the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(const SpectrumValue& lhs, SpectrumValue&& rhs);
 
     /**
      * division by a scalar
@@ -307,7 +354,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of *this / rhs
      */
-    friend SpectrumValue operator/(const SpectrumValue& lhs, double rhs);
+    friend SpectrumValue operator/(SpectrumValue lhs, double rhs);
 
     /**
      * division of a scalar
@@ -317,7 +364,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the value of *this / rhs
      */
-    friend SpectrumValue operator/(double lhs, const SpectrumValue& rhs);
+    friend SpectrumValue operator/(double lhs, SpectrumValue rhs);
 
     /**
      * Compare two spectrum values
@@ -353,7 +400,7 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      * @param rhs Right Hand Side of the operator
      * @return the value of - *this
      */
-    friend SpectrumValue operator-(const SpectrumValue& rhs);
+    friend SpectrumValue operator-(SpectrumValue rhs);
 
     /**
      * left shift operator
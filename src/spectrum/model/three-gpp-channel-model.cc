@@ -21,11 +21,13 @@
 #include "ns3/shuffle.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <array>
 #include <map>
 #include <random>
+#include <thread>
 
 namespace ns3
 {
@@ -1128,6 +1130,14 @@ ThreeGppChannelModel::GetTypeId()
                           TimeValue(MilliSeconds(0)),
                           MakeTimeAccessor(&ThreeGppChannelModel::m_updatePeriod),
                           MakeTimeChecker())
+            .AddAttribute("NumThreads",
+                          "The number of threads computing the coefficients of a channel matrix. "
+                          "The antenna elements of the receiver are divided among the threads; "
+                          "the resulting channel matrix does not depend on the number of "
+                          "threads. Small antenna arrays are always handled by a single thread.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_numThreads),
+                          MakeUintegerChecker<uint32_t>(1))
             // attributes for the blockage model
             .AddAttribute("Blockage",
                           "Enable blockage model A (sec 7.6.4.1)",
@@ -3407,117 +3417,162 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
-    // The following for loops computes the channel coefficients
+    // Page of hUsn in which the second sub-cluster of each cluster is stored
+    // (the third one is in the next page); only used for the strongest 2 clusters
+    std::vector<size_t> subClusterPage(channelParams->m_reducedClusterNumber, 0);
     // Keeps track of how many sub-clusters have been added up to now
     uint8_t numSubClustersAdded = 0;
     for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
-        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+        {
+            subClusterPage[nIndex] = channelParams->m_reducedClusterNumber + numSubClustersAdded;
+            numSubClustersAdded += 2;
+        }
+    }
+
+    // Computes the channel coefficients of the receive antenna elements in [uBegin, uEnd).
+    // Each coefficient only depends on the values computed above, hence disjoint ranges of
+    // elements can be computed concurrently and give the same result as a single range.
+    auto computeCoefficients = [&](size_t uBegin, size_t uEnd) {
+        for (size_t uIndex = uBegin; uIndex < uEnd; uIndex++)
         {
             Vector uLoc = uAntenna->GetElementLocation(uIndex);
 
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
                 Vector sLoc = sAntenna->GetElementLocation(sIndex);
-                // Compute the N-2 weakest cluster, assuming 0 slant angle and a
-                // polarization slant angle configured in the array (7.5-22)
-                if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
+                const Complex2DVector& rayTerms = raysPreComp.at(
+                    std::make_pair(sAntenna->GetElemPol(sIndex), uAntenna->GetElemPol(uIndex)));
+
+                for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
                 {
-                    std::complex<double> rays(0, 0);
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    // Compute the N-2 weakest cluster, assuming 0 slant angle and a
+                    // polarization slant angle configured in the array (7.5-22)
+                    if (nIndex != channelParams->m_cluster1st &&
+                        nIndex != channelParams->m_cluster2nd)
                     {
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-                        // NOTE Doppler is computed in the CalcBeamformingGain function and is
-                        // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                           uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                          mIndex) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        std::complex<double> rays(0, 0);
+                        for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                        {
+                            // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+                            double rxPhaseDiff = 2 * M_PI *
+                                                 (sinCosA[nIndex][mIndex] * uLoc.x +
+                                                  sinSinA[nIndex][mIndex] * uLoc.y +
+                                                  cosZoA[nIndex][mIndex] * uLoc.z);
+
+                            double txPhaseDiff = 2 * M_PI *
+                                                 (sinCosD[nIndex][mIndex] * sLoc.x +
+                                                  sinSinD[nIndex][mIndex] * sLoc.y +
+                                                  cosZoD[nIndex][mIndex] * sLoc.z);
+                            // NOTE Doppler is computed in the CalcBeamformingGain function and
+                            // is simplified to only account for the center angle of each
+                            // cluster.
+                            rays += rayTerms(nIndex, mIndex) *
+                                    std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
+                                    std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        }
+                        rays *= sqrt(channelParams->m_clusterPower[nIndex] /
+                                     table3gpp->m_raysPerCluster);
+                        hUsn(uIndex, sIndex, nIndex) = rays;
                     }
-                    rays *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn(uIndex, sIndex, nIndex) = rays;
-                }
-                else //(7.5-28)
-                {
-                    std::complex<double> raysSub1(0, 0);
-                    std::complex<double> raysSub2(0, 0);
-                    std::complex<double> raysSub3(0, 0);
-
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    else //(7.5-28)
                     {
-                        // ZML:Just remind me that the angle offsets for the 3 subclusters were not
-                        // generated correctly.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
-                        std::complex<double> raySub =
-                            raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                       uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                      mIndex) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
-                        switch (mIndex)
+                        std::complex<double> raysSub1(0, 0);
+                        std::complex<double> raysSub2(0, 0);
+                        std::complex<double> raysSub3(0, 0);
+
+                        for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
                         {
-                        case 9:
-                        case 10:
-                        case 11:
-                        case 12:
-                        case 17:
-                        case 18:
-                            raysSub2 += raySub;
-                            break;
-                        case 13:
-                        case 14:
-                        case 15:
-                        case 16:
-                            raysSub3 += raySub;
-                            break;
-                        default: // case 1,2,3,4,5,6,7,8,19,20
-                            raysSub1 += raySub;
-                            break;
+                            // ZML:Just remind me that the angle offsets for the 3 subclusters
+                            // were not generated correctly.
+                            double rxPhaseDiff = 2 * M_PI *
+                                                 (sinCosA[nIndex][mIndex] * uLoc.x +
+                                                  sinSinA[nIndex][mIndex] * uLoc.y +
+                                                  cosZoA[nIndex][mIndex] * uLoc.z);
+
+                            double txPhaseDiff = 2 * M_PI *
+                                                 (sinCosD[nIndex][mIndex] * sLoc.x +
+                                                  sinSinD[nIndex][mIndex] * sLoc.y +
+                                                  cosZoD[nIndex][mIndex] * sLoc.z);
+
+                            std::complex<double> raySub =
+                                rayTerms(nIndex, mIndex) *
+                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
+                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+
+                            switch (mIndex)
+                            {
+                            case 9:
+                            case 10:
+                            case 11:
+                            case 12:
+                            case 17:
+                            case 18:
+                                raysSub2 += raySub;
+                                break;
+                            case 13:
+                            case 14:
+                            case 15:
+                            case 16:
+                                raysSub3 += raySub;
+                                break;
+                            default: // case 1,2,3,4,5,6,7,8,19,20
+                                raysSub1 += raySub;
+                                break;
+                            }
                         }
+                        raysSub1 *= sqrt(channelParams->m_clusterPower[nIndex] /
+                                         table3gpp->m_raysPerCluster);
+                        raysSub2 *= sqrt(channelParams->m_clusterPower[nIndex] /
+                                         table3gpp->m_raysPerCluster);
+                        raysSub3 *= sqrt(channelParams->m_clusterPower[nIndex] /
+                                         table3gpp->m_raysPerCluster);
+                        hUsn(uIndex, sIndex, nIndex) = raysSub1;
+                        hUsn(uIndex, sIndex, subClusterPage[nIndex]) = raysSub2;
+                        hUsn(uIndex, sIndex, subClusterPage[nIndex] + 1) = raysSub3;
                     }
-                    raysSub1 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub2 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub3 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn(uIndex, sIndex, nIndex) = raysSub1;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded) = raysSub2;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded + 1) =
-                        raysSub3;
                 }
             }
         }
-        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+    };
+
+    // Split the receive antenna elements among the worker threads, unless there are too few
+    // coefficients to make up for the cost of starting the threads
+    size_t numThreads = std::min<size_t>(m_numThreads, uSize);
+    if (uSize * sSize * channelParams->m_reducedClusterNumber * table3gpp->m_raysPerCluster <
+        MIN_RAYS_PER_THREAD * numThreads)
+    {
+        numThreads = 1;
+    }
+    if (numThreads > 1)
+    {
+        NS_LOG_LOGIC("computing the channel coefficients with " << numThreads << " threads");
+        std::vector<std::thread> workers;
+        size_t uBegin = 0;
+        for (size_t t = 0; t < numThreads; t++)
         {
-            numSubClustersAdded += 2;
+            size_t uEnd = uBegin + uSize / numThreads + (t < uSize % numThreads ? 1 : 0);
+            if (t + 1 < numThreads)
+            {
+                workers.emplace_back(computeCoefficients, uBegin, uEnd);
+            }
+            else
+            {
+                // the calling thread computes the last range
+                computeCoefficients(uBegin, uEnd);
+            }
+            uBegin = uEnd;
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
         }
     }
+    else
+    {
+        computeCoefficients(0, uSize);
+    }
 
     if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
     {
@@ -353,6 +353,11 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                             //!< key of this map is reciprocal and uniquely identifies a pair of
                             //!< nodes
     Time m_updatePeriod;    //!< the channel update period
+    uint32_t m_numThreads;  //!< the number of threads computing the channel coefficients
+
+    /// Minimum number of rays per thread for which the channel coefficients are computed by
+    /// several threads
+    static constexpr size_t MIN_RAYS_PER_THREAD = 8192;
     double m_frequency;     //!< the operating frequency
     std::string m_scenario; //!< the 3GPP scenario
     Ptr<ChannelConditionModel> m_channelConditionModel; //!< the channel condition model
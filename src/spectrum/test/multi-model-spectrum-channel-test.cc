@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy recording the signals it receives
+ */
+class MaxRangeTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * @param id the identifier of the PHY
+     * @param model the RX spectrum model
+     * @param mobility the mobility model, or nullptr
+     * @param receptions the identifiers of the PHYs that received a signal
+     */
+    MaxRangeTestPhy(uint32_t id,
+                    Ptr<const SpectrumModel> model,
+                    Ptr<MobilityModel> mobility,
+                    std::vector<uint32_t>* receptions)
+        : m_id(id),
+          m_model(model),
+          m_mobility(mobility),
+          m_receptions(receptions)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_receptions->push_back(m_id);
+    }
+
+  private:
+    uint32_t m_id;                       //!< identifier of the PHY
+    Ptr<const SpectrumModel> m_model;    //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;       //!< mobility model
+    std::vector<uint32_t>* m_receptions; //!< PHYs that received a signal
+};
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check the receivers of MultiModelSpectrumChannel with the MaxRange attribute
+ *
+ * A PHY at the origin transmits to PHYs with an overlapping, the same or an
+ * orthogonal spectrum model, some of which are out of range, move into range
+ * or are moved out of range.
+ */
+class MultiModelSpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    MultiModelSpectrumChannelMaxRangeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit a signal and check the PHYs that receive it.
+     * @param expected the identifiers of the PHYs expected to receive the signal, in order
+     */
+    void Transmit(std::vector<uint32_t> expected);
+
+    Ptr<MultiModelSpectrumChannel> m_channel; //!< the channel
+    Ptr<MaxRangeTestPhy> m_txPhy;             //!< the transmitter
+    std::vector<uint32_t> m_receptions;       //!< PHYs that received a signal
+};
+
+MultiModelSpectrumChannelMaxRangeTestCase::MultiModelSpectrumChannelMaxRangeTestCase()
+    : TestCase("Check the receivers within MaxRange")
+{
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::Transmit(std::vector<uint32_t> expected)
+{
+    m_receptions.clear();
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(m_txPhy->GetRxSpectrumModel());
+    params->duration = MilliSeconds(1);
+    params->txPhy = m_txPhy;
+    m_channel->StartTx(params);
+    // the receptions are scheduled without delay
+    Simulator::Schedule(MicroSeconds(1), [=, this]() {
+        NS_TEST_EXPECT_MSG_EQ((m_receptions == expected),
+                              true,
+                              "Wrong receivers at " << Simulator::Now().As(Time::S));
+    });
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::DoRun()
+{
+    m_channel =
+        CreateObjectWithAttributes<MultiModelSpectrumChannel>("MaxRange", DoubleValue(100));
+    auto modelA = Create<SpectrumModel>(std::vector<double>{1e9, 1.1e9});
+    auto modelB = Create<SpectrumModel>(std::vector<double>{1.05e9, 1.15e9});
+    auto modelC = Create<SpectrumModel>(std::vector<double>{3e9, 3.1e9});
+
+    auto at = [](double x) {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(x, 0, 0));
+        return mobility;
+    };
+    m_txPhy = CreateObject<MaxRangeTestPhy>(0, modelA, at(0), &m_receptions);
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(300, 0, 0));
+    moving->SetVelocity(Vector(-100, 0, 0));
+    auto jumping = at(50);
+    std::vector<Ptr<MaxRangeTestPhy>> phys = {
+        m_txPhy,
+        CreateObject<MaxRangeTestPhy>(1, modelA, jumping, &m_receptions),
+        CreateObject<MaxRangeTestPhy>(2, modelB, at(60), &m_receptions),
+        CreateObject<MaxRangeTestPhy>(3, modelA, at(150), &m_receptions),
+        CreateObject<MaxRangeTestPhy>(4, modelC, at(10), &m_receptions),
+        CreateObject<MaxRangeTestPhy>(5, modelB, moving, &m_receptions),
+        CreateObject<MaxRangeTestPhy>(6, modelA, nullptr, &m_receptions),
+    };
+    for (const auto& phy : phys)
+    {
+        m_channel->AddRx(phy);
+    }
+
+    // the receivers are grouped by spectrum model, in the order in which they
+    // were added; PHY 4 is orthogonal to the transmitter, and PHY 6 has no
+    // position
+    Simulator::Schedule(Seconds(0),
+                        &MultiModelSpectrumChannelMaxRangeTestCase::Transmit,
+                        this,
+                        std::vector<uint32_t>{1, 6, 2});
+    Simulator::Schedule(Seconds(1), [=]() { jumping->SetPosition(Vector(500, 0, 0)); });
+    Simulator::Schedule(Seconds(2.5),
+                        &MultiModelSpectrumChannelMaxRangeTestCase::Transmit,
+                        this,
+                        std::vector<uint32_t>{6, 2, 5});
+    Simulator::Schedule(Seconds(5),
+                        &MultiModelSpectrumChannelMaxRangeTestCase::Transmit,
+                        this,
+                        std::vector<uint32_t>{6, 2});
+    Simulator::Run();
+
+    m_channel->Dispose();
+    m_channel = nullptr;
+    m_txPhy = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief MultiModelSpectrumChannel test suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", Type::UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelMaxRangeTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
@@ -197,6 +197,30 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 = v1 * v2"), TestCase::Duration::QUICK);
     AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 = v1 div v2"), TestCase::Duration::QUICK);
 
+    // the right operand is a temporary, whose storage holds the result
+    tv3 = v1 + SpectrumValue(v2);
+    tv4 = v1 - SpectrumValue(v2);
+    tv5 = v1 * SpectrumValue(v2);
+    tv6 = v1 / SpectrumValue(v2);
+
+    AddTestCase(new SpectrumValueTestCase(tv3, v3, "tv3 = v1 + temporary v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4, v4, "tv4 = v1 - temporary v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 = v1 * temporary v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 = v1 div temporary v2"),
+                TestCase::Duration::QUICK);
+
+    // both operands are temporaries
+    tv3 = (v1 * 1.0) + (v2 * 1.0);
+    tv4 = (v1 * 1.0) - (v2 * 1.0);
+
+    AddTestCase(new SpectrumValueTestCase(tv3, v3, "tv3 = temporary v1 + temporary v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4, v4, "tv4 = temporary v1 - temporary v2"),
+                TestCase::Duration::QUICK);
+
     // std::cerr << v6 << std::endl;
     // std::cerr << tv6 << std::endl;
 
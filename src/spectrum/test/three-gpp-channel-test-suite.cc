@@ -6,6 +6,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/angles.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
@@ -713,6 +714,107 @@ ThreeGppAntennaSetupChangedTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * Test case for the NumThreads attribute of the ThreeGppChannelModel class.
+ * Checks that the channel matrices computed with several threads are identical
+ * to the ones computed by a single thread, in LOS and NLOS conditions.
+ */
+class ThreeGppChannelMatrixThreadsTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param numThreads the number of threads of the model under test
+     */
+    ThreeGppChannelMatrixThreadsTest(uint32_t numThreads);
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    uint32_t m_numThreads; //!< the number of threads of the model under test
+};
+
+ThreeGppChannelMatrixThreadsTest::ThreeGppChannelMatrixThreadsTest(uint32_t numThreads)
+    : TestCase("Check that the channel matrix does not depend on the number of threads, "
+               "numThreads=" +
+               std::to_string(numThreads)),
+      m_numThreads(numThreads)
+{
+}
+
+void
+ThreeGppChannelMatrixThreadsTest::DoRun()
+{
+    // create the tx and rx nodes, with their mobility models
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(80.0, 30.0, 1.6));
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    // create large antenna arrays, so that the coefficients are actually split among
+    // the threads, with an odd number of elements at the receiver
+    Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(8),
+        "NumRows",
+        UintegerValue(4),
+        "AntennaElement",
+        PointerValue(CreateObject<ThreeGppAntennaModel>()),
+        "IsDualPolarized",
+        BooleanValue(true));
+    Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(5),
+        "NumRows",
+        UintegerValue(3),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+
+    for (bool los : {true, false})
+    {
+        Ptr<ChannelConditionModel> channelConditionModel;
+        if (los)
+        {
+            channelConditionModel = CreateObject<AlwaysLosChannelConditionModel>();
+        }
+        else
+        {
+            channelConditionModel = CreateObject<NeverLosChannelConditionModel>();
+        }
+
+        std::vector<Ptr<const ThreeGppChannelModel::ChannelMatrix>> channels;
+        for (uint32_t numThreads : {1U, m_numThreads})
+        {
+            auto channelModel = CreateObject<ThreeGppChannelModel>();
+            channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+            channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+            channelModel->SetAttribute("ChannelConditionModel",
+                                       PointerValue(channelConditionModel));
+            channelModel->SetAttribute("NumThreads", UintegerValue(numThreads));
+            channelModel->AssignStreams(1);
+            channels.push_back(channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna));
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(channels[0]->m_channel.GetNumPages(),
+                              channels[1]->m_channel.GetNumPages(),
+                              "Different number of clusters, los=" << los);
+        NS_TEST_ASSERT_MSG_EQ((channels[0]->m_channel == channels[1]->m_channel),
+                              true,
+                              "The channel matrix depends on the number of threads, los="
+                                  << los);
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup spectrum-tests
  * @brief A structure that holds the parameters for the function
@@ -1477,6 +1579,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 4, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 2, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppAntennaSetupChangedTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelMatrixThreadsTest(2), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelMatrixThreadsTest(4), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 1, 1),
                 TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 2, 2),
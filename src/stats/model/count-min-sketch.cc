@@ -0,0 +1,102 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "count-min-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CountMinSketch");
+
+namespace
+{
+
+/**
+ * The SplitMix64 finalizer, used to derive the hash of a key in each row.
+ * @param x the value to mix
+ * @return the mixed value
+ */
+uint64_t
+Mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+CountMinSketch::CountMinSketch(uint32_t width, uint32_t depth)
+    : m_width(width),
+      m_depth(depth),
+      m_counters(static_cast<std::size_t>(width) * depth, 0),
+      m_total(0)
+{
+    NS_LOG_FUNCTION(this << width << depth);
+    NS_ABORT_MSG_UNLESS(width > 0 && depth > 0, "The sketch needs at least one counter");
+}
+
+std::size_t
+CountMinSketch::GetCounter(uint64_t key, uint32_t row) const
+{
+    uint64_t hash = Mix(key ^ Mix(row));
+    return static_cast<std::size_t>(row) * m_width + hash % m_width;
+}
+
+void
+CountMinSketch::Add(uint64_t key, uint64_t count)
+{
+    NS_LOG_FUNCTION(this << key << count);
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        m_counters[GetCounter(key, row)] += count;
+    }
+    m_total += count;
+}
+
+uint64_t
+CountMinSketch::Estimate(uint64_t key) const
+{
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        estimate = std::min(estimate, m_counters[GetCounter(key, row)]);
+    }
+    return estimate;
+}
+
+void
+CountMinSketch::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_total = 0;
+}
+
+uint64_t
+CountMinSketch::GetTotal() const
+{
+    return m_total;
+}
+
+uint32_t
+CountMinSketch::GetWidth() const
+{
+    return m_width;
+}
+
+uint32_t
+CountMinSketch::GetDepth() const
+{
+    return m_depth;
+}
+
+} // namespace ns3
@@ -0,0 +1,86 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef COUNT_MIN_SKETCH_H
+#define COUNT_MIN_SKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Fixed-memory estimator of the totals of a large set of keys
+ *
+ * This class implements the count-min sketch (G. Cormode and
+ * S. Muthukrishnan, "An improved data stream summary: the count-min sketch
+ * and its applications", Journal of Algorithms, 2005).  The counts added
+ * to a key are added to one counter in each of `depth` rows of `width`
+ * counters, chosen by independent hash functions; the total of a key is
+ * estimated as the minimum of its counters.  The estimate is never smaller
+ * than the true total, and exceeds it by at most 2N/width (N being the sum
+ * of all the counts) with probability at least 1 - 2^-depth.
+ */
+class CountMinSketch
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param width the number of counters in each row
+     * @param depth the number of rows
+     */
+    CountMinSketch(uint32_t width = 2048, uint32_t depth = 4);
+
+    /**
+     * @brief Add a count to a key
+     * @param key the key
+     * @param count the count to add
+     */
+    void Add(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Estimate the total count of a key
+     * @param key the key
+     * @return the estimate
+     */
+    uint64_t Estimate(uint64_t key) const;
+
+    /**
+     * @brief Reset all the counters.
+     */
+    void Clear();
+
+    /**
+     * @return the sum of all the counts added
+     */
+    uint64_t GetTotal() const;
+    /**
+     * @return the number of counters in each row
+     */
+    uint32_t GetWidth() const;
+    /**
+     * @return the number of rows
+     */
+    uint32_t GetDepth() const;
+
+  private:
+    /**
+     * Get the counter of a key in a row.
+     * @param key the key
+     * @param row the row
+     * @return the position of the counter in m_counters
+     */
+    std::size_t GetCounter(uint64_t key, uint32_t row) const;
+
+    uint32_t m_width;                 //!< Number of counters in each row
+    uint32_t m_depth;                 //!< Number of rows
+    std::vector<uint64_t> m_counters; //!< The counters, row by row
+    uint64_t m_total;                 //!< Sum of all the counts
+};
+
+} // namespace ns3
+
+#endif /* COUNT_MIN_SKETCH_H */
@@ -0,0 +1,199 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "quantile-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QuantileSketch");
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, uint32_t maxBins)
+    : m_relativeAccuracy(relativeAccuracy),
+      m_maxBins(maxBins),
+      m_offset(0),
+      m_zeroCount(0),
+      m_count(0),
+      m_min(0),
+      m_max(0)
+{
+    NS_ABORT_MSG_UNLESS(relativeAccuracy > 0 && relativeAccuracy < 1,
+                        "The relative accuracy must be in (0, 1)");
+    NS_ABORT_MSG_UNLESS(maxBins > 0, "The sketch needs at least one bin");
+    m_gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy);
+    m_logGamma = std::log(m_gamma);
+}
+
+int32_t
+QuantileSketch::GetIndex(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma));
+}
+
+void
+QuantileSketch::AddToBin(int32_t index, uint64_t count)
+{
+    if (m_bins.empty())
+    {
+        m_bins.assign(1, count);
+        m_offset = index;
+        return;
+    }
+    int32_t low = std::min(index, m_offset);
+    int32_t high = std::max(index, m_offset + static_cast<int32_t>(m_bins.size()) - 1);
+    if (high - low + 1 > static_cast<int32_t>(m_maxBins))
+    {
+        // the lowest bins are merged into the lowest one that is kept
+        low = high - static_cast<int32_t>(m_maxBins) + 1;
+        index = std::max(index, low);
+    }
+    if (low != m_offset || high - low + 1 != static_cast<int32_t>(m_bins.size()))
+    {
+        std::vector<uint64_t> bins(high - low + 1, 0);
+        for (std::size_t i = 0; i < m_bins.size(); i++)
+        {
+            int32_t binIndex = std::max(m_offset + static_cast<int32_t>(i), low);
+            bins[binIndex - low] += m_bins[i];
+        }
+        m_bins.swap(bins);
+        m_offset = low;
+    }
+    m_bins[index - m_offset] += count;
+}
+
+void
+QuantileSketch::AddValue(double value)
+{
+    NS_LOG_FUNCTION(this << value);
+    value = std::max(value, 0.0);
+    if (m_count == 0)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+    if (value <= std::numeric_limits<double>::min())
+    {
+        m_zeroCount++;
+        return;
+    }
+    AddToBin(GetIndex(value), 1);
+}
+
+double
+QuantileSketch::GetQuantile(double q) const
+{
+    NS_LOG_FUNCTION(this << q);
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    // rank of the value, counting from zero
+    auto rank = static_cast<uint64_t>(q * (m_count - 1));
+    if (rank < m_zeroCount)
+    {
+        return 0;
+    }
+    uint64_t seen = m_zeroCount;
+    std::size_t i = 0;
+    for (; i + 1 < m_bins.size(); i++)
+    {
+        seen += m_bins[i];
+        if (seen > rank)
+        {
+            break;
+        }
+    }
+    // the value that minimizes the relative error in the bin (gamma^(i-1), gamma^i]
+    double estimate = 2 * std::pow(m_gamma, m_offset + static_cast<int32_t>(i)) / (m_gamma + 1);
+    return std::clamp(estimate, m_min, m_max);
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(other.m_relativeAccuracy == m_relativeAccuracy,
+                        "Cannot merge sketches with a different accuracy");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (m_count == 0)
+    {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    }
+    else
+    {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+    for (std::size_t i = 0; i < other.m_bins.size(); i++)
+    {
+        if (other.m_bins[i] > 0)
+        {
+            AddToBin(other.m_offset + static_cast<int32_t>(i), other.m_bins[i]);
+        }
+    }
+}
+
+void
+QuantileSketch::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_bins.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+uint64_t
+QuantileSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+QuantileSketch::GetMin() const
+{
+    return m_min;
+}
+
+double
+QuantileSketch::GetMax() const
+{
+    return m_max;
+}
+
+double
+QuantileSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+uint32_t
+QuantileSketch::GetNBins() const
+{
+    return m_bins.size();
+}
+
+} // namespace ns3
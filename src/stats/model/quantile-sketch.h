@@ -0,0 +1,119 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Streaming estimator of the quantiles of a set of non-negative values
+ *
+ * This class implements the DDSketch algorithm (C. Masson, J. E. Rim and
+ * H. K. Lee, "DDSketch: A Fast and Fully-Mergeable Quantile Sketch with
+ * Relative-Error Guarantees", VLDB 2019).  The positive values are counted
+ * in logarithmically spaced bins, so that any quantile is estimated with a
+ * relative error bounded by the accuracy given to the constructor, with a
+ * memory that grows with the logarithm of the range of the values rather
+ * than with their number.  The values equal to zero are counted apart.
+ *
+ * The number of bins is bounded: when a new value would require more bins,
+ * the lowest bins are merged, which trades the accuracy of the lowest
+ * quantiles for a fixed memory.  With the default parameters, 1024 bins
+ * cover almost 9 orders of magnitude at 1% accuracy, e.g., from 1 ns to 1 s.
+ *
+ * Two sketches with the same accuracy can be merged.
+ */
+class QuantileSketch
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+     * @param maxBins the maximum number of bins
+     */
+    QuantileSketch(double relativeAccuracy = 0.01, uint32_t maxBins = 1024);
+
+    /**
+     * @brief Add a value to the sketch
+     * @param value the value to add; negative values are counted as zero
+     */
+    void AddValue(double value);
+
+    /**
+     * @brief Estimate a quantile of the values added so far.
+     * @param q the quantile, in [0, 1] (e.g., 0.99 for the 99th percentile)
+     * @return the estimate, or zero if the sketch is empty
+     */
+    double GetQuantile(double q) const;
+
+    /**
+     * @brief Merge the values of another sketch into this one.
+     *
+     * The two sketches must have the same relative accuracy.
+     *
+     * @param other the other sketch
+     */
+    void Merge(const QuantileSketch& other);
+
+    /**
+     * @brief Remove all the values.
+     */
+    void Clear();
+
+    /**
+     * @return the number of values added to the sketch
+     */
+    uint64_t GetCount() const;
+    /**
+     * @return the smallest value added to the sketch, or zero if it is empty
+     */
+    double GetMin() const;
+    /**
+     * @return the largest value added to the sketch, or zero if it is empty
+     */
+    double GetMax() const;
+    /**
+     * @return the relative accuracy of the sketch
+     */
+    double GetRelativeAccuracy() const;
+    /**
+     * @return the number of bins in use
+     */
+    uint32_t GetNBins() const;
+
+  private:
+    /**
+     * Get the index of the bin of a positive value.
+     * @param value the value
+     * @return the index
+     */
+    int32_t GetIndex(double value) const;
+    /**
+     * Add a count to a bin, merging the lowest bins if needed.
+     * @param index the bin index
+     * @param count the count to add
+     */
+    void AddToBin(int32_t index, uint64_t count);
+
+    double m_relativeAccuracy;    //!< Relative accuracy
+    double m_gamma;               //!< Ratio between the bounds of a bin
+    double m_logGamma;            //!< Natural logarithm of m_gamma
+    uint32_t m_maxBins;           //!< Maximum number of bins
+    std::vector<uint64_t> m_bins; //!< Counts of the positive values, by bin
+    int32_t m_offset;             //!< Index of the first bin in m_bins
+    uint64_t m_zeroCount;         //!< Count of the values equal to zero
+    uint64_t m_count;             //!< Count of all the values
+    double m_min;                 //!< Smallest value
+    double m_max;                 //!< Largest value
+};
+
+} // namespace ns3
+
+#endif /* QUANTILE_SKETCH_H */
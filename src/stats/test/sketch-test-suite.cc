@@ -0,0 +1,173 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/count-min-sketch.h"
+#include "ns3/quantile-sketch.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch Test
+ */
+class QuantileSketchTestCase : public TestCase
+{
+  public:
+    QuantileSketchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QuantileSketchTestCase::QuantileSketchTestCase()
+    : TestCase("QuantileSketch")
+{
+}
+
+void
+QuantileSketchTestCase::DoRun()
+{
+    const double accuracy = 0.01;
+    QuantileSketch sketch(accuracy);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetQuantile(0.5), 0, "An empty sketch has no quantiles");
+
+    // values spread over six orders of magnitude, added out of order
+    std::vector<double> values;
+    for (uint32_t i = 1; i <= 10000; i++)
+    {
+        values.push_back(1e-6 * std::pow(1e6, ((i * 7919) % 10000) / 10000.0));
+    }
+    for (auto value : values)
+    {
+        sketch.AddValue(value);
+    }
+    std::sort(values.begin(), values.end());
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), values.size(), "Wrong count");
+    for (double q : {0.0, 0.01, 0.5, 0.9, 0.99, 1.0})
+    {
+        double exact = values[static_cast<std::size_t>(q * (values.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(q),
+                                  exact,
+                                  exact * accuracy,
+                                  "Quantile " << q << " out of the accuracy bound");
+    }
+
+    // merging two halves gives the same quantiles as a single sketch
+    QuantileSketch low(accuracy);
+    QuantileSketch high(accuracy);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        (i < values.size() / 2 ? low : high).AddValue(values[i]);
+    }
+    low.Merge(high);
+    NS_TEST_EXPECT_MSG_EQ(low.GetCount(), sketch.GetCount(), "Wrong count after merge");
+    NS_TEST_EXPECT_MSG_EQ(low.GetQuantile(0.99), sketch.GetQuantile(0.99), "Wrong merge");
+
+    // zeros are counted apart
+    QuantileSketch zeros(accuracy);
+    for (uint32_t i = 0; i < 60; i++)
+    {
+        zeros.AddValue(0);
+    }
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        zeros.AddValue(1);
+    }
+    NS_TEST_EXPECT_MSG_EQ(zeros.GetQuantile(0.5), 0, "The median should be zero");
+    NS_TEST_EXPECT_MSG_EQ_TOL(zeros.GetQuantile(0.99), 1, accuracy, "Wrong high quantile");
+
+    // with a bounded number of bins, the high quantiles keep their accuracy
+    QuantileSketch bounded(accuracy, 100);
+    for (auto value : values)
+    {
+        bounded.AddValue(value);
+    }
+    NS_TEST_EXPECT_MSG_EQ(bounded.GetNBins(), 100, "The number of bins should be bounded");
+    double exact = values[static_cast<std::size_t>(0.99 * (values.size() - 1))];
+    NS_TEST_EXPECT_MSG_EQ_TOL(bounded.GetQuantile(0.99),
+                              exact,
+                              exact * accuracy,
+                              "High quantile of a bounded sketch out of the accuracy bound");
+    NS_TEST_EXPECT_MSG_EQ(bounded.GetMin(), values.front(), "Wrong minimum");
+    NS_TEST_EXPECT_MSG_EQ(bounded.GetMax(), values.back(), "Wrong maximum");
+
+    bounded.Clear();
+    NS_TEST_EXPECT_MSG_EQ(bounded.GetCount(), 0, "The sketch should be empty");
+    NS_TEST_EXPECT_MSG_EQ(bounded.GetNBins(), 0, "The sketch should have no bins");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief CountMinSketch Test
+ */
+class CountMinSketchTestCase : public TestCase
+{
+  public:
+    CountMinSketchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CountMinSketchTestCase::CountMinSketchTestCase()
+    : TestCase("CountMinSketch")
+{
+}
+
+void
+CountMinSketchTestCase::DoRun()
+{
+    CountMinSketch sketch(1024, 4);
+
+    // a few heavy keys among many light ones
+    uint64_t total = 0;
+    for (uint64_t key = 0; key < 20000; key++)
+    {
+        uint64_t count = (key % 1000 == 0) ? 100000 : 10;
+        sketch.Add(key, count);
+        total += count;
+    }
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetTotal(), total, "Wrong total");
+
+    for (uint64_t key = 0; key < 20000; key += 1000)
+    {
+        uint64_t estimate = sketch.Estimate(key);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(estimate, 100000, "The estimate cannot be low");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(estimate,
+                                    100000 + 2 * total / sketch.GetWidth(),
+                                    "Heavy key estimate out of the error bound");
+    }
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(sketch.Estimate(1), 10, "The estimate cannot be low");
+
+    sketch.Clear();
+    NS_TEST_EXPECT_MSG_EQ(sketch.Estimate(1000), 0, "The sketch should be empty");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetTotal(), 0, "The sketch should be empty");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief Sketch TestSuite
+ */
+class SketchTestSuite : public TestSuite
+{
+  public:
+    SketchTestSuite();
+};
+
+SketchTestSuite::SketchTestSuite()
+    : TestSuite("stats-sketch", Type::UNIT)
+{
+    AddTestCase(new QuantileSketchTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CountMinSketchTestCase, TestCase::Duration::QUICK);
+}
+
+static SketchTestSuite g_sketchTestSuite; //!< Static variable for test initialization
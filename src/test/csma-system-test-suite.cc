@@ -9,12 +9,15 @@
 
 #include "ns3/address.h"
 #include "ns3/application-container.h"
+#include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/callback.h"
 #include "ns3/config.h"
 #include "ns3/csma-helper.h"
 #include "ns3/csma-star-helper.h"
 #include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/error-model.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -36,6 +39,8 @@
 #include "ns3/uinteger.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -1220,6 +1225,133 @@ CsmaStarTestCase::DoRun()
                           "Hub node did not receive the proper number of packets");
 }
 
+/**
+ * @ingroup system-tests-csma
+ *
+ * @brief CSMA channel delivery test.
+ *
+ * Checks that the UnicastFilter and ShareGroupFrames attributes of the
+ * CsmaChannel do not change the packets received by the nodes of a LAN
+ * carrying colliding unicast and broadcast flows, with a receive error
+ * model on a destination and on a bystander, and that they reduce the
+ * number of events.
+ */
+class CsmaDeliveryTestCase : public TestCase
+{
+  public:
+    CsmaDeliveryTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the simulation of the LAN.
+     * @param optimize the value of the UnicastFilter and ShareGroupFrames
+     *        attributes of the channel
+     * @return the number of events executed
+     */
+    uint64_t RunLan(bool optimize);
+
+    /**
+     * Sink called when a packet is received by a node.
+     * @param context Context of the trace source.
+     * @param p Received packet.
+     * @param ad Sender's address (unused).
+     */
+    void SinkRx(std::string context, Ptr<const Packet> p, const Address& ad);
+
+    /// Receptions (context of the sink and time) of each run
+    std::vector<std::pair<std::string, Time>> m_rx[2];
+    uint32_t m_run; //!< Index of the current run
+};
+
+CsmaDeliveryTestCase::CsmaDeliveryTestCase()
+    : TestCase("Delivery of unicast and broadcast frames on a CSMA channel"),
+      m_run(0)
+{
+}
+
+void
+CsmaDeliveryTestCase::SinkRx(std::string context, Ptr<const Packet> p, const Address& ad)
+{
+    m_rx[m_run].emplace_back(context, Simulator::Now());
+}
+
+uint64_t
+CsmaDeliveryTestCase::RunLan(bool optimize)
+{
+    NodeContainer nodes;
+    nodes.Create(12);
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", DataRateValue(DataRate(5000000)));
+    csma.SetChannelAttribute("Delay", TimeValue(MilliSeconds(2)));
+    csma.SetChannelAttribute("UnicastFilter", BooleanValue(optimize));
+    csma.SetChannelAttribute("ShareGroupFrames", BooleanValue(optimize));
+    NetDeviceContainer devices = csma.Install(nodes);
+    csma.AssignStreams(devices, 0);
+
+    // a destination and a bystander lose some frames
+    for (uint32_t i : {1, 7})
+    {
+        Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+        em->SetAttribute("ErrorRate", DoubleValue(0.05));
+        em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+        em->AssignStreams(100 + i);
+        devices.Get(i)->SetAttribute("ReceiveErrorModel", PointerValue(em));
+    }
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    internet.AssignStreams(nodes, 200);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 9;
+    ApplicationContainer apps;
+    // three unicast flows, from node i to node i + 1, and a broadcast flow
+    for (uint32_t i : {0, 2, 4, 6})
+    {
+        Ipv4Address destination =
+            (i == 6) ? Ipv4Address("255.255.255.255") : interfaces.GetAddress(i + 1);
+        OnOffHelper onoff("ns3::UdpSocketFactory", InetSocketAddress(destination, port));
+        onoff.SetConstantRate(DataRate(500000), 512);
+        apps.Add(onoff.Install(nodes.Get(i)));
+    }
+    PacketSinkHelper sink("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    apps.Add(sink.Install(nodes));
+    apps.Start(Seconds(1));
+    apps.Stop(Seconds(3));
+
+    Config::Connect("/NodeList/*/ApplicationList/*/$ns3::PacketSink/Rx",
+                    MakeCallback(&CsmaDeliveryTestCase::SinkRx, this));
+
+    Simulator::Run();
+    uint64_t nEvents = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return nEvents;
+}
+
+void
+CsmaDeliveryTestCase::DoRun()
+{
+    m_run = 0;
+    uint64_t nEvents = RunLan(false);
+    m_run = 1;
+    uint64_t nOptimizedEvents = RunLan(true);
+
+    NS_TEST_ASSERT_MSG_GT(m_rx[0].size(), 0, "No packet received");
+    NS_TEST_ASSERT_MSG_EQ(m_rx[0].size(), m_rx[1].size(), "Different numbers of packets received");
+    for (std::size_t i = 0; i < m_rx[0].size() && i < m_rx[1].size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rx[0][i].first, m_rx[1][i].first, "Different receivers");
+        NS_TEST_ASSERT_MSG_EQ(m_rx[0][i].second, m_rx[1][i].second, "Different reception times");
+    }
+    NS_TEST_ASSERT_MSG_LT(nOptimizedEvents, nEvents, "No reception event was saved");
+}
+
 /**
  * @ingroup system-tests-csma
  *
@@ -1242,6 +1374,7 @@ CsmaSystemTestSuite::CsmaSystemTestSuite()
     AddTestCase(new CsmaPingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new CsmaRawIpSocketTestCase, TestCase::Duration::QUICK);
     AddTestCase(new CsmaStarTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CsmaDeliveryTestCase, TestCase::Duration::QUICK);
 }
 
 /// Do not forget to allocate an instance of this TestSuite
@@ -110,32 +110,19 @@ main(int argc, char* argv[])
 
     int totlinks = inFile->LinksSize();
 
-    NS_LOG_INFO("creating node containers");
-    auto nc = new NodeContainer[totlinks];
-    TopologyReader::ConstLinksIterator iter;
-    int i = 0;
-    for (iter = inFile->LinksBegin(); iter != inFile->LinksEnd(); iter++, i++)
-    {
-        nc[i] = NodeContainer(iter->GetFromNode(), iter->GetToNode());
-    }
-
-    NS_LOG_INFO("creating net device containers");
-    auto ndc = new NetDeviceContainer[totlinks];
+    NS_LOG_INFO("creating net devices");
     PointToPointHelper p2p;
-    for (int i = 0; i < totlinks; i++)
-    {
-        // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
-        p2p.SetChannelAttribute("Delay", StringValue("2ms"));
-        p2p.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
-        ndc[i] = p2p.Install(nc[i]);
-    }
+    // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
+    p2p.SetChannelAttribute("Delay", StringValue("2ms"));
+    p2p.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    NetDeviceContainer devices = inFile->InstallLinks(p2p);
 
     // it crates little subnets, one for each couple of nodes.
     NS_LOG_INFO("creating IPv4 interfaces");
     auto ipic = new Ipv4InterfaceContainer[totlinks];
     for (int i = 0; i < totlinks; i++)
     {
-        ipic[i] = address.Assign(ndc[i]);
+        ipic[i] = address.Assign(NetDeviceContainer(devices.Get(2 * i), devices.Get(2 * i + 1)));
         address.NewNetwork();
     }
 
@@ -192,8 +179,6 @@ main(int argc, char* argv[])
     Simulator::Destroy();
 
     delete[] ipic;
-    delete[] ndc;
-    delete[] nc;
 
     NS_LOG_INFO("Done.");
 
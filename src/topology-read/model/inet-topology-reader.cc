@@ -9,13 +9,15 @@
 
 #include "inet-topology-reader.h"
 
+#include "mapped-text-file.h"
+
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <charconv>
+#include <string_view>
+#include <unordered_map>
 
 /**
  * @file
@@ -52,20 +54,20 @@ InetTopologyReader::~InetTopologyReader()
 NodeContainer
 InetTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
+    MappedTextFile topgen;
+    std::unordered_map<std::string_view, Ptr<Node>> nodeMap;
     NodeContainer nodes;
 
-    if (!topgen.is_open())
+    if (!topgen.Open(GetFileName()))
     {
         NS_LOG_WARN("Inet topology file object is not open, check file name and permissions");
         return nodes;
     }
 
-    std::string from;
-    std::string to;
-    std::string linkAttr;
+    // the tokens are views of the file, which stays open while they are used
+    std::string_view from;
+    std::string_view to;
+    std::string_view linkAttr;
 
     int linksNumber = 0;
     int nodesNumber = 0;
@@ -73,64 +75,68 @@ InetTopologyReader::Read()
     int totnode = 0;
     int totlink = 0;
 
-    std::istringstream lineBuffer;
-    std::string line;
+    std::string_view line;
+    std::string_view token;
 
-    getline(topgen, line);
-    lineBuffer.str(line);
+    topgen.GetLine(line);
 
-    lineBuffer >> totnode;
-    lineBuffer >> totlink;
+    if (MappedTextFile::GetToken(line, token))
+    {
+        auto result = std::from_chars(token.data(), token.data() + token.size(), totnode);
+        if (result.ec == std::errc() && MappedTextFile::GetToken(line, token))
+        {
+            std::from_chars(token.data(), token.data() + token.size(), totlink);
+        }
+    }
     NS_LOG_INFO("Inet topology should have " << totnode << " nodes and " << totlink << " links");
-
-    for (int i = 0; i < totnode && !topgen.eof(); i++)
+    if (totlink > 0)
     {
-        getline(topgen, line);
+        ReserveLinks(totlink);
     }
 
-    for (int i = 0; i < totlink && !topgen.eof(); i++)
+    for (int i = 0; i < totnode && topgen.GetLine(line); i++)
     {
-        getline(topgen, line);
-        lineBuffer.clear();
-        lineBuffer.str(line);
+    }
 
-        lineBuffer >> from;
-        lineBuffer >> to;
-        lineBuffer >> linkAttr;
+    for (int i = 0; i < totlink && topgen.GetLine(line); i++)
+    {
+        // missing fields keep the value of the previous line
+        if (MappedTextFile::GetToken(line, from) && MappedTextFile::GetToken(line, to))
+        {
+            MappedTextFile::GetToken(line, linkAttr);
+        }
 
         if ((!from.empty()) && (!to.empty()))
         {
             NS_LOG_INFO("Link " << linksNumber << " from: " << from << " to: " << to);
 
-            if (!nodeMap[from])
+            Ptr<Node>& fromNode = nodeMap[from];
+            if (!fromNode)
             {
                 NS_LOG_INFO("Node " << nodesNumber << " name: " << from);
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodeName = "InetTopology/NodeName/" + from;
-                Names::Add(from, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
+                fromNode = CreateObject<Node>();
+                Names::Add(std::string(from), fromNode);
+                nodes.Add(fromNode);
                 nodesNumber++;
             }
 
-            if (!nodeMap[to])
+            Ptr<Node>& toNode = nodeMap[to];
+            if (!toNode)
             {
                 NS_LOG_INFO("Node " << nodesNumber << " name: " << to);
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "InetTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
+                toNode = CreateObject<Node>();
+                Names::Add("InetTopology/NodeName/" + std::string(to), toNode);
+                nodes.Add(toNode);
                 nodesNumber++;
             }
 
-            Link link(nodeMap[from], from, nodeMap[to], to);
+            Link link(fromNode, std::string(from), toNode, std::string(to));
             if (!linkAttr.empty())
             {
                 NS_LOG_INFO("Link " << linksNumber << " weight: " << linkAttr);
-                link.SetAttribute("Weight", linkAttr);
+                link.SetAttribute("Weight", std::string(linkAttr));
             }
-            AddLink(link);
+            AddLink(std::move(link));
 
             linksNumber++;
         }
@@ -138,7 +144,6 @@ InetTopologyReader::Read()
 
     NS_LOG_INFO("Inet topology created with " << nodesNumber << " nodes and " << linksNumber
                                               << " links");
-    topgen.close();
 
     return nodes;
 }
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mapped-text-file.h"
+
+#include "ns3/log.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::MappedTextFile implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MappedTextFile");
+
+/**
+ * @param c A character.
+ * @return True if the character is a whitespace in the "C" locale.
+ */
+static inline bool
+IsSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+MappedTextFile::MappedTextFile()
+    : m_data(nullptr),
+      m_size(0),
+      m_pos(0),
+      m_mapped(false),
+      m_open(false)
+{
+}
+
+MappedTextFile::~MappedTextFile()
+{
+    Close();
+}
+
+bool
+MappedTextFile::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    Close();
+
+#ifndef __WIN32__
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        if (st.st_size == 0)
+        {
+            close(fd);
+            m_open = true;
+            return true;
+        }
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            m_data = static_cast<const char*>(data);
+            m_size = st.st_size;
+            m_mapped = true;
+            m_open = true;
+            return true;
+        }
+        NS_LOG_LOGIC("Cannot map " << fileName << ", reading it");
+    }
+    close(fd);
+#endif
+
+    // not a regular file, or it cannot be mapped
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    m_copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_data = m_copy.data();
+    m_size = m_copy.size();
+    m_open = true;
+    return true;
+}
+
+void
+MappedTextFile::Close()
+{
+#ifndef __WIN32__
+    if (m_mapped)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_copy.clear();
+    m_copy.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+    m_pos = 0;
+    m_mapped = false;
+    m_open = false;
+}
+
+bool
+MappedTextFile::IsOpen() const
+{
+    return m_open;
+}
+
+bool
+MappedTextFile::GetLine(std::string_view& line)
+{
+    if (!m_open || m_pos > m_size)
+    {
+        return false;
+    }
+    std::string_view rest(m_data + m_pos, m_size - m_pos);
+    std::size_t end = rest.find('\n');
+    if (end == std::string_view::npos)
+    {
+        line = rest;
+        m_pos = m_size + 1;
+    }
+    else
+    {
+        line = rest.substr(0, end);
+        m_pos += end + 1;
+    }
+    return true;
+}
+
+bool
+MappedTextFile::GetToken(std::string_view& line, std::string_view& token)
+{
+    std::size_t start = 0;
+    while (start < line.size() && IsSpace(line[start]))
+    {
+        start++;
+    }
+    if (start == line.size())
+    {
+        line = std::string_view();
+        return false;
+    }
+    std::size_t end = start + 1;
+    while (end < line.size() && !IsSpace(line[end]))
+    {
+        end++;
+    }
+    token = line.substr(start, end - start);
+    line.remove_prefix(end);
+    return true;
+}
+
+} // namespace ns3
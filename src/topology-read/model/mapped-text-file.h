@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MAPPED_TEXT_FILE_H
+#define MAPPED_TEXT_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::MappedTextFile declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup topology
+ *
+ * @brief Read-only view of a whole text file, split in lines and tokens without copying them.
+ *
+ * The file is memory-mapped where the platform supports it, and read at once otherwise.
+ * The topology readers parse large Internet maps with it, instead of extracting every
+ * line and every field into a std::string through a stream.
+ */
+class MappedTextFile
+{
+  public:
+    MappedTextFile();
+    ~MappedTextFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MappedTextFile(const MappedTextFile&) = delete;
+    MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+    /**
+     * @brief Opens a file, closing the one previously opened.
+     * @param [in] fileName The name of the file.
+     * @return True if the file could be opened.
+     */
+    bool Open(const std::string& fileName);
+
+    /// @brief Closes the file.
+    void Close();
+
+    /**
+     * @brief Checks if a file is open.
+     * @return True if a file is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Returns the next line of the file.
+     *
+     * The line does not include its terminating '\\n'. As when calling
+     * std::getline until the end of the stream is reached, a file ending with
+     * a '\\n' has an empty last line, and an empty file has a single empty line.
+     *
+     * @param [out] line The line, valid until the file is closed.
+     * @return False if there are no more lines.
+     */
+    bool GetLine(std::string_view& line);
+
+    /**
+     * @brief Extracts the next token of a line, as operator>> would extract a std::string.
+     *
+     * The tokens are separated by whitespace characters.
+     *
+     * @param [in,out] line The line, from which the token and the whitespace
+     * characters before it are removed.
+     * @param [out] token The token.
+     * @return False if there are no more tokens, in which case the token is unchanged.
+     */
+    static bool GetToken(std::string_view& line, std::string_view& token);
+
+  private:
+    const char* m_data; //!< The content of the file.
+    std::size_t m_size; //!< The size of the file.
+    std::size_t m_pos;  //!< The position of the next line, past the end after the last one.
+    bool m_mapped;      //!< True if m_data is a memory mapping.
+    bool m_open;        //!< True if a file is open.
+    std::string m_copy; //!< The content of the file, when it is not memory-mapped.
+};
+
+} // namespace ns3
+
+#endif /* MAPPED_TEXT_FILE_H */
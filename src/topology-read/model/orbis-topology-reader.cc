@@ -9,13 +9,14 @@
 
 #include "orbis-topology-reader.h"
 
+#include "mapped-text-file.h"
+
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 /**
  * @file
@@ -53,68 +54,53 @@ OrbisTopologyReader::~OrbisTopologyReader()
 NodeContainer
 OrbisTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
+    MappedTextFile topgen;
+    std::unordered_map<std::string_view, Ptr<Node>> nodeMap;
     NodeContainer nodes;
 
-    if (!topgen.is_open())
+    if (!topgen.Open(GetFileName()))
     {
         return nodes;
     }
 
-    std::string from;
-    std::string to;
-    std::istringstream lineBuffer;
-    std::string line;
+    std::string_view line;
 
     int linksNumber = 0;
     int nodesNumber = 0;
 
-    while (!topgen.eof())
+    while (topgen.GetLine(line))
     {
-        line.clear();
-        lineBuffer.clear();
-        from.clear();
-        to.clear();
-
-        getline(topgen, line);
-        lineBuffer.str(line);
-        lineBuffer >> from;
-        lineBuffer >> to;
-
-        if ((!from.empty()) && (!to.empty()))
+        std::string_view from;
+        std::string_view to;
+        if (MappedTextFile::GetToken(line, from) && MappedTextFile::GetToken(line, to))
         {
             NS_LOG_INFO(linksNumber << " From: " << from << " to: " << to);
-            if (!nodeMap[from])
+            Ptr<Node>& fromNode = nodeMap[from];
+            if (!fromNode)
             {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "OrbisTopology/NodeName/" + from;
-                Names::Add(nodename, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
+                fromNode = CreateObject<Node>();
+                Names::Add("OrbisTopology/NodeName/" + std::string(from), fromNode);
+                nodes.Add(fromNode);
                 nodesNumber++;
             }
 
-            if (!nodeMap[to])
+            Ptr<Node>& toNode = nodeMap[to];
+            if (!toNode)
             {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "OrbisTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
+                toNode = CreateObject<Node>();
+                Names::Add("OrbisTopology/NodeName/" + std::string(to), toNode);
+                nodes.Add(toNode);
                 nodesNumber++;
             }
 
-            Link link(nodeMap[from], from, nodeMap[to], to);
-            AddLink(link);
+            Link link(fromNode, std::string(from), toNode, std::string(to));
+            AddLink(std::move(link));
 
             linksNumber++;
         }
     }
     NS_LOG_INFO("Orbis topology created with " << nodesNumber << " nodes and " << linksNumber
                                                << " links");
-    topgen.close();
 
     return nodes;
 }
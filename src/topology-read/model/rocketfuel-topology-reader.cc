@@ -8,15 +8,16 @@
 
 #include "rocketfuel-topology-reader.h"
 
+#include "mapped-text-file.h"
+
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
 #include <cstdlib>
-#include <fstream>
-#include <iostream>
 #include <regex>
 #include <string>
+#include <string_view>
 
 /**
  * @file
@@ -227,6 +228,7 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
             }
             NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << uid
                                       << " to: " << nuid);
+            m_links.insert(GetLinkKey(m_nodeMap[uid], m_nodeMap[nuid]));
             Link link(m_nodeMap[uid], uid, m_nodeMap[nuid], nuid);
             AddLink(link);
             m_linksNumber++;
@@ -282,20 +284,10 @@ RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>
         }
         NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << sname
                                   << " to: " << tname);
-        TopologyReader::ConstLinksIterator iter;
-        bool found = false;
-        for (iter = LinksBegin(); iter != LinksEnd(); iter++)
-        {
-            if ((iter->GetFromNode() == m_nodeMap[tname]) &&
-                (iter->GetToNode() == m_nodeMap[sname]))
-            {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found)
+        // the link may have been given in the other direction
+        if (m_links.count(GetLinkKey(m_nodeMap[tname], m_nodeMap[sname])) == 0)
         {
+            m_links.insert(GetLinkKey(m_nodeMap[sname], m_nodeMap[tname]));
             Link link(m_nodeMap[sname], sname, m_nodeMap[tname], tname);
             AddLink(link);
             m_linksNumber++;
@@ -327,37 +319,84 @@ RocketfuelTopologyReader::GetFileType(const std::string& line)
     return RF_UNKNOWN;
 }
 
+uint64_t
+RocketfuelTopologyReader::GetLinkKey(Ptr<Node> from, Ptr<Node> to)
+{
+    return (static_cast<uint64_t>(from->GetId()) << 32) | to->GetId();
+}
+
+/**
+ * @brief Splits a line of a weights file, which must match ROCKETFUEL_WEIGHTS_LINE.
+ *
+ * This is much faster than matching the regex on each line of large files.
+ *
+ * @param [in] line The line.
+ * @param [out] argv The source, destination and weight of the link.
+ * @return True if the line matches.
+ */
+static bool
+SplitWeightsLine(std::string_view line, std::vector<std::string>& argv)
+{
+    argv.clear();
+    std::size_t pos = 0;
+    while (argv.size() < 3)
+    {
+        if (argv.size() > 0)
+        {
+            // SPACE
+            std::size_t start = pos;
+            while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+            {
+                pos++;
+            }
+            if (pos == start)
+            {
+                return false;
+            }
+        }
+        std::size_t start = pos;
+        while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t')
+        {
+            pos++;
+        }
+        if (pos == start)
+        {
+            return false;
+        }
+        argv.emplace_back(line.substr(start, pos - start));
+    }
+    // ([0-9.]+) MAYSPACE END
+    if (argv[2].find_first_not_of("0123456789.") != std::string::npos)
+    {
+        return false;
+    }
+    return line.find_first_not_of(" \t", pos) == std::string_view::npos;
+}
+
 NodeContainer
 RocketfuelTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
+    MappedTextFile topgen;
     NodeContainer nodes;
 
-    std::istringstream lineBuffer;
-    std::string line;
+    std::string_view line;
     int lineNumber = 0;
     RF_FileType ftype = RF_UNKNOWN;
 
-    if (!topgen.is_open())
+    if (!topgen.Open(GetFileName()))
     {
         NS_LOG_WARN("Couldn't open the file " << GetFileName());
         return nodes;
     }
 
-    while (!topgen.eof())
+    std::vector<std::string> argv;
+    while (topgen.GetLine(line))
     {
-        std::vector<std::string> argv;
-
         lineNumber++;
-        line.clear();
-        lineBuffer.clear();
-
-        getline(topgen, line);
 
         if (lineNumber == 1)
         {
-            ftype = GetFileType(line);
+            ftype = GetFileType(std::string(line));
             if (ftype == RF_UNKNOWN)
             {
                 NS_LOG_INFO("Unknown File Format (" << GetFileName() << ")");
@@ -365,48 +404,31 @@ RocketfuelTopologyReader::Read()
             }
         }
 
-        std::smatch matches;
-
         if (ftype == RF_MAPS)
         {
-            bool ret = std::regex_match(line, matches, rocketfuel_maps_regex);
+            std::string buf(line);
+            std::smatch matches;
+            bool ret = std::regex_match(buf, matches, rocketfuel_maps_regex);
             if (!ret || matches.empty())
             {
                 NS_LOG_WARN("match failed (maps file): %s" << line);
                 break;
             }
-        }
-        else if (ftype == RF_WEIGHTS)
-        {
-            bool ret = std::regex_match(line, matches, rocketfuel_weights_regex);
-            if (!ret || matches.empty())
-            {
-                NS_LOG_WARN("match failed (weights file): %s" << line);
-                break;
-            }
-        }
-
-        std::string matched_string;
 
-        for (auto it = matches.begin() + 1; it != matches.end(); it++)
-        {
-            if (it->matched)
+            argv.clear();
+            for (auto it = matches.begin() + 1; it != matches.end(); it++)
             {
-                matched_string = it->str();
+                argv.push_back(it->matched ? it->str() : "");
             }
-            else
-            {
-                matched_string = "";
-            }
-            argv.push_back(matched_string);
-        }
-
-        if (ftype == RF_MAPS)
-        {
             nodes.Add(GenerateFromMapsFile(argv));
         }
         else if (ftype == RF_WEIGHTS)
         {
+            if (!SplitWeightsLine(line, argv))
+            {
+                NS_LOG_WARN("match failed (weights file): %s" << line);
+                break;
+            }
             nodes.Add(GenerateFromWeightsFile(argv));
         }
         else
@@ -415,8 +437,6 @@ RocketfuelTopologyReader::Read()
         }
     }
 
-    topgen.close();
-
     return nodes;
 }
 
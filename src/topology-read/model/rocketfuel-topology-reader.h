@@ -11,6 +11,12 @@
 
 #include "topology-reader.h"
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 /**
  * @file
  * @ingroup topology
@@ -102,9 +108,18 @@ class RocketfuelTopologyReader : public TopologyReader
      */
     RF_FileType GetFileType(const std::string& buf);
 
-    int m_linksNumber;                          //!< Number of links.
-    int m_nodesNumber;                          //!< Number of nodes.
-    std::map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
+    /**
+     * @brief Returns the key of a link in m_links.
+     * @param [in] from The node the link originates from.
+     * @param [in] to The node the link is directed to.
+     * @return The key of the link.
+     */
+    static uint64_t GetLinkKey(Ptr<Node> from, Ptr<Node> to);
+
+    int m_linksNumber;                                    //!< Number of links.
+    int m_nodesNumber;                                    //!< Number of nodes.
+    std::unordered_map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
+    std::unordered_set<uint64_t> m_links;                 //!< Keys of the links added.
 
     // end class RocketfuelTopologyReader
 };
@@ -11,6 +11,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <limits>
+
 /**
  * @file
  * @ingroup topology
@@ -83,7 +86,70 @@ TopologyReader::LinksEmpty() const
 void
 TopologyReader::AddLink(Link link)
 {
-    m_linksList.push_back(link);
+    m_linksList.push_back(std::move(link));
+}
+
+void
+TopologyReader::ReserveLinks(std::size_t n)
+{
+    m_linksList.reserve(m_linksList.size() + n);
+}
+
+TopologyReader::Adjacency
+TopologyReader::GetAdjacency(const NodeContainer& nodes) const
+{
+    NS_LOG_FUNCTION(this);
+    constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    // index of the nodes in the container, by node id
+    uint32_t maxId = 0;
+    for (auto it = nodes.Begin(); it != nodes.End(); it++)
+    {
+        maxId = std::max(maxId, (*it)->GetId());
+    }
+    std::vector<uint32_t> index(nodes.GetN() > 0 ? maxId + 1 : 0, NONE);
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        index[nodes.Get(i)->GetId()] = i;
+    }
+    auto getIndex = [&index](const Ptr<Node>& node) {
+        uint32_t id = node->GetId();
+        return id < index.size() ? index[id] : NONE;
+    };
+
+    // count the neighbors of each node, then place them
+    Adjacency adjacency;
+    adjacency.offsets.assign(nodes.GetN() + 1, 0);
+    for (const auto& link : m_linksList)
+    {
+        uint32_t from = getIndex(link.GetFromNode());
+        uint32_t to = getIndex(link.GetToNode());
+        if (from != NONE && to != NONE)
+        {
+            adjacency.offsets[from + 1]++;
+            adjacency.offsets[to + 1]++;
+        }
+    }
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        adjacency.offsets[i + 1] += adjacency.offsets[i];
+    }
+    adjacency.neighbors.resize(adjacency.offsets.back());
+    adjacency.links.resize(adjacency.offsets.back());
+    std::vector<uint32_t> next(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (uint32_t l = 0; l < m_linksList.size(); l++)
+    {
+        uint32_t from = getIndex(m_linksList[l].GetFromNode());
+        uint32_t to = getIndex(m_linksList[l].GetToNode());
+        if (from != NONE && to != NONE)
+        {
+            adjacency.neighbors[next[from]] = to;
+            adjacency.links[next[from]++] = l;
+            adjacency.neighbors[next[to]] = from;
+            adjacency.links[next[to]++] = l;
+        }
+    }
+    return adjacency;
 }
 
 TopologyReader::Link::Link(Ptr<Node> fromPtr,
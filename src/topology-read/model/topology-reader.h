@@ -10,12 +10,15 @@
 #ifndef TOPOLOGY_READER_H
 #define TOPOLOGY_READER_H
 
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
 #include "ns3/node.h"
 #include "ns3/object.h"
 
-#include <list>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -26,8 +29,6 @@
 namespace ns3
 {
 
-class NodeContainer;
-
 /**
  * @ingroup topology
  *
@@ -130,7 +131,23 @@ class TopologyReader : public Object
     /**
      * @brief Constant iterator to the list of the links.
      */
-    typedef std::list<Link>::const_iterator ConstLinksIterator;
+    typedef std::vector<Link>::const_iterator ConstLinksIterator;
+
+    /**
+     * @brief Adjacency of the nodes, in compressed sparse row format.
+     *
+     * The nodes are identified by their index in the container given to
+     * GetAdjacency(), and the links by their position in the list of links.
+     * The neighbors of node i are neighbors[offsets[i]] to
+     * neighbors[offsets[i + 1] - 1], connected to it by the links with the
+     * same indices in links. Each link appears in the adjacency of both its nodes.
+     */
+    struct Adjacency
+    {
+        std::vector<uint32_t> offsets;   //!< Start of the neighbors of each node, and their end.
+        std::vector<uint32_t> neighbors; //!< Index of the neighbors of the nodes.
+        std::vector<uint32_t> links;     //!< Index of the links to the neighbors.
+    };
 
     /**
      * @brief Get the type ID.
@@ -200,6 +217,36 @@ class TopologyReader : public Object
      */
     void AddLink(Link link);
 
+    /**
+     * @brief Builds the adjacency of the nodes from the links.
+     *
+     * The links between nodes that are not in the container are ignored.
+     *
+     * @param [in] nodes The nodes, usually the container returned by Read().
+     * @return The adjacency of the nodes.
+     */
+    Adjacency GetAdjacency(const NodeContainer& nodes) const;
+
+    /**
+     * @brief Installs a device on both nodes of each link.
+     *
+     * This is a shortcut for calling the Install(NodeContainer) method of the
+     * helper on the two nodes of each link, e.g., with a PointToPointHelper.
+     *
+     * @tparam Helper \deduced The type of the helper.
+     * @param [in] helper The helper installing the devices.
+     * @return The devices, the two devices of link i being at positions 2i and 2i + 1.
+     */
+    template <typename Helper>
+    NetDeviceContainer InstallLinks(Helper& helper) const;
+
+  protected:
+    /**
+     * @brief Reserves room for the links of the topology, when it is known in advance.
+     * @param [in] n The number of links to be added.
+     */
+    void ReserveLinks(std::size_t n);
+
   private:
     /**
      * The name of the input file.
@@ -209,11 +256,27 @@ class TopologyReader : public Object
     /**
      * The container of the links between the nodes.
      */
-    std::list<Link> m_linksList;
+    std::vector<Link> m_linksList;
 
     // end class TopologyReader
 };
 
+/*************************************************
+ **  Template implementation
+ ************************************************/
+
+template <typename Helper>
+NetDeviceContainer
+TopologyReader::InstallLinks(Helper& helper) const
+{
+    NetDeviceContainer devices;
+    for (const auto& link : m_linksList)
+    {
+        devices.Add(helper.Install(NodeContainer(link.GetFromNode(), link.GetToNode())));
+    }
+    return devices;
+}
+
 // end namespace ns3
 }; // namespace ns3
 
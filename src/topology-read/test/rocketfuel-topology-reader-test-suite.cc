@@ -13,12 +13,18 @@
 #include "ns3/abort.h"
 #include "ns3/attribute.h"
 #include "ns3/log.h"
+#include "ns3/names.h"
 #include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
 #include "ns3/object-factory.h"
+#include "ns3/orbis-topology-reader.h"
 #include "ns3/rocketfuel-topology-reader.h"
+#include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -120,6 +126,85 @@ RocketfuelTopologyReaderMapsTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup topology-test
+ * @brief Topology Reader Adjacency Test
+ *
+ * Checks the adjacency of the nodes and the devices installed on the links
+ * of the Orbis sample file against its list of links.
+ */
+class TopologyReaderAdjacencyTest : public TestCase
+{
+  public:
+    TopologyReaderAdjacencyTest();
+
+  private:
+    void DoRun() override;
+};
+
+TopologyReaderAdjacencyTest::TopologyReaderAdjacencyTest()
+    : TestCase("TopologyReaderAdjacencyTest")
+{
+}
+
+void
+TopologyReaderAdjacencyTest::DoRun()
+{
+    std::string input("./src/topology-read/examples/Orbis_toposample.txt");
+
+    // the labels of the nodes may have been given to the nodes of another topology
+    Names::Clear();
+    Ptr<OrbisTopologyReader> inFile = CreateObject<OrbisTopologyReader>();
+    inFile->SetFileName(input);
+    NodeContainer nodes = inFile->Read();
+
+    NS_TEST_EXPECT_MSG_EQ(nodes.GetN(), 1423, "nodes");
+    NS_TEST_ASSERT_MSG_EQ(inFile->LinksSize(), 2769, "links");
+
+    // only the first node of the container
+    TopologyReader::Adjacency first = inFile->GetAdjacency(NodeContainer(nodes.Get(0)));
+    NS_TEST_EXPECT_MSG_EQ(first.offsets.size(), 2, "offsets of a single node");
+    NS_TEST_EXPECT_MSG_EQ(first.neighbors.size(), 0, "no link between the node and itself");
+
+    TopologyReader::Adjacency adjacency = inFile->GetAdjacency(nodes);
+    NS_TEST_ASSERT_MSG_EQ(adjacency.offsets.size(), nodes.GetN() + 1, "offsets");
+    NS_TEST_ASSERT_MSG_EQ(adjacency.neighbors.size(), 2 * 2769, "both nodes of each link");
+    NS_TEST_ASSERT_MSG_EQ(adjacency.links.size(), 2 * 2769, "both nodes of each link");
+
+    std::vector<uint32_t> seen(inFile->LinksSize(), 0);
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        for (uint32_t j = adjacency.offsets[i]; j < adjacency.offsets[i + 1]; j++)
+        {
+            const auto& link = *(inFile->LinksBegin() + adjacency.links[j]);
+            Ptr<Node> node = nodes.Get(i);
+            Ptr<Node> neighbor = nodes.Get(adjacency.neighbors[j]);
+            bool match = (link.GetFromNode() == node && link.GetToNode() == neighbor) ||
+                         (link.GetFromNode() == neighbor && link.GetToNode() == node);
+            NS_TEST_ASSERT_MSG_EQ(match, true, "link " << adjacency.links[j] << " of node " << i);
+            seen[adjacency.links[j]]++;
+        }
+    }
+    for (uint32_t l = 0; l < seen.size(); l++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(seen[l], 2, "link " << l << " should be seen from both nodes");
+    }
+
+    SimpleNetDeviceHelper helper;
+    NetDeviceContainer devices = inFile->InstallLinks(helper);
+    NS_TEST_ASSERT_MSG_EQ(devices.GetN(), 2 * 2769, "two devices per link");
+    uint32_t l = 0;
+    for (auto link = inFile->LinksBegin(); link != inFile->LinksEnd(); link++, l++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(devices.Get(2 * l)->GetNode(), link->GetFromNode(), "from device");
+        NS_TEST_EXPECT_MSG_EQ(devices.Get(2 * l + 1)->GetNode(), link->GetToNode(), "to device");
+        NS_TEST_EXPECT_MSG_EQ(devices.Get(2 * l)->GetChannel(),
+                              devices.Get(2 * l + 1)->GetChannel(),
+                              "devices of a link on the same channel");
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup topology-test
  *
@@ -138,6 +223,7 @@ RocketfuelTopologyReaderTestSuite::RocketfuelTopologyReaderTestSuite()
 {
     AddTestCase(new RocketfuelTopologyReaderWeightsTest(), TestCase::Duration::QUICK);
     AddTestCase(new RocketfuelTopologyReaderMapsTest(), TestCase::Duration::QUICK);
+    AddTestCase(new TopologyReaderAdjacencyTest(), TestCase::Duration::QUICK);
 }
 
 /**
@@ -44,19 +44,6 @@ ReciprocalDivide(uint32_t A, uint32_t R)
 
 /* end kernel borrowings */
 
-/**
- * Returns the current time translated in CoDel time representation
- * @return the current time
- */
-static uint32_t
-CoDelGetTime()
-{
-    Time time = Simulator::Now();
-    uint64_t ns = time.GetNanoSeconds();
-
-    return static_cast<uint32_t>(ns >> CODEL_SHIFT);
-}
-
 NS_OBJECT_ENSURE_REGISTERED(CoDelQueueDisc);
 
 TypeId
@@ -184,7 +171,7 @@ CoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 }
 
 bool
-CoDelQueueDisc::OkToDrop(Ptr<QueueDiscItem> item, uint32_t now)
+CoDelQueueDisc::OkToDrop(Ptr<QueueDiscItem> item, uint32_t now, Time curTime)
 {
     NS_LOG_FUNCTION(this);
     bool okToDrop;
@@ -195,7 +182,7 @@ CoDelQueueDisc::OkToDrop(Ptr<QueueDiscItem> item, uint32_t now)
         return false;
     }
 
-    Time delta = Simulator::Now() - item->GetTimeStamp();
+    Time delta = curTime - item->GetTimeStamp();
     NS_LOG_INFO("Sojourn time " << delta.As(Time::MS));
     uint32_t sojournTime = Time2CoDel(delta);
 
@@ -240,7 +227,9 @@ CoDelQueueDisc::DoDequeue()
         NS_LOG_LOGIC("Queue empty");
         return nullptr;
     }
-    uint32_t ldelay = Time2CoDel(Simulator::Now() - item->GetTimeStamp());
+    // the current time is read once per dequeue
+    const Time curTime = Simulator::Now();
+    uint32_t ldelay = Time2CoDel(curTime - item->GetTimeStamp());
     if (item && m_useL4s)
     {
         uint8_t tosByte = 0;
@@ -265,14 +254,14 @@ CoDelQueueDisc::DoDequeue()
         }
     }
 
-    uint32_t now = CoDelGetTime();
+    uint32_t now = Time2CoDel(curTime);
 
     NS_LOG_LOGIC("Popped " << item);
     NS_LOG_LOGIC("Number packets remaining " << GetInternalQueue(0)->GetNPackets());
     NS_LOG_LOGIC("Number bytes remaining " << GetInternalQueue(0)->GetNBytes());
 
     // Determine if item should be dropped
-    bool okToDrop = OkToDrop(item, now);
+    bool okToDrop = OkToDrop(item, now, curTime);
     bool isMarked = false;
 
     if (m_dropping)
@@ -323,7 +312,7 @@ CoDelQueueDisc::DoDequeue()
                     NS_LOG_LOGIC("Number bytes remaining " << GetInternalQueue(0)->GetNBytes());
                 }
 
-                if (!OkToDrop(item, now))
+                if (!OkToDrop(item, now, curTime))
                 {
                     /* leave dropping state */
                     NS_LOG_LOGIC("Leaving dropping state");
@@ -367,7 +356,7 @@ CoDelQueueDisc::DoDequeue()
                     NS_LOG_LOGIC("Number packets remaining " << GetInternalQueue(0)->GetNPackets());
                     NS_LOG_LOGIC("Number bytes remaining " << GetInternalQueue(0)->GetNBytes());
                 }
-                OkToDrop(item, now);
+                OkToDrop(item, now, curTime);
             }
             m_dropping = true;
             /*
@@ -394,7 +383,7 @@ CoDelQueueDisc::DoDequeue()
         }
     }
 end:
-    ldelay = Time2CoDel(Simulator::Now() - item->GetTimeStamp());
+    ldelay = Time2CoDel(curTime - item->GetTimeStamp());
     // In Linux, this branch of code is executed even if the packet has been marked
     // according to the target delay above. If the ns-3 code were to do the same here,
     // it would result in two counts of mark in the queue statistics. Therefore, we
@@ -152,10 +152,11 @@ class CoDelQueueDisc : public QueueDisc
      *
      * @param item The packet that is considered
      * @param now The current time represented as 32-bit unsigned integer (us)
+     * @param curTime The current time
      * @returns True if it is OK to drop the packet (sojourn time above target for at least
      * interval)
      */
-    bool OkToDrop(Ptr<QueueDiscItem> item, uint32_t now);
+    bool OkToDrop(Ptr<QueueDiscItem> item, uint32_t now, Time curTime);
 
     /**
      * Check if CoDel time a is successive to b
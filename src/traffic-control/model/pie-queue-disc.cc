@@ -279,16 +279,17 @@ PieQueueDisc::DropEarly(Ptr<QueueDiscItem> item, uint32_t qSize)
     double p = m_dropProb;
 
     uint32_t packetSize = item->GetSize();
+    QueueSizeUnit unit = GetMaxSize().GetUnit();
 
-    if (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES)
+    if (unit == QueueSizeUnit::BYTES)
     {
         p = p * packetSize / m_meanPktSize;
     }
 
     // Safeguard PIE to be work conserving (Section 4.1 of RFC 8033)
     if ((m_qDelayOld.GetSeconds() < (0.5 * m_qDelayRef.GetSeconds()) && m_dropProb < 0.2) ||
-        (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES && qSize <= 2 * m_meanPktSize) ||
-        (GetMaxSize().GetUnit() == QueueSizeUnit::PACKETS && qSize <= 2))
+        (unit == QueueSizeUnit::BYTES && qSize <= 2 * m_meanPktSize) ||
+        (unit == QueueSizeUnit::PACKETS && qSize <= 2))
     {
         return false;
     }
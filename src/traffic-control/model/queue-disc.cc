@@ -841,6 +841,46 @@ QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
 {
     NS_LOG_FUNCTION(this << item);
 
+    bool retval = EnqueueItem(item, Simulator::Now());
+
+    // check that the received packet was either enqueued or dropped
+    NS_ASSERT(m_stats.nTotalReceivedPackets ==
+              m_stats.nTotalDroppedPacketsBeforeEnqueue + m_stats.nTotalEnqueuedPackets);
+    NS_ASSERT(m_stats.nTotalReceivedBytes ==
+              m_stats.nTotalDroppedBytesBeforeEnqueue + m_stats.nTotalEnqueuedBytes);
+
+    return retval;
+}
+
+uint32_t
+QueueDisc::EnqueueBatch(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    Time now = Simulator::Now();
+    uint32_t nEnqueued = 0;
+    for (const auto& item : items)
+    {
+        if (EnqueueItem(item, now))
+        {
+            nEnqueued++;
+        }
+    }
+
+    // check that the received packets were either enqueued or dropped
+    NS_ASSERT(m_stats.nTotalReceivedPackets ==
+              m_stats.nTotalDroppedPacketsBeforeEnqueue + m_stats.nTotalEnqueuedPackets);
+    NS_ASSERT(m_stats.nTotalReceivedBytes ==
+              m_stats.nTotalDroppedBytesBeforeEnqueue + m_stats.nTotalEnqueuedBytes);
+
+    return nEnqueued;
+}
+
+bool
+QueueDisc::EnqueueItem(Ptr<QueueDiscItem> item, Time now)
+{
+    NS_LOG_FUNCTION(this << item << now);
+
     m_stats.nTotalReceivedPackets++;
     m_stats.nTotalReceivedBytes += item->GetSize();
 
@@ -848,7 +888,7 @@ QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
 
     if (retval)
     {
-        item->SetTimeStamp(Simulator::Now());
+        item->SetTimeStamp(now);
     }
 
     // DoEnqueue may return false because:
@@ -862,12 +902,6 @@ QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
     //    -> DoEnqueue has to explicitly call DropBeforeEnqueue
     // Thus, we do not have to call DropBeforeEnqueue here.
 
-    // check that the received packet was either enqueued or dropped
-    NS_ASSERT(m_stats.nTotalReceivedPackets ==
-              m_stats.nTotalDroppedPacketsBeforeEnqueue + m_stats.nTotalEnqueuedPackets);
-    NS_ASSERT(m_stats.nTotalReceivedBytes ==
-              m_stats.nTotalDroppedBytesBeforeEnqueue + m_stats.nTotalEnqueuedBytes);
-
     return retval;
 }
 
@@ -905,6 +939,25 @@ QueueDisc::Dequeue()
     return item;
 }
 
+uint32_t
+QueueDisc::DequeueBatch(uint32_t maxItems, std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << maxItems);
+
+    uint32_t nDequeued = 0;
+    while (nDequeued < maxItems)
+    {
+        Ptr<QueueDiscItem> item = Dequeue();
+        if (!item)
+        {
+            break;
+        }
+        items.push_back(item);
+        nDequeued++;
+    }
+    return nDequeued;
+}
+
 Ptr<const QueueDiscItem>
 QueueDisc::Peek()
 {
@@ -388,6 +388,15 @@ class QueueDisc : public Object
      */
     bool Enqueue(Ptr<QueueDiscItem> item);
 
+    /**
+     * Pass several packets to store to the queue discipline, in order. This is
+     * equivalent to calling Enqueue for each of them, except that the current
+     * time, which the enqueued items are stamped with, is read only once.
+     * @param items the items to enqueue
+     * @return the number of items that were enqueued
+     */
+    uint32_t EnqueueBatch(const std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * Extract from the queue disc the packet that has been dequeued by calling
      * Peek, if any, or call the private DoDequeue method (which must be
@@ -397,6 +406,16 @@ class QueueDisc : public Object
      */
     Ptr<QueueDiscItem> Dequeue();
 
+    /**
+     * Extract up to a number of packets from the queue disc, by calling Dequeue
+     * until it fails or the given number of packets is reached.
+     *
+     * @param maxItems the maximum number of items to dequeue
+     * @param [out] items the vector the dequeued items are appended to
+     * @return the number of items dequeued
+     */
+    uint32_t DequeueBatch(uint32_t maxItems, std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * Get a copy of the next packet the queue discipline will extract. This
      * function only calls the (private) DoPeek function. This base class provides
@@ -659,6 +678,15 @@ class QueueDisc : public Object
      */
     bool Transmit(Ptr<QueueDiscItem> item);
 
+    /**
+     * Update the statistics and call DoEnqueue for an item, and stamp the item
+     * with the given time if it is enqueued.
+     * @param item item to enqueue
+     * @param now the current time
+     * @return True if the operation was successful; false otherwise
+     */
+    bool EnqueueItem(Ptr<QueueDiscItem> item, Time now);
+
     /**
      * @brief Perform the actions required when the queue disc is notified of
      *        a packet enqueue
@@ -215,7 +215,8 @@ RedQueueDisc::GetTypeId()
 }
 
 RedQueueDisc::RedQueueDisc()
-    : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
+    : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE),
+      m_decayWeight(0)
 {
     NS_LOG_FUNCTION(this);
     m_uv = CreateObject<UniformRandomVariable>();
@@ -544,6 +545,14 @@ RedQueueDisc::InitializeParams()
         m_qW = 1.0 - std::exp(-10.0 / m_ptc);
     }
 
+    // decay of the average queue size after up to 255 (idle) arrivals
+    m_decayWeight = m_qW;
+    m_decay.resize(256);
+    for (uint32_t k = 0; k < m_decay.size(); k++)
+    {
+        m_decay[k] = std::pow(1.0 - m_qW, k);
+    }
+
     if (m_bottom == 0)
     {
         m_bottom = 0.01;
@@ -623,11 +632,13 @@ RedQueueDisc::Estimator(uint32_t nQueued, uint32_t m, double qAvg, double qW)
 {
     NS_LOG_FUNCTION(this << nQueued << m << qAvg << qW);
 
-    double newAve = qAvg * std::pow(1.0 - qW, m);
+    // the decay of the average over m arrivals is looked up, rather than
+    // computed, unless the queue weight changed or the idle period was long
+    double decay = (qW == m_decayWeight && m < m_decay.size()) ? m_decay[m] : std::pow(1.0 - qW, m);
+    double newAve = qAvg * decay;
     newAve += qW * nQueued;
 
-    Time now = Simulator::Now();
-    if (m_isAdaptMaxP && now > m_lastSet + m_interval)
+    if (m_isAdaptMaxP && Simulator::Now() > m_lastSet + m_interval)
     {
         UpdateMaxP(newAve);
     }
@@ -56,6 +56,10 @@
 #include "ns3/nstime.h"
 #include "ns3/random-variable-stream.h"
 
+#include <vector>
+
+class RedQueueDiscEstimatorTestCase; // Forward declaration for unit test
+
 namespace ns3
 {
 
@@ -196,6 +200,7 @@ class RedQueueDisc : public QueueDisc
     void DoDispose() override;
 
   private:
+    friend class ::RedQueueDiscEstimatorTestCase; // Test code
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     Ptr<const QueueDiscItem> DoPeek() override;
@@ -300,6 +305,9 @@ class RedQueueDisc : public QueueDisc
      */
     uint32_t m_cautious;
     Time m_idleTime; //!< Start of current idle period
+    /// Powers of (1 - m_decayWeight) used by Estimator, indexed by the exponent
+    std::vector<double> m_decay;
+    double m_decayWeight; //!< Queue weight of the m_decay table
 
     Ptr<UniformRandomVariable> m_uv; //!< rng stream
 };
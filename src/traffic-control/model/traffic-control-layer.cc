@@ -15,6 +15,7 @@
 #include "ns3/packet.h"
 #include "ns3/socket.h"
 
+#include <algorithm>
 #include <tuple>
 
 namespace ns3
@@ -409,4 +410,65 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
     }
 }
 
+void
+TrafficControlLayer::SendBatch(Ptr<NetDevice> device, const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << device << items.size());
+
+    auto ndi = m_netDevices.find(device);
+
+    if (ndi == m_netDevices.end() || !ndi->second.m_rootQueueDisc)
+    {
+        for (const auto& item : items)
+        {
+            Send(device, item);
+        }
+        return;
+    }
+
+    Ptr<NetDeviceQueueInterface> devQueueIface = ndi->second.m_ndqi;
+
+    // Enqueue the consecutive packets sharing a queue disc at once, then try to
+    // dequeue packets from each queue disc that received packets
+    std::vector<Ptr<QueueDisc>> queueDiscs;
+    std::vector<Ptr<QueueDiscItem>> batch;
+    Ptr<QueueDisc> batchQueueDisc;
+    for (const auto& item : items)
+    {
+        std::size_t txq = 0;
+        if (devQueueIface && devQueueIface->GetNTxQueues() > 1)
+        {
+            txq = devQueueIface->GetSelectQueueCallback()(item);
+        }
+        NS_ASSERT(!devQueueIface || txq < devQueueIface->GetNTxQueues());
+        item->SetTxQueueIndex(txq);
+
+        Ptr<QueueDisc> qDisc = ndi->second.m_queueDiscsToWake[txq];
+        NS_ASSERT(qDisc);
+        if (qDisc != batchQueueDisc)
+        {
+            if (!batch.empty())
+            {
+                batchQueueDisc->EnqueueBatch(batch);
+                batch.clear();
+            }
+            if (std::find(queueDiscs.begin(), queueDiscs.end(), qDisc) == queueDiscs.end())
+            {
+                queueDiscs.push_back(qDisc);
+            }
+            batchQueueDisc = qDisc;
+        }
+        batch.push_back(item);
+    }
+    if (!batch.empty())
+    {
+        batchQueueDisc->EnqueueBatch(batch);
+    }
+
+    for (const auto& qDisc : queueDiscs)
+    {
+        qDisc->Run();
+    }
+}
+
 } // namespace ns3
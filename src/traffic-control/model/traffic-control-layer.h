@@ -200,6 +200,25 @@ class TrafficControlLayer : public Object
      */
     virtual void Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item);
 
+    /**
+     * @brief Called from upper layer to queue several packets for the transmission.
+     *
+     * If the device has no queue disc, this is equivalent to calling Send for
+     * each packet. Otherwise, all the packets are enqueued in the queue discs
+     * of their transmission queues, with QueueDisc::EnqueueBatch, before
+     * packets are dequeued from each of these queue discs and sent to the
+     * device, which may then write them to its channel in a batch.
+     *
+     * Unlike repeated calls to Send, which dequeue packets after enqueuing
+     * each of them, the whole burst is enqueued before Run is called on the
+     * queue discs. A queue disc close to its limit therefore drops more
+     * packets than with Send.
+     *
+     * @param device the device the packets must be sent to
+     * @param items the queue items including the packets and additional information
+     */
+    virtual void SendBatch(Ptr<NetDevice> device, const std::vector<Ptr<QueueDiscItem>>& items);
+
   protected:
     void DoDispose() override;
     void DoInitialize() override;
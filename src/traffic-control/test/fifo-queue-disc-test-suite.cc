@@ -254,6 +254,83 @@ FifoQueueDiscTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Fifo Queue Disc Batch Test Case
+ *
+ * Checks that QueueDisc::EnqueueBatch and QueueDisc::DequeueBatch behave as
+ * repeated calls to Enqueue and Dequeue.
+ */
+class FifoQueueDiscBatchTestCase : public TestCase
+{
+  public:
+    FifoQueueDiscBatchTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Enqueue and dequeue batches of packets
+     * @param q the queue disc, with room for 10 packets
+     */
+    void RunBatchTest(Ptr<FifoQueueDisc> q);
+};
+
+FifoQueueDiscBatchTestCase::FifoQueueDiscBatchTestCase()
+    : TestCase("Check the batch enqueue and dequeue of the queue discs")
+{
+}
+
+void
+FifoQueueDiscBatchTestCase::RunBatchTest(Ptr<FifoQueueDisc> q)
+{
+    Address dest;
+    std::vector<Ptr<QueueDiscItem>> items;
+    std::vector<uint64_t> uids;
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(100);
+        uids.push_back(p->GetUid());
+        items.push_back(Create<FifoQueueDiscTestItem>(p, dest));
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(q->EnqueueBatch(items), 10, "Only 10 packets should have been enqueued");
+    NS_TEST_ASSERT_MSG_EQ(q->GetNPackets(), 10, "There should be 10 packets in there");
+    NS_TEST_ASSERT_MSG_EQ(q->GetStats().nTotalReceivedPackets,
+                          12,
+                          "12 packets should have been received");
+    NS_TEST_ASSERT_MSG_EQ(q->GetStats().nTotalDroppedPacketsBeforeEnqueue,
+                          2,
+                          "2 packets should have been dropped");
+
+    items.clear();
+    NS_TEST_ASSERT_MSG_EQ(q->DequeueBatch(4, items), 4, "4 packets should have been dequeued");
+    NS_TEST_ASSERT_MSG_EQ(q->DequeueBatch(100, items), 6, "6 packets should have been dequeued");
+    NS_TEST_ASSERT_MSG_EQ(q->DequeueBatch(100, items), 0, "The queue disc should be empty");
+    NS_TEST_ASSERT_MSG_EQ(items.size(), 10, "10 packets should have been dequeued");
+    for (uint32_t i = 0; i < items.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(items[i]->GetPacket()->GetUid(),
+                              uids[i],
+                              "was this the right packet?");
+        NS_TEST_ASSERT_MSG_EQ(items[i]->GetTimeStamp(),
+                              Seconds(1),
+                              "The packet should have been stamped with the enqueue time");
+    }
+}
+
+void
+FifoQueueDiscBatchTestCase::DoRun()
+{
+    Ptr<FifoQueueDisc> queue = CreateObject<FifoQueueDisc>();
+    queue->SetAttribute("MaxSize", QueueSizeValue(QueueSize("10p")));
+    queue->Initialize();
+
+    Simulator::Schedule(Seconds(1), &FifoQueueDiscBatchTestCase::RunBatchTest, this, queue);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -266,5 +343,6 @@ static class FifoQueueDiscTestSuite : public TestSuite
         : TestSuite("fifo-queue-disc", Type::UNIT)
     {
         AddTestCase(new FifoQueueDiscTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new FifoQueueDiscBatchTestCase(), TestCase::Duration::QUICK);
     }
 } g_fifoQueueTestSuite; ///< the test suite
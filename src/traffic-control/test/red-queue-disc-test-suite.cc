@@ -17,6 +17,8 @@
 #include "ns3/test.h"
 #include "ns3/uinteger.h"
 
+#include <cmath>
+
 using namespace ns3;
 
 /**
@@ -602,6 +604,56 @@ RedQueueDiscTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Check that the average queue sizes computed with the table of the
+ * decay of the average are identical to those computed with std::pow
+ */
+class RedQueueDiscEstimatorTestCase : public TestCase
+{
+  public:
+    RedQueueDiscEstimatorTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RedQueueDiscEstimatorTestCase::RedQueueDiscEstimatorTestCase()
+    : TestCase("Check the average queue sizes computed with the decay table")
+{
+}
+
+void
+RedQueueDiscEstimatorTestCase::DoRun()
+{
+    Ptr<RedQueueDisc> queue = CreateObject<RedQueueDisc>();
+    queue->SetAttribute("QW", DoubleValue(0.002));
+    queue->Initialize();
+
+    // the table holds the decay for up to 255 arrivals with the weight of the
+    // queue; longer idle periods and other weights are computed with std::pow
+    for (double qW : {0.002, 0.1})
+    {
+        for (double qAvg : {0.0, 0.37, 3.5, 12.25})
+        {
+            for (uint32_t m = 0; m < 300; m++)
+            {
+                for (uint32_t nQueued : {0, 1, 7})
+                {
+                    double expected = qAvg * std::pow(1.0 - qW, m);
+                    expected += qW * nQueued;
+                    NS_TEST_ASSERT_MSG_EQ(queue->Estimator(nQueued, m, qAvg, qW),
+                                          expected,
+                                          "Wrong average for qW=" << qW << " qAvg=" << qAvg
+                                                                  << " m=" << m);
+                }
+            }
+        }
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -614,5 +666,6 @@ static class RedQueueDiscTestSuite : public TestSuite
         : TestSuite("red-queue-disc", Type::UNIT)
     {
         AddTestCase(new RedQueueDiscTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RedQueueDiscEstimatorTestCase(), TestCase::Duration::QUICK);
     }
 } g_redQueueTestSuite; ///< the test suite
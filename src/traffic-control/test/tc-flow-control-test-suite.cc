@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -481,6 +482,166 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Traffic Control SendBatch Test Case
+ *
+ * A burst of packets is sent to a device with one or two transmission queues,
+ * each with a queue disc holding up to four packets, either one packet at a
+ * time with TrafficControlLayer::Send or at once with
+ * TrafficControlLayer::SendBatch. In both cases, the packets must be enqueued
+ * in the queue disc of their transmission queue. Since SendBatch enqueues the
+ * whole burst before dequeuing packets, the queue discs drop the packets that
+ * Send enqueues after the first ones were passed to the device.
+ */
+class TcSendBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param nTxQueues the number of transmission queues of the device
+     */
+    TcSendBatchTestCase(std::size_t nTxQueues);
+
+  private:
+    void DoRun() override;
+    /**
+     * Send a burst of packets to a device.
+     * @param batch whether to send the packets with SendBatch rather than Send
+     * @return the statistics of the queue discs of the transmission queues
+     */
+    std::vector<QueueDisc::Stats> SendBurst(bool batch);
+    std::size_t m_nTxQueues; //!< the number of transmission queues of the device
+};
+
+TcSendBatchTestCase::TcSendBatchTestCase(std::size_t nTxQueues)
+    : TestCase("Test SendBatch with " + std::to_string(nTxQueues) + " transmission queue(s)"),
+      m_nTxQueues(nTxQueues)
+{
+}
+
+std::vector<QueueDisc::Stats>
+TcSendBatchTestCase::SendBurst(bool batch)
+{
+    NodeContainer n;
+    n.Create(2);
+
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("1p"));
+    simple.DisableFlowControl();
+
+    Ptr<NetDevice> txDev;
+    txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+    txDev->SetMtu(2500);
+
+    // the transmission queues share the queue of the device, and the packets
+    // of 500 bytes are sent on the last one
+    auto ndqi = CreateObjectWithAttributes<NetDeviceQueueInterface>("NTxQueues",
+                                                                    UintegerValue(m_nTxQueues));
+    PointerValue ptr;
+    txDev->GetAttribute("TxQueue", ptr);
+    for (std::size_t i = 0; i < m_nTxQueues; i++)
+    {
+        ndqi->GetTxQueue(i)->ConnectQueueTraces(ptr.Get<Queue<Packet>>());
+    }
+    ndqi->SetSelectQueueCallback([this](Ptr<QueueItem> item) -> std::size_t {
+        return (item->GetPacket()->GetSize() == 500) ? m_nTxQueues - 1 : 0;
+    });
+    txDev->AggregateObject(ndqi);
+
+    TrafficControlHelper tch;
+    if (m_nTxQueues == 1)
+    {
+        tch.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxSize", StringValue("4p"));
+    }
+    else
+    {
+        uint16_t handle = tch.SetRootQueueDisc("ns3::MqQueueDisc");
+        TrafficControlHelper::ClassIdList cls =
+            tch.AddQueueDiscClasses(handle, m_nTxQueues, "ns3::QueueDiscClass");
+        tch.AddChildQueueDiscs(handle, cls, "ns3::FifoQueueDisc", "MaxSize", StringValue("4p"));
+    }
+    Ptr<QueueDisc> root = tch.Install(txDev).Get(0);
+
+    // send 12 packets, alternately of 1000 and 500 bytes, at time 0
+    Simulator::Schedule(Seconds(0), [=]() {
+        Ptr<TrafficControlLayer> tc = n.Get(0)->GetObject<TrafficControlLayer>();
+        std::vector<Ptr<QueueDiscItem>> items;
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            items.push_back(Create<QueueDiscTestItem>(Create<Packet>((i % 2) ? 500 : 1000)));
+        }
+        if (batch)
+        {
+            tc->SendBatch(txDev, items);
+        }
+        else
+        {
+            for (const auto& item : items)
+            {
+                tc->Send(txDev, item);
+            }
+        }
+    });
+
+    Simulator::Run();
+
+    std::vector<QueueDisc::Stats> stats;
+    if (m_nTxQueues == 1)
+    {
+        stats.push_back(root->GetStats());
+    }
+    else
+    {
+        for (std::size_t i = 0; i < m_nTxQueues; i++)
+        {
+            stats.push_back(root->GetQueueDiscClass(i)->GetQueueDisc()->GetStats());
+        }
+    }
+    Simulator::Destroy();
+    return stats;
+}
+
+void
+TcSendBatchTestCase::DoRun()
+{
+    auto sendStats = SendBurst(false);
+    auto batchStats = SendBurst(true);
+    for (std::size_t i = 0; i < m_nTxQueues; i++) { std::cerr << "DBG " << i << " " << sendStats[i] << " " << batchStats[i].nTotalDroppedPackets << std::endl; }
+
+    // With Send, the first packet passed to the device fills its queue and
+    // stops the transmission queues until its transmission ends: each queue
+    // disc passes one packet to the device and then enqueues four of those
+    // that follow. With SendBatch, each queue disc enqueues the first four
+    // packets it receives.
+    const uint32_t nReceived = 12 / m_nTxQueues;
+    for (std::size_t i = 0; i < m_nTxQueues; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sendStats[i].nTotalReceivedPackets,
+                              nReceived,
+                              "Send: wrong number of packets received by queue disc " << i);
+        NS_TEST_EXPECT_MSG_EQ(batchStats[i].nTotalReceivedPackets,
+                              nReceived,
+                              "SendBatch: wrong number of packets received by queue disc " << i);
+        NS_TEST_EXPECT_MSG_EQ(sendStats[i].nTotalDroppedPackets,
+                              nReceived - 5,
+                              "Send: wrong number of packets dropped by queue disc " << i);
+        NS_TEST_EXPECT_MSG_EQ(batchStats[i].nTotalDroppedPackets,
+                              nReceived - 4,
+                              "SendBatch: wrong number of packets dropped by queue disc " << i);
+    }
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +676,7 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+        AddTestCase(new TcSendBatchTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new TcSendBatchTestCase(2), TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
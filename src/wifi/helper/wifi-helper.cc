@@ -10,13 +10,17 @@
 
 #include "wifi-helper.h"
 
+#include "ns3/abstract-wifi-mac.h"
+#include "ns3/abstract-wifi-medium.h"
 #include "ns3/ampdu-subframe-header.h"
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-ppdu.h"
+#include "ns3/error-rate-model.h"
 #include "ns3/he-configuration.h"
 #include "ns3/ht-configuration.h"
+#include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/names.h"
@@ -33,6 +37,7 @@
 
 #include <bit>
 #include <memory>
+#include <set>
 
 namespace
 {
@@ -184,6 +189,28 @@ WifiPhyHelper::Set(uint8_t linkId, std::string name, const AttributeValue& v)
     m_phys.at(linkId).Set(name, v);
 }
 
+std::vector<Ptr<WifiPhy>>
+WifiPhyHelper::CreateForMacAbstraction(Ptr<WifiNetDevice> device) const
+{
+    std::vector<Ptr<WifiPhy>> phys;
+    for (std::size_t i = 0; i < m_phys.size(); ++i)
+    {
+        // unlike the other PHY types, a YansWifiPhy does not need a channel to
+        // operate on a frequency; the attributes of the WifiPhy base class
+        // set on this helper still apply
+        auto factory = m_phys[i];
+        factory.SetTypeId("ns3::YansWifiPhy");
+        auto phy = factory.Create<WifiPhy>();
+        // the remote station managers compute their SNR thresholds with the
+        // error rate model of the PHY
+        phy->SetInterferenceHelper(m_interferenceHelper.Create<InterferenceHelper>());
+        phy->SetErrorRateModel(m_errorRateModel.at(i).Create<ErrorRateModel>());
+        phy->SetDevice(device);
+        phys.push_back(phy);
+    }
+    return phys;
+}
+
 void
 WifiPhyHelper::DisablePreambleDetectionModel()
 {
@@ -1033,6 +1060,12 @@ WifiHelper::DisableFlowControl()
     m_enableFlowControl = false;
 }
 
+void
+WifiHelper::SetMacAbstraction(Ptr<AbstractWifiMedium> medium)
+{
+    m_abstractMedium = medium;
+}
+
 void
 WifiHelper::SetSelectQueueCallback(SelectQueueCallback f)
 {
@@ -1083,7 +1116,9 @@ WifiHelper::Install(const WifiPhyHelper& phyHelper,
             device->SetEhtConfiguration(ehtConfiguration);
         }
         std::vector<Ptr<WifiRemoteStationManager>> managers;
-        std::vector<Ptr<WifiPhy>> phys = phyHelper.Create(node, device);
+        std::vector<Ptr<WifiPhy>> phys = m_abstractMedium
+                                              ? phyHelper.CreateForMacAbstraction(device)
+                                              : phyHelper.Create(node, device);
         device->SetPhys(phys);
         // if only one remote station manager model was provided, replicate it for all the links
         auto stationManagers = m_stationManager;
@@ -1101,7 +1136,16 @@ WifiHelper::Install(const WifiPhyHelper& phyHelper,
             managers.push_back(stationManagers[i].Create<WifiRemoteStationManager>());
         }
         device->SetRemoteStationManagers(managers);
-        Ptr<WifiMac> mac = macHelper.Create(device, m_standard);
+        Ptr<WifiMac> mac;
+        if (m_abstractMedium)
+        {
+            mac = macHelper.CreateForMacAbstraction(device, m_standard);
+            StaticCast<AbstractWifiMac>(mac)->SetMedium(m_abstractMedium);
+        }
+        else
+        {
+            mac = macHelper.Create(device, m_standard);
+        }
         if ((m_standard >= WIFI_STANDARD_80211ax) && (m_obssPdAlgorithm.IsTypeIdSet()))
         {
             Ptr<ObssPdAlgorithm> obssPdAlgorithm = m_obssPdAlgorithm.Create<ObssPdAlgorithm>();
@@ -1171,6 +1215,8 @@ WifiHelper::EnableLogComponents(LogLevel logLevel)
 
     LogComponentEnable("AarfWifiManager", logLevel);
     LogComponentEnable("AarfcdWifiManager", logLevel);
+    LogComponentEnable("AbstractWifiMac", logLevel);
+    LogComponentEnable("AbstractWifiMedium", logLevel);
     LogComponentEnable("AdhocWifiMac", logLevel);
     LogComponentEnable("AdvancedApEmlsrManager", logLevel);
     LogComponentEnable("AdvancedEmlsrManager", logLevel);
@@ -1280,15 +1326,28 @@ WifiHelper::AssignStreams(NetDeviceContainer c, int64_t stream)
 {
     int64_t currentStream = stream;
     Ptr<NetDevice> netDevice;
+    std::set<Ptr<AbstractWifiMedium>> abstractMedia;
     for (auto i = c.Begin(); i != c.End(); ++i)
     {
         netDevice = (*i);
         if (auto wifi = DynamicCast<WifiNetDevice>(netDevice))
         {
-            // Handle any random numbers in the PHY objects.
-            for (auto& phy : wifi->GetPhys())
+            if (auto abstractMac = DynamicCast<AbstractWifiMac>(wifi->GetMac()))
+            {
+                // Handle any random numbers in the medium shared by the devices
+                // using the MAC abstraction, whose PHY objects are not used.
+                if (abstractMedia.insert(abstractMac->GetMedium()).second)
+                {
+                    currentStream += abstractMac->GetMedium()->AssignStreams(currentStream);
+                }
+            }
+            else
             {
-                currentStream += phy->AssignStreams(currentStream);
+                // Handle any random numbers in the PHY objects.
+                for (auto& phy : wifi->GetPhys())
+                {
+                    currentStream += phy->AssignStreams(currentStream);
+                }
             }
 
             // Handle any random numbers in the station managers.
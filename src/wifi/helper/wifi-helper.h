@@ -25,6 +25,7 @@
 namespace ns3
 {
 
+class AbstractWifiMedium;
 class Node;
 class RadiotapHeader;
 class QueueItem;
@@ -57,6 +58,21 @@ class WifiPhyHelper : public PcapHelperForDevice, public AsciiTraceHelperForDevi
      */
     virtual std::vector<Ptr<WifiPhy>> Create(Ptr<Node> node, Ptr<WifiNetDevice> device) const = 0;
 
+    /**
+     * @param device the device within which the PHY object(s) will reside
+     *
+     * @returns new PHY objects for a device using the MAC abstraction (see
+     * WifiHelper::SetMacAbstraction()).
+     *
+     * These PHY objects only hold the configuration of the device (standard,
+     * operating channel, TX power, antenna gains...) read by the
+     * AbstractWifiMedium. They are YansWifiPhy objects that are not attached
+     * to any channel and have no frame capture model nor preamble detection
+     * model. Their error rate model is only used by the remote station
+     * managers to compute SNR thresholds.
+     */
+    std::vector<Ptr<WifiPhy>> CreateForMacAbstraction(Ptr<WifiNetDevice> device) const;
+
     /**
      * @param name the name of the attribute to set
      * @param v the value of the attribute
@@ -463,6 +479,22 @@ class WifiHelper
      */
     void DisableFlowControl();
 
+    /**
+     * Enable the abstraction of the MAC and PHY layers. The devices installed
+     * from now on use an AbstractWifiMac attached to the given medium, which
+     * computes the outcome of each TXOP analytically instead of simulating
+     * the frame exchanges, the channel access and the PHY receptions. The
+     * type of MAC set on the WifiMacHelper is then ignored, while its other
+     * settings (e.g., the maximum A-MPDU sizes and the EDCA parameters) still
+     * apply. The devices have no channel access manager nor frame exchange
+     * manager, and their PHY objects are not attached to the channel of the
+     * PHY helper (see WifiPhyHelper::CreateForMacAbstraction()).
+     *
+     * @param medium the medium shared by the devices, or a null pointer to
+     *        disable the abstraction
+     */
+    void SetMacAbstraction(Ptr<AbstractWifiMedium> medium);
+
     /**
      * @param phy the PHY helper to create PHY objects
      * @param mac the MAC helper to create MAC objects
@@ -588,7 +620,9 @@ class WifiHelper
      * Assign a fixed random variable stream number to the random variables
      * used by the PHY and MAC aspects of the Wifi models.  Each device in
      * container c has fixed stream numbers assigned to its random variables.
-     * The Wifi channel (e.g. propagation loss model) is excluded.
+     * The Wifi channel (e.g. propagation loss model) is excluded. For the
+     * devices using the MAC abstraction, the random variables of the
+     * AbstractWifiMedium are assigned instead of the ones of the PHY objects.
      * Return the number of streams (possibly zero) that
      * have been assigned. The Install() method should have previously been
      * called by the user.
@@ -610,6 +644,7 @@ class WifiHelper
     SelectQueueCallback m_selectQueueCallback;           ///< select queue callback
     ObjectFactory m_obssPdAlgorithm;                     ///< OBSS_PD algorithm
     bool m_enableFlowControl;                            //!< whether to enable flow control
+    Ptr<AbstractWifiMedium> m_abstractMedium; //!< medium of the MAC abstraction (null if disabled)
 };
 
 } // namespace ns3
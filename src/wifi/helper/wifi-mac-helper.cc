@@ -57,11 +57,9 @@ WifiMacHelper::~WifiMacHelper()
 {
 }
 
-Ptr<WifiMac>
-WifiMacHelper::Create(Ptr<WifiNetDevice> device, WifiStandard standard) const
+ObjectFactory
+WifiMacHelper::GetMacObjectFactory(WifiStandard standard) const
 {
-    NS_ABORT_MSG_IF(standard == WIFI_STANDARD_UNSPECIFIED, "No standard specified!");
-
     // this is a const method, but we need to force the correct QoS setting
     ObjectFactory macObjectFactory = m_mac;
     if (standard >= WIFI_STANDARD_80211n)
@@ -85,6 +83,15 @@ WifiMacHelper::Create(Ptr<WifiNetDevice> device, WifiStandard standard) const
         auto s = ss.str().substr(3); // discard "AC "
         macObjectFactory.Set(s, PointerValue(edca.Create<QosTxop>()));
     }
+    return macObjectFactory;
+}
+
+Ptr<WifiMac>
+WifiMacHelper::Create(Ptr<WifiNetDevice> device, WifiStandard standard) const
+{
+    NS_ABORT_MSG_IF(standard == WIFI_STANDARD_UNSPECIFIED, "No standard specified!");
+
+    ObjectFactory macObjectFactory = GetMacObjectFactory(standard);
 
     // WaveNetDevice (through ns-3.38) stores PHY entities in a different member than WifiNetDevice,
     // hence GetNPhys() would return 0
@@ -179,4 +186,19 @@ WifiMacHelper::Create(Ptr<WifiNetDevice> device, WifiStandard standard) const
     return mac;
 }
 
+Ptr<WifiMac>
+WifiMacHelper::CreateForMacAbstraction(Ptr<WifiNetDevice> device, WifiStandard standard) const
+{
+    NS_ABORT_MSG_IF(standard == WIFI_STANDARD_UNSPECIFIED, "No standard specified!");
+
+    ObjectFactory macObjectFactory = GetMacObjectFactory(standard);
+    macObjectFactory.SetTypeId("ns3::AbstractWifiMac");
+
+    Ptr<WifiMac> mac = macObjectFactory.Create<WifiMac>();
+    mac->SetDevice(device);
+    mac->SetAddress(Mac48Address::Allocate());
+    device->SetMac(mac);
+    return mac;
+}
+
 } // namespace ns3
@@ -187,6 +187,20 @@ class WifiMacHelper
      */
     virtual Ptr<WifiMac> Create(Ptr<WifiNetDevice> device, WifiStandard standard) const;
 
+    /**
+     * @param device the device within which the MAC object will reside
+     * @param standard the standard to configure during installation
+     * @returns a new AbstractWifiMac object.
+     *
+     * This allows the ns3::WifiHelper class to create MAC objects from
+     * ns3::WifiHelper::Install when the MAC abstraction is enabled (see
+     * WifiHelper::SetMacAbstraction()). The type of MAC set on this helper is
+     * ignored, while its attributes and the (Qos)Txop objects still apply. No
+     * channel access manager, frame exchange manager or other MAC component
+     * is created, since the AbstractWifiMedium replaces them.
+     */
+    Ptr<WifiMac> CreateForMacAbstraction(Ptr<WifiNetDevice> device, WifiStandard standard) const;
+
   protected:
     ObjectFactory m_mac;                                     ///< MAC object factory
     ObjectFactory m_dcf;                                     ///< Txop (DCF) object factory
@@ -201,6 +215,14 @@ class WifiMacHelper
     ObjectFactory m_emlsrManager;         ///< EMLSR Manager object factory
     ObjectFactory m_apEmlsrManager;       ///< AP EMLSR Manager object factory
     ObjectFactory m_gcrManager;           ///< GCR Manager object factory
+
+  private:
+    /**
+     * @param standard the standard to configure during installation
+     * @returns the factory of the MAC objects, set with the (Qos)Txop objects
+     *          to install
+     */
+    ObjectFactory GetMacObjectFactory(WifiStandard standard) const;
 };
 
 } // namespace ns3
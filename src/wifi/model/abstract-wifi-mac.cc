@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "abstract-wifi-mac.h"
+
+#include "abstract-wifi-medium.h"
+#include "qos-txop.h"
+#include "wifi-mpdu.h"
+#include "wifi-phy.h"
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AbstractWifiMac");
+
+NS_OBJECT_ENSURE_REGISTERED(AbstractWifiMac);
+
+TypeId
+AbstractWifiMac::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::AbstractWifiMac")
+                            .SetParent<WifiMac>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<AbstractWifiMac>();
+    return tid;
+}
+
+AbstractWifiMac::AbstractWifiMac()
+{
+    NS_LOG_FUNCTION(this);
+    SetTypeOfStation(ADHOC_STA);
+}
+
+AbstractWifiMac::~AbstractWifiMac()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AbstractWifiMac::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_medium = nullptr;
+    WifiMac::DoDispose();
+}
+
+void
+AbstractWifiMac::DoCompleteConfig()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AbstractWifiMac::SetWifiPhys(const std::vector<Ptr<WifiPhy>>& phys)
+{
+    NS_LOG_FUNCTION(this);
+    WifiMac::SetWifiPhys(phys);
+    // WifiMac only configures the EDCA parameters once the channel access
+    // managers and the frame exchange managers are set, which this MAC has not
+    if (auto txop = GetTxop())
+    {
+        txop->SetWifiMac(this);
+    }
+    if (GetQosSupported())
+    {
+        for (const auto& [aci, ac] : wifiAcList)
+        {
+            GetQosTxop(aci)->SetWifiMac(this);
+        }
+    }
+    const auto standard = GetWifiPhy()->GetStandard();
+    ConfigureContentionWindow(standard == WIFI_STANDARD_80211b ? 31 : 15, 1023);
+}
+
+void
+AbstractWifiMac::SetMedium(Ptr<AbstractWifiMedium> medium)
+{
+    NS_LOG_FUNCTION(this << medium);
+    m_medium = medium;
+    m_medium->Add(this);
+}
+
+Ptr<AbstractWifiMedium>
+AbstractWifiMac::GetMedium() const
+{
+    return m_medium;
+}
+
+bool
+AbstractWifiMac::CanForwardPacketsTo(Mac48Address to) const
+{
+    return true;
+}
+
+void
+AbstractWifiMac::SetLinkUpCallback(Callback<void> linkUp)
+{
+    NS_LOG_FUNCTION(this << &linkUp);
+    WifiMac::SetLinkUpCallback(linkUp);
+    // there is no association, hence the link is always up
+    linkUp();
+}
+
+void
+AbstractWifiMac::Enqueue(Ptr<WifiMpdu> mpdu, Mac48Address to, Mac48Address from)
+{
+    NS_LOG_FUNCTION(this << *mpdu << to << from);
+    NS_ABORT_MSG_IF(!m_medium, "The MAC is not attached to an AbstractWifiMedium");
+    auto& hdr = mpdu->GetHeader();
+    hdr.SetAddr1(to);
+    hdr.SetAddr2(GetAddress());
+    // there is no BSS (and no frame exchange manager holding its BSSID)
+    hdr.SetAddr3(Mac48Address::GetBroadcast());
+    hdr.SetDsNotFrom();
+    hdr.SetDsNotTo();
+    m_medium->Enqueue(this, mpdu);
+}
+
+void
+AbstractWifiMac::Deliver(Ptr<const WifiMpdu> mpdu)
+{
+    NS_LOG_FUNCTION(this << *mpdu);
+    const auto& hdr = mpdu->GetHeader();
+    ForwardUp(mpdu->GetPacket(), hdr.GetAddr2(), hdr.GetAddr1());
+}
+
+} // namespace ns3
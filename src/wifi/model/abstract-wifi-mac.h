@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ABSTRACT_WIFI_MAC_H
+#define ABSTRACT_WIFI_MAC_H
+
+#include "wifi-mac.h"
+
+namespace ns3
+{
+
+class AbstractWifiMedium;
+
+/**
+ * @ingroup wifi
+ *
+ * @brief A MAC whose frames are not transmitted by the PHY but by an AbstractWifiMedium
+ *
+ * The frames enqueued by this MAC are handed over to the AbstractWifiMedium
+ * it is attached to, which computes analytically the duration and the outcome
+ * of each TXOP and delivers the frames that are successfully received to the
+ * MAC of the receiver. The device therefore has no frame exchange manager
+ * nor channel access manager, and its PHYs only provide its configuration
+ * to the medium.  The (Qos)Txop objects hold the EDCA parameters used by
+ * the medium, which this MAC configures when its PHYs are set, as WifiMac
+ * does for the other MACs.
+ *
+ * As with AdhocWifiMac, every device can send frames to every other device
+ * attached to the same medium, without any association, and the link is
+ * always up. The frames carry the wildcard BSSID.  This MAC is normally installed by WifiHelper when the MAC
+ * abstraction is enabled (see WifiHelper::SetMacAbstraction()).
+ */
+class AbstractWifiMac : public WifiMac
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    AbstractWifiMac();
+    ~AbstractWifiMac() override;
+
+    /**
+     * Attach this MAC to a medium.
+     * @param medium the medium
+     */
+    void SetMedium(Ptr<AbstractWifiMedium> medium);
+    /**
+     * @return the medium this MAC is attached to
+     */
+    Ptr<AbstractWifiMedium> GetMedium() const;
+
+    void SetWifiPhys(const std::vector<Ptr<WifiPhy>>& phys) override;
+    void SetLinkUpCallback(Callback<void> linkUp) override;
+    bool CanForwardPacketsTo(Mac48Address to) const override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class AbstractWifiMedium;
+
+    void DoCompleteConfig() override;
+    void Enqueue(Ptr<WifiMpdu> mpdu, Mac48Address to, Mac48Address from) override;
+
+    /**
+     * Deliver an MPDU received through the medium to the upper layers.
+     * @param mpdu the MPDU
+     */
+    void Deliver(Ptr<const WifiMpdu> mpdu);
+
+    Ptr<AbstractWifiMedium> m_medium; //!< The medium this MAC is attached to
+};
+
+} // namespace ns3
+
+#endif /* ABSTRACT_WIFI_MAC_H */
@@ -0,0 +1,437 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "abstract-wifi-medium.h"
+
+#include "abstract-wifi-mac.h"
+#include "block-ack-type.h"
+#include "error-rate-model.h"
+#include "interference-helper.h"
+#include "mpdu-aggregator.h"
+#include "qos-txop.h"
+#include "table-based-error-rate-model.h"
+#include "wifi-mpdu.h"
+#include "wifi-net-device.h"
+#include "wifi-phy.h"
+#include "wifi-utils.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AbstractWifiMedium");
+
+NS_OBJECT_ENSURE_REGISTERED(AbstractWifiMedium);
+
+TypeId
+AbstractWifiMedium::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AbstractWifiMedium")
+            .SetParent<Object>()
+            .SetGroupName("Wifi")
+            .AddConstructor<AbstractWifiMedium>()
+            .AddAttribute("PropagationLossModel",
+                          "The propagation loss model used to compute the SNR of the receivers.",
+                          PointerValue(),
+                          MakePointerAccessor(&AbstractWifiMedium::m_loss),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("ErrorRateModel",
+                          "The error rate model used to compute the MPDU error rates.",
+                          PointerValue(CreateObject<TableBasedErrorRateModel>()),
+                          MakePointerAccessor(&AbstractWifiMedium::m_errorRateModel),
+                          MakePointerChecker<ErrorRateModel>())
+            .AddAttribute("RxNoiseFigure",
+                          "The noise figure of the receivers (dB).",
+                          DoubleValue(7),
+                          MakeDoubleAccessor(&AbstractWifiMedium::m_noiseFigure),
+                          MakeDoubleChecker<dB_u>())
+            .AddAttribute("PerThreshold",
+                          "The maximum MPDU error rate of the transmission mode selected for "
+                          "a TXOP. The lowest rate mode is used if no mode meets it.",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&AbstractWifiMedium::m_perThreshold),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("MaxPpduDuration",
+                          "The maximum duration of the PPDU carrying the data frames of a TXOP.",
+                          TimeValue(MicroSeconds(5484)),
+                          MakeTimeAccessor(&AbstractWifiMedium::m_maxPpduDuration),
+                          MakeTimeChecker())
+            .AddAttribute("MeanBackoffSlots",
+                          "The mean number of backoff slots that precede a TXOP.",
+                          DoubleValue(7.5),
+                          MakeDoubleAccessor(&AbstractWifiMedium::m_meanBackoffSlots),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("RetryLimit",
+                          "The maximum number of transmissions of an MPDU.",
+                          UintegerValue(7),
+                          MakeUintegerAccessor(&AbstractWifiMedium::m_retryLimit),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxQueueSize",
+                          "The maximum number of MPDUs waiting for transmission at each MAC.",
+                          UintegerValue(500),
+                          MakeUintegerAccessor(&AbstractWifiMedium::m_maxQueueSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddTraceSource("Txop",
+                            "The end of a TXOP.",
+                            MakeTraceSourceAccessor(&AbstractWifiMedium::m_txopTrace),
+                            "ns3::AbstractWifiMedium::TxopTracedCallback");
+    return tid;
+}
+
+AbstractWifiMedium::AbstractWifiMedium()
+    : m_next(0),
+      m_txopSender(0),
+      m_txopNMpdus(0),
+      m_txopNReceived(0)
+{
+    NS_LOG_FUNCTION(this);
+    m_uniform = CreateObject<UniformRandomVariable>();
+}
+
+AbstractWifiMedium::~AbstractWifiMedium()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AbstractWifiMedium::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_txopEnd.Cancel();
+    m_stations.clear();
+    m_index.clear();
+    m_txopFailed.clear();
+    m_loss = nullptr;
+    m_errorRateModel = nullptr;
+    m_uniform = nullptr;
+    Object::DoDispose();
+}
+
+int64_t
+AbstractWifiMedium::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_uniform->SetStream(stream);
+    return 1;
+}
+
+void
+AbstractWifiMedium::Add(Ptr<AbstractWifiMac> mac)
+{
+    NS_LOG_FUNCTION(this << mac);
+    NS_ABORT_MSG_IF(m_index.contains(mac->GetAddress()),
+                    "A MAC with address " << mac->GetAddress() << " is already attached");
+    m_index[mac->GetAddress()] = m_stations.size();
+    m_stations.push_back({mac, {}, Seconds(0)});
+}
+
+std::size_t
+AbstractWifiMedium::GetNMacs() const
+{
+    return m_stations.size();
+}
+
+Time
+AbstractWifiMedium::GetAirtime(Mac48Address address) const
+{
+    auto it = m_index.find(address);
+    NS_ABORT_MSG_IF(it == m_index.end(), "No MAC with address " << address);
+    return m_stations[it->second].airtime;
+}
+
+double
+AbstractWifiMedium::GetAirtimeShare(Mac48Address address) const
+{
+    if (m_totalAirtime.IsZero())
+    {
+        return 0;
+    }
+    return GetAirtime(address).GetSeconds() / m_totalAirtime.GetSeconds();
+}
+
+void
+AbstractWifiMedium::Enqueue(Ptr<AbstractWifiMac> mac, Ptr<WifiMpdu> mpdu)
+{
+    NS_LOG_FUNCTION(this << mac << *mpdu);
+    auto it = m_index.find(mac->GetAddress());
+    NS_ABORT_MSG_IF(it == m_index.end(), "The MAC is not attached to this medium");
+    auto& station = m_stations[it->second];
+    if (station.queue.size() >= m_maxQueueSize)
+    {
+        NS_LOG_DEBUG("Queue of " << mac->GetAddress() << " full, dropping " << *mpdu);
+        mac->NotifyTxDrop(mpdu->GetPacket());
+        return;
+    }
+    station.queue.push_back({mpdu, 0});
+    if (!m_txopEnd.IsPending())
+    {
+        StartTxop();
+    }
+}
+
+WifiTxVector
+AbstractWifiMedium::GetTxVector(Ptr<WifiPhy> phy, WifiMode mode) const
+{
+    const auto modulation = mode.GetModulationClass();
+    MHz_u width = phy->GetChannelWidth();
+    if (modulation < WIFI_MOD_CLASS_HT)
+    {
+        width = (modulation == WIFI_MOD_CLASS_DSSS || modulation == WIFI_MOD_CLASS_HR_DSSS)
+                    ? MHz_u{22}
+                    : MHz_u{20};
+    }
+    auto device = DynamicCast<WifiNetDevice>(phy->GetDevice());
+    return WifiTxVector(mode,
+                        0,
+                        GetPreambleForTransmission(modulation, false),
+                        GetGuardIntervalForMode(mode, device),
+                        1,
+                        1,
+                        0,
+                        width,
+                        modulation >= WIFI_MOD_CLASS_HT);
+}
+
+Watt_u
+AbstractWifiMedium::GetRxPower(const Station& sender, const Station& receiver) const
+{
+    NS_ABORT_MSG_IF(!m_loss, "No propagation loss model set on the AbstractWifiMedium");
+    auto txPhy = sender.mac->GetWifiPhy();
+    auto rxPhy = receiver.mac->GetWifiPhy();
+    const dBm_u txPower = txPhy->GetTxPowerStart() + txPhy->GetTxGain();
+    const dBm_u rxPower =
+        m_loss->CalcRxPower(txPower, txPhy->GetMobility(), rxPhy->GetMobility()) +
+        rxPhy->GetRxGain();
+    return DbmToW(rxPower);
+}
+
+double
+AbstractWifiMedium::GetSnr(Watt_u rxPower, const WifiTxVector& txVector) const
+{
+    // same thermal noise as InterferenceHelper, over the width of the PPDU
+    const Watt_u noise = DbToRatio(m_noiseFigure) * InterferenceHelper::BOLTZMANN * 290 *
+                         MHzToHz(txVector.GetChannelWidth());
+    return rxPower / noise;
+}
+
+double
+AbstractWifiMedium::GetSuccessRate(const WifiTxVector& txVector,
+                                   double snr,
+                                   uint32_t mpduSize) const
+{
+    return m_errorRateModel->GetChunkSuccessRate(txVector.GetMode(), txVector, snr, 8 * mpduSize);
+}
+
+WifiTxVector
+AbstractWifiMedium::SelectTxVector(Ptr<WifiPhy> phy, Watt_u rxPower, uint32_t mpduSize) const
+{
+    const auto modulation = GetModulationClassForStandard(phy->GetStandard());
+    auto modes = (modulation >= WIFI_MOD_CLASS_HT) ? phy->GetMcsList(modulation)
+                                                    : phy->GetModeList();
+    WifiTxVector best = GetTxVector(phy, phy->GetDefaultMode());
+    uint64_t bestRate = 0;
+    for (const auto& mode : modes)
+    {
+        auto txVector = GetTxVector(phy, mode);
+        if (!txVector.IsValid(phy->GetPhyBand()))
+        {
+            continue;
+        }
+        const auto rate = mode.GetDataRate(txVector);
+        if (rate > bestRate &&
+            1 - GetSuccessRate(txVector, GetSnr(rxPower, txVector), mpduSize) <= m_perThreshold)
+        {
+            best = txVector;
+            bestRate = rate;
+        }
+    }
+    return best;
+}
+
+void
+AbstractWifiMedium::StartTxop()
+{
+    NS_LOG_FUNCTION(this);
+    // serve the stations in round robin order
+    const std::size_t nStations = m_stations.size();
+    std::size_t index = nStations;
+    for (std::size_t i = 0; i < nStations; i++)
+    {
+        std::size_t candidate = (m_next + i) % nStations;
+        if (!m_stations[candidate].queue.empty())
+        {
+            index = candidate;
+            break;
+        }
+    }
+    if (index == nStations)
+    {
+        NS_LOG_DEBUG("No queued MPDU, the medium is idle");
+        return;
+    }
+    m_next = (index + 1) % nStations;
+    m_txopSender = index;
+    m_txopStart = Simulator::Now();
+    auto& sender = m_stations[index];
+    auto phy = sender.mac->GetWifiPhy();
+    const auto band = phy->GetPhyBand();
+    const auto& hdr = sender.queue.front().mpdu->GetHeader();
+    const Mac48Address to = hdr.GetAddr1();
+    // the EDCA parameters of the queue of the MPDU at the head of the queue
+    // (of the DCF for non-QoS frames) set the AIFS of the TXOP
+    const AcIndex ac = hdr.IsQosData() ? QosUtilsMapTidToAc(hdr.GetQosTid()) : AC_BE_NQOS;
+    Ptr<Txop> txop = sender.mac->GetTxop();
+    if (hdr.IsQosData())
+    {
+        txop = sender.mac->GetQosTxop(ac);
+    }
+    const Time aifs = phy->GetSifs() + txop->GetAifsn(SINGLE_LINK_OP_ID) * phy->GetSlot();
+    Time duration = aifs + m_meanBackoffSlots * phy->GetSlot();
+    m_txopFailed.clear();
+    m_txopNMpdus = 0;
+    m_txopNReceived = 0;
+
+    if (to.IsGroup())
+    {
+        // a single MPDU at the lowest rate, received independently by all the
+        // other stations and never retransmitted
+        auto mpdu = sender.queue.front().mpdu;
+        sender.queue.pop_front();
+        m_txopTxVector = GetTxVector(phy, phy->GetDefaultMode());
+        duration += WifiPhy::CalculateTxDuration(mpdu->GetSize(), m_txopTxVector, band);
+        m_txopNMpdus = 1;
+        for (std::size_t i = 0; i < nStations; i++)
+        {
+            if (i == index)
+            {
+                continue;
+            }
+            auto& receiver = m_stations[i];
+            const double snr = GetSnr(GetRxPower(sender, receiver), m_txopTxVector);
+            double success = GetSuccessRate(m_txopTxVector, snr, mpdu->GetSize());
+            if (m_uniform->GetValue() < success)
+            {
+                m_txopNReceived++;
+                Simulator::ScheduleWithContext(receiver.mac->GetDevice()->GetNode()->GetId(),
+                                               duration,
+                                               &AbstractWifiMac::Deliver,
+                                               receiver.mac,
+                                               mpdu);
+            }
+        }
+        m_txopReceiver = to;
+        m_txopEnd = Simulator::Schedule(duration, &AbstractWifiMedium::EndTxop, this);
+        return;
+    }
+
+    auto it = m_index.find(to);
+    NS_ABORT_MSG_IF(it == m_index.end(),
+                    "The receiver " << to << " is not attached to the AbstractWifiMedium");
+    auto& receiver = m_stations[it->second];
+    const Watt_u rxPower = GetRxPower(sender, receiver);
+    m_txopTxVector = SelectTxVector(phy, rxPower, sender.queue.front().mpdu->GetSize());
+    const double snr = GetSnr(rxPower, m_txopTxVector);
+
+    // aggregate the MPDUs at the head of the queue that have the same receiver
+    const uint32_t maxAmpduSize =
+        m_txopTxVector.GetModulationClass() >= WIFI_MOD_CLASS_HT
+            ? sender.mac->GetMaxAmpduSize(ac)
+            : 0;
+    std::vector<QueuedMpdu> mpdus;
+    uint32_t ampduSize = 0;
+    while (!sender.queue.empty() && sender.queue.front().mpdu->GetHeader().GetAddr1() == to &&
+           mpdus.size() < MAX_MPDUS_PER_TXOP)
+    {
+        const uint32_t mpduSize = sender.queue.front().mpdu->GetSize();
+        uint32_t size = mpduSize;
+        if (maxAmpduSize > 0)
+        {
+            size = MpduAggregator::GetSizeIfAggregated(mpduSize, ampduSize);
+        }
+        if (!mpdus.empty() &&
+            (maxAmpduSize == 0 || size > maxAmpduSize ||
+             WifiPhy::CalculateTxDuration(size, m_txopTxVector, band) > m_maxPpduDuration))
+        {
+            break;
+        }
+        ampduSize = size;
+        mpdus.push_back(sender.queue.front());
+        sender.queue.pop_front();
+    }
+    m_txopTxVector.SetAggregation(mpdus.size() > 1);
+
+    const Time dataDuration = WifiPhy::CalculateTxDuration(ampduSize, m_txopTxVector, band);
+    const auto ackTxVector = GetTxVector(phy, phy->GetDefaultMode());
+    const uint32_t ackSize =
+        mpdus.size() > 1 ? GetBlockAckSize(BlockAckType::COMPRESSED) : GetAckSize();
+    duration += dataDuration + phy->GetSifs() +
+                WifiPhy::CalculateTxDuration(ackSize, ackTxVector, band);
+    m_txopNMpdus = mpdus.size();
+
+    const uint32_t nodeId = receiver.mac->GetDevice()->GetNode()->GetId();
+    for (auto& queued : mpdus)
+    {
+        double success = GetSuccessRate(m_txopTxVector, snr, queued.mpdu->GetSize());
+        if (m_uniform->GetValue() < success)
+        {
+            m_txopNReceived++;
+            Simulator::ScheduleWithContext(nodeId,
+                                           duration,
+                                           &AbstractWifiMac::Deliver,
+                                           receiver.mac,
+                                           queued.mpdu);
+        }
+        else if (++queued.retries < m_retryLimit)
+        {
+            m_txopFailed.push_back(queued);
+        }
+        else
+        {
+            NS_LOG_DEBUG("Retry limit reached, dropping " << *queued.mpdu);
+            sender.mac->NotifyTxDrop(queued.mpdu->GetPacket());
+        }
+    }
+    NS_LOG_DEBUG("TXOP " << sender.mac->GetAddress() << "->" << to << ": " << mpdus.size()
+                         << " MPDUs, " << m_txopTxVector.GetMode() << ", SNR="
+                         << RatioToDb(snr) << "dB, duration=" << duration.As(Time::US));
+    m_txopReceiver = to;
+    m_txopEnd = Simulator::Schedule(duration, &AbstractWifiMedium::EndTxop, this);
+}
+
+void
+AbstractWifiMedium::EndTxop()
+{
+    NS_LOG_FUNCTION(this);
+    auto& sender = m_stations[m_txopSender];
+    const Time duration = Simulator::Now() - m_txopStart;
+    sender.airtime += duration;
+    m_totalAirtime += duration;
+    // the failed MPDUs are retransmitted first, in their original order
+    for (auto it = m_txopFailed.rbegin(); it != m_txopFailed.rend(); ++it)
+    {
+        sender.queue.push_front(*it);
+    }
+    m_txopFailed.clear();
+    m_txopTrace(sender.mac->GetAddress(),
+                m_txopReceiver,
+                m_txopTxVector,
+                duration,
+                m_txopNMpdus,
+                m_txopNReceived);
+    StartTxop();
+}
+
+} // namespace ns3
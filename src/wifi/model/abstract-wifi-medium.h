@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ABSTRACT_WIFI_MEDIUM_H
+#define ABSTRACT_WIFI_MEDIUM_H
+
+#include "qos-utils.h"
+#include "wifi-mode.h"
+#include "wifi-tx-vector.h"
+#include "wifi-units.h"
+
+#include "ns3/event-id.h"
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class AbstractWifiMac;
+class ErrorRateModel;
+class PropagationLossModel;
+class UniformRandomVariable;
+class WifiMpdu;
+class WifiPhy;
+
+/**
+ * @ingroup wifi
+ *
+ * @brief A shared medium that computes the outcome of each TXOP analytically
+ *
+ * This class replaces the frame exchange managers, the channel access
+ * managers, the rate control and the PHYs of a set of devices using an
+ * AbstractWifiMac, in order to simulate the throughput of large numbers of
+ * stations quickly.  Rather than simulating each frame, backoff slot and
+ * PHY reception, the medium serves the stations with queued frames in round
+ * robin order, one TXOP at a time, which gives each backlogged station the
+ * same share of TXOPs, as the long-term behavior of DCF/EDCA does.  For each
+ * TXOP:
+ *
+ *  - the SNR is computed from the TX power of the sender, the propagation
+ *    loss model of the medium and the thermal noise over the width of the
+ *    PPDU (i.e., 20 MHz for the non-HT OFDM modes);
+ *  - the transmission mode is the highest rate mode of the sender whose
+ *    MPDU error rate, given by the error rate model of the medium (a
+ *    TableBasedErrorRateModel by default), does not exceed PerThreshold;
+ *  - the frames queued for the same receiver are aggregated in an A-MPDU
+ *    (if the sender supports HT) up to its maximum A-MPDU size and to
+ *    MaxPpduDuration;
+ *  - the duration of the TXOP includes the AIFS given by the EDCA
+ *    parameters of the sender for the Access Category of the first frame,
+ *    the mean backoff, the PPDU, SIFS and the (Block)Ack;
+ *  - each MPDU is received successfully with the probability given by the
+ *    error rate model; failed MPDUs are retransmitted in a later TXOP, up to
+ *    RetryLimit times.
+ *
+ * Group addressed frames are sent alone, at the lowest rate, and are not
+ * retransmitted.  Collisions, hidden nodes and interference from other
+ * transmissions are not modeled.
+ */
+class AbstractWifiMedium : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    AbstractWifiMedium();
+    ~AbstractWifiMedium() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AbstractWifiMedium(const AbstractWifiMedium&) = delete;
+    AbstractWifiMedium& operator=(const AbstractWifiMedium&) = delete;
+
+    /**
+     * Attach a MAC to this medium. This method is called by
+     * AbstractWifiMac::SetMedium().
+     * @param mac the MAC
+     */
+    void Add(Ptr<AbstractWifiMac> mac);
+
+    /**
+     * Queue an MPDU for transmission.
+     * @param mac the MAC of the sender
+     * @param mpdu the MPDU
+     */
+    void Enqueue(Ptr<AbstractWifiMac> mac, Ptr<WifiMpdu> mpdu);
+
+    /**
+     * @return the number of MACs attached to this medium
+     */
+    std::size_t GetNMacs() const;
+
+    /**
+     * @param address the address of a MAC attached to this medium
+     * @return the total duration of the TXOPs of that MAC
+     */
+    Time GetAirtime(Mac48Address address) const;
+
+    /**
+     * @param address the address of a MAC attached to this medium
+     * @return the ratio of the airtime of that MAC to the total airtime, or
+     *         zero if the medium has not been used yet
+     */
+    double GetAirtimeShare(Mac48Address address) const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model.
+     *
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * TracedCallback signature for the end of a TXOP.
+     *
+     * @param sender the address of the sender
+     * @param receiver the address of the receiver
+     * @param txVector the TXVECTOR of the data frame
+     * @param duration the duration of the TXOP
+     * @param nMpdus the number of MPDUs transmitted
+     * @param nReceived the number of MPDUs received successfully
+     */
+    typedef void (*TxopTracedCallback)(Mac48Address sender,
+                                       Mac48Address receiver,
+                                       const WifiTxVector& txVector,
+                                       Time duration,
+                                       uint32_t nMpdus,
+                                       uint32_t nReceived);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// An MPDU waiting for transmission
+    struct QueuedMpdu
+    {
+        Ptr<WifiMpdu> mpdu; //!< The MPDU
+        uint32_t retries;   //!< Number of failed transmissions
+    };
+
+    /// A MAC attached to the medium
+    struct Station
+    {
+        Ptr<AbstractWifiMac> mac;     //!< The MAC
+        std::deque<QueuedMpdu> queue; //!< MPDUs waiting for transmission
+        Time airtime;                 //!< Total duration of the TXOPs of the station
+    };
+
+    /**
+     * Start the next TXOP, if any station has queued MPDUs.
+     */
+    void StartTxop();
+
+    /**
+     * End the current TXOP and start the next one.
+     */
+    void EndTxop();
+
+    /**
+     * @param phy the PHY of the sender
+     * @param mode the transmission mode
+     * @return the TXVECTOR to use for the given mode
+     */
+    WifiTxVector GetTxVector(Ptr<WifiPhy> phy, WifiMode mode) const;
+
+    /**
+     * @param sender the sending station
+     * @param receiver the receiving station
+     * @return the power received by the receiver
+     */
+    Watt_u GetRxPower(const Station& sender, const Station& receiver) const;
+
+    /**
+     * @param rxPower the power received by the receiver
+     * @param txVector the TXVECTOR of the PPDU, whose channel width sets the
+     *        noise bandwidth (20 MHz for the non-HT OFDM modes)
+     * @return the SNR (linear) at the receiver
+     */
+    double GetSnr(Watt_u rxPower, const WifiTxVector& txVector) const;
+
+    /**
+     * Select the highest rate transmission mode whose MPDU error rate does
+     * not exceed the threshold.
+     *
+     * @param phy the PHY of the sender
+     * @param rxPower the power received by the receiver
+     * @param mpduSize the size of the MPDUs (bytes)
+     * @return the TXVECTOR to use
+     */
+    WifiTxVector SelectTxVector(Ptr<WifiPhy> phy, Watt_u rxPower, uint32_t mpduSize) const;
+
+    /**
+     * @param txVector the TXVECTOR of the data frame
+     * @param snr the SNR (linear) at the receiver
+     * @param mpduSize the size of the MPDU (bytes)
+     * @return the probability that the MPDU is received successfully
+     */
+    double GetSuccessRate(const WifiTxVector& txVector, double snr, uint32_t mpduSize) const;
+
+    /// Maximum number of MPDUs in a TXOP (size of the Block Ack bitmap)
+    static constexpr std::size_t MAX_MPDUS_PER_TXOP = 64;
+
+    Ptr<PropagationLossModel> m_loss;     //!< Propagation loss model
+    Ptr<ErrorRateModel> m_errorRateModel; //!< Error rate model
+    dB_u m_noiseFigure;                   //!< Noise figure of the receivers
+    double m_perThreshold;                //!< Maximum MPDU error rate of the selected mode
+    Time m_maxPpduDuration;               //!< Maximum duration of a data PPDU
+    double m_meanBackoffSlots;            //!< Mean number of backoff slots before a TXOP
+    uint32_t m_retryLimit;                //!< Maximum number of transmissions of an MPDU
+    uint32_t m_maxQueueSize;              //!< Maximum number of queued MPDUs per station
+    Ptr<UniformRandomVariable> m_uniform; //!< Outcome of the MPDU transmissions
+
+    std::vector<Station> m_stations;                                      //!< Attached MACs
+    std::unordered_map<Mac48Address, std::size_t, WifiAddressHash> m_index; //!< MACs by address
+    std::size_t m_next;  //!< Index of the first station considered for the next TXOP
+    EventId m_txopEnd;   //!< End of the ongoing TXOP
+    Time m_totalAirtime; //!< Total duration of the TXOPs
+
+    std::size_t m_txopSender;             //!< Index of the sender of the ongoing TXOP
+    Mac48Address m_txopReceiver;          //!< Receiver of the ongoing TXOP
+    Time m_txopStart;                     //!< Start of the ongoing TXOP
+    WifiTxVector m_txopTxVector;          //!< TXVECTOR of the data frame of the ongoing TXOP
+    uint32_t m_txopNMpdus;                //!< Number of MPDUs sent in the ongoing TXOP
+    uint32_t m_txopNReceived;             //!< Number of MPDUs received in the ongoing TXOP
+    std::vector<QueuedMpdu> m_txopFailed; //!< MPDUs to retransmit after the ongoing TXOP
+
+    /// Trace fired at the end of each TXOP
+    TracedCallback<Mac48Address, Mac48Address, const WifiTxVector&, Time, uint32_t, uint32_t>
+        m_txopTrace;
+};
+
+} // namespace ns3
+
+#endif /* ABSTRACT_WIFI_MEDIUM_H */
@@ -194,6 +194,16 @@ ChannelAccessManager::GetTypeId()
                           UintegerValue(0),
                           MakeUintegerAccessor(&ChannelAccessManager::m_nSlotsLeft),
                           MakeUintegerChecker<uint8_t>())
+            .AddAttribute("LazyAccessTimeout",
+                          "Specify whether the access timeout is moved to the expected end of "
+                          "the backoff procedure as soon as the medium becomes busy, rather than "
+                          "being left to expire while the medium is busy and being rescheduled "
+                          "at that time. The outcome of the contention is the same, but a single "
+                          "event is scheduled per contention round. This attribute is ignored "
+                          "if NSlotsLeft is not zero.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ChannelAccessManager::m_lazyAccessTimeout),
+                          MakeBooleanChecker())
             .AddTraceSource("NSlotsLeftAlert",
                             "The backoff counter of the AC with the given index reached the "
                             "threshold set through the NSlotsLeft attribute.",
@@ -212,6 +222,7 @@ ChannelAccessManager::ChannelAccessManager()
       m_lastSwitchingEnd(0),
       m_sleeping(false),
       m_off(false),
+      m_lazyAccessTimeout(false),
       m_linkId(0)
 {
     NS_LOG_FUNCTION(this);
@@ -811,8 +822,23 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
             }
         }
 
-        if (m_accessTimeout.IsPending() &&
-            Simulator::GetDelayLeft(m_accessTimeout) > expectedBackoffDelay)
+        if (m_lazyAccessTimeout && m_nSlotsLeft == 0)
+        {
+            // if the access timeout is pending and expires before the expected backoff end,
+            // it would be rescheduled at the expected backoff end when expiring; if it expires
+            // later, it is rescheduled at the expected backoff end now
+            UpdateNominalAccessTimeout();
+            m_nominalAccessTimeout = m_accessTimeout.IsPending()
+                                         ? std::min(m_nominalAccessTimeout, expectedBackoffEnd)
+                                         : expectedBackoffEnd;
+            if (m_accessTimeout.IsPending() &&
+                Simulator::GetDelayLeft(m_accessTimeout) != expectedBackoffDelay)
+            {
+                Simulator::Remove(m_accessTimeout);
+            }
+        }
+        else if (m_accessTimeout.IsPending() &&
+                 Simulator::GetDelayLeft(m_accessTimeout) > expectedBackoffDelay)
         {
             m_accessTimeout.Cancel();
         }
@@ -825,6 +851,64 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
     }
 }
 
+void
+ChannelAccessManager::UpdateNominalAccessTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_accessTimeout.IsPending() && m_nominalAccessTimeout <= Simulator::Now())
+    {
+        // without LazyAccessTimeout, the access timeout would have expired at the nominal
+        // time and would have been rescheduled at the expected backoff end computed at that
+        // time, which is when the pending access timeout expires
+        m_nominalAccessTimeout = Simulator::Now() + Simulator::GetDelayLeft(m_accessTimeout);
+    }
+}
+
+void
+ChannelAccessManager::MoveAccessTimeoutIfNeeded()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_lazyAccessTimeout || m_nSlotsLeft > 0 || !m_accessTimeout.IsPending())
+    {
+        return;
+    }
+    UpdateNominalAccessTimeout();
+    /**
+     * Without LazyAccessTimeout, the pending access timeout would expire at the nominal time
+     * and, if no Txop could be granted access at that time, would be rescheduled at the
+     * expected backoff end computed given the current state of the medium. Hence, move the
+     * access timeout directly to the latter time. If a Txop may be granted access now, the
+     * pending access timeout is left untouched.
+     */
+    auto expectedBackoffEnd = Simulator::GetMaximumSimulationTime();
+    const auto accessGrantStart = GetAccessGrantStart();
+    const auto now = Simulator::Now();
+    for (auto txop : m_txops)
+    {
+        if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED)
+        {
+            const auto backoffEnd = GetBackoffEndFor(txop, accessGrantStart);
+            if (backoffEnd <= now)
+            {
+                return;
+            }
+            expectedBackoffEnd = std::min(expectedBackoffEnd, backoffEnd);
+        }
+    }
+    const auto accessTimeout = std::max(m_nominalAccessTimeout, expectedBackoffEnd);
+    if (now + Simulator::GetDelayLeft(m_accessTimeout) == accessTimeout)
+    {
+        return;
+    }
+    Simulator::Remove(m_accessTimeout);
+    if (accessTimeout < Simulator::GetMaximumSimulationTime())
+    {
+        NS_LOG_DEBUG("access timeout moved to " << accessTimeout.As(Time::US));
+        m_accessTimeout =
+            Simulator::Schedule(accessTimeout - now, &ChannelAccessManager::AccessTimeout, this);
+    }
+}
+
 MHz_u
 ChannelAccessManager::GetLargestIdlePrimaryChannel(Time interval, Time end)
 {
@@ -920,6 +1004,7 @@ ChannelAccessManager::NotifyRxStartNow(Time duration)
     m_lastRx.start = Simulator::Now();
     m_lastRx.end = m_lastRx.start + duration;
     m_lastRxReceivedOk = true;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -929,6 +1014,7 @@ ChannelAccessManager::NotifyRxEndOkNow()
     NS_LOG_DEBUG("rx end ok");
     m_lastRx.end = Simulator::Now();
     m_lastRxReceivedOk = true;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -939,6 +1025,7 @@ ChannelAccessManager::NotifyRxEndErrorNow()
     // we expect the PHY to notify us of the start of a CCA busy period, if needed
     m_lastRx.end = Simulator::Now();
     m_lastRxReceivedOk = false;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -961,6 +1048,7 @@ ChannelAccessManager::NotifyTxStartNow(Time duration)
     NS_LOG_DEBUG("tx start for " << duration);
     UpdateBackoff();
     m_lastTxEnd = now + duration;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -1001,6 +1089,7 @@ ChannelAccessManager::NotifyCcaBusyStartNow(Time duration,
             }
         }
     }
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -1188,6 +1277,7 @@ ChannelAccessManager::NotifyNavStartNow(Time duration)
     NS_LOG_DEBUG("nav start for=" << duration);
     UpdateBackoff();
     m_lastNavEnd = std::max(m_lastNavEnd, Simulator::Now() + duration);
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -1196,6 +1286,7 @@ ChannelAccessManager::NotifyAckTimeoutStartNow(Time duration)
     NS_LOG_FUNCTION(this << duration);
     NS_ASSERT(m_lastAckTimeoutEnd < Simulator::Now());
     m_lastAckTimeoutEnd = Simulator::Now() + duration;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -1211,6 +1302,7 @@ ChannelAccessManager::NotifyCtsTimeoutStartNow(Time duration)
 {
     NS_LOG_FUNCTION(this << duration);
     m_lastCtsTimeoutEnd = Simulator::Now() + duration;
+    MoveAccessTimeoutIfNeeded();
 }
 
 void
@@ -420,6 +420,21 @@ class ChannelAccessManager : public Object
 
     void DoRestartAccessTimeoutIfNeeded();
 
+    /**
+     * If the LazyAccessTimeout attribute is set, move the pending access timeout (if any)
+     * to the time at which it would be rescheduled if it were not moved, i.e., the time
+     * the backoff of the first Txop requesting access is now expected to end. This method
+     * is called when the state of the medium changes, so that the access timeout does not
+     * expire while the medium is busy.
+     */
+    void MoveAccessTimeoutIfNeeded();
+
+    /**
+     * If the nominal access timeout has elapsed while the access timeout is pending, set
+     * the nominal access timeout to the time the pending access timeout expires.
+     */
+    void UpdateNominalAccessTimeout();
+
     /**
      * Called when access timeout should occur
      * (e.g. backoff procedure expired).
@@ -490,6 +505,10 @@ class ChannelAccessManager : public Object
                                   //!< provided that the queue is not actually empty
     bool m_proactiveBackoff; //!< whether a new backoff value is generated when a CCA busy period
                              //!< starts and the backoff counter is zero
+    bool m_lazyAccessTimeout; //!< whether the access timeout is moved when the medium becomes
+                              //!< busy rather than left to expire while the medium is busy
+    Time m_nominalAccessTimeout; //!< the time at which the access timeout would expire if
+                                 //!< LazyAccessTimeout were not set
 
     /// Information associated with each PHY that is going to operate on another EMLSR link
     struct EmlsrLinkSwitchInfo
@@ -13,6 +13,9 @@
 
 #include "ns3/object.h"
 
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -130,6 +133,9 @@ class InterferenceHelper : public Object
      */
     static TypeId GetTypeId();
 
+    /// Boltzmann constant (J/K), used to compute the thermal noise at 290K
+    static constexpr double BOLTZMANN = 1.3803e-23;
+
     /**
      * Add a frequency band.
      *
@@ -391,9 +397,11 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * NiChanges of a band, sorted by time. NiChanges occurring at the same time are kept in
+     * insertion order. They are stored contiguously, since they are mostly scanned in order
+     * and the number of NiChanges is kept small by pruning the ones preceding a new reception.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
 
     /**
      * Map of NiChanges per band
@@ -440,13 +448,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param [out] ni the NiChanges of the band occurring during the event
      * @param band the band
      *
      * @return noise and interference power
      */
     Watt_u CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
+                                       NiChanges& ni,
                                        const WifiSpectrumBandInfo& band) const;
 
     /**
@@ -468,7 +476,7 @@ class InterferenceHelper : public Object
      *
      * @param event the event
      * @param channelWidth the channel width used to transmit the PSDU
-     * @param nis the NiChanges
+     * @param ni the NiChanges of the band occurring during the event
      * @param band identify the band used by the PSDU
      * @param staId the station ID of the PSDU (only used for MU)
      * @param window time window (pair of start and end times) of PHY payload to focus on
@@ -477,7 +485,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                MHz_u channelWidth,
-                               NiChangesPerBand* nis,
+                               const NiChanges& ni,
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -486,7 +494,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param ni the NiChanges of the band occurring during the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param header the PHY header to consider
@@ -494,7 +502,7 @@ class InterferenceHelper : public Object
      * @return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 const NiChanges& ni,
                                  MHz_u channelWidth,
                                  const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
@@ -502,7 +510,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param ni the NiChanges of the band occurring during the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
@@ -510,7 +518,7 @@ class InterferenceHelper : public Object
      * @return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        const NiChanges& ni,
                                         MHz_u channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
@@ -528,6 +536,14 @@ class InterferenceHelper : public Object
      * @returns an iterator to the list of NiChanges
      */
     NiChanges::iterator GetNextPosition(Time moment, NiChangesPerBand::iterator niIt);
+    /**
+     * Returns an iterator to the first NiChange that is not earlier than moment
+     *
+     * @param moment time to check from
+     * @param nis the NiChanges of the band to check
+     * @returns an iterator to the list of NiChanges
+     */
+    static NiChanges::const_iterator GetFirstPosition(Time moment, const NiChanges& nis);
     /**
      * Returns an iterator to the last NiChange that is before than moment
      *
@@ -538,8 +554,9 @@ class InterferenceHelper : public Object
     NiChanges::iterator GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt);
 
     /**
-     * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * Add NiChange to the list at the appropriate position (after the NiChanges occurring at
+     * the same time) and return the iterator of the new event. The iterators to the NiChanges
+     * of the band are invalidated.
      *
      * @param moment time to check from
      * @param change the NiChange to add
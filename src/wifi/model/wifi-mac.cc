@@ -554,7 +554,10 @@ WifiMac::SetPromisc()
 {
     for (auto& [id, link] : m_links)
     {
-        link->feManager->SetPromisc();
+        if (link->feManager)
+        {
+            link->feManager->SetPromisc();
+        }
     }
 }
 
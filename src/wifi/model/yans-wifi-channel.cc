@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -21,6 +22,7 @@
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
 
 namespace ns3
 {
@@ -46,11 +48,22 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The distance (in meters) beyond which a transmission is not delivered "
+                          "to a PHY, without computing its propagation loss. It should be set "
+                          "to a distance at which the received power is always negligible, "
+                          "e.g., below the noise floor. Note that skipping the loss computation "
+                          "of the PHYs out of range changes the draws of the random variables "
+                          "of a stochastic propagation loss model. Zero means no limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -81,44 +94,103 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    std::vector<Ptr<YansWifiPhy>> receivers;
+    std::vector<Ptr<MobilityModel>> receiverMobilities;
+    auto addReceiver = [&](const Ptr<YansWifiPhy>& phy) {
+        if (phy == sender)
+        {
+            return;
+        }
+        // For now don't account for inter channel interference nor channel bonding
+        if (phy->GetChannelNumber() != sender->GetChannelNumber())
+        {
+            return;
+        }
+        receivers.push_back(phy);
+        receiverMobilities.push_back(phy->GetMobility()->GetObject<MobilityModel>());
+    };
+
+    if (m_maxRange <= 0)
+    {
+        for (const auto& phy : m_phyList)
+        {
+            addReceiver(phy);
+        }
+    }
+    else
     {
-        if (sender != (*i))
+        if (!m_index)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            m_index = Create<SpatialGridIndex>(m_maxRange);
+            for (const auto& phy : m_phyList)
             {
-                continue;
+                m_index->Add(phy->GetMobility());
             }
+        }
+        // the identifiers are the indices in m_phyList, in increasing order, so that
+        // the receptions are scheduled in the same order as without the index
+        std::vector<uint32_t> ids;
+        m_index->GetItemsWithinDistance(senderMobility->GetPosition(), m_maxRange, ids);
+        NS_LOG_DEBUG(ids.size() << " of " << m_phyList.size() << " PHYs within " << m_maxRange
+                                << "m");
+        for (auto id : ids)
+        {
+            addReceiver(m_phyList[id]);
+        }
+    }
 
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
+    if (receivers.empty())
+    {
+        return;
+    }
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
-        }
+    // the received powers of all the receivers are computed in a single call,
+    // which lets the loss models process the receivers in a batch
+    std::vector<double> rxPowers;
+    m_loss->CalcRxPowers(txPower, senderMobility, receiverMobilities, rxPowers);
+    for (std::size_t i = 0; i < receivers.size(); i++)
+    {
+        Transmit(senderMobility,
+                 receivers[i],
+                 receiverMobilities[i],
+                 ppdu,
+                 txPower,
+                 dBm_u{rxPowers[i]});
     }
 }
 
+void
+YansWifiChannel::Transmit(Ptr<MobilityModel> senderMobility,
+                          Ptr<YansWifiPhy> receiver,
+                          Ptr<MobilityModel> receiverMobility,
+                          Ptr<const WifiPpdu> ppdu,
+                          dBm_u txPower,
+                          dBm_u rxPower) const
+{
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPower);
+}
+
 void
 YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, dBm_u rxPower)
 {
@@ -158,6 +230,7 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    m_index = nullptr;
 }
 
 int64_t
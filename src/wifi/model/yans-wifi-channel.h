@@ -16,9 +16,11 @@
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
+class SpatialGridIndex;
 class YansWifiPhy;
 class Packet;
 class Time;
@@ -32,6 +34,13 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * When the MaxRange attribute is set, the channel only delivers a PPDU to
+ * the PHYs whose distance from the sender is at most MaxRange; the others
+ * are skipped before any propagation loss or delay computation.  The PHYs
+ * are located through a SpatialGridIndex, so that the cost of a
+ * transmission grows with the number of PHYs in range rather than with the
+ * number of PHYs attached to the channel.
  */
 class YansWifiChannel : public Channel
 {
@@ -104,9 +113,30 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
-    PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
-    Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
-    Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    /**
+     * Schedule the reception of a PPDU by a receiver, after the propagation
+     * delay from the sender.
+     *
+     * @param senderMobility the mobility model of the sender
+     * @param receiver the PHY object to which the packet is delivered
+     * @param receiverMobility the mobility model of the receiver
+     * @param ppdu the PPDU to send
+     * @param txPower the TX power associated to the packet
+     * @param rxPower the RX power of the packet at the receiver
+     */
+    void Transmit(Ptr<MobilityModel> senderMobility,
+                  Ptr<YansWifiPhy> receiver,
+                  Ptr<MobilityModel> receiverMobility,
+                  Ptr<const WifiPpdu> ppdu,
+                  dBm_u txPower,
+                  dBm_u rxPower) const;
+
+    /// List of YansWifiPhys connected to this YansWifiChannel
+    PhyList m_phyList;
+    Ptr<PropagationLossModel> m_loss;      //!< Propagation loss model
+    Ptr<PropagationDelayModel> m_delay;    //!< Propagation delay model
+    double m_maxRange;                     //!< Maximum range of a transmission (0 if unlimited)
+    mutable Ptr<SpatialGridIndex> m_index; //!< Index of the PHYs, built on the first Send
 };
 
 } // namespace ns3
@@ -8,6 +8,7 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-access-manager.h"
 #include "ns3/config.h"
 #include "ns3/frame-exchange-manager.h"
@@ -232,7 +233,12 @@ template <typename TxopType>
 class ChannelAccessManagerTest : public TestCase
 {
   public:
-    ChannelAccessManagerTest();
+    /**
+     * Constructor
+     * @param lazyAccessTimeout the value of the LazyAccessTimeout attribute of the
+     *                          ChannelAccessManager
+     */
+    ChannelAccessManagerTest(bool lazyAccessTimeout = false);
     void DoRun() override;
 
     /**
@@ -421,6 +427,7 @@ class ChannelAccessManagerTest : public TestCase
     Ptr<SpectrumWifiPhy> m_phy;                           //!< the PHY object
     TxopTests m_txop;                                     //!< the vector of Txop test instances
     uint32_t m_ackTimeoutValue;                           //!< the Ack timeout value
+    bool m_lazyAccessTimeout; //!< the value of the LazyAccessTimeout attribute
 };
 
 template <typename TxopType>
@@ -480,8 +487,10 @@ TxopTest<TxopType>::NotifyWakeUp(uint8_t linkId)
 }
 
 template <typename TxopType>
-ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest()
-    : TestCase("ChannelAccessManager")
+ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest(bool lazyAccessTimeout)
+    : TestCase(std::string("ChannelAccessManager") +
+               (lazyAccessTimeout ? " with lazy access timeout" : "")),
+      m_lazyAccessTimeout(lazyAccessTimeout)
 {
 }
 
@@ -618,6 +627,7 @@ ChannelAccessManagerTest<TxopType>::StartTest(uint64_t slotTime,
                                               MHz_u chWidth)
 {
     m_ChannelAccessManager = CreateObject<ChannelAccessManagerStub>();
+    m_ChannelAccessManager->SetAttribute("LazyAccessTimeout", BooleanValue(m_lazyAccessTimeout));
     m_feManager = CreateObject<FrameExchangeManagerStub<TxopType>>(this);
     m_ChannelAccessManager->SetupFrameExchangeManager(m_feManager);
     m_ChannelAccessManager->SetSlot(MicroSeconds(slotTime));
@@ -2025,6 +2035,7 @@ TxopTestSuite::TxopTestSuite()
     : TestSuite("wifi-devices-dcf", Type::UNIT)
 {
     AddTestCase(new ChannelAccessManagerTest<Txop>, TestCase::Duration::QUICK);
+    AddTestCase(new ChannelAccessManagerTest<Txop>(true), TestCase::Duration::QUICK);
 }
 
 static TxopTestSuite g_dcfTestSuite;
@@ -2045,6 +2056,7 @@ QosTxopTestSuite::QosTxopTestSuite()
     : TestSuite("wifi-devices-edca", Type::UNIT)
 {
     AddTestCase(new ChannelAccessManagerTest<QosTxop>, TestCase::Duration::QUICK);
+    AddTestCase(new ChannelAccessManagerTest<QosTxop>(true), TestCase::Duration::QUICK);
 }
 
 static QosTxopTestSuite g_edcaTestSuite;
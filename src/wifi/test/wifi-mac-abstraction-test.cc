@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/abstract-wifi-mac.h"
+#include "ns3/abstract-wifi-medium.h"
+#include "ns3/channel-access-manager.h"
+#include "ns3/double.h"
+#include "ns3/frame-exchange-manager.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <map>
+#include <string>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiMacAbstractionTest");
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the MAC abstraction enabled by WifiHelper::SetMacAbstraction
+ *
+ * Three stations, at increasing distances from a fourth one, each send the same
+ * number of packets to it. The test checks that all the packets are received
+ * and that the farthest station uses a lower rate, hence more TXOPs and a
+ * larger share of the airtime, than the nearest one.
+ */
+class WifiMacAbstractionTest : public TestCase
+{
+  public:
+    WifiMacAbstractionTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when a TXOP ends.
+     * @param sender the address of the sender
+     * @param receiver the address of the receiver
+     * @param txVector the TXVECTOR of the data frame
+     * @param duration the duration of the TXOP
+     * @param nMpdus the number of MPDUs transmitted
+     * @param nReceived the number of MPDUs received successfully
+     */
+    void TxopEnded(Mac48Address sender,
+                   Mac48Address receiver,
+                   const WifiTxVector& txVector,
+                   Time duration,
+                   uint32_t nMpdus,
+                   uint32_t nReceived);
+
+    /**
+     * Callback invoked when a packet is received by the destination.
+     * @param device the receiving device
+     * @param packet the packet
+     * @param protocol the protocol number
+     * @param from the address of the sender
+     * @return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    static constexpr uint32_t N_PACKETS = 200; ///< Number of packets sent by each station
+
+    std::map<Mac48Address, uint32_t> m_nTxops;    ///< Number of TXOPs per sender
+    std::map<Mac48Address, uint64_t> m_maxRate;   ///< Highest data rate used per sender
+    std::map<Mac48Address, uint32_t> m_nReceived; ///< Number of packets received per sender
+};
+
+WifiMacAbstractionTest::WifiMacAbstractionTest()
+    : TestCase("Test the abstraction of the MAC and PHY layers")
+{
+}
+
+void
+WifiMacAbstractionTest::TxopEnded(Mac48Address sender,
+                                  Mac48Address receiver,
+                                  const WifiTxVector& txVector,
+                                  Time duration,
+                                  uint32_t nMpdus,
+                                  uint32_t nReceived)
+{
+    NS_TEST_EXPECT_MSG_GT(nMpdus, 0, "A TXOP must carry at least one MPDU");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(nReceived, nMpdus, "More MPDUs received than transmitted");
+    m_nTxops[sender]++;
+    m_maxRate[sender] = std::max(m_maxRate[sender], txVector.GetMode().GetDataRate(txVector));
+}
+
+bool
+WifiMacAbstractionTest::Receive(Ptr<NetDevice> device,
+                                Ptr<const Packet> packet,
+                                uint16_t protocol,
+                                const Address& from)
+{
+    m_nReceived[Mac48Address::ConvertFrom(from)]++;
+    return true;
+}
+
+void
+WifiMacAbstractionTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes(4);
+    MobilityHelper mobility;
+    auto positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    positions->Add(Vector(5, 0, 0));
+    positions->Add(Vector(20, 0, 0));
+    positions->Add(Vector(60, 0, 0));
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(nodes);
+
+    auto medium = CreateObjectWithAttributes<AbstractWifiMedium>(
+        "PropagationLossModel",
+        PointerValue(CreateObject<LogDistancePropagationLossModel>()));
+    medium->TraceConnectWithoutContext("Txop",
+                                       MakeCallback(&WifiMacAbstractionTest::TxopEnded, this));
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetMacAbstraction(medium);
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    WifiHelper::AssignStreams(devices, 100);
+
+    NS_TEST_ASSERT_MSG_EQ(medium->GetNMacs(), 4, "All the MACs should be attached to the medium");
+    auto dst = DynamicCast<WifiNetDevice>(devices.Get(0));
+    NS_TEST_ASSERT_MSG_NE(DynamicCast<AbstractWifiMac>(dst->GetMac()),
+                          nullptr,
+                          "The MAC type set on the WifiMacHelper should be replaced");
+    NS_TEST_EXPECT_MSG_EQ(dst->GetMac()->GetChannelAccessManager(),
+                          nullptr,
+                          "No channel access manager should be created");
+    NS_TEST_EXPECT_MSG_EQ(dst->GetMac()->GetFrameExchangeManager(),
+                          nullptr,
+                          "No frame exchange manager should be created");
+    NS_TEST_EXPECT_MSG_EQ(dst->GetPhy()->GetChannel(),
+                          nullptr,
+                          "The PHY should not be attached to the channel");
+    dst->SetReceiveCallback(MakeCallback(&WifiMacAbstractionTest::Receive, this));
+
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        auto device = devices.Get(i);
+        Simulator::Schedule(MilliSeconds(100), [device, dst]() {
+            for (uint32_t n = 0; n < N_PACKETS; n++)
+            {
+                device->Send(Create<Packet>(1000), dst->GetAddress(), 0x0800);
+            }
+        });
+    }
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    std::vector<Mac48Address> senders;
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        senders.push_back(Mac48Address::ConvertFrom(devices.Get(i)->GetAddress()));
+    }
+    for (const auto& sender : senders)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nReceived[sender],
+                              N_PACKETS,
+                              "Wrong number of packets received from " << sender);
+    }
+    // the near station aggregates more MPDUs per TXOP, since it uses a higher rate
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_nTxops[senders[0]],
+                                m_nTxops[senders[2]],
+                                "The near station should need fewer TXOPs");
+    NS_TEST_EXPECT_MSG_GT(m_maxRate[senders[0]],
+                          m_maxRate[senders[2]],
+                          "The near station should use a higher rate");
+    double nearShare = medium->GetAirtimeShare(senders[0]);
+    double farShare = medium->GetAirtimeShare(senders[2]);
+    NS_TEST_EXPECT_MSG_GT(farShare, nearShare, "The far station should use more airtime");
+    double totalShare = nearShare + medium->GetAirtimeShare(senders[1]) + farShare;
+    NS_TEST_EXPECT_MSG_EQ_TOL(totalShare, 1.0, 1e-9, "The airtime shares should sum to one");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the duration of a TXOP of the MAC abstraction
+ *
+ * A station sends a group addressed frame, whose TXOP is made of the AIFS
+ * given by the AIFSN configured for AC_BE and of the PPDU, sent at the lowest
+ * rate over 20 MHz, since the mean backoff is set to zero.
+ */
+class WifiMacAbstractionAifsTest : public TestCase
+{
+  public:
+    WifiMacAbstractionAifsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when a TXOP ends.
+     * @param sender the address of the sender
+     * @param receiver the address of the receiver
+     * @param txVector the TXVECTOR of the data frame
+     * @param duration the duration of the TXOP
+     * @param nMpdus the number of MPDUs transmitted
+     * @param nReceived the number of MPDUs received successfully
+     */
+    void TxopEnded(Mac48Address sender,
+                   Mac48Address receiver,
+                   const WifiTxVector& txVector,
+                   Time duration,
+                   uint32_t nMpdus,
+                   uint32_t nReceived);
+
+    static constexpr uint8_t AIFSN = 7;           ///< AIFSN of AC_BE
+    static constexpr uint32_t PACKET_SIZE = 1000; ///< Size of the packet sent
+
+    Ptr<WifiPhy> m_phy;   ///< PHY of the sender
+    uint32_t m_nTxops{0}; ///< Number of TXOPs
+};
+
+WifiMacAbstractionAifsTest::WifiMacAbstractionAifsTest()
+    : TestCase("Test the AIFS of the TXOPs of the MAC abstraction")
+{
+}
+
+void
+WifiMacAbstractionAifsTest::TxopEnded(Mac48Address sender,
+                                      Mac48Address receiver,
+                                      const WifiTxVector& txVector,
+                                      Time duration,
+                                      uint32_t nMpdus,
+                                      uint32_t nReceived)
+{
+    m_nTxops++;
+    NS_TEST_EXPECT_MSG_EQ(txVector.GetChannelWidth(),
+                          MHz_u{20},
+                          "A non-HT PPDU should be sent over 20 MHz");
+    // LLC header, QoS Data header and FCS
+    const uint32_t mpduSize = PACKET_SIZE + 8 + 26 + 4;
+    const Time expected = m_phy->GetSifs() + AIFSN * m_phy->GetSlot() +
+                          WifiPhy::CalculateTxDuration(mpduSize, txVector, m_phy->GetPhyBand());
+    NS_TEST_EXPECT_MSG_EQ(duration, expected, "Wrong TXOP duration");
+}
+
+void
+WifiMacAbstractionAifsTest::DoRun()
+{
+    NodeContainer nodes(2);
+    MobilityHelper mobility;
+    mobility.Install(nodes);
+
+    auto medium = CreateObjectWithAttributes<AbstractWifiMedium>(
+        "PropagationLossModel",
+        PointerValue(CreateObject<LogDistancePropagationLossModel>()),
+        "MeanBackoffSlots",
+        DoubleValue(0));
+    medium->TraceConnectWithoutContext("Txop",
+                                       MakeCallback(&WifiMacAbstractionAifsTest::TxopEnded, this));
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetEdca(AC_BE, "Aifsns", StringValue(std::to_string(AIFSN)));
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetMacAbstraction(medium);
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    WifiHelper::AssignStreams(devices, 100);
+
+    auto src = DynamicCast<WifiNetDevice>(devices.Get(1));
+    m_phy = src->GetPhy();
+    Simulator::Schedule(MilliSeconds(100), [src]() {
+        src->Send(Create<Packet>(PACKET_SIZE), Mac48Address::GetBroadcast(), 0x0800);
+    });
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nTxops, 1, "Exactly one TXOP should take place");
+    m_phy = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief MAC abstraction Test Suite
+ */
+class WifiMacAbstractionTestSuite : public TestSuite
+{
+  public:
+    WifiMacAbstractionTestSuite();
+};
+
+WifiMacAbstractionTestSuite::WifiMacAbstractionTestSuite()
+    : TestSuite("wifi-mac-abstraction", Type::UNIT)
+{
+    AddTestCase(new WifiMacAbstractionTest(), TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacAbstractionAifsTest(), TestCase::Duration::QUICK);
+}
+
+static WifiMacAbstractionTestSuite g_wifiMacAbstractionTestSuite; ///< the test suite
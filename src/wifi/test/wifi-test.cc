@@ -420,6 +420,140 @@ InterferenceHelperSequenceTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * Check the noise and interference tracked by the InterferenceHelper when many
+ * overlapping signals are received, so that the NiChanges of the band are
+ * reallocated while the events are added.
+ */
+class InterferenceHelperNiChangesTest : public TestCase
+{
+  public:
+    InterferenceHelperNiChangesTest();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Add a signal of 20 us and 1 nW on the band
+     * @param helper the interference helper
+     */
+    void AddSignal(Ptr<InterferenceHelper> helper);
+    /**
+     * Check the time the energy on the band stays above some thresholds
+     * @param helper the interference helper
+     */
+    void CheckEnergyDuration(Ptr<InterferenceHelper> helper);
+
+    WifiSpectrumBandInfo m_band; ///< the band
+};
+
+InterferenceHelperNiChangesTest::InterferenceHelperNiChangesTest()
+    : TestCase("InterferenceHelper NiChanges with overlapping signals"),
+      m_band{{{0, 63}}, {{5170e6, 5190e6}}}
+{
+}
+
+void
+InterferenceHelperNiChangesTest::AddSignal(Ptr<InterferenceHelper> helper)
+{
+    RxPowerWattPerChannelBand rxPower{{m_band, 1e-9}};
+    helper->AddForeignSignal(MicroSeconds(20), rxPower, WHOLE_WIFI_SPECTRUM);
+}
+
+void
+InterferenceHelperNiChangesTest::CheckEnergyDuration(Ptr<InterferenceHelper> helper)
+{
+    // the 20 signals started every us and end every us from 20 us
+    NS_TEST_EXPECT_MSG_EQ(helper->GetEnergyDuration(20.5e-9, m_band),
+                          Time(0),
+                          "The energy should be below 20.5 nW");
+    NS_TEST_EXPECT_MSG_EQ(helper->GetEnergyDuration(19.5e-9, m_band),
+                          MicroSeconds(1),
+                          "The energy should stay above 19.5 nW until the first signal ends");
+    NS_TEST_EXPECT_MSG_EQ(helper->GetEnergyDuration(10.5e-9, m_band),
+                          MicroSeconds(10),
+                          "The energy should stay above 10.5 nW until 10 signals ended");
+    NS_TEST_EXPECT_MSG_EQ(helper->GetEnergyDuration(0.5e-9, m_band),
+                          MicroSeconds(20),
+                          "The energy should stay above 0.5 nW until the last signal ends");
+}
+
+void
+InterferenceHelperNiChangesTest::DoRun()
+{
+    auto helper = CreateObject<InterferenceHelper>();
+    helper->AddBand(m_band);
+    // while receiving, the NiChanges preceding a new signal are kept
+    helper->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i),
+                            &InterferenceHelperNiChangesTest::AddSignal,
+                            this,
+                            helper);
+    }
+    Simulator::Schedule(MicroSeconds(19),
+                        &InterferenceHelperNiChangesTest::CheckEnergyDuration,
+                        this,
+                        helper);
+    Simulator::Run();
+    helper->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * Check that a YansWifiChannel without propagation loss model can carry the
+ * transmissions of a PHY that has no receiver on the channel.
+ */
+class YansWifiChannelNoReceiverTest : public TestCase
+{
+  public:
+    YansWifiChannelNoReceiverTest();
+
+    void DoRun() override;
+};
+
+YansWifiChannelNoReceiverTest::YansWifiChannelNoReceiverTest()
+    : TestCase("YansWifiChannel without receiver nor propagation loss model")
+{
+}
+
+void
+YansWifiChannelNoReceiverTest::DoRun()
+{
+    auto channel = CreateObject<YansWifiChannel>();
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    phy->SetErrorRateModel(CreateObject<YansErrorRateModel>());
+    phy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    phy->SetChannel(channel);
+    phy->ConfigureStandard(WIFI_STANDARD_80211a);
+    NS_TEST_ASSERT_MSG_EQ(channel->GetNDevices(), 1, "The PHY should be attached to the channel");
+    // process the events scheduled while configuring the PHY
+    Simulator::Run();
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    auto ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(1000), hdr),
+                                 WifiTxVector(OfdmPhy::GetOfdmRate6Mbps(),
+                                              0,
+                                              WIFI_PREAMBLE_LONG,
+                                              NanoSeconds(800),
+                                              1,
+                                              1,
+                                              0,
+                                              MHz_u{20},
+                                              false),
+                                 phy->GetOperatingChannel());
+    channel->Send(phy, ppdu, dBm_u{16});
+    NS_TEST_EXPECT_MSG_EQ(Simulator::IsFinished(), true, "No reception should be scheduled");
+
+    phy->Dispose();
+    Simulator::Destroy();
+}
+
 //-----------------------------------------------------------------------------
 /**
  * Make sure that when multiple broadcast packets are queued on the same
@@ -3979,6 +4113,8 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new WifiTest, TestCase::Duration::QUICK);
     AddTestCase(new QosUtilsIsOldPacketTest, TestCase::Duration::QUICK);
     AddTestCase(new InterferenceHelperSequenceTest, TestCase::Duration::QUICK); // Bug 991
+    AddTestCase(new InterferenceHelperNiChangesTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelNoReceiverTest, TestCase::Duration::QUICK);
     AddTestCase(new DcfImmediateAccessBroadcastTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Bug730TestCase, TestCase::Duration::QUICK); // Bug 730
     AddTestCase(new QosFragmentationTestCase, TestCase::Duration::QUICK);
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the building lookups of the buildings module on
+// Manhattan grids of increasing numbers of buildings.  For each grid, it
+// reports the wall clock time needed to classify random positions as indoor
+// or outdoor with MobilityBuildingInfo, and to determine the line of sight
+// between random outdoor positions with BuildingsChannelConditionModel,
+// compared to a linear scan of the BuildingList (which the models used
+// before the spatial index of the buildings).  The results of both methods
+// are checked to be identical.
+// Sample usage:  ./ns3 run 'bench-buildings --counts=100,10000 --queries=100000'
+
+#include "ns3/abort.h"
+#include "ns3/building-list.h"
+#include "ns3/building.h"
+#include "ns3/buildings-channel-condition-model.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/mobility-building-info.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Run the benchmark on a grid of buildings.
+ * @param nBuildings the number of buildings
+ * @param nQueries the number of queries of each kind
+ */
+static void
+Run(uint32_t nBuildings, uint32_t nQueries)
+{
+    // square blocks of 50 m separated by streets of 20 m
+    const double block = 50;
+    const double street = 20;
+    auto side = static_cast<uint32_t>(std::ceil(std::sqrt(nBuildings)));
+    for (uint32_t i = 0; i < nBuildings; i++)
+    {
+        double x = (i % side) * (block + street);
+        double y = (i / side) * (block + street);
+        Ptr<Building> building = CreateObject<Building>();
+        building->SetBoundaries(Box(x, x + block, y, y + block, 0, 30));
+    }
+    const double size = side * (block + street);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> coordinate(-street, size);
+    std::vector<Vector> positions(nQueries);
+    for (auto& position : positions)
+    {
+        position = Vector(coordinate(rng), coordinate(rng), 1.5);
+    }
+    // outdoor positions, in the middle of a street
+    std::uniform_int_distribution<uint32_t> streetIndex(0, side);
+    std::vector<Vector> outdoor(nQueries);
+    for (auto& position : outdoor)
+    {
+        double s = streetIndex(rng) * (block + street) - street / 2;
+        position = (rng() % 2) ? Vector(s, coordinate(rng), 1.5) : Vector(coordinate(rng), s, 1.5);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    BuildingList::GetSpatialIndex();
+    int64_t indexMs = timer.End();
+
+    // indoor or outdoor
+    std::vector<bool> indoorScan(nQueries);
+    timer.Start();
+    for (uint32_t i = 0; i < nQueries; i++)
+    {
+        for (auto it = BuildingList::Begin(); it != BuildingList::End(); ++it)
+        {
+            if ((*it)->IsInside(positions[i]))
+            {
+                indoorScan[i] = true;
+                break;
+            }
+        }
+    }
+    int64_t indoorScanMs = timer.End();
+
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityBuildingInfo> info = CreateObject<MobilityBuildingInfo>();
+    mobility->AggregateObject(info);
+    uint32_t nIndoor = 0;
+    timer.Start();
+    for (uint32_t i = 0; i < nQueries; i++)
+    {
+        mobility->SetPosition(positions[i]);
+        NS_ABORT_IF(info->IsIndoor() != indoorScan[i]);
+        nIndoor += indoorScan[i];
+    }
+    int64_t indoorMs = timer.End();
+
+    // line of sight
+    std::vector<bool> blockedScan(nQueries);
+    timer.Start();
+    for (uint32_t i = 0; i < nQueries; i++)
+    {
+        const Vector& a = outdoor[i];
+        const Vector& b = outdoor[(i + 1) % nQueries];
+        for (auto it = BuildingList::Begin(); it != BuildingList::End(); ++it)
+        {
+            if ((*it)->IsIntersect(a, b))
+            {
+                blockedScan[i] = true;
+                break;
+            }
+        }
+    }
+    int64_t losScanMs = timer.End();
+
+    Ptr<BuildingsChannelConditionModel> condition =
+        CreateObject<BuildingsChannelConditionModel>();
+    Ptr<ConstantPositionMobilityModel> other = CreateObject<ConstantPositionMobilityModel>();
+    other->AggregateObject(CreateObject<MobilityBuildingInfo>());
+    timer.Start();
+    for (uint32_t i = 0; i < nQueries; i++)
+    {
+        mobility->SetPosition(outdoor[i]);
+        other->SetPosition(outdoor[(i + 1) % nQueries]);
+        bool blocked = condition->GetChannelCondition(mobility, other)->IsNlos();
+        NS_ABORT_IF(blocked != blockedScan[i]);
+    }
+    int64_t losMs = timer.End();
+
+    std::cout << std::setw(10) << nBuildings << std::setw(10) << indexMs << std::setw(10)
+              << nIndoor << std::setw(14) << indoorScanMs << std::setw(14) << indoorMs
+              << std::setw(14) << losScanMs << std::setw(14) << losMs << std::endl;
+
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string counts = "10,100,1000,10000";
+    uint32_t nQueries = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the building lookups on Manhattan grids.");
+    cmd.AddValue("counts", "comma-separated numbers of buildings", counts);
+    cmd.AddValue("queries", "number of queries of each kind", nQueries);
+    cmd.Parse(argc, argv);
+
+    if (nQueries == 0)
+    {
+        std::cerr << "There must be at least one query" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::setw(10) << "buildings" << std::setw(10) << "index ms" << std::setw(10)
+              << "indoor" << std::setw(14) << "in scan ms" << std::setw(14) << "in index ms"
+              << std::setw(14) << "los scan ms" << std::setw(14) << "los index ms" << std::endl;
+    std::istringstream list(counts);
+    std::string count;
+    while (std::getline(list, count, ','))
+    {
+        Run(std::stoul(count), nQueries);
+    }
+    return 0;
+}
@@ -0,0 +1,318 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks an FF MAC scheduler of the LTE module in isolation:
+// it reports the number of TTIs (one DL and one UL scheduling request each)
+// processed per second, for several numbers of UEs in the cell. All the UEs
+// always have data to transmit, report subband CQIs every 10 TTIs and
+// acknowledge all their DL transmissions.
+// Sample usage:  ./ns3 run 'bench-ff-mac-scheduler --scheduler=ns3::PssFfMacScheduler'
+
+#include "ns3/command-line.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/lte-ffr-sap.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * FF MAC CSCHED SAP user that ignores the confirmations of the scheduler.
+ */
+class CschedSapUserStub : public FfMacCschedSapUser
+{
+  public:
+    void CschedCellConfigCnf(const CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(const CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(const CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(const CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(const CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(const CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(const CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+};
+
+/**
+ * FF MAC SCHED SAP user that records the DL transmissions scheduled in each TTI.
+ */
+class SchedSapUserStub : public FfMacSchedSapUser
+{
+  public:
+    void SchedDlConfigInd(const SchedDlConfigIndParameters& params) override
+    {
+        for (const auto& data : params.m_buildDataList)
+        {
+            DlInfoListElement_s info;
+            info.m_rnti = data.m_rnti;
+            info.m_harqProcessId = data.m_dci.m_harqProcess;
+            info.m_harqStatus.resize(data.m_dci.m_ndi.size(), DlInfoListElement_s::ACK);
+            m_dlTx.push_back(info);
+        }
+    }
+
+    void SchedUlConfigInd(const SchedUlConfigIndParameters& params) override
+    {
+    }
+
+    std::vector<DlInfoListElement_s> m_dlTx; ///< DL transmissions scheduled in the last TTI
+};
+
+/**
+ * FFR SAP provider that makes all the resource blocks available to all the UEs.
+ */
+class FfrSapProviderStub : public LteFfrSapProvider
+{
+  public:
+    /**
+     * Constructor
+     * @param dlRbgNum the number of DL RBGs
+     * @param ulBandwidth the UL bandwidth in RBs
+     */
+    FfrSapProviderStub(uint16_t dlRbgNum, uint16_t ulBandwidth)
+        : m_dlRbgNum(dlRbgNum),
+          m_ulBandwidth(ulBandwidth)
+    {
+    }
+
+    std::vector<bool> GetAvailableDlRbg() override
+    {
+        return std::vector<bool>(m_dlRbgNum, false);
+    }
+
+    bool IsDlRbgAvailableForUe(int i, uint16_t rnti) override
+    {
+        return true;
+    }
+
+    std::vector<bool> GetAvailableUlRbg() override
+    {
+        return std::vector<bool>(m_ulBandwidth, false);
+    }
+
+    bool IsUlRbgAvailableForUe(int i, uint16_t rnti) override
+    {
+        return true;
+    }
+
+    void ReportDlCqiInfo(const FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params) override
+    {
+    }
+
+    void ReportUlCqiInfo(const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params) override
+    {
+    }
+
+    void ReportUlCqiInfo(std::map<uint16_t, std::vector<double>> ulCqiMap) override
+    {
+    }
+
+    uint8_t GetTpc(uint16_t rnti) override
+    {
+        return 1; // 1 is mapped to 0 for Accumulated mode, and to -1 in Absolute mode
+    }
+
+    uint16_t GetMinContinuousUlBandwidth() override
+    {
+        return m_ulBandwidth;
+    }
+
+  private:
+    uint16_t m_dlRbgNum;    ///< number of DL RBGs
+    uint16_t m_ulBandwidth; ///< UL bandwidth in RBs
+};
+
+/**
+ * @param bandwidth the DL bandwidth in RBs
+ * @return the RBG size for resource allocation type 0 (see table 7.1.6.1-1 of 36.213)
+ */
+uint16_t
+GetRbgSize(uint16_t bandwidth)
+{
+    return (bandwidth < 10) ? 1 : (bandwidth < 26) ? 2 : (bandwidth < 63) ? 3 : 4;
+}
+
+/**
+ * Run a scheduler for a number of TTIs.
+ * @param scheduler the TypeId name of the scheduler
+ * @param nUes the number of UEs
+ * @param bandwidth the DL and UL bandwidth in RBs
+ * @param ttis the number of measured TTIs
+ * @return the number of TTIs processed per second
+ */
+double
+Run(const std::string& scheduler, uint16_t nUes, uint16_t bandwidth, uint32_t ttis)
+{
+    const uint16_t rbgNum = bandwidth / GetRbgSize(bandwidth);
+    const uint8_t lcid = 3;
+    const uint32_t cqiPeriod = 10;
+    // the feedback of the transmissions of a TTI is received 4 TTIs later
+    const uint32_t harqDelay = 4;
+
+    ObjectFactory factory(scheduler);
+    auto sched = factory.Create<FfMacScheduler>();
+    CschedSapUserStub cschedSapUser;
+    SchedSapUserStub schedSapUser;
+    FfrSapProviderStub ffrSapProvider(rbgNum, bandwidth);
+    sched->SetFfMacCschedSapUser(&cschedSapUser);
+    sched->SetFfMacSchedSapUser(&schedSapUser);
+    sched->SetLteFfrSapProvider(&ffrSapProvider);
+    sched->Initialize();
+    auto csched = sched->GetFfMacCschedSapProvider();
+    auto schedSap = sched->GetFfMacSchedSapProvider();
+
+    FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig{};
+    cellConfig.m_dlBandwidth = bandwidth;
+    cellConfig.m_ulBandwidth = bandwidth;
+    csched->CschedCellConfigReq(cellConfig);
+
+    FfMacSchedSapProvider::SchedDlRlcBufferReqParameters bufferReq{};
+    bufferReq.m_logicalChannelIdentity = lcid;
+    bufferReq.m_rlcTransmissionQueueSize = 1000000;
+
+    for (uint16_t rnti = 1; rnti <= nUes; rnti++)
+    {
+        FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig{};
+        ueConfig.m_rnti = rnti;
+        ueConfig.m_transmissionMode = 0; // SISO
+        csched->CschedUeConfigReq(ueConfig);
+
+        FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig{};
+        lcConfig.m_rnti = rnti;
+        LogicalChannelConfigListElement_s lc;
+        lc.m_logicalChannelIdentity = lcid;
+        lc.m_logicalChannelGroup = 0;
+        lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+        lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+        lc.m_qci = 9;
+        lc.m_eRabMaximulBitrateUl = 100000000;
+        lc.m_eRabMaximulBitrateDl = 100000000;
+        lc.m_eRabGuaranteedBitrateUl = 1000000;
+        lc.m_eRabGuaranteedBitrateDl = 1000000;
+        lcConfig.m_logicalChannelConfigList.push_back(lc);
+        csched->CschedLcConfigReq(lcConfig);
+
+        bufferReq.m_rnti = rnti;
+        schedSap->SchedDlRlcBufferReq(bufferReq);
+    }
+
+    std::vector<std::vector<DlInfoListElement_s>> pendingFeedback(harqDelay);
+    auto runTti = [&](uint32_t tti) {
+        const uint16_t sfnSf = (((tti / 10) % 1024) << 4) | (tti % 10 + 1);
+
+        FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiInfo;
+        cqiInfo.m_sfnSf = sfnSf;
+        for (uint16_t rnti = 1 + tti % cqiPeriod; rnti <= nUes; rnti += cqiPeriod)
+        {
+            CqiListElement_s cqi;
+            cqi.m_rnti = rnti;
+            cqi.m_ri = 1;
+            cqi.m_cqiType = CqiListElement_s::A30;
+            cqi.m_wbCqi.push_back(1 + (rnti * 7 + tti / cqiPeriod) % 15);
+            for (uint16_t rbg = 0; rbg < rbgNum; rbg++)
+            {
+                HigherLayerSelected_s sb;
+                sb.m_sbPmi = 0;
+                sb.m_sbCqi.push_back(1 + (rnti * 7 + rbg * 3 + tti / cqiPeriod) % 15);
+                cqi.m_sbMeasResult.m_higherLayerSelected.push_back(sb);
+            }
+            cqiInfo.m_cqiList.push_back(cqi);
+        }
+        schedSap->SchedDlCqiInfoReq(cqiInfo);
+
+        FfMacSchedSapProvider::SchedDlTriggerReqParameters dlTrigger;
+        dlTrigger.m_sfnSf = sfnSf;
+        dlTrigger.m_dlInfoList = std::move(pendingFeedback[tti % harqDelay]);
+        schedSapUser.m_dlTx.clear();
+        schedSap->SchedDlTriggerReq(dlTrigger);
+        pendingFeedback[tti % harqDelay] = schedSapUser.m_dlTx;
+
+        // refill the RLC buffers of the UEs that were served
+        for (const auto& tx : schedSapUser.m_dlTx)
+        {
+            bufferReq.m_rnti = tx.m_rnti;
+            schedSap->SchedDlRlcBufferReq(bufferReq);
+        }
+
+        FfMacSchedSapProvider::SchedUlTriggerReqParameters ulTrigger;
+        ulTrigger.m_sfnSf = sfnSf;
+        schedSap->SchedUlTriggerReq(ulTrigger);
+    };
+
+    // warm up, so that all the UEs have reported their CQIs
+    const uint32_t warmup = 2 * cqiPeriod;
+    for (uint32_t tti = 0; tti < warmup; tti++)
+    {
+        runTti(tti);
+    }
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t tti = warmup; tti < warmup + ttis; tti++)
+    {
+        runTti(tti);
+    }
+    int64_t elapsed = timer.End();
+    sched->Dispose();
+    return (elapsed > 0) ? 1e3 * ttis / elapsed : 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string scheduler = "ns3::PfFfMacScheduler";
+    std::string ues = "10,50,100,200,400";
+    uint16_t bandwidth = 100;
+    uint32_t ttis = 2000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark an FF MAC scheduler for several numbers of UEs in a cell.");
+    cmd.AddValue("scheduler", "TypeId name of the FF MAC scheduler", scheduler);
+    cmd.AddValue("ues", "comma-separated list of the numbers of UEs", ues);
+    cmd.AddValue("bandwidth", "DL and UL bandwidth in RBs", bandwidth);
+    cmd.AddValue("ttis", "number of measured TTIs for each number of UEs", ttis);
+    cmd.Parse(argc, argv);
+
+    std::cout << scheduler << ", " << bandwidth << " RBs" << std::endl;
+    std::cout << std::setw(6) << "UEs" << std::setw(12) << "TTIs/s" << std::setw(14)
+              << "us per TTI" << std::endl;
+
+    std::istringstream list(ues);
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        auto nUes = static_cast<uint16_t>(std::stoul(item));
+        double rate = Run(scheduler, nUes, bandwidth, ttis);
+        std::cout << std::setw(6) << nUes << std::setw(12) << std::fixed << std::setprecision(0)
+                  << rate << std::setw(14) << std::setprecision(1)
+                  << ((rate > 0) ? 1e6 / rate : 0) << std::endl;
+    }
+    return 0;
+}
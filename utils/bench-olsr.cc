@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the OLSR control plane for increasing node
+// densities: the nodes are placed at random in a square area and exchange
+// OLSR messages over an ad hoc WiFi network whose range is fixed, without any
+// data traffic. For each number of nodes, it reports the mean number of
+// neighbors of a node and the wall clock time needed to simulate the network.
+// Sample usage:  ./ns3 run 'bench-olsr --nodes=50,100,200 --duration=20'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/olsr-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Simulate a network of OLSR nodes.
+ * @param nNodes the number of nodes
+ * @param side the side of the square area, in meters
+ * @param range the range of the nodes, in meters
+ * @param duration the simulated time
+ * @param meanNeighbors [out] the mean number of neighbors of a node
+ * @return the wall clock time needed to simulate the network, in milliseconds
+ */
+static int64_t
+Run(uint32_t nNodes, double side, double range, Time duration, double& meanNeighbors)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes(nNodes);
+    MobilityHelper mobility;
+    std::ostringstream bound;
+    bound << "ns3::UniformRandomVariable[Min=0|Max=" << side << "]";
+    mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
+                                  "X",
+                                  StringValue(bound.str()),
+                                  "Y",
+                                  StringValue(bound.str()));
+    mobility.Install(nodes);
+
+    uint32_t nLinks = 0;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        auto position = nodes.Get(i)->GetObject<MobilityModel>();
+        for (uint32_t j = i + 1; j < nNodes; j++)
+        {
+            if (position->GetDistanceFrom(nodes.Get(j)->GetObject<MobilityModel>()) <= range)
+            {
+                nLinks++;
+            }
+        }
+    }
+    meanNeighbors = (nNodes > 0) ? 2.0 * nLinks / nNodes : 0;
+
+    YansWifiChannelHelper channel;
+    channel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    channel.AddPropagationLoss("ns3::RangePropagationLossModel", "MaxRange", DoubleValue(range));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    OlsrHelper olsr;
+    InternetStackHelper internet;
+    internet.SetRoutingHelper(olsr);
+    internet.Install(nodes);
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.0.0");
+    addresses.Assign(devices);
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(duration);
+    Simulator::Run();
+    int64_t elapsed = timer.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string nodes = "25,50,100,200";
+    double side = 500;
+    double range = 100;
+    Time duration = Seconds(20);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the OLSR control plane for increasing node densities.");
+    cmd.AddValue("nodes", "comma-separated list of the numbers of nodes", nodes);
+    cmd.AddValue("side", "side of the square area, in meters", side);
+    cmd.AddValue("range", "range of the nodes, in meters", range);
+    cmd.AddValue("duration", "simulated time for each number of nodes", duration);
+    cmd.Parse(argc, argv);
+
+    std::cout << side << " m x " << side << " m, range " << range << " m, "
+              << duration.As(Time::S) << std::endl;
+    std::cout << std::setw(6) << "nodes" << std::setw(12) << "neighbors" << std::setw(12)
+              << "wall ms" << std::setw(18) << "wall ms per sim s" << std::endl;
+
+    std::istringstream list(nodes);
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        auto nNodes = static_cast<uint32_t>(std::stoul(item));
+        double meanNeighbors = 0;
+        int64_t elapsed = Run(nNodes, side, range, duration, meanNeighbors);
+        std::cout << std::setw(6) << nNodes << std::setw(12) << std::fixed << std::setprecision(1)
+                  << meanNeighbors << std::setw(12) << elapsed << std::setw(18)
+                  << elapsed / duration.GetSeconds() << std::endl;
+    }
+    return 0;
+}
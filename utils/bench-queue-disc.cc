@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the enqueue and dequeue operations of the queue
+// discs of the traffic-control module.  Bursts of packets arrive at a queue
+// disc at regular intervals, and the queue disc is drained at a lower rate,
+// so that the AQM algorithms of RED, adaptive RED, PIE and CoDel drop
+// packets.  For each queue disc, it reports the number of packets enqueued
+// and dropped and the wall clock time needed to process the bursts, with
+// calls to Enqueue and Dequeue for each packet and with calls to
+// EnqueueBatch and DequeueBatch for each burst.  The numbers of packets
+// enqueued and dropped are checked to be identical.
+// Sample usage:  ./ns3 run 'bench-queue-disc --bursts=100000 --burst=32'
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/pie-queue-disc.h"
+#include "ns3/queue-disc.h"
+#include "ns3/red-queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Queue disc item of the benchmark, without headers.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * @param p the packet
+     */
+    BenchQueueDiscItem(Ptr<Packet> p)
+        : QueueDiscItem(p, Address(), 0)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+};
+
+/// Parameters and state of a run
+struct Run
+{
+    Ptr<QueueDisc> queueDisc;              //!< queue disc
+    uint32_t nBursts;                      //!< number of bursts to process
+    uint32_t burst;                        //!< number of packets per burst
+    uint32_t drain;                        //!< number of packets dequeued per burst
+    bool batch;                            //!< whether to use the batch entry points
+    std::vector<Ptr<QueueDiscItem>> items; //!< packets of a burst
+    uint32_t nBurstsDone{0};               //!< bursts processed
+    uint64_t nEnqueued{0};                 //!< packets enqueued
+    uint64_t nDequeued{0};                 //!< packets dequeued
+};
+
+/**
+ * Enqueue a burst of packets, dequeue some packets, and schedule the next burst.
+ * @param run the run
+ */
+static void
+Burst(Run* run)
+{
+    run->items.clear();
+    for (uint32_t i = 0; i < run->burst; i++)
+    {
+        run->items.push_back(Create<BenchQueueDiscItem>(Create<Packet>(1000)));
+    }
+    if (run->batch)
+    {
+        run->nEnqueued += run->queueDisc->EnqueueBatch(run->items);
+        run->items.clear();
+        run->nDequeued += run->queueDisc->DequeueBatch(run->drain, run->items);
+    }
+    else
+    {
+        for (const auto& item : run->items)
+        {
+            run->nEnqueued += run->queueDisc->Enqueue(item);
+        }
+        for (uint32_t i = 0; i < run->drain && run->queueDisc->Dequeue(); i++)
+        {
+            run->nDequeued++;
+        }
+    }
+    if (++run->nBurstsDone < run->nBursts)
+    {
+        Simulator::Schedule(MilliSeconds(1), &Burst, run);
+    }
+    else
+    {
+        Simulator::Stop();
+    }
+}
+
+/**
+ * Process bursts of packets with a queue disc.
+ * @param name the name shown for the queue disc
+ * @param factory the factory of the queue disc
+ * @param nBursts the number of bursts
+ * @param burst the number of packets per burst
+ * @param batch whether to use the batch entry points
+ * @return the numbers of packets enqueued and dropped
+ */
+static std::pair<uint64_t, uint64_t>
+Measure(std::string name, ObjectFactory factory, uint32_t nBursts, uint32_t burst, bool batch)
+{
+    Run run;
+    run.queueDisc = factory.Create<QueueDisc>();
+    if (auto red = DynamicCast<RedQueueDisc>(run.queueDisc))
+    {
+        red->AssignStreams(0);
+    }
+    if (auto pie = DynamicCast<PieQueueDisc>(run.queueDisc))
+    {
+        pie->AssignStreams(0);
+    }
+    run.queueDisc->Initialize();
+    run.nBursts = nBursts;
+    run.burst = burst;
+    // the queue disc builds up a standing queue
+    run.drain = std::max<uint32_t>(burst * 3 / 4, 1);
+    run.batch = batch;
+
+    Simulator::Schedule(MilliSeconds(1), &Burst, &run);
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t ms = timer.End();
+
+    uint64_t nDropped = run.queueDisc->GetStats().nTotalDroppedPackets;
+    run.queueDisc->Dispose();
+    Simulator::Destroy();
+
+    std::cout << std::setw(8) << name << std::setw(8) << (batch ? "batch" : "single")
+              << std::setw(12) << run.nEnqueued << std::setw(12) << nDropped << std::setw(10) << ms
+              << std::endl;
+    return {run.nEnqueued, nDropped};
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nBursts = 100000;
+    uint32_t burst = 32;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the enqueue and dequeue operations of the queue discs.");
+    cmd.AddValue("bursts", "number of bursts", nBursts);
+    cmd.AddValue("burst", "number of packets per burst", burst);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nBursts == 0 || burst == 0, "There must be at least one packet");
+
+    std::vector<std::pair<std::string, ObjectFactory>> queueDiscs;
+    ObjectFactory factory("ns3::FifoQueueDisc");
+    queueDiscs.emplace_back("Fifo", factory);
+    factory.SetTypeId("ns3::RedQueueDisc");
+    factory.Set("MaxSize", StringValue("1000p"));
+    queueDiscs.emplace_back("RED", factory);
+    factory.Set("ARED", BooleanValue(true));
+    queueDiscs.emplace_back("ARED", factory);
+    factory = ObjectFactory("ns3::PieQueueDisc");
+    queueDiscs.emplace_back("PIE", factory);
+    factory.SetTypeId("ns3::CoDelQueueDisc");
+    queueDiscs.emplace_back("CoDel", factory);
+
+    std::cout << std::setw(8) << "qdisc" << std::setw(8) << "calls" << std::setw(12) << "enqueued"
+              << std::setw(12) << "dropped" << std::setw(10) << "ms" << std::endl;
+    for (const auto& [name, f] : queueDiscs)
+    {
+        auto single = Measure(name, f, nBursts, burst, false);
+        auto batched = Measure(name, f, nBursts, burst, true);
+        NS_ABORT_MSG_IF(single != batched, "Different numbers of packets enqueued or dropped");
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the arithmetic of SpectrumValue against a plain
+// implementation in which every operator copies its left operand and loops
+// with iterators, for several numbers of bands.
+// Sample usage:  ./ns3 run 'bench-spectrum-value --elements=100000000'
+
+#include "ns3/command-line.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Plain implementation of the SpectrumValue operations, used as the
+ * reference of the benchmark.
+ */
+namespace plain
+{
+
+/**
+ * Element-wise addition
+ * @param lhs the first operand
+ * @param rhs the second operand
+ * @return lhs + rhs
+ */
+Values
+Add(const Values& lhs, const Values& rhs)
+{
+    Values res = lhs;
+    auto it2 = rhs.begin();
+    for (auto it1 = res.begin(); it1 != res.end(); ++it1, ++it2)
+    {
+        *it1 += *it2;
+    }
+    return res;
+}
+
+/**
+ * Element-wise subtraction, computed as the opposite of rhs plus lhs
+ * @param lhs the first operand
+ * @param rhs the second operand
+ * @return lhs - rhs
+ */
+Values
+Subtract(const Values& lhs, const Values& rhs)
+{
+    Values res = rhs;
+    for (auto it1 = res.begin(); it1 != res.end(); ++it1)
+    {
+        *it1 = -(*it1);
+    }
+    auto it2 = lhs.begin();
+    for (auto it1 = res.begin(); it1 != res.end(); ++it1, ++it2)
+    {
+        *it1 += *it2;
+    }
+    return res;
+}
+
+/**
+ * Element-wise multiplication
+ * @param lhs the first operand
+ * @param rhs the second operand
+ * @return lhs * rhs
+ */
+Values
+Multiply(const Values& lhs, const Values& rhs)
+{
+    Values res = lhs;
+    auto it2 = rhs.begin();
+    for (auto it1 = res.begin(); it1 != res.end(); ++it1, ++it2)
+    {
+        *it1 *= *it2;
+    }
+    return res;
+}
+
+/**
+ * Element-wise division
+ * @param lhs the first operand
+ * @param rhs the second operand
+ * @return lhs / rhs
+ */
+Values
+Divide(const Values& lhs, const Values& rhs)
+{
+    Values res = lhs;
+    auto it2 = rhs.begin();
+    for (auto it1 = res.begin(); it1 != res.end(); ++it1, ++it2)
+    {
+        *it1 /= *it2;
+    }
+    return res;
+}
+
+/**
+ * Integral of a function over the bands of a spectrum model
+ * @param values the values of the function
+ * @param model the spectrum model
+ * @return the integral
+ */
+double
+Integral(const Values& values, Ptr<const SpectrumModel> model)
+{
+    double i = 0;
+    auto bit = model->Begin();
+    for (auto vit = values.begin(); vit != values.end(); ++vit, ++bit)
+    {
+        i += (*vit) * (bit->fh - bit->fl);
+    }
+    return i;
+}
+
+} // namespace plain
+
+/**
+ * Run an operation repeatedly and return its duration.
+ * @param iterations the number of repetitions
+ * @param operation the operation, returning a value to keep
+ * @return the duration in nanoseconds per operation
+ */
+template <class F>
+double
+Measure(uint32_t iterations, F operation)
+{
+    double sink = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        sink += operation();
+    }
+    int64_t elapsed = timer.End();
+    // prevent the compiler from removing the loop
+    if (sink == -1)
+    {
+        std::cout << sink << std::endl;
+    }
+    return 1e6 * elapsed / iterations;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t elements = 50000000;
+    std::vector<uint32_t> bands = {100, 250, 500, 1000, 2000, 4000};
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the arithmetic operations of SpectrumValue.\n"
+              "Each operation is run on about elements/bands SpectrumValues.");
+    cmd.AddValue("elements", "number of elements processed per operation", elements);
+    cmd.Parse(argc, argv);
+
+    std::cout << "time per operation in ns, plain / SpectrumValue" << std::endl;
+    std::cout << std::setw(6) << "bands" << std::setw(22) << "a += b" << std::setw(22)
+              << "a * b + c" << std::setw(22) << "a / (b - a + c)" << std::setw(22)
+              << "Integral(a)" << std::endl;
+
+    for (auto nBands : bands)
+    {
+        std::vector<double> frequencies;
+        for (uint32_t i = 0; i <= nBands; i++)
+        {
+            frequencies.push_back(2.4e9 + i * 78125.0);
+        }
+        auto model = Create<SpectrumModel>(frequencies);
+        SpectrumValue a(model);
+        SpectrumValue b(model);
+        SpectrumValue c(model);
+        for (uint32_t i = 0; i < nBands; i++)
+        {
+            a[i] = 1e-12 * (i + 1);
+            b[i] = 2e-12 * (i % 7 + 1);
+            c[i] = 1e-14;
+        }
+        Values va = a.GetValues();
+        Values vb = b.GetValues();
+        Values vc = c.GetValues();
+        uint32_t iterations = std::max<uint64_t>(elements / nBands, 1);
+
+        double plainAdd = Measure(iterations, [&]() {
+            va = plain::Add(va, vb);
+            return va[0];
+        });
+        double add = Measure(iterations, [&]() {
+            a += b;
+            return a[0];
+        });
+        double plainFma = Measure(iterations, [&]() {
+            Values r = plain::Add(plain::Multiply(va, vb), vc);
+            return r[0];
+        });
+        double fma = Measure(iterations, [&]() {
+            SpectrumValue r = a * b + c;
+            return r[0];
+        });
+        double plainSinr = Measure(iterations, [&]() {
+            Values r = plain::Divide(va, plain::Add(plain::Subtract(vb, va), vc));
+            return r[0];
+        });
+        double sinr = Measure(iterations, [&]() {
+            SpectrumValue r = a / (b - a + c);
+            return r[0];
+        });
+        double plainIntegral =
+            Measure(iterations, [&]() { return plain::Integral(va, model); });
+        double integral = Measure(iterations, [&]() { return Integral(a); });
+
+        auto print = [](double plainTime, double time) {
+            std::cout << std::setw(10) << std::fixed << std::setprecision(1) << plainTime << " /"
+                      << std::setw(10) << time;
+        };
+        std::cout << std::setw(6) << nBands;
+        print(plainAdd, add);
+        print(plainFma, fma);
+        print(plainSinr, sinr);
+        print(plainIntegral, integral);
+        std::cout << std::endl;
+    }
+    return 0;
+}
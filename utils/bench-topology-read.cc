@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the topology readers on large synthetic Internet
+// maps: it writes an Inet, an Orbis and a Rocketfuel weights file with the
+// same random links, then reports for each format the wall clock time needed
+// to read the file, to build the adjacency of the nodes and, optionally, to
+// install a device on both nodes of each link.
+// Sample usage:  ./ns3 run 'bench-topology-read --links=1000000 --nodes=100000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/inet-topology-reader.h"
+#include "ns3/names.h"
+#include "ns3/node-container.h"
+#include "ns3/orbis-topology-reader.h"
+#include "ns3/rocketfuel-topology-reader.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-path.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Write the same links in the three formats.
+ * @param dir the directory of the files
+ * @param nNodes the number of nodes
+ * @param links the links
+ */
+static void
+WriteFiles(const std::string& dir,
+           uint32_t nNodes,
+           const std::vector<std::pair<uint32_t, uint32_t>>& links)
+{
+    std::ofstream inet(SystemPath::Append(dir, "inet.txt"));
+    inet << nNodes << " " << links.size() << "\n";
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        inet << i << " " << i % 1000 << " " << i / 1000 << "\n";
+    }
+    std::ofstream orbis(SystemPath::Append(dir, "orbis.txt"));
+    std::ofstream weights(SystemPath::Append(dir, "weights.txt"));
+    for (const auto& [from, to] : links)
+    {
+        inet << from << "\t" << to << "\t" << 1 + (from + to) % 100 << "\n";
+        orbis << from << " " << to << "\n";
+        weights << "r" << from << "\tr" << to << "\t" << 1 + (from + to) % 100 << "\n";
+    }
+}
+
+/**
+ * Read a topology file and report the time of each step.
+ * @param format the name of the format
+ * @param reader the topology reader
+ * @param fileName the name of the file
+ * @param install whether to install a device on both nodes of each link
+ */
+static void
+Run(const std::string& format,
+    Ptr<TopologyReader> reader,
+    const std::string& fileName,
+    bool install)
+{
+    reader->SetFileName(fileName);
+    SystemWallClockMs timer;
+
+    timer.Start();
+    NodeContainer nodes = reader->Read();
+    int64_t readMs = timer.End();
+
+    timer.Start();
+    TopologyReader::Adjacency adjacency = reader->GetAdjacency(nodes);
+    int64_t adjacencyMs = timer.End();
+    NS_ABORT_IF(adjacency.neighbors.size() != 2 * static_cast<std::size_t>(reader->LinksSize()));
+
+    int64_t installMs = 0;
+    if (install)
+    {
+        SimpleNetDeviceHelper helper;
+        timer.Start();
+        reader->InstallLinks(helper);
+        installMs = timer.End();
+    }
+
+    std::cout << std::setw(12) << format << std::setw(10) << nodes.GetN() << std::setw(10)
+              << reader->LinksSize() << std::setw(10) << readMs << std::setw(14) << adjacencyMs
+              << std::setw(12) << installMs << std::endl;
+
+    Simulator::Destroy();
+    Names::Clear();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nLinks = 1000000;
+    uint32_t nNodes = 100000;
+    bool install = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the topology readers on large synthetic maps.");
+    cmd.AddValue("links", "number of links", nLinks);
+    cmd.AddValue("nodes", "number of nodes", nNodes);
+    cmd.AddValue("install", "install a device on both nodes of each link", install);
+    cmd.Parse(argc, argv);
+
+    if (nNodes < 2 || nLinks > uint64_t(nNodes) * (nNodes - 1) / 2)
+    {
+        std::cerr << "There must be at least 2 nodes and at most one link per pair of nodes"
+                  << std::endl;
+        return 1;
+    }
+
+    // random links between distinct pairs of nodes, the first ones starting from each node
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> node(0, nNodes - 1);
+    std::set<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    links.reserve(nLinks);
+    while (links.size() < nLinks)
+    {
+        uint32_t from = (links.size() < nNodes) ? links.size() : node(rng);
+        uint32_t to = node(rng);
+        if (from != to && pairs.emplace(std::min(from, to), std::max(from, to)).second)
+        {
+            links.emplace_back(from, to);
+        }
+    }
+
+    std::string dir = SystemPath::MakeTemporaryDirectoryName();
+    SystemPath::MakeDirectories(dir);
+    WriteFiles(dir, nNodes, links);
+
+    std::cout << std::setw(12) << "format" << std::setw(10) << "nodes" << std::setw(10) << "links"
+              << std::setw(10) << "read ms" << std::setw(14) << "adjacency ms" << std::setw(12)
+              << "install ms" << std::endl;
+    Run("Inet", CreateObject<InetTopologyReader>(), SystemPath::Append(dir, "inet.txt"), install);
+    Run("Orbis",
+        CreateObject<OrbisTopologyReader>(),
+        SystemPath::Append(dir, "orbis.txt"),
+        install);
+    Run("Rocketfuel",
+        CreateObject<RocketfuelTopologyReader>(),
+        SystemPath::Append(dir, "weights.txt"),
+        install);
+
+    for (const auto& name : {"inet.txt", "orbis.txt", "weights.txt"})
+    {
+        std::remove(SystemPath::Append(dir, name).c_str());
+    }
+    std::remove(dir.c_str());
+    return 0;
+}
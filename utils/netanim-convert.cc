@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program converts a binary animation trace, written by an
+// AnimationInterface created with the BINARY_TRACE format, to the XML trace
+// that NetAnim reads.
+// Sample usage:  ./ns3 run 'netanim-convert --input=anim.bin --output=anim.xml'
+
+#include "ns3/animation-interface.h"
+#include "ns3/command-line.h"
+
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary animation trace to the XML trace read by NetAnim.");
+    cmd.AddValue("input", "binary trace file", input);
+    cmd.AddValue("output", "XML trace file", output);
+    cmd.Parse(argc, argv);
+
+    if (input.empty() || output.empty())
+    {
+        std::cerr << "Both --input and --output are required" << std::endl;
+        return 1;
+    }
+    AnimationInterface::ConvertBinaryTrace(input, output);
+    return 0;
+}